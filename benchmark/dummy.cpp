@@ -1,6 +0,0 @@
-#include <Core/Core.h>
-#include <benchmark/benchmark.h>
-
-// @Incomplete Add realistic use-case benchmarks ...
-
-// BENCHMARK(BM_...);
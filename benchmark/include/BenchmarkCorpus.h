@@ -0,0 +1,35 @@
+#ifndef __JELLYBENCHMARK_BENCHMARKCORPUS__
+#define __JELLYBENCHMARK_BENCHMARKCORPUS__
+
+#include <JellyCore/JellyCore.h>
+#include <string>
+
+/// Generates `functionCount` functions with local variables, branches, loops and calls into the previous function.
+std::string BenchmarkCorpusMakeFunctions(Index functionCount, const std::string &prefix = "function");
+
+/// Generates `structureCount` structures which are pointing to the previous structure and a function accessing the members of each.
+std::string BenchmarkCorpusMakeStructures(Index structureCount);
+
+/// Generates `declarationCount` global variable declarations in a single source unit.
+std::string BenchmarkCorpusMakeDeclarations(Index declarationCount);
+
+/// Generates a single function returning a binary expression which is nested `depth` times.
+std::string BenchmarkCorpusMakeDeepExpression(Index depth);
+
+/// Appends the entry point which is required to build the IR of a corpus.
+std::string BenchmarkCorpusMakeEntryPoint();
+
+/// Generates the recursive fibonacci sample with an entry point exiting with the status `fibonacci(n)`, so the computation is observable
+/// and can't be removed by the optimizer.
+std::string BenchmarkCorpusMakeFibonacciProgram(Index n);
+
+/// Writes a `main.jelly` into `directory` which `#load`(s) `fileCount` files each containing `functionCount` functions.
+void BenchmarkCorpusWriteLoadFiles(const std::string &directory, Index fileCount, Index functionCount);
+
+/// Creates a new temporary directory and returns its path.
+std::string BenchmarkCorpusCreateTemporaryDirectory();
+
+/// Removes `directory` including all files and subdirectories like the build directory of a workspace.
+void BenchmarkCorpusRemoveDirectory(const std::string &directory);
+
+#endif
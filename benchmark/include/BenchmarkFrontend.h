@@ -0,0 +1,30 @@
+#ifndef __JELLYBENCHMARK_BENCHMARKFRONTEND__
+#define __JELLYBENCHMARK_BENCHMARKFRONTEND__
+
+#include <JellyCore/JellyCore.h>
+#include <string>
+
+/// Runs the stages of the compiler on a single in memory source in the same order as the `Workspace`, each stage expects all previous
+/// stages to be performed already. The AST is mutated by the stages, so a new frontend has to be created for each measured iteration.
+struct BenchmarkFrontend {
+    AllocatorRef allocator;
+    StringRef moduleName;
+    StringRef filePath;
+    StringRef string;
+    SourceBufferRef source;
+    ASTContextRef context;
+    ParserRef parser;
+
+    BenchmarkFrontend(const std::string &source);
+    ~BenchmarkFrontend();
+
+    ASTModuleDeclarationRef GetModule();
+
+    void Parse();
+    void ApplySubstitution();
+    void ResolveNames();
+    void TypeCheck();
+    void MangleNames();
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <JellyCore/JellyCore.h>
+
+#include <vector>
+
+/// Reports the heap usage of the measured iterations through the per-thread allocator statistics, `heap_peak_bytes` is the highest
+/// amount of live heap memory of a single iteration.
+static void _BenchmarkSetHeapCounters(benchmark::State &state, AllocatorStatistics start, Int peakLiveBytes) {
+    AllocatorStatistics statistics     = AllocatorGetThreadStatistics();
+    Index iterations                   = MAX(state.iterations(), 1);
+    state.counters["heap_allocations"] = (double)(statistics.allocationCount - start.allocationCount) / iterations;
+    state.counters["heap_bytes"]       = (double)(statistics.allocatedBytes - start.allocatedBytes) / iterations;
+    state.counters["heap_peak_bytes"]  = (double)peakLiveBytes;
+}
+
+/// Allocates `state.range(0)` blocks of symbol name sizes from `allocator` and releases them again, the allocator is created per
+/// iteration by `create` so that the pages of the arenas are part of the measurement.
+template <typename CreateAllocator>
+static void _BenchmarkAllocator(benchmark::State &state, CreateAllocator create) {
+    std::vector<void *> blocks(state.range(0));
+    AllocatorStatistics start = AllocatorGetThreadStatistics();
+    Int peakLiveBytes         = 0;
+
+    for (auto _ : state) {
+        AllocatorSetThreadPeakLiveBytes(AllocatorGetThreadStatistics().liveBytes);
+        Int liveBytes = AllocatorGetThreadStatistics().liveBytes;
+
+        AllocatorRef allocator = create();
+        for (Index index = 0; index < state.range(0); index++) {
+            blocks[index] = AllocatorAllocate(allocator, 8 + (index % 7) * 8);
+            benchmark::DoNotOptimize(blocks[index]);
+        }
+
+        for (Index index = 0; index < state.range(0); index++) {
+            AllocatorDeallocate(allocator, blocks[index]);
+        }
+
+        if (allocator != AllocatorGetSystemDefault()) {
+            AllocatorDestroy(allocator);
+        }
+
+        peakLiveBytes = MAX(peakLiveBytes, AllocatorGetThreadStatistics().peakLiveBytes - liveBytes);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    _BenchmarkSetHeapCounters(state, start, peakLiveBytes);
+}
+
+static void BM_AllocatorSystem(benchmark::State &state) {
+    _BenchmarkAllocator(state, []() { return AllocatorGetSystemDefault(); });
+}
+
+static void BM_AllocatorBump(benchmark::State &state) {
+    _BenchmarkAllocator(state, []() { return BumpAllocatorCreate(AllocatorGetSystemDefault()); });
+}
+
+static void BM_AllocatorTemp(benchmark::State &state) {
+    _BenchmarkAllocator(state, []() { return TempAllocatorCreate(AllocatorGetSystemDefault()); });
+}
+
+/// Creates an ASTContext including the scopes of all builtin operators, which is the fixed memory cost of every compilation.
+static void BM_ASTContextCreate(benchmark::State &state) {
+    StringRef moduleName      = StringCreate(AllocatorGetSystemDefault(), "Benchmark");
+    AllocatorStatistics start = AllocatorGetThreadStatistics();
+    Int peakLiveBytes         = 0;
+
+    for (auto _ : state) {
+        AllocatorSetThreadPeakLiveBytes(AllocatorGetThreadStatistics().liveBytes);
+        Int liveBytes = AllocatorGetThreadStatistics().liveBytes;
+
+        ASTContextRef context = ASTContextCreate(AllocatorGetSystemDefault(), AllocatorGetSystemDefault(), moduleName);
+        benchmark::DoNotOptimize(context);
+        ASTContextDestroy(context);
+
+        peakLiveBytes = MAX(peakLiveBytes, AllocatorGetThreadStatistics().peakLiveBytes - liveBytes);
+    }
+
+    _BenchmarkSetHeapCounters(state, start, peakLiveBytes);
+    StringDestroy(moduleName);
+}
+
+BENCHMARK(BM_AllocatorSystem)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK(BM_AllocatorBump)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK(BM_AllocatorTemp)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK(BM_ASTContextCreate)->Unit(benchmark::kMillisecond);
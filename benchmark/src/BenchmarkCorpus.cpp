@@ -0,0 +1,143 @@
+#include "BenchmarkCorpus.h"
+
+#include <dirent.h>
+#include <fstream>
+#include <stdlib.h>
+#include <unistd.h>
+
+std::string BenchmarkCorpusMakeFunctions(Index functionCount, const std::string &prefix) {
+    std::string source = "// Synthetic function corpus\n\n";
+    for (Index index = 0; index < functionCount; index++) {
+        std::string name = prefix + std::to_string(index);
+        source += "/* The function " + name + " computes a value\n   from its arguments. */\n";
+        source += "func " + name + "(lhs: Int, rhs: Int, flag: Bool) -> Int {\n";
+        source += "    var accumulator: Int = 0x1F + 0b101 + " + std::to_string(index) + "\n";
+        source += "    if flag && lhs >= rhs {\n";
+        source += "        accumulator = lhs * rhs + accumulator // multiply\n";
+        source += "    } else {\n";
+        source += "        accumulator = lhs - rhs\n";
+        source += "    }\n\n";
+        source += "    while accumulator > 1024 {\n";
+        source += "        accumulator = accumulator / 2\n";
+        source += "    }\n\n";
+        if (index > 0) {
+            source += "    return accumulator + " + prefix + std::to_string(index - 1) + "(rhs, lhs, !flag)\n";
+        } else {
+            source += "    return accumulator\n";
+        }
+        source += "}\n\n";
+    }
+
+    return source;
+}
+
+std::string BenchmarkCorpusMakeStructures(Index structureCount) {
+    std::string source = "// Synthetic structure corpus\n\n";
+    for (Index index = 0; index < structureCount; index++) {
+        std::string name = "Structure" + std::to_string(index);
+        source += "struct " + name + " {\n";
+        source += "    var x: Int\n";
+        source += "    var y: Float\n";
+        source += "    var flag: Bool\n";
+        if (index > 0) {
+            source += "    var previous: Structure" + std::to_string(index - 1) + "*\n";
+        }
+        source += "}\n\n";
+        source += "func sum" + name + "(value: " + name + "*) -> Int {\n";
+        source += "    var result: Int = value.x\n";
+        source += "    if value.flag {\n";
+        source += "        result = result + 1\n";
+        source += "    }\n\n";
+        source += "    return result\n";
+        source += "}\n\n";
+    }
+
+    return source;
+}
+
+std::string BenchmarkCorpusMakeDeclarations(Index declarationCount) {
+    std::string source = "// Synthetic declaration corpus\n\n";
+    for (Index index = 0; index < declarationCount; index++) {
+        source += "var global" + std::to_string(index) + ": Int = " + std::to_string(index) + "\n";
+    }
+
+    return source;
+}
+
+std::string BenchmarkCorpusMakeDeepExpression(Index depth) {
+    static const char *operators[] = {" + ", " * ", " - ", " / "};
+
+    std::string expression;
+    for (Index index = 0; index < depth; index++) {
+        expression += "(value" + std::string(operators[index % 4]);
+    }
+    expression += "value";
+    expression += std::string(depth, ')');
+
+    return "// Synthetic expression corpus\n\nfunc deepExpression(value: Int) -> Int {\n    return " + expression + "\n}\n\n";
+}
+
+std::string BenchmarkCorpusMakeEntryPoint() {
+    return "func main() -> Void {}\n";
+}
+
+std::string BenchmarkCorpusMakeFibonacciProgram(Index n) {
+    // The status parameter is declared as Int because there is no integer conversion yet, the callee only reads the lower 32 bits
+    std::string source = "#foreign func exit(status: Int) -> Void \"exit\"\n\n";
+    source += "func fibonacci(n: Int) -> Int {\n";
+    source += "    if n < 2 {\n";
+    source += "        return n\n";
+    source += "    }\n\n";
+    source += "    return fibonacci(n - 1) + fibonacci(n - 2)\n";
+    source += "}\n\n";
+    source += "func main() -> Void {\n";
+    source += "    exit(fibonacci(" + std::to_string(n) + "))\n";
+    source += "}\n";
+    return source;
+}
+
+void BenchmarkCorpusWriteLoadFiles(const std::string &directory, Index fileCount, Index functionCount) {
+    std::ofstream mainFile(directory + "/main.jelly");
+    for (Index index = 0; index < fileCount; index++) {
+        std::string fileName = "File" + std::to_string(index) + ".jelly";
+        mainFile << "#load \"" << fileName << "\"\n";
+
+        std::ofstream file(directory + "/" + fileName);
+        file << BenchmarkCorpusMakeFunctions(functionCount, "file" + std::to_string(index) + "Function");
+    }
+
+    mainFile << "\n" << BenchmarkCorpusMakeEntryPoint();
+}
+
+std::string BenchmarkCorpusCreateTemporaryDirectory() {
+    char path[] = "/tmp/JellyBenchmark.XXXXXX";
+    if (!mkdtemp(path)) {
+        FatalError("Couldn't create temporary directory for benchmark corpus");
+    }
+
+    return path;
+}
+
+void BenchmarkCorpusRemoveDirectory(const std::string &directory) {
+    DIR *handle = opendir(directory.c_str());
+    if (!handle) {
+        return;
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(handle))) {
+        std::string fileName = entry->d_name;
+        if (fileName == "." || fileName == "..") {
+            continue;
+        }
+
+        if (entry->d_type == DT_DIR) {
+            BenchmarkCorpusRemoveDirectory(directory + "/" + fileName);
+        } else {
+            unlink((directory + "/" + fileName).c_str());
+        }
+    }
+
+    closedir(handle);
+    rmdir(directory.c_str());
+}
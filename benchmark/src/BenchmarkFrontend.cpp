@@ -0,0 +1,52 @@
+#include "BenchmarkFrontend.h"
+
+#include <JellyCore/ASTMangling.h>
+#include <JellyCore/ASTSubstitution.h>
+#include <JellyCore/TypeChecker.h>
+
+BenchmarkFrontend::BenchmarkFrontend(const std::string &source) {
+    this->allocator  = AllocatorGetSystemDefault();
+    this->moduleName = StringCreate(this->allocator, "Benchmark");
+    this->filePath   = StringCreate(this->allocator, "main.jelly");
+    this->string     = StringCreate(this->allocator, source.c_str());
+    this->source     = SourceBufferCreateFromString(this->allocator, this->string);
+    this->context    = ASTContextCreate(this->allocator, this->allocator, this->moduleName);
+    this->parser     = ParserCreate(this->allocator, this->allocator, this->context);
+}
+
+BenchmarkFrontend::~BenchmarkFrontend() {
+    ParserDestroy(this->parser);
+    ASTContextDestroy(this->context);
+    SourceBufferDestroy(this->source);
+    StringDestroy(this->string);
+    StringDestroy(this->filePath);
+    StringDestroy(this->moduleName);
+}
+
+ASTModuleDeclarationRef BenchmarkFrontend::GetModule() {
+    return ASTContextGetModule(this->context);
+}
+
+void BenchmarkFrontend::Parse() {
+    ParserParseSourceUnit(this->parser, this->filePath, this->source);
+}
+
+void BenchmarkFrontend::ApplySubstitution() {
+    ASTPerformSubstitution(this->context, ASTTagUnaryExpression, &ASTUnaryExpressionUnification);
+    ASTPerformSubstitution(this->context, ASTTagBinaryExpression, &ASTBinaryExpressionUnification);
+    ASTApplySubstitution(this->context, this->GetModule());
+}
+
+void BenchmarkFrontend::ResolveNames() {
+    PerformNameResolution(this->context, this->GetModule());
+}
+
+void BenchmarkFrontend::TypeCheck() {
+    TypeCheckerRef typeChecker = TypeCheckerCreate(this->allocator);
+    TypeCheckerValidateModule(typeChecker, this->context, this->GetModule());
+    TypeCheckerDestroy(typeChecker);
+}
+
+void BenchmarkFrontend::MangleNames() {
+    PerformNameMangling(this->context, this->GetModule());
+}
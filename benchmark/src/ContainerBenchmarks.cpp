@@ -0,0 +1,212 @@
+#include <benchmark/benchmark.h>
+#include <JellyCore/JellyCore.h>
+#include <string>
+#include <vector>
+
+static void BM_ArrayAppend(benchmark::State &state) {
+    for (auto _ : state) {
+        ArrayRef array = ArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(Index), 8);
+        for (Index index = 0; index < state.range(0); index++) {
+            ArrayAppendElement(array, &index);
+        }
+        ArrayDestroy(array);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ArrayIterate(benchmark::State &state) {
+    ArrayRef array = ArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(Index), state.range(0));
+    for (Index index = 0; index < state.range(0); index++) {
+        ArrayAppendElement(array, &index);
+    }
+
+    for (auto _ : state) {
+        Index sum = 0;
+        for (Index index = 0; index < ArrayGetElementCount(array); index++) {
+            sum += *((Index *)ArrayGetElementAtIndex(array, index));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    ArrayDestroy(array);
+}
+
+static void BM_DictionaryInsert(benchmark::State &state) {
+    std::vector<std::string> keys;
+    for (Index index = 0; index < state.range(0); index++) {
+        keys.push_back("key" + std::to_string(index));
+    }
+
+    for (auto _ : state) {
+        DictionaryRef dictionary = CStringDictionaryCreate(AllocatorGetSystemDefault(), 8);
+        for (Index index = 0; index < state.range(0); index++) {
+            DictionaryInsert(dictionary, keys[index].c_str(), &index, sizeof(Index));
+        }
+        DictionaryDestroy(dictionary);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DictionaryLookup(benchmark::State &state) {
+    std::vector<std::string> keys;
+    DictionaryRef dictionary = CStringDictionaryCreate(AllocatorGetSystemDefault(), 8);
+    for (Index index = 0; index < state.range(0); index++) {
+        keys.push_back("key" + std::to_string(index));
+        DictionaryInsert(dictionary, keys[index].c_str(), &index, sizeof(Index));
+    }
+
+    for (auto _ : state) {
+        for (Index index = 0; index < state.range(0); index++) {
+            benchmark::DoNotOptimize(DictionaryLookup(dictionary, keys[index].c_str()));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    DictionaryDestroy(dictionary);
+}
+
+static void BM_BucketArrayAppend(benchmark::State &state) {
+    for (auto _ : state) {
+        BucketArrayRef array = BucketArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(Index), 8);
+        for (Index index = 0; index < state.range(0); index++) {
+            BucketArrayAppendElement(array, &index);
+        }
+        BucketArrayDestroy(array);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BucketArrayIterate(benchmark::State &state) {
+    BucketArrayRef array = BucketArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(Index), 8);
+    for (Index index = 0; index < state.range(0); index++) {
+        BucketArrayAppendElement(array, &index);
+    }
+
+    for (auto _ : state) {
+        Index sum                    = 0;
+        BucketArrayIterator iterator = BucketArrayGetIterator(array);
+        while (iterator.element) {
+            sum += *((Index *)iterator.element);
+            BucketArrayIteratorNext(&iterator);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    BucketArrayDestroy(array);
+}
+
+/// Sweeps the elements by index like `BM_ArrayIterate` to compare the page lookup of the BucketArray with the contiguous Array.
+static void BM_BucketArrayGetElementAtIndex(benchmark::State &state) {
+    BucketArrayRef array = BucketArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(Index), 8);
+    for (Index index = 0; index < state.range(0); index++) {
+        BucketArrayAppendElement(array, &index);
+    }
+
+    for (auto _ : state) {
+        Index sum = 0;
+        for (Index index = 0; index < BucketArrayGetElementCount(array); index++) {
+            sum += *((Index *)BucketArrayGetElementAtIndex(array, index));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    BucketArrayDestroy(array);
+}
+
+/// ASTArray(s) are owned by the ASTContext and are never deallocated individually, so a new context is created for each iteration.
+static void BM_ASTArrayAppend(benchmark::State &state) {
+    StringRef moduleName = StringCreate(AllocatorGetSystemDefault(), "Benchmark");
+    for (auto _ : state) {
+        state.PauseTiming();
+        ASTContextRef context = ASTContextCreate(AllocatorGetSystemDefault(), AllocatorGetSystemDefault(), moduleName);
+        state.ResumeTiming();
+
+        ASTArrayRef array = ASTContextCreateArray(context, SourceRangeNull(), kScopeNull);
+        for (Index index = 0; index < state.range(0); index++) {
+            ASTArrayAppendElement(array, context);
+        }
+        benchmark::DoNotOptimize(ASTArrayGetElementCount(array));
+
+        state.PauseTiming();
+        ASTContextDestroy(context);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    StringDestroy(moduleName);
+}
+
+static void BM_ASTArrayIterate(benchmark::State &state) {
+    StringRef moduleName  = StringCreate(AllocatorGetSystemDefault(), "Benchmark");
+    ASTContextRef context = ASTContextCreate(AllocatorGetSystemDefault(), AllocatorGetSystemDefault(), moduleName);
+    ASTArrayRef array     = ASTContextCreateArray(context, SourceRangeNull(), kScopeNull);
+    for (Index index = 0; index < state.range(0); index++) {
+        ASTArrayAppendElement(array, context);
+    }
+
+    for (auto _ : state) {
+        Index count                  = 0;
+        ASTArrayIteratorRef iterator = ASTArrayGetIterator(array);
+        while (iterator) {
+            benchmark::DoNotOptimize(ASTArrayIteratorGetElement(iterator));
+            count += 1;
+            iterator = ASTArrayIteratorNext(iterator);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    ASTContextDestroy(context);
+    StringDestroy(moduleName);
+}
+
+static void BM_ASTArrayGetElementAtIndex(benchmark::State &state) {
+    StringRef moduleName  = StringCreate(AllocatorGetSystemDefault(), "Benchmark");
+    ASTContextRef context = ASTContextCreate(AllocatorGetSystemDefault(), AllocatorGetSystemDefault(), moduleName);
+    ASTArrayRef array     = ASTContextCreateArray(context, SourceRangeNull(), kScopeNull);
+    for (Index index = 0; index < state.range(0); index++) {
+        ASTArrayAppendElement(array, context);
+    }
+
+    for (auto _ : state) {
+        for (Index index = 0; index < ASTArrayGetElementCount(array); index++) {
+            benchmark::DoNotOptimize(ASTArrayGetElementAtIndex(array, index));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    ASTContextDestroy(context);
+    StringDestroy(moduleName);
+}
+
+static void BM_QueueEnqueueDequeue(benchmark::State &state) {
+    QueueRef queue = QueueCreate(AllocatorGetSystemDefault());
+    for (auto _ : state) {
+        for (Index index = 0; index < state.range(0); index++) {
+            QueueEnqueue(queue, queue);
+        }
+        while (QueueDequeue(queue)) {
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    QueueDestroy(queue);
+}
+
+BENCHMARK(BM_ArrayAppend)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_ArrayIterate)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_DictionaryInsert)->RangeMultiplier(16)->Range(16, 65536);
+BENCHMARK(BM_DictionaryLookup)->RangeMultiplier(16)->Range(16, 65536);
+BENCHMARK(BM_BucketArrayAppend)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_BucketArrayIterate)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_BucketArrayGetElementAtIndex)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_ASTArrayAppend)->RangeMultiplier(16)->Range(16, 65536);
+BENCHMARK(BM_ASTArrayIterate)->RangeMultiplier(16)->Range(16, 65536);
+BENCHMARK(BM_ASTArrayGetElementAtIndex)->RangeMultiplier(16)->Range(16, 65536);
+BENCHMARK(BM_QueueEnqueueDequeue)->RangeMultiplier(16)->Range(16, 65536);
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include <JellyCore/JellyCore.h>
+
+#include "BenchmarkCorpus.h"
+#include "BenchmarkFrontend.h"
+
+/// The IRBuilder keeps the IR of the AST nodes in its own tables and resets them for each build, so the AST is only verified once and
+/// the same builder is measured building the module repeatedly.
+static void _BenchmarkIRBuilder(benchmark::State &state, const std::string &source) {
+    BenchmarkFrontend frontend(source + BenchmarkCorpusMakeEntryPoint());
+    frontend.Parse();
+    frontend.ApplySubstitution();
+    frontend.ResolveNames();
+    frontend.TypeCheck();
+    frontend.MangleNames();
+
+    StringRef buildDirectory = StringCreate(AllocatorGetSystemDefault(), "build");
+    IRBuilderRef builder     = IRBuilderCreate(AllocatorGetSystemDefault(), frontend.context, buildDirectory);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(IRBuilderBuild(builder, frontend.GetModule()));
+    }
+
+    IRBuilderDestroy(builder);
+    StringDestroy(buildDirectory);
+}
+
+static void BM_IRBuilderFunctions(benchmark::State &state) {
+    _BenchmarkIRBuilder(state, BenchmarkCorpusMakeFunctions(state.range(0)));
+}
+
+static void BM_IRBuilderStructures(benchmark::State &state) {
+    _BenchmarkIRBuilder(state, BenchmarkCorpusMakeStructures(state.range(0)));
+}
+
+static void BM_IRBuilderDeepExpression(benchmark::State &state) {
+    _BenchmarkIRBuilder(state, BenchmarkCorpusMakeDeepExpression(state.range(0)));
+}
+
+BENCHMARK(BM_IRBuilderFunctions)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IRBuilderStructures)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IRBuilderDeepExpression)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
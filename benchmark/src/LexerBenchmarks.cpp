@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <JellyCore/JellyCore.h>
+
+#include "BenchmarkCorpus.h"
+
+static void BM_LexerThroughput(benchmark::State &state) {
+    std::string source = BenchmarkCorpusMakeFunctions(state.range(0));
+    StringRef buffer   = StringCreate(AllocatorGetSystemDefault(), source.c_str());
+    Index tokenCount   = 0;
+
+    for (auto _ : state) {
+        LexerRef lexer = LexerCreate(AllocatorGetSystemDefault(), buffer);
+        Token token;
+        do {
+            LexerNextToken(lexer, &token);
+            tokenCount += 1;
+        } while (token.kind != TokenKindEndOfFile);
+        LexerDestroy(lexer);
+    }
+
+    // Reported as bytes per second which Google Benchmark prints in MB/s
+    state.SetBytesProcessed(state.iterations() * source.size());
+    state.counters["tokens"] = benchmark::Counter(tokenCount, benchmark::Counter::kIsRate);
+    StringDestroy(buffer);
+}
+
+static void BM_TokenBufferCreate(benchmark::State &state) {
+    std::string source = BenchmarkCorpusMakeFunctions(state.range(0));
+    StringRef buffer   = StringCreate(AllocatorGetSystemDefault(), source.c_str());
+
+    for (auto _ : state) {
+        TokenBufferRef tokens = TokenBufferCreate(AllocatorGetSystemDefault(), buffer);
+        benchmark::DoNotOptimize(TokenBufferGetCount(tokens));
+        TokenBufferDestroy(tokens);
+    }
+
+    state.SetBytesProcessed(state.iterations() * source.size());
+    StringDestroy(buffer);
+}
+
+BENCHMARK(BM_LexerThroughput)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_TokenBufferCreate)->RangeMultiplier(8)->Range(8, 4096);
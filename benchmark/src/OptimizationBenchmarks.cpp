@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <JellyCore/JellyCore.h>
+
+#include "BenchmarkCorpus.h"
+
+#include <fstream>
+#include <sys/wait.h>
+
+#define _kBenchmarkFibonacciArgument 32
+
+struct _BenchmarkOptimizationLevel {
+    const Char *name;
+    WorkspaceOptions options;
+};
+typedef struct _BenchmarkOptimizationLevel BenchmarkOptimizationLevel;
+
+static const BenchmarkOptimizationLevel _kBenchmarkOptimizationLevels[] = {
+    {"-O0", WorkspaceOptionsNone},
+    {"-O1", WorkspaceOptionsOptimizeLess},
+    {"-O2", WorkspaceOptionsOptimizeDefault},
+    {"-O3", WorkspaceOptionsOptimizeAggressive},
+    {"-Os", WorkspaceOptionsOptimizeSize},
+};
+
+static Index _BenchmarkFibonacci(Index n) {
+    return n < 2 ? n : _BenchmarkFibonacci(n - 1) + _BenchmarkFibonacci(n - 2);
+}
+
+/// Runs the executable at `path` and returns its exit status or -1 if it didn't exit normally.
+static Int _BenchmarkRunExecutable(const std::string &path) {
+    pid_t process = fork();
+    if (process == 0) {
+        execl(path.c_str(), path.c_str(), (char *)NULL);
+        _exit(127);
+    }
+
+    Int32 status = 0;
+    if (process < 0 || waitpid(process, &status, 0) != process || !WIFEXITED(status)) {
+        return -1;
+    }
+
+    return WEXITSTATUS(status);
+}
+
+/// Compiles the fibonacci sample once at the optimization level `state.range(0)` and measures the runtime of the linked executable.
+static void BM_OptimizationFibonacciRuntime(benchmark::State &state) {
+    const BenchmarkOptimizationLevel *level = &_kBenchmarkOptimizationLevels[state.range(0)];
+    state.SetLabel(level->name);
+
+    AllocatorRef allocator = AllocatorGetSystemDefault();
+    std::string directory  = BenchmarkCorpusCreateTemporaryDirectory();
+    {
+        std::ofstream file(directory + "/main.jelly");
+        file << BenchmarkCorpusMakeFibonacciProgram(_kBenchmarkFibonacciArgument);
+    }
+
+    StringRef workingDirectory = StringCreate(allocator, directory.c_str());
+    StringRef buildDirectory   = StringCreate(allocator, (directory + "/build").c_str());
+    StringRef moduleName       = StringCreate(allocator, "Fibonacci");
+    StringRef filePath         = StringCreate(allocator, "main.jelly");
+    WorkspaceRef workspace     = WorkspaceCreate(allocator, workingDirectory, buildDirectory, moduleName,
+                                                 (WorkspaceOptions)(level->options | WorkspaceOptionsNoCache));
+    WorkspaceAddSourceFile(workspace, filePath);
+
+    Bool isCompiled = WorkspaceStartAsync(workspace);
+    if (isCompiled) {
+        WorkspaceWaitForFinish(workspace);
+        isCompiled = !DiagnosticEngineHasErrors(WorkspaceGetDiagnosticEngine(workspace));
+    }
+
+    std::string executablePath = directory + "/build/Fibonacci";
+    Int expectedStatus         = _BenchmarkFibonacci(_kBenchmarkFibonacciArgument) & 0xFF;
+    if (!isCompiled || access(executablePath.c_str(), X_OK) != 0) {
+        state.SkipWithError("Couldn't compile the fibonacci sample");
+    } else if (_BenchmarkRunExecutable(executablePath) != expectedStatus) {
+        state.SkipWithError("The fibonacci sample returned a wrong result");
+    } else {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(_BenchmarkRunExecutable(executablePath));
+        }
+    }
+
+    WorkspaceDestroy(workspace);
+    StringDestroy(filePath);
+    StringDestroy(moduleName);
+    StringDestroy(buildDirectory);
+    StringDestroy(workingDirectory);
+    BenchmarkCorpusRemoveDirectory(directory);
+}
+
+BENCHMARK(BM_OptimizationFibonacciRuntime)
+    ->DenseRange(0, sizeof(_kBenchmarkOptimizationLevels) / sizeof(BenchmarkOptimizationLevel) - 1)
+    ->ArgName("level")
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
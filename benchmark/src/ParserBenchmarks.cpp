@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <JellyCore/JellyCore.h>
+
+#include "BenchmarkCorpus.h"
+#include "BenchmarkFrontend.h"
+
+static void _BenchmarkParser(benchmark::State &state, const std::string &source) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        BenchmarkFrontend *frontend = new BenchmarkFrontend(source);
+        state.ResumeTiming();
+
+        frontend->Parse();
+
+        state.PauseTiming();
+        delete frontend;
+        state.ResumeTiming();
+    }
+
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+static void BM_ParserFunctions(benchmark::State &state) {
+    _BenchmarkParser(state, BenchmarkCorpusMakeFunctions(state.range(0)));
+}
+
+static void BM_ParserStructures(benchmark::State &state) {
+    _BenchmarkParser(state, BenchmarkCorpusMakeStructures(state.range(0)));
+}
+
+static void BM_ParserDeclarations(benchmark::State &state) {
+    _BenchmarkParser(state, BenchmarkCorpusMakeDeclarations(state.range(0)));
+}
+
+static void BM_ParserDeepExpression(benchmark::State &state) {
+    _BenchmarkParser(state, BenchmarkCorpusMakeDeepExpression(state.range(0)));
+}
+
+BENCHMARK(BM_ParserFunctions)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParserStructures)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParserDeclarations)->RangeMultiplier(8)->Range(64, 4096)->Arg(50000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParserDeepExpression)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <JellyCore/JellyCore.h>
+
+#include "BenchmarkCorpus.h"
+#include "BenchmarkFrontend.h"
+
+static void _BenchmarkNameResolution(benchmark::State &state, const std::string &source) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        BenchmarkFrontend *frontend = new BenchmarkFrontend(source + BenchmarkCorpusMakeEntryPoint());
+        frontend->Parse();
+        frontend->ApplySubstitution();
+        state.ResumeTiming();
+
+        frontend->ResolveNames();
+
+        state.PauseTiming();
+        delete frontend;
+        state.ResumeTiming();
+    }
+}
+
+static void _BenchmarkTypeChecker(benchmark::State &state, const std::string &source) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        BenchmarkFrontend *frontend = new BenchmarkFrontend(source + BenchmarkCorpusMakeEntryPoint());
+        frontend->Parse();
+        frontend->ApplySubstitution();
+        frontend->ResolveNames();
+        state.ResumeTiming();
+
+        frontend->TypeCheck();
+
+        state.PauseTiming();
+        delete frontend;
+        state.ResumeTiming();
+    }
+}
+
+static void BM_NameResolutionFunctions(benchmark::State &state) {
+    _BenchmarkNameResolution(state, BenchmarkCorpusMakeFunctions(state.range(0)));
+}
+
+static void BM_NameResolutionStructures(benchmark::State &state) {
+    _BenchmarkNameResolution(state, BenchmarkCorpusMakeStructures(state.range(0)));
+}
+
+static void BM_NameResolutionDeepExpression(benchmark::State &state) {
+    _BenchmarkNameResolution(state, BenchmarkCorpusMakeDeepExpression(state.range(0)));
+}
+
+static void BM_TypeCheckerFunctions(benchmark::State &state) {
+    _BenchmarkTypeChecker(state, BenchmarkCorpusMakeFunctions(state.range(0)));
+}
+
+static void BM_TypeCheckerStructures(benchmark::State &state) {
+    _BenchmarkTypeChecker(state, BenchmarkCorpusMakeStructures(state.range(0)));
+}
+
+static void BM_TypeCheckerDeepExpression(benchmark::State &state) {
+    _BenchmarkTypeChecker(state, BenchmarkCorpusMakeDeepExpression(state.range(0)));
+}
+
+BENCHMARK(BM_NameResolutionFunctions)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_NameResolutionStructures)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_NameResolutionDeepExpression)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TypeCheckerFunctions)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TypeCheckerStructures)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_TypeCheckerDeepExpression)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMicrosecond);
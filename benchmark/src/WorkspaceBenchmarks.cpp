@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <JellyCore/JellyCore.h>
+
+#include "BenchmarkCorpus.h"
+
+/// Type checks a module which is `#load`(ing) `state.range(0)` files from disk, the files are parsed by `state.range(1)` jobs.
+static void BM_WorkspaceLoadFiles(benchmark::State &state) {
+    AllocatorRef allocator = AllocatorGetSystemDefault();
+    std::string directory  = BenchmarkCorpusCreateTemporaryDirectory();
+    BenchmarkCorpusWriteLoadFiles(directory, state.range(0), 16);
+
+    StringRef workingDirectory = StringCreate(allocator, directory.c_str());
+    StringRef buildDirectory   = StringCreate(allocator, (directory + "/build").c_str());
+    StringRef moduleName       = StringCreate(allocator, "Benchmark");
+    StringRef filePath         = StringCreate(allocator, "main.jelly");
+
+    for (auto _ : state) {
+        WorkspaceRef workspace = WorkspaceCreate(allocator, workingDirectory, buildDirectory, moduleName, WorkspaceOptionsTypeCheck);
+        WorkspaceSetJobCount(workspace, state.range(1));
+        WorkspaceAddSourceFile(workspace, filePath);
+        if (!WorkspaceStartAsync(workspace)) {
+            state.SkipWithError("Couldn't start workspace");
+            WorkspaceDestroy(workspace);
+            break;
+        }
+
+        WorkspaceWaitForFinish(workspace);
+        WorkspaceDestroy(workspace);
+    }
+
+    StringDestroy(filePath);
+    StringDestroy(moduleName);
+    StringDestroy(buildDirectory);
+    StringDestroy(workingDirectory);
+    BenchmarkCorpusRemoveDirectory(directory);
+}
+
+BENCHMARK(BM_WorkspaceLoadFiles)
+    ->ArgsProduct({{8, 32, 128}, {1, 4}})
+    ->ArgNames({"files", "jobs"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/// Parses `state.range(0)` files of 256 functions each with `state.range(1)` jobs, the AST is dumped to /dev/null to stop the pipeline
+/// before the serial name resolution and type checking.
+static void BM_WorkspaceParseFiles(benchmark::State &state) {
+    AllocatorRef allocator = AllocatorGetSystemDefault();
+    std::string directory  = BenchmarkCorpusCreateTemporaryDirectory();
+    BenchmarkCorpusWriteLoadFiles(directory, state.range(0), 256);
+
+    StringRef workingDirectory = StringCreate(allocator, directory.c_str());
+    StringRef buildDirectory   = StringCreate(allocator, (directory + "/build").c_str());
+    StringRef moduleName       = StringCreate(allocator, "Benchmark");
+    StringRef filePath         = StringCreate(allocator, "main.jelly");
+    FILE *output               = fopen("/dev/null", "w");
+
+    for (auto _ : state) {
+        WorkspaceRef workspace = WorkspaceCreate(allocator, workingDirectory, buildDirectory, moduleName, WorkspaceOptionsDumpAST);
+        WorkspaceSetDumpASTOutput(workspace, output);
+        WorkspaceSetJobCount(workspace, state.range(1));
+        WorkspaceAddSourceFile(workspace, filePath);
+        if (!WorkspaceStartAsync(workspace)) {
+            state.SkipWithError("Couldn't start workspace");
+            WorkspaceDestroy(workspace);
+            break;
+        }
+
+        WorkspaceWaitForFinish(workspace);
+        WorkspaceDestroy(workspace);
+    }
+
+    fclose(output);
+    StringDestroy(filePath);
+    StringDestroy(moduleName);
+    StringDestroy(buildDirectory);
+    StringDestroy(workingDirectory);
+    BenchmarkCorpusRemoveDirectory(directory);
+}
+
+BENCHMARK(BM_WorkspaceParseFiles)
+    ->ArgsProduct({{64}, {1, 2, 4, 8}})
+    ->ArgNames({"files", "jobs"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -1,8 +1,9 @@
 cmake_minimum_required (VERSION 2.8.12)
 
 set(BENCHMARK_ENABLE_TESTING OFF)
+set(BENCHMARK_ENABLE_INSTALL OFF)
 
-configure_file(cmake/Benchmark.ink.txt benchmark-download/CMakeLists.txt)
+configure_file(${CMAKE_CURRENT_LIST_DIR}/Benchmark.ink.txt ${CMAKE_BINARY_DIR}/benchmark-download/CMakeLists.txt)
 
 execute_process(COMMAND ${CMAKE_COMMAND} -G "${CMAKE_GENERATOR}" .
     RESULT_VARIABLE result
@@ -5,30 +5,81 @@
 #include <JellyCore/Allocator.h>
 #include <JellyCore/Base.h>
 #include <JellyCore/BucketArray.h>
+#include <JellyCore/SourceBuffer.h>
+#include <JellyCore/StringInterner.h>
 
 JELLY_EXTERN_C_BEGIN
 
 typedef struct _ASTContext *ASTContextRef;
 
-ASTContextRef ASTContextCreate(AllocatorRef allocator, StringRef moduleName);
+struct _ASTContextNodeIterator {
+    ASTContextRef context;
+    ASTTag tag;
+    Index segment;
+    BucketArrayRef nodes;
+    Index index;
+    Index endIndex;
+    ASTNodeRef node;
+};
+typedef struct _ASTContextNodeIterator ASTContextNodeIterator;
+
+/// Creates the context of the module named `moduleName`, the symbol table of the context is allocated by `symbolTableAllocator` to allow
+/// accounting its memory separately from the AST.
+ASTContextRef ASTContextCreate(AllocatorRef allocator, AllocatorRef symbolTableAllocator, StringRef moduleName);
+
+/// Creates a shard of `context` which allows parsing a source on another thread, the nodes of the shard are allocated separately and are
+/// only visible to `context` after merging the shard. The shard shares the symbol table of `context` and is owned by `context`.
+ASTContextRef ASTContextCreateShard(ASTContextRef context);
+
+/// Adds the source units and link directives parsed into `shard` to the module of `context`, merges have to be serialized by the caller.
+void ASTContextMergeShard(ASTContextRef context, ASTContextRef shard);
 
 void ASTContextDestroy(ASTContextRef context);
 
 AllocatorRef ASTContextGetTempAllocator(ASTContextRef context);
 
+AllocatorRef ASTContextGetArrayAllocator(ASTContextRef context);
+
+/// Returns the interner of all identifiers stored in the AST, interned identifiers can be compared by pointer equality.
+StringInternerRef ASTContextGetStringInterner(ASTContextRef context);
+
 SymbolTableRef ASTContextGetSymbolTable(ASTContextRef context);
 
 ASTModuleDeclarationRef ASTContextGetModule(ASTContextRef context);
 
-BucketArrayRef ASTContextGetAllNodes(ASTContextRef context, ASTTag tag);
+Index ASTContextGetNodeCount(ASTContextRef context, ASTTag tag);
+
+/// Returns an iterator over all nodes of `tag` in the order they have been created, the nodes of a shard are visited at the position of
+/// the merge of the shard. The `node` of the iterator is NULL after reaching the end.
+ASTContextNodeIterator ASTContextGetNodeIterator(ASTContextRef context, ASTTag tag);
+
+void ASTContextNodeIteratorNext(ASTContextNodeIterator *iterator);
+
+/// Registers the characters of `source` as source of the locations of nodes, the characters of `source` have to outlive the context.
+/// Reports an error and returns false if the sources of the context would exceed the 4 GB addressable by the locations of nodes, the
+/// nodes of an unregistered source have no location.
+Bool ASTContextAddSource(ASTContextRef context, SourceBufferRef source);
+
+/// Returns the location of `node` or a null range if the location isn't pointing into one of the sources of the context.
+SourceRange ASTContextGetNodeLocation(ASTContextRef context, ASTNodeRef node);
+
+void ASTContextSetNodeLocation(ASTContextRef context, ASTNodeRef node, SourceRange location);
+
+/// Returns the node replacing `node` after applying the substitutions or NULL if `node` has no substitute.
+ASTNodeRef ASTContextGetSubstitute(ASTContextRef context, ASTNodeRef node);
+
+void ASTContextSetSubstitute(ASTContextRef context, ASTNodeRef node, ASTNodeRef substitute);
+
+/// Reserves space for `count` additional substitutes to avoid growing the side table while performing a substitution.
+void ASTContextReserveSubstitutes(ASTContextRef context, Index count);
 
 void ASTModuleAddSourceUnit(ASTContextRef context, ASTModuleDeclarationRef module, ASTSourceUnitRef sourceUnit);
 
+void ASTModuleAddLinkDirective(ASTContextRef context, ASTModuleDeclarationRef module, ASTLinkDirectiveRef directive);
+
 ASTSourceUnitRef ASTContextCreateSourceUnit(ASTContextRef context, SourceRange location, ScopeID scope, StringRef filePath,
                                             ArrayRef declarations);
 
-ASTLinkedListRef ASTContextCreateLinkedList(ASTContextRef context, SourceRange location, ScopeID scope);
-
 ASTArrayRef ASTContextCreateArray(ASTContextRef context, SourceRange location, ScopeID scope);
 
 ASTLoadDirectiveRef ASTContextCreateLoadDirective(ASTContextRef context, SourceRange location, ScopeID scope,
@@ -14,7 +14,6 @@ typedef void *IRRef;
 
 enum _ASTTag {
     ASTTagSourceUnit,
-    ASTTagLinkedList,
     ASTTagArray,
     ASTTagLoadDirective,
     ASTTagLinkDirective,
@@ -61,6 +60,7 @@ typedef enum _ASTTag ASTTag;
 
 // TODO: Add error flag for validity checks
 // TODO: Add flag to indicate if an expression is resolved or not
+/// The flags are stored in 16 bits of the header of a node.
 enum _ASTFlags {
     ASTFlagsNone                       = 0,
     ASTFlagsStructureHasCyclicStorage  = 1 << 0,
@@ -73,6 +73,8 @@ enum _ASTFlags {
     ASTFlagsIsPointerArithmetic        = 1 << 7,
     ASTFlagsCallIsInitialization       = 1 << 8,
     ASTFlagsArrayTypeIsStatic          = 1 << 9,
+    ASTFlagsHasSubstitute              = 1 << 10,
+    ASTFlagsModuleIsPrecompiled        = 1 << 11,
 };
 typedef enum _ASTFlags ASTFlags;
 
@@ -91,7 +93,6 @@ typedef struct _ASTDeclaration *ASTDeclarationRef;
 typedef struct _ASTNode *ASTTypeRef;
 
 typedef struct _ASTSourceUnit *ASTSourceUnitRef;
-typedef struct _ASTLinkedList *ASTLinkedListRef;
 typedef struct _ASTLoadDirective *ASTLoadDirectiveRef;
 typedef struct _ASTLinkDirective *ASTLinkDirectiveRef;
 typedef struct _ASTImportDirective *ASTImportDirectiveRef;
@@ -129,16 +130,21 @@ typedef struct _ASTEnumerationType *ASTEnumerationTypeRef;
 typedef struct _ASTFunctionType *ASTFunctionTypeRef;
 typedef struct _ASTStructureType *ASTStructureTypeRef;
 
+/// The location of a node as offset into the sources of its `ASTContext` where the offset 0 is reserved for nodes without a location,
+/// the `SourceRange` of a node is resolved by `ASTContextGetNodeLocation`.
+struct _ASTLocation {
+    UInt32 offset;
+    UInt32 length;
+};
+typedef struct _ASTLocation ASTLocation;
+
+/// The header shared by all nodes is kept at 16 bytes, the substitution links of a node are stored in the `ASTContext` and the IR of a
+/// node is stored in the `IRBuilder` instead.
 struct _ASTNode {
-    ASTTag tag;
-    ASTFlags flags;
-    SourceRange location;
+    UInt16 tag;
+    UInt16 flags;
     ScopeID scope;
-    ASTNodeRef substitute;
-    ASTNodeRef primary;
-
-    IRRef irValue;
-    IRRef irType;
+    ASTLocation location;
 };
 
 struct _ASTExpression {
@@ -148,19 +154,13 @@ struct _ASTExpression {
     ASTTypeRef expectedType;
 };
 
-struct _ASTLinkedList {
-    struct _ASTNode base;
-
-    void *node;
-    ASTLinkedListRef next;
-};
-
 struct _ASTArray {
     struct _ASTNode base;
 
     void *context;
     Index elementCount;
-    ASTLinkedListRef list;
+    Index capacity;
+    void **elements;
 };
 
 struct _ASTSourceUnit {
@@ -14,27 +14,56 @@ typedef enum {
 
 typedef void *(*AllocatorCallback)(AllocatorMode mode, Index capacity, void *memory, void *context);
 
+/// Ownership model for allocators used by multiple threads:
+///  - The system default and malloc allocators are thread-safe and can be shared freely.
+///  - All other allocators like the bump and temp allocators have no internal locking, an instance has to be owned by a single thread at
+///    a time. Ownership can be handed to another thread at a synchronization point like `pthread_create` or `pthread_join`, the thread
+///    creating the allocator stays responsible for destroying it after the receiving thread has finished using it.
+///  - The current default allocator is thread-local, passing `AllocatorGetDefault()` resolves to the current default of the calling
+///    thread or the system default if none has been set. An allocator installed as current default must not itself be backed by
+///    `AllocatorGetDefault()`.
 typedef struct _Allocator *AllocatorRef;
 
+/// The live bytes are measured by the usable size of the heap blocks and can become negative on a thread which releases memory allocated
+/// by another thread, the peak is the highest value of the live bytes since it has last been set by `AllocatorSetThreadPeakLiveBytes`.
+struct _AllocatorStatistics {
+    Index allocationCount;
+    Index allocatedBytes;
+    Int liveBytes;
+    Int peakLiveBytes;
+};
+typedef struct _AllocatorStatistics AllocatorStatistics;
+
 AllocatorRef AllocatorGetDefault(void);
 AllocatorRef AllocatorGetSystemDefault(void);
 AllocatorRef AllocatorGetMalloc(void);
 AllocatorRef AllocatorGetNull(void);
 
+/// Sets the current default allocator of the calling thread, passing NULL restores the system default.
 void AllocatorSetCurrentDefault(AllocatorRef allocator);
 
+/// Returns the current default allocator of the calling thread.
 AllocatorRef AllocatorGetCurrentDefault(void);
 
 AllocatorRef AllocatorCreate(AllocatorRef allocator, AllocatorCallback callback, void *context);
 
 void AllocatorDestroy(AllocatorRef allocator);
 
+/// Returns the context of the allocator if it has been created with the given `callback`, otherwise NULL.
+void *AllocatorGetContext(AllocatorRef allocator, AllocatorCallback callback);
+
 void *AllocatorAllocate(AllocatorRef allocator, Index capacity);
 
 void *AllocatorReallocate(AllocatorRef allocator, void *memory, Index capacity);
 
 void *AllocatorDeallocate(AllocatorRef allocator, void *memory);
 
+/// Returns the count and the requested size of all heap allocations and reallocations performed by the calling thread.
+AllocatorStatistics AllocatorGetThreadStatistics(void);
+
+/// Sets the peak of the live heap bytes of the calling thread and returns the previous one.
+Int AllocatorSetThreadPeakLiveBytes(Int peakLiveBytes);
+
 JELLY_EXTERN_C_END
 
 #endif
@@ -54,6 +54,14 @@ typedef size_t Index;
 #define JELLY_ATTRIBUTE_NORETURN
 #endif
 
+#ifdef __GNUC__
+#define JELLY_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define JELLY_THREAD_LOCAL __declspec(thread)
+#else
+#define JELLY_THREAD_LOCAL
+#endif
+
 JELLY_ATTRIBUTE_NORETURN void __jelly_unreachable(const Char *message, const Char *file, Index line);
 
 #ifndef JELLY_UNREACHABLE
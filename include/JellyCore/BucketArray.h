@@ -10,10 +10,21 @@ typedef struct _BucketArray *BucketArrayRef;
 
 typedef Bool (*BucketArrayPredicate)(const void *elementLeft, const void *elementRight);
 
+struct _BucketArrayIterator {
+    BucketArrayRef array;
+    Index index;
+    Index pageIndex;
+    UInt8 *element;
+    UInt8 *pageEnd;
+};
+typedef struct _BucketArrayIterator BucketArrayIterator;
+
 BucketArrayRef BucketArrayCreate(AllocatorRef allocator, Index pageSize, Index elementSize, const void *elements, Index elementCount);
 
 BucketArrayRef BucketArrayCreateCopy(AllocatorRef allocator, Index pageSize, BucketArrayRef array);
 
+/// Creates an array with a first page of `capacity` elements rounded up to a power of two, each further page doubles the capacity so that
+/// an element is found in constant time through the page directory and the address of an element never changes.
 BucketArrayRef BucketArrayCreateEmpty(AllocatorRef allocator, Index elementSize, Index capacity);
 
 void BucketArrayDestroy(BucketArrayRef array);
@@ -34,6 +45,12 @@ void BucketArraySetElementAtIndex(BucketArrayRef array, Index index, const void
 
 Bool BucketArrayContainsElement(BucketArrayRef array, BucketArrayPredicate predicate, const void *element);
 
+/// Returns an iterator pointing to the first element, the `element` of the iterator is NULL if the array is empty.
+BucketArrayIterator BucketArrayGetIterator(BucketArrayRef array);
+
+/// Advances the iterator to the next element and sets the `element` of the iterator to NULL after reaching the end of the array.
+void BucketArrayIteratorNext(BucketArrayIterator *iterator);
+
 JELLY_EXTERN_C_END
 
 #endif
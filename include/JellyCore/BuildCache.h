@@ -0,0 +1,42 @@
+#ifndef __JELLY_BUILDCACHE__
+#define __JELLY_BUILDCACHE__
+
+#include <JellyCore/Allocator.h>
+#include <JellyCore/Base.h>
+#include <JellyCore/String.h>
+
+JELLY_EXTERN_C_BEGIN
+
+typedef struct _BuildCache *BuildCacheRef;
+
+struct _BuildCacheStatistics {
+    Index hitCount;
+    Index missCount;
+};
+typedef struct _BuildCacheStatistics BuildCacheStatistics;
+
+extern const UInt64 kBuildCacheHashSeed;
+
+/// Loads the cache file of the build directory, a missing or malformed cache file results in an empty cache.
+BuildCacheRef BuildCacheCreate(AllocatorRef allocator, StringRef buildDirectory);
+
+void BuildCacheDestroy(BuildCacheRef cache);
+
+/// Continues the 64-bit FNV-1a `hash` with the given bytes, a new hash has to start with `kBuildCacheHashSeed`.
+UInt64 BuildCacheHash(UInt64 hash, const void *bytes, Index length);
+
+/// Returns true if the object file of the module exists and has been emitted from a module closure with the same `fingerprint`.
+Bool BuildCacheLookupModule(BuildCacheRef cache, StringRef moduleName, UInt64 fingerprint);
+
+void BuildCacheInsertModule(BuildCacheRef cache, StringRef moduleName, UInt64 fingerprint);
+
+void BuildCacheRemoveModule(BuildCacheRef cache, StringRef moduleName);
+
+/// Writes the cache file into the build directory.
+Bool BuildCacheWrite(BuildCacheRef cache);
+
+BuildCacheStatistics BuildCacheGetStatistics(BuildCacheRef cache);
+
+JELLY_EXTERN_C_END
+
+#endif
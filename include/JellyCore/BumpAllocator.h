@@ -6,8 +6,29 @@
 
 JELLY_EXTERN_C_BEGIN
 
+struct _BumpAllocatorMarker {
+    void *page;
+    Index index;
+    void *oversizedPage;
+};
+typedef struct _BumpAllocatorMarker BumpAllocatorMarker;
+
+/// Creates an arena which hands out memory from 64 KiB pages, deallocations are no-ops and memory is only released on rewind, reset or
+/// destroy. Allocations larger than a quarter of a page are placed on dedicated pages.
 AllocatorRef BumpAllocatorCreate(AllocatorRef allocator);
 
+/// Allocates `capacity` bytes aligned to `alignment`, which has to be a power of two; the default alignment is `2 * sizeof(void *)`.
+void *BumpAllocatorAllocateAligned(AllocatorRef allocator, Index capacity, Index alignment);
+
+/// Returns a checkpoint of the current allocation state of the arena.
+BumpAllocatorMarker BumpAllocatorGetMarker(AllocatorRef allocator);
+
+/// Releases all allocations performed after `marker` was taken, markers have to be rewound in the reverse order of their creation.
+void BumpAllocatorRewind(AllocatorRef allocator, BumpAllocatorMarker marker);
+
+/// Releases all allocations but keeps the regular pages for reuse.
+void BumpAllocatorReset(AllocatorRef allocator);
+
 JELLY_EXTERN_C_END
 
 #endif
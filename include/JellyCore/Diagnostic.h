@@ -1,7 +1,10 @@
 #ifndef __JELLY_DIAGNOSTIC__
 #define __JELLY_DIAGNOSTIC__
 
+#include <JellyCore/Allocator.h>
 #include <JellyCore/Base.h>
+#include <JellyCore/SourceBuffer.h>
+#include <JellyCore/SourceRange.h>
 #include <JellyCore/String.h>
 
 JELLY_EXTERN_C_BEGIN
@@ -17,13 +20,63 @@ enum _DiagnosticLevel {
 };
 typedef enum _DiagnosticLevel DiagnosticLevel;
 
-typedef void (*DiagnosticHandler)(DiagnosticLevel level, const Char *message, void *context);
+struct _Diagnostic {
+    DiagnosticLevel level;
+    const Char *message;
+    SourceRange location;
+    /// The file path, line and column are resolved from the location when the diagnostic is emitted, the file path is NULL if the
+    /// location is null or doesn't point into a source added to the engine.
+    const Char *filePath;
+    Index line;
+    Index column;
+};
+typedef struct _Diagnostic Diagnostic;
+
+typedef struct _DiagnosticEngine *DiagnosticEngineRef;
+
+typedef void (*DiagnosticHandler)(const Diagnostic *diagnostic, void *context);
+
+/// Writes each diagnostic as a single line JSON object into the `FILE *` passed as context or into stderr if the context is NULL.
+void DiagnosticHandlerJSON(const Diagnostic *diagnostic, void *context);
+
+/// Creates an engine reporting to the handler of the default engine at the time of creation.
+DiagnosticEngineRef DiagnosticEngineCreate(AllocatorRef allocator);
+
+/// Flushes all staged reports before destroying the engine.
+void DiagnosticEngineDestroy(DiagnosticEngineRef engine);
+
+/// Returns the process-wide engine which receives the reports of all threads without a current engine.
+DiagnosticEngineRef DiagnosticEngineGetDefault(void);
+
+/// Returns the engine which receives the `Report*` calls of the calling thread.
+DiagnosticEngineRef DiagnosticEngineGetCurrent(void);
+
+/// Installs the engine receiving the `Report*` calls of the calling thread, NULL restores the default engine.
+void DiagnosticEngineSetCurrent(DiagnosticEngineRef engine);
+
+/// The handler is always called under the lock of the engine, so it doesn't have to be thread-safe itself.
+void DiagnosticEngineSetHandler(DiagnosticEngineRef engine, DiagnosticHandler handler, void *context);
 
 void DiagnosticEngineSetDefaultHandler(DiagnosticHandler handler, void *context);
 
-void DiagnosticEngineResetMessageCounts();
+/// Registers a source which is used to resolve the locations of diagnostics, `source` has to outlive the engine.
+void DiagnosticEngineAddSource(DiagnosticEngineRef engine, StringRef filePath, SourceBufferRef source);
+
+void DiagnosticEngineResetMessageCounts(DiagnosticEngineRef engine);
+
+/// Message counts include staged reports which haven't been flushed yet.
+Index DiagnosticEngineGetMessageCount(DiagnosticEngineRef engine, DiagnosticLevel level);
+
+/// Returns true if any error or critical message has been reported to the engine.
+Bool DiagnosticEngineHasErrors(DiagnosticEngineRef engine);
+
+/// Buffers the reports of the calling thread until `DiagnosticEngineEndStaging` is called, the buffer is flushed at position `order`.
+void DiagnosticEngineBeginStaging(DiagnosticEngineRef engine, Index order);
+
+void DiagnosticEngineEndStaging(DiagnosticEngineRef engine);
 
-Index DiagnosticEngineGetMessageCount(DiagnosticLevel level);
+/// Reports all staged buffers in ascending order, buffers with an equal order are reported in the order they have been staged.
+void DiagnosticEngineFlush(DiagnosticEngineRef engine);
 
 void ReportDebug(const Char *message);
 void ReportDebugString(StringRef message);
@@ -36,10 +89,12 @@ void ReportInfoFormat(const Char *format, ...) JELLY_PRINTFLIKE(1, 2);
 void ReportWarning(const Char *message);
 void ReportWarningString(StringRef message);
 void ReportWarningFormat(const Char *format, ...) JELLY_PRINTFLIKE(1, 2);
+void ReportWarningAt(SourceRange location, const Char *format, ...) JELLY_PRINTFLIKE(2, 3);
 
 void ReportError(const Char *message);
 void ReportErrorString(StringRef message);
 void ReportErrorFormat(const Char *format, ...) JELLY_PRINTFLIKE(1, 2);
+void ReportErrorAt(SourceRange location, const Char *format, ...) JELLY_PRINTFLIKE(2, 3);
 
 void ReportCritical(const Char *message);
 void ReportCriticalString(StringRef message);
@@ -25,8 +25,10 @@ const void *DictionaryLookup(DictionaryRef dictionary, const void *key);
 
 void DictionaryRemove(DictionaryRef dictionary, const void *key);
 
+/// Returns the packed storage of all keys, the order of the keys is unspecified.
 void DictionaryGetKeyBuffer(DictionaryRef dictionary, void **memory, Index *length);
 
+/// Returns the packed storage of all values, each value is aligned to 8 bytes and the order of the values is unspecified.
 void DictionaryGetValueBuffer(DictionaryRef dictionary, void **memory, Index *length);
 
 JELLY_EXTERN_C_END
@@ -1,6 +1,7 @@
 #ifndef __JELLY_IRBUILDER__
 #define __JELLY_IRBUILDER__
 
+#include <JellyCore/ASTContext.h>
 #include <JellyCore/ASTNodes.h>
 #include <JellyCore/Base.h>
 
@@ -9,10 +10,29 @@ JELLY_EXTERN_C_BEGIN
 typedef struct _IRBuilder *IRBuilderRef;
 typedef struct _IRModule *IRModuleRef;
 
+enum _IROptimizationLevel {
+    IROptimizationLevelNone,
+    IROptimizationLevelLess,
+    IROptimizationLevelDefault,
+    IROptimizationLevelAggressive,
+    IROptimizationLevelSize,
+};
+typedef enum _IROptimizationLevel IROptimizationLevel;
+
 IRBuilderRef IRBuilderCreate(AllocatorRef allocator, ASTContextRef context, StringRef buildDirectory);
 
 void IRBuilderDestroy(IRBuilderRef builder);
 
+/// Sets the optimization level used by `IRBuilderEmitObjectFile` for the IR pass pipeline and the code generation of the target machine.
+void IRBuilderSetOptimizationLevel(IRBuilderRef builder, IROptimizationLevel level);
+
+/// Sets the target triple of the emitted object files, the default NULL triple emits for the host cpu and its features while any other
+/// triple is emitted for the generic cpu of the target.
+void IRBuilderSetTargetTriple(IRBuilderRef builder, StringRef targetTriple);
+
+/// Returns true if the target of the triple has been compiled into LLVM, this also initializes the process-wide target registry.
+Bool IRBuilderIsTargetTripleSupported(StringRef targetTriple);
+
 IRModuleRef IRBuilderBuild(IRBuilderRef builder, ASTModuleDeclarationRef module);
 
 void IRBuilderDumpModule(IRBuilderRef builder, IRModuleRef module, FILE *target);
@@ -0,0 +1,13 @@
+#ifndef __JELLY_JSONWRITER__
+#define __JELLY_JSONWRITER__
+
+#include <JellyCore/Base.h>
+
+JELLY_EXTERN_C_BEGIN
+
+/// Writes `string` as a quoted JSON string literal escaping quotes, backslashes and control characters.
+void JSONWriteString(FILE *output, const Char *string);
+
+JELLY_EXTERN_C_END
+
+#endif
@@ -7,20 +7,29 @@
 #include <JellyCore/Allocator.h>
 #include <JellyCore/Array.h>
 #include <JellyCore/BucketArray.h>
+#include <JellyCore/BuildCache.h>
 #include <JellyCore/BumpAllocator.h>
 #include <JellyCore/ClangImporter.h>
 #include <JellyCore/Compiler.h>
 #include <JellyCore/DependencyGraph.h>
 #include <JellyCore/Diagnostic.h>
 #include <JellyCore/Dictionary.h>
+#include <JellyCore/IRBuilder.h>
 #include <JellyCore/Lexer.h>
+#include <JellyCore/ModuleInterface.h>
 #include <JellyCore/NameResolution.h>
 #include <JellyCore/Parser.h>
+#include <JellyCore/PointerMap.h>
+#include <JellyCore/Profiler.h>
 #include <JellyCore/Queue.h>
+#include <JellyCore/SourceBuffer.h>
 #include <JellyCore/SourceRange.h>
 #include <JellyCore/String.h>
+#include <JellyCore/StringInterner.h>
 #include <JellyCore/SymbolTable.h>
 #include <JellyCore/TempAllocator.h>
+#include <JellyCore/TokenBuffer.h>
+#include <JellyCore/TrackingAllocator.h>
 #include <JellyCore/Workspace.h>
 
 #endif
@@ -3,6 +3,7 @@
 
 #include <JellyCore/Allocator.h>
 #include <JellyCore/Base.h>
+#include <JellyCore/SourceBuffer.h>
 #include <JellyCore/SourceRange.h>
 #include <JellyCore/String.h>
 
@@ -144,6 +145,9 @@ typedef struct _LexerState LexerState;
 
 LexerRef LexerCreate(AllocatorRef allocator, StringRef buffer);
 
+/// Creates a lexer reading directly from the characters of `buffer` which have to outlive all tokens and SourceRange(s) of the lexer.
+LexerRef LexerCreateFromSourceBuffer(AllocatorRef allocator, SourceBufferRef buffer);
+
 void LexerDestroy(LexerRef lexer);
 
 LexerState LexerGetState(LexerRef lexer);
@@ -152,6 +156,9 @@ void LexerSetState(LexerRef lexer, LexerState state);
 void LexerPeekToken(LexerRef lexer, Token *token);
 void LexerNextToken(LexerRef lexer, Token *token);
 
+/// Returns a view of the characters of `token` in the source buffer of the lexer without copying them.
+StringView TokenGetView(const Token *token);
+
 JELLY_EXTERN_C_END
 
 #endif
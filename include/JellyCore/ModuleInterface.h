@@ -0,0 +1,37 @@
+#ifndef __JELLY_MODULEINTERFACE__
+#define __JELLY_MODULEINTERFACE__
+
+#include <JellyCore/ASTContext.h>
+#include <JellyCore/Allocator.h>
+#include <JellyCore/Base.h>
+#include <JellyCore/String.h>
+
+JELLY_EXTERN_C_BEGIN
+
+typedef struct _ModuleInterface *ModuleInterfaceRef;
+
+/// Writes the resolved declarations, types and mangled names of `module` into a `.jmod` file at `filePath`. The file consists of fixed
+/// size little endian records referencing each other by index and a string table referenced by offset, so that it can be used directly
+/// from a read-only mapping. Returns false if the module contains declarations which are not part of an interface, imports other modules
+/// or if the file couldn't be written.
+Bool ModuleInterfaceWrite(AllocatorRef allocator, ASTModuleDeclarationRef module, UInt64 fingerprint, StringRef filePath);
+
+/// Maps the `.jmod` file at `filePath` into memory and validates all records, returns NULL if the file is missing or malformed.
+ModuleInterfaceRef ModuleInterfaceCreateFromFile(AllocatorRef allocator, const Char *filePath);
+
+void ModuleInterfaceDestroy(ModuleInterfaceRef interface);
+
+UInt64 ModuleInterfaceGetFingerprint(ModuleInterfaceRef interface);
+
+/// The first source unit is the module declaration itself and the remaining ones are the files loaded by the module.
+Index ModuleInterfaceGetSourceUnitCount(ModuleInterfaceRef interface);
+
+const Char *ModuleInterfaceGetSourceUnitFilePath(ModuleInterfaceRef interface, Index index);
+
+/// Creates the source units loaded by `module` with the stored declarations in `context` as the `Parser` would have created them,
+/// all types are unresolved and have to be resolved by `PerformNameResolution` again.
+void ModuleInterfaceLoadDeclarations(ModuleInterfaceRef interface, ASTContextRef context, ASTModuleDeclarationRef module);
+
+JELLY_EXTERN_C_END
+
+#endif
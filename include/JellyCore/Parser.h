@@ -4,6 +4,7 @@
 #include <JellyCore/ASTContext.h>
 #include <JellyCore/Allocator.h>
 #include <JellyCore/Base.h>
+#include <JellyCore/SourceBuffer.h>
 
 #warning TODO: Add support for character literals!
 #warning TODO: Allow parameter swapping for functions like `==` where the algorithm for swapped arguments would be equivalent!
@@ -12,13 +13,14 @@ JELLY_EXTERN_C_BEGIN
 
 typedef struct _Parser *ParserRef;
 
-ParserRef ParserCreate(AllocatorRef allocator, ASTContextRef context);
+/// Creates a parser for `context` which allocates the lexer of each parsed source with `lexerAllocator`.
+ParserRef ParserCreate(AllocatorRef allocator, AllocatorRef lexerAllocator, ASTContextRef context);
 
 void ParserDestroy(ParserRef parser);
 
-ASTSourceUnitRef ParserParseSourceUnit(ParserRef parser, StringRef filePath, StringRef source);
-ASTSourceUnitRef ParserParseModuleSourceUnit(ParserRef parser, ASTModuleDeclarationRef module, StringRef filePath, StringRef source);
-ASTModuleDeclarationRef ParserParseModuleDeclaration(ParserRef parser, StringRef filePath, StringRef source);
+ASTSourceUnitRef ParserParseSourceUnit(ParserRef parser, StringRef filePath, SourceBufferRef source);
+ASTSourceUnitRef ParserParseModuleSourceUnit(ParserRef parser, ASTModuleDeclarationRef module, StringRef filePath, SourceBufferRef source);
+ASTModuleDeclarationRef ParserParseModuleDeclaration(ParserRef parser, StringRef filePath, SourceBufferRef source);
 
 JELLY_EXTERN_C_END
 
@@ -0,0 +1,34 @@
+#ifndef __JELLY_POINTERMAP__
+#define __JELLY_POINTERMAP__
+
+#include <JellyCore/Allocator.h>
+#include <JellyCore/Base.h>
+
+JELLY_EXTERN_C_BEGIN
+
+typedef struct _PointerMap *PointerMapRef;
+
+/// Creates a hash map from non-NULL pointers to values of `valueSize` bytes, the values are stored inline next to their keys and the
+/// memory of the table is only allocated on the first insertion. The map is not thread-safe.
+PointerMapRef PointerMapCreate(AllocatorRef allocator, Index valueSize);
+
+void PointerMapDestroy(PointerMapRef map);
+
+Index PointerMapGetCount(PointerMapRef map);
+
+/// Returns the value of `key` or NULL if the map doesn't contain `key`, the value is valid until the next insertion into the map.
+void *PointerMapLookup(PointerMapRef map, const void *key);
+
+/// Returns the value of `key` and inserts a zero initialized value if the map doesn't contain `key` yet, the value is valid until the
+/// next insertion into the map.
+void *PointerMapInsert(PointerMapRef map, const void *key);
+
+/// Grows the table once to hold `count` additional keys without rehashing on each insertion.
+void PointerMapReserve(PointerMapRef map, Index count);
+
+/// Removes all keys but keeps the memory of the table.
+void PointerMapRemoveAll(PointerMapRef map);
+
+JELLY_EXTERN_C_END
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef __JELLY_PROFILER__
+#define __JELLY_PROFILER__
+
+#include <JellyCore/Allocator.h>
+#include <JellyCore/Base.h>
+#include <JellyCore/String.h>
+
+JELLY_EXTERN_C_BEGIN
+
+typedef struct _Profiler *ProfilerRef;
+
+ProfilerRef ProfilerCreate(AllocatorRef allocator);
+
+void ProfilerDestroy(ProfilerRef profiler);
+
+/// Starts measuring the wall time, the cpu time and the heap allocations of the calling thread for a `phase` of the compilation applied
+/// to `unitName` which is either a source file or a module, the `phase` has to be a string literal. Returns the span for `ProfilerEndSpan`.
+Index ProfilerBeginSpan(ProfilerRef profiler, const Char *phase, StringRef unitName);
+
+/// Ends the `span` on the same thread it has been started on.
+void ProfilerEndSpan(ProfilerRef profiler, Index span);
+
+/// Prints the accumulated measurements of each phase followed by the measurements of each unit of the phase.
+void ProfilerPrintReport(ProfilerRef profiler, FILE *output);
+
+/// Writes all spans in the Chrome trace event format.
+void ProfilerWriteTrace(ProfilerRef profiler, FILE *output);
+
+JELLY_EXTERN_C_END
+
+#endif
@@ -8,14 +8,34 @@ JELLY_EXTERN_C_BEGIN
 
 typedef struct _Queue *QueueRef;
 
+/// Creates a FIFO queue backed by a growing ring buffer, enqueue and dequeue are amortized O(1). The queue is not thread-safe.
 QueueRef QueueCreate(AllocatorRef allocator);
 
 void QueueDestroy(QueueRef queue);
 
+Index QueueGetElementCount(QueueRef queue);
+
 void QueueEnqueue(QueueRef queue, void *element);
 
+/// Returns the oldest element of the queue or NULL if the queue is empty.
 void *QueueDequeue(QueueRef queue);
 
+typedef struct _ConcurrentQueue *ConcurrentQueueRef;
+
+/// Creates an unbounded lock-free multi-producer multi-consumer FIFO queue. The elements are stored in linked segments which are only
+/// released when the queue gets destroyed, so `allocator` has to be thread-safe if elements are enqueued from multiple threads.
+ConcurrentQueueRef ConcurrentQueueCreate(AllocatorRef allocator);
+
+/// Destroys the queue, there must not be any concurrent access to the queue.
+void ConcurrentQueueDestroy(ConcurrentQueueRef queue);
+
+/// Enqueues a non-NULL `element`.
+void ConcurrentQueueEnqueue(ConcurrentQueueRef queue, void *element);
+
+/// Returns the oldest element of the queue or NULL if the queue is empty, an element whose enqueue is still in progress on another
+/// thread is treated as not yet enqueued.
+void *ConcurrentQueueDequeue(ConcurrentQueueRef queue);
+
 JELLY_EXTERN_C_END
 
 #endif
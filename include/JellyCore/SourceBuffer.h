@@ -0,0 +1,38 @@
+#ifndef __JELLY_SOURCEBUFFER__
+#define __JELLY_SOURCEBUFFER__
+
+#include <JellyCore/Allocator.h>
+#include <JellyCore/Base.h>
+#include <JellyCore/String.h>
+
+JELLY_EXTERN_C_BEGIN
+
+typedef struct _SourceBuffer *SourceBufferRef;
+
+/// Maps the file read-only into memory so that the lexer and all SourceRange(s) point directly into the page cache. The characters are
+/// always followed by a null terminator, files where the mapping wouldn't provide one are read into an allocated buffer instead.
+SourceBufferRef SourceBufferCreateFromFile(AllocatorRef allocator, const Char *filePath);
+
+/// Creates a buffer holding a copy of the characters of `string`.
+SourceBufferRef SourceBufferCreateFromString(AllocatorRef allocator, StringRef string);
+
+void SourceBufferDestroy(SourceBufferRef buffer);
+
+const Char *SourceBufferGetCharacters(SourceBufferRef buffer);
+
+Index SourceBufferGetLength(SourceBufferRef buffer);
+
+Bool SourceBufferIsMapped(SourceBufferRef buffer);
+
+/// Returns true if `position` points into the characters of the buffer or at its null terminator.
+Bool SourceBufferContainsPosition(SourceBufferRef buffer, const Char *position);
+
+Index SourceBufferGetLineCount(SourceBufferRef buffer);
+
+/// Resolves `position` to a 1-based line and byte column. The line table is built by the first query, so the first query must not
+/// race with other queries of the same buffer.
+Bool SourceBufferGetLineAndColumn(SourceBufferRef buffer, const Char *position, Index *line, Index *column);
+
+JELLY_EXTERN_C_END
+
+#endif
@@ -8,12 +8,23 @@ JELLY_EXTERN_C_BEGIN
 
 typedef struct _String *StringRef;
 
+/// A non-owning reference to `length` characters which are not necessarily null terminated, the referenced characters have to outlive
+/// the view.
+struct _StringView {
+    const Char *characters;
+    Index length;
+};
+typedef struct _StringView StringView;
+
+/// Short strings are stored inline within the allocation of the string, longer ones in a separate buffer which grows geometrically.
 StringRef StringCreate(AllocatorRef allocator, const Char *rawString);
 
 StringRef StringCreateRange(AllocatorRef allocator, const Char *start, const Char *end);
 
 StringRef StringCreateCopy(AllocatorRef allocator, StringRef string);
 
+StringRef StringCreateFromView(AllocatorRef allocator, StringView view);
+
 /// Searches the `string` for `character` and returns a copy of the `string` beginning at the last occurence of `character`.
 StringRef StringCreateCopyFromLastOccurenceOf(AllocatorRef allocator, StringRef string, Char character);
 
@@ -37,10 +48,16 @@ Index StringGetLength(StringRef string);
 
 Char *StringGetCharacters(StringRef string);
 
+/// Returns a view of the characters of `string` which is invalidated by any modification of the `string`.
+StringView StringGetView(StringRef string);
+
 void StringAppend(StringRef string, const Char *rawString);
 
 void StringAppendString(StringRef string, StringRef other);
 
+void StringAppendView(StringRef string, StringView view);
+
+/// Appends the formatted characters to the `string`, the arguments must not point into the `string` itself.
 void StringAppendFormat(StringRef string, const Char *format, ...) JELLY_PRINTFLIKE(2, 3);
 
 Bool StringIsEqual(StringRef lhs, StringRef rhs);
@@ -49,6 +66,12 @@ Bool StringIsEqualToCString(StringRef lhs, const Char *rawString);
 
 void StringRemovePrefix(StringRef string, const Char *prefix);
 
+StringView StringViewMake(const Char *start, const Char *end);
+
+Bool StringViewIsEqual(StringView lhs, StringView rhs);
+
+Bool StringViewIsEqualToCString(StringView view, const Char *rawString);
+
 JELLY_EXTERN_C_END
 
 #endif
@@ -0,0 +1,50 @@
+#ifndef __JELLY_STRINGINTERNER__
+#define __JELLY_STRINGINTERNER__
+
+#include <JellyCore/Allocator.h>
+#include <JellyCore/Base.h>
+#include <JellyCore/String.h>
+
+JELLY_EXTERN_C_BEGIN
+
+typedef struct _StringInterner *StringInternerRef;
+
+struct _StringInternerStatistics {
+    Index internCount;
+    Index lookupCount;
+    Index probeCount;
+    Index stringCount;
+    Index stringMemorySize;
+    Index savedMemorySize;
+};
+typedef struct _StringInternerStatistics StringInternerStatistics;
+
+StringInternerRef StringInternerCreate(AllocatorRef allocator);
+
+/// Creates a cache of `interner` for a single thread, strings missing in the cache are interned by `interner` which is locked for the
+/// lifetime of the interner as soon as the first cache has been created. The cache returns the strings owned by `interner`.
+StringInternerRef StringInternerCreateCache(AllocatorRef allocator, StringInternerRef interner);
+
+void StringInternerDestroy(StringInternerRef interner);
+
+/// Returns the unique immutable string which is equal to `string`, two interned strings are equal if and only if they are the same
+/// pointer. The returned string is owned by the interner and must not be modified or destroyed.
+StringRef StringInternerIntern(StringInternerRef interner, StringRef string);
+
+StringRef StringInternerInternCString(StringInternerRef interner, const Char *rawString);
+
+/// Returns the interned string equal to `string` or NULL if the string has never been interned.
+StringRef StringInternerLookup(StringInternerRef interner, StringRef string);
+
+StringInternerStatistics StringInternerGetStatistics(StringInternerRef interner);
+
+/// Adds the requests served by `cache` itself to the statistics of its interner and resets the statistics of `cache`, the cache must not
+/// be used concurrently while merging.
+void StringInternerMergeCacheStatistics(StringInternerRef cache);
+
+/// Prints the amount of unique strings, the memory saved by interning and the amount of probes per request.
+void StringInternerPrintReport(StringInternerRef interner, FILE *output);
+
+JELLY_EXTERN_C_END
+
+#endif
@@ -4,6 +4,7 @@
 #include <JellyCore/Allocator.h>
 #include <JellyCore/Base.h>
 #include <JellyCore/String.h>
+#include <JellyCore/StringInterner.h>
 
 JELLY_EXTERN_C_BEGIN
 
@@ -20,7 +21,7 @@ enum _ScopeKind {
 };
 typedef enum _ScopeKind ScopeKind;
 
-typedef Int64 ScopeID;
+typedef Int32 ScopeID;
 
 static ScopeID kScopeGlobal = 0;
 static ScopeID kScopeNull   = -1;
@@ -33,7 +34,8 @@ typedef struct _Symbol *SymbolRef;
 
 typedef struct _SymbolTable *SymbolTableRef;
 
-SymbolTableRef SymbolTableCreate(AllocatorRef allocator);
+/// Creates a symbol table which stores all symbol names in `interner`, the interner has to outlive the symbol table.
+SymbolTableRef SymbolTableCreate(AllocatorRef allocator, StringInternerRef interner);
 
 void SymbolTableDestroy(SymbolTableRef table);
 
@@ -7,6 +7,8 @@
 JELLY_EXTERN_C_BEGIN
 
 // TODO: Rename temp allocator... it has more use cases then just acting as a temporary allocation...
+/// Creates a pool allocator which serves small allocations from size classes carved out of slabs, allocating, reallocating and
+/// deallocating are constant time and all memory still in use is released when the allocator gets destroyed.
 AllocatorRef TempAllocatorCreate(AllocatorRef allocator);
 
 JELLY_EXTERN_C_END
@@ -0,0 +1,34 @@
+#ifndef __JELLY_TOKENBUFFER__
+#define __JELLY_TOKENBUFFER__
+
+#include <JellyCore/Allocator.h>
+#include <JellyCore/Base.h>
+#include <JellyCore/Lexer.h>
+#include <JellyCore/SourceBuffer.h>
+#include <JellyCore/String.h>
+
+JELLY_EXTERN_C_BEGIN
+
+typedef struct _TokenBuffer *TokenBufferRef;
+
+/// Lexes all tokens of `buffer` at once, the characters of `buffer` have to outlive the token buffer.
+TokenBufferRef TokenBufferCreate(AllocatorRef allocator, StringRef buffer);
+
+/// Lexes all tokens of `buffer` at once, the characters of `buffer` have to outlive the token buffer.
+TokenBufferRef TokenBufferCreateFromSourceBuffer(AllocatorRef allocator, SourceBufferRef buffer);
+
+void TokenBufferDestroy(TokenBufferRef buffer);
+
+/// Returns the amount of tokens including the trailing `TokenKindEndOfFile` token.
+Index TokenBufferGetCount(TokenBufferRef buffer);
+
+TokenKind TokenBufferGetKind(TokenBufferRef buffer, Index index);
+
+/// Reconstructs the token at `index`, the leading trivia spans from the end of the previous token to the start of the token and the
+/// trailing trivia is restored from its stored length. The line and column of the token aren't stored and are always 0, the location can
+/// be resolved by `SourceBufferGetLineAndColumn` instead.
+void TokenBufferGetToken(TokenBufferRef buffer, Index index, Token *token);
+
+JELLY_EXTERN_C_END
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef __JELLY_TRACKINGALLOCATOR__
+#define __JELLY_TRACKINGALLOCATOR__
+
+#include <JellyCore/Allocator.h>
+#include <JellyCore/Base.h>
+
+JELLY_EXTERN_C_BEGIN
+
+/// Bucket `n` counts the allocations of up to `16 << n` bytes, the last bucket counts all larger allocations.
+#define JELLY_TRACKING_ALLOCATOR_HISTOGRAM_BUCKET_COUNT 14
+
+struct _TrackingAllocatorStatistics {
+    Index allocationCount;
+    Index reallocationCount;
+    Index deallocationCount;
+    Index liveAllocationCount;
+    Index liveBytes;
+    Index peakBytes;
+    Index histogram[JELLY_TRACKING_ALLOCATOR_HISTOGRAM_BUCKET_COUNT];
+};
+typedef struct _TrackingAllocatorStatistics TrackingAllocatorStatistics;
+
+/// Creates a thread-safe allocator which forwards to `allocator` and records the allocations of the subsystem named by `tag`, the `tag`
+/// has to be a string literal. Allocations still alive when the allocator gets destroyed are released.
+AllocatorRef TrackingAllocatorCreate(AllocatorRef allocator, const Char *tag);
+
+const Char *TrackingAllocatorGetTag(AllocatorRef allocator);
+
+TrackingAllocatorStatistics TrackingAllocatorGetStatistics(AllocatorRef allocator);
+
+/// Sets the call site which is recorded for all following allocations of the calling thread and returns the previous one, the
+/// `callSite` has to be a string literal or NULL.
+const Char *TrackingAllocatorSetCallSite(const Char *callSite);
+
+/// Prints a table with the statistics and the size histogram of each of the tracking `allocators`.
+void TrackingAllocatorPrintReport(AllocatorRef *allocators, Index allocatorCount, FILE *output);
+
+/// Prints the live allocations of `allocator` grouped by call site and returns their count.
+Index TrackingAllocatorPrintLeakReport(AllocatorRef allocator, FILE *output);
+
+JELLY_EXTERN_C_END
+
+#endif
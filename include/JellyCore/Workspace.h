@@ -4,6 +4,7 @@
 #include <JellyCore/ASTContext.h>
 #include <JellyCore/Allocator.h>
 #include <JellyCore/Base.h>
+#include <JellyCore/Diagnostic.h>
 
 JELLY_EXTERN_C_BEGIN
 
@@ -12,9 +13,26 @@ enum _WorkspaceOptions {
     WorkspaceOptionsDumpAST   = 1 << 0,
     WorkspaceOptionsDumpIR    = 1 << 1,
     WorkspaceOptionsTypeCheck = 1 << 2,
+
+    WorkspaceOptionsOptimizeLess       = 1 << 3,
+    WorkspaceOptionsOptimizeDefault    = 1 << 4,
+    WorkspaceOptionsOptimizeAggressive = 1 << 5,
+    WorkspaceOptionsOptimizeSize       = 1 << 6,
+
+    /// Rebuilds all modules without consulting the build cache of the build directory
+    WorkspaceOptionsNoCache = 1 << 7,
+    /// Reports the hit and miss counts of the build cache after building the modules
+    WorkspaceOptionsCacheReport = 1 << 8,
+    /// Prints the wall time, cpu time and heap allocations of each compilation phase per source file and module
+    WorkspaceOptionsTimeReport = 1 << 9,
+    /// Tracks the heap allocations of each subsystem, prints their statistics after finishing and reports leaks on destroy
+    WorkspaceOptionsMemoryReport = 1 << 10,
 };
 typedef enum _WorkspaceOptions WorkspaceOptions;
 
+/// Returns the subset of `options` which changes the emitted object files and therefore is part of the build cache fingerprint.
+WorkspaceOptions WorkspaceOptionsGetFingerprintOptions(WorkspaceOptions options);
+
 typedef struct _Workspace *WorkspaceRef;
 
 WorkspaceRef WorkspaceCreate(AllocatorRef allocator, StringRef workingDirectory, StringRef buildDirectory, StringRef moduleName,
@@ -24,10 +42,25 @@ void WorkspaceDestroy(WorkspaceRef workspace);
 
 ASTContextRef WorkspaceGetContext(WorkspaceRef workspace);
 
+/// The engine is owned by the workspace and receives all diagnostics of the workspace threads, it reports to the default handler
+/// installed at the time the workspace has been created.
+DiagnosticEngineRef WorkspaceGetDiagnosticEngine(WorkspaceRef workspace);
+
 void WorkspaceAddSourceFile(WorkspaceRef workspace, StringRef filePath);
 
 void WorkspaceSetDumpASTOutput(WorkspaceRef workspace, FILE *output);
 
+/// Enables the profiling of the compilation phases and writes a span per source file or module and phase as Chrome trace events into
+/// `output` after the workspace has finished.
+void WorkspaceSetTraceOutput(WorkspaceRef workspace, FILE *output);
+
+/// Sets the amount of workers used to process the parse queue and to build the modules, each parse worker owns a separate `ParserRef`
+/// and `LexerRef` and each module is built by a separate `IRBuilderRef`.
+void WorkspaceSetJobCount(WorkspaceRef workspace, Index jobCount);
+
+/// Sets the target triple of the emitted object files, the default NULL triple compiles for the host.
+void WorkspaceSetTargetTriple(WorkspaceRef workspace, StringRef targetTriple);
+
 Bool WorkspaceStartAsync(WorkspaceRef workspace);
 
 void WorkspaceWaitForFinish(WorkspaceRef workspace);
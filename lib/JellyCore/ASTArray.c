@@ -1,6 +1,11 @@
 #include "JellyCore/ASTArray.h"
 #include "JellyCore/ASTContext.h"
 
+// The element buffer is always terminated by a NULL entry, which allows the iterator to be a plain pointer into the buffer.
+const Index kASTArrayMinimumCapacity = 4;
+
+static inline void _ASTArrayReserveCapacity(ASTArrayRef array, Index capacity);
+
 Index ASTArrayGetSortedInsertionIndex(ASTArrayRef array, ASTArrayPredicate isOrderedAscending, void *element) {
     if (ASTArrayGetElementCount(array) < 1) {
         return 0;
@@ -21,42 +26,28 @@ Index ASTArrayGetElementCount(ASTArrayRef array) {
 void *ASTArrayGetElementAtIndex(ASTArrayRef array, Index index) {
     assert(index < array->elementCount);
 
-    ASTLinkedListRef list = array->list;
-    for (Index offset = 0; offset < index; offset++) {
-        assert(list->next);
-        list = list->next;
-    }
-
-    return list->node;
+    return array->elements[index];
 }
 
 void ASTArrayAppendElement(ASTArrayRef array, void *element) {
     assert(element);
 
-    if (!array->list) {
-        array->list       = ASTContextCreateLinkedList(array->context, array->base.location, array->base.scope);
-        array->list->node = element;
-        array->elementCount += 1;
-        return;
-    }
-
-    ASTLinkedListRef list = array->list;
-    while (list && list->next) {
-        list = list->next;
-    }
-
-    list->next       = ASTContextCreateLinkedList(array->context, array->base.location, array->base.scope);
-    list->next->node = element;
+    _ASTArrayReserveCapacity(array, array->elementCount + 1);
+    array->elements[array->elementCount] = element;
     array->elementCount += 1;
+    array->elements[array->elementCount] = NULL;
 }
 
 void ASTArrayAppendASTArray(ASTArrayRef array, ASTArrayRef other) {
-    for (Index index = 0; index < other->elementCount; index++) {
-        ASTArrayAppendElement(array, ASTArrayGetElementAtIndex(other, index));
+    Index elementCount = other->elementCount;
+    _ASTArrayReserveCapacity(array, array->elementCount + elementCount);
+    for (Index index = 0; index < elementCount; index++) {
+        ASTArrayAppendElement(array, other->elements[index]);
     }
 }
 
 void ASTArrayAppendArray(ASTArrayRef array, ArrayRef other) {
+    _ASTArrayReserveCapacity(array, array->elementCount + ArrayGetElementCount(other));
     for (Index index = 0; index < ArrayGetElementCount(other); index++) {
         void *element = *((void **)ArrayGetElementAtIndex(other, index));
         ASTArrayAppendElement(array, element);
@@ -64,69 +55,41 @@ void ASTArrayAppendArray(ASTArrayRef array, ArrayRef other) {
 }
 
 void ASTArrayInsertElementAtIndex(ASTArrayRef array, Index index, void *element) {
-    if (index == array->elementCount) {
-        return ASTArrayAppendElement(array, element);
-    }
-
-    ASTLinkedListRef list = array->list;
-    if (index > 0) {
-        for (Index offset = 0; offset < index - 1; offset++) {
-            assert(list->next);
-            list = list->next;
-        }
-    }
+    assert(element);
+    assert(index <= array->elementCount);
 
-    ASTLinkedListRef next = ASTContextCreateLinkedList(array->context, array->base.location, array->base.scope);
-    next->node            = list->node;
-    next->next            = list->next;
-    list->node            = element;
-    list->next            = next;
+    _ASTArrayReserveCapacity(array, array->elementCount + 1);
+    memmove(&array->elements[index + 1], &array->elements[index], sizeof(void *) * (array->elementCount - index + 1));
+    array->elements[index] = element;
     array->elementCount += 1;
 }
 
 void ASTArraySetElementAtIndex(ASTArrayRef array, Index index, void *element) {
+    assert(element);
     assert(index < array->elementCount);
 
-    ASTLinkedListRef list = array->list;
-    for (Index offset = 0; offset < index; offset++) {
-        assert(list->next);
-        list = list->next;
-    }
-
-    list->node = element;
+    array->elements[index] = element;
 }
 
 void ASTArrayRemoveElementAtIndex(ASTArrayRef array, Index index) {
     assert(index < array->elementCount);
 
-    ASTLinkedListRef list = array->list;
-    if (index > 0) {
-        for (Index offset = 0; offset < index - 1; offset++) {
-            assert(list->next);
-            list = list->next;
-        }
-    }
-
-    if (list->next) {
-        list->next = list->next->next;
-    }
-
+    memmove(&array->elements[index], &array->elements[index + 1], sizeof(void *) * (array->elementCount - index));
     array->elementCount -= 1;
 }
 
 void ASTArrayRemoveAllElements(ASTArrayRef array) {
-    array->list         = NULL;
     array->elementCount = 0;
+    if (array->elements) {
+        array->elements[0] = NULL;
+    }
 }
 
 bool ASTArrayContainsElement(ASTArrayRef array, ASTArrayPredicate predicate, void *element) {
-    ASTLinkedListRef list = array->list;
-    while (list) {
-        if (predicate(list->node, element)) {
+    for (Index index = 0; index < array->elementCount; index++) {
+        if (predicate(array->elements[index], element)) {
             return true;
         }
-
-        list = list->next;
     }
 
     return false;
@@ -137,40 +100,65 @@ bool ASTArrayIsEqual(ASTArrayRef lhs, ASTArrayRef rhs) {
         return false;
     }
 
-    ASTLinkedListRef lhsList = lhs->list;
-    ASTLinkedListRef rhsList = rhs->list;
-    while (lhsList) {
-        if (lhsList->node != rhsList->node) {
+    for (Index index = 0; index < lhs->elementCount; index++) {
+        if (lhs->elements[index] != rhs->elements[index]) {
             return false;
         }
-
-        lhsList = lhsList->next;
-        rhsList = rhsList->next;
     }
 
     return true;
 }
 
 ASTArrayIteratorRef ASTArrayGetIterator(ASTArrayRef array) {
-    return (ASTArrayIteratorRef)array->list;
+    if (array->elementCount < 1) {
+        return NULL;
+    }
+
+    return (ASTArrayIteratorRef)array->elements;
 }
 
 ASTArrayIteratorRef ASTArrayIteratorNext(ASTArrayIteratorRef iterator) {
-    ASTLinkedListRef list = (ASTLinkedListRef)iterator;
-    return (ASTArrayIteratorRef)list->next;
+    void **element = (void **)iterator;
+    element += 1;
+    return *element ? (ASTArrayIteratorRef)element : NULL;
 }
 
 void *ASTArrayIteratorGetElement(ASTArrayIteratorRef iterator) {
-    ASTLinkedListRef list = (ASTLinkedListRef)iterator;
-    return list->node;
+    void **element = (void **)iterator;
+    return *element;
 }
 
 void ASTArrayIteratorSetElement(ASTArrayIteratorRef iterator, void *element) {
-    ASTLinkedListRef list = (ASTLinkedListRef)iterator;
-    list->node            = element;
+    assert(element);
+
+    void **target = (void **)iterator;
+    *target       = element;
 }
 
 void *ASTArrayIteratorGetElementPointer(ASTArrayIteratorRef iterator) {
-    ASTLinkedListRef list = (ASTLinkedListRef)iterator;
-    return &list->node;
+    return iterator;
+}
+
+static inline void _ASTArrayReserveCapacity(ASTArrayRef array, Index capacity) {
+    // Reserve one additional slot for the NULL terminator
+    if (capacity + 1 <= array->capacity) {
+        return;
+    }
+
+    Index newCapacity = MAX(array->capacity * 2, kASTArrayMinimumCapacity);
+    while (newCapacity < capacity + 1) {
+        newCapacity *= 2;
+    }
+
+    // The array allocator is an arena owned by the context, so the previous buffer is released together with the context
+    AllocatorRef allocator = ASTContextGetArrayAllocator((ASTContextRef)array->context);
+    void **elements        = AllocatorAllocate(allocator, sizeof(void *) * newCapacity);
+    if (array->elements) {
+        memcpy(elements, array->elements, sizeof(void *) * (array->elementCount + 1));
+    } else {
+        elements[0] = NULL;
+    }
+
+    array->capacity = newCapacity;
+    array->elements = elements;
 }
@@ -2,13 +2,36 @@
 #include "JellyCore/ASTFunctions.h"
 #include "JellyCore/ASTMangling.h"
 #include "JellyCore/ASTNodes.h"
+#include "JellyCore/BumpAllocator.h"
+#include "JellyCore/Diagnostic.h"
+#include "JellyCore/PointerMap.h"
+#include "JellyCore/StringInterner.h"
 #include "JellyCore/SymbolTable.h"
 #include "JellyCore/TempAllocator.h"
 
+#include <pthread.h>
+
+/// The sources are appended in the order they are added to the context, so that the offsets of the sources are sorted ascending.
+struct _ASTContextSource {
+    const Char *characters;
+    Index length;
+    UInt32 offset;
+};
+typedef struct _ASTContextSource ASTContextSource;
+
+/// The node counts of the parent at the time of the merge are recorded to visit the nodes of the shard in the order they have been merged.
+struct _ASTContextShardEntry {
+    ASTContextRef shard;
+    Index nodeCounts[AST_TAG_COUNT];
+};
+typedef struct _ASTContextShardEntry ASTContextShardEntry;
+
 // TODO: Add unified identifier storage and remove temp allocator!
 struct _ASTContext {
     AllocatorRef allocator;
     AllocatorRef tempAllocator;
+    AllocatorRef arrayAllocator;
+    StringInternerRef interner;
     SymbolTableRef symbolTable;
     BucketArrayRef nodes[AST_TAG_COUNT];
     ASTModuleDeclarationRef module;
@@ -17,6 +40,21 @@ struct _ASTContext {
     ASTBuiltinTypeRef builtinTypes[AST_BUILTIN_TYPE_KIND_COUNT];
     ASTStructureTypeRef stringType;
     ASTTypeRef voidPointerType;
+
+    ArrayRef sources;
+    Index lastSourceIndex;
+    UInt32 nextSourceOffset;
+    // The substitution links are only set for the few nodes which have been replaced, so they are stored outside of the nodes
+    PointerMapRef substitutes;
+
+    ASTContextRef parent;
+    ArrayRef shards;
+    ArrayRef mergedShards;
+    ArrayRef pendingSourceUnits;
+    ArrayRef pendingLinkDirectives;
+    Index shardCount;
+    Bool isMerged;
+    pthread_mutex_t mutex;
 };
 
 ASTNodeRef _ASTContextCreateNode(ASTContextRef context, ASTTag tag, SourceRange location, ScopeID scope);
@@ -26,55 +64,33 @@ void _ASTContextInitBuiltinFunctions(ASTContextRef context);
 
 ASTTypeRef _ASTContextGetTypeByName(ASTContextRef context, const Char *name);
 
-ASTContextRef ASTContextCreate(AllocatorRef allocator, StringRef moduleName) {
+static inline void _ASTContextInitNodes(ASTContextRef context);
+static inline Bool _ASTContextLock(ASTContextRef context);
+static inline void _ASTContextUnlock(ASTContextRef context, Bool isLocked);
+static inline Bool _ASTContextAppendSource(ASTContextRef context, const Char *characters, Index length, ASTContextSource *entry);
+static inline void _ASTContextNodeIteratorLoadSegment(ASTContextNodeIterator *iterator);
+static inline ASTLocation _ASTContextMakeLocation(ASTContextRef context, SourceRange range);
+
+ASTContextRef ASTContextCreate(AllocatorRef allocator, AllocatorRef symbolTableAllocator, StringRef moduleName) {
     ASTContextRef context                        = AllocatorAllocate(allocator, sizeof(struct _ASTContext));
     context->allocator                           = allocator;
     context->tempAllocator                       = TempAllocatorCreate(allocator);
-    context->symbolTable                         = SymbolTableCreate(allocator);
-    context->nodes[ASTTagSourceUnit]             = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTSourceUnit), 8);
-    context->nodes[ASTTagLinkedList]             = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTLinkedList), 8);
-    context->nodes[ASTTagArray]                  = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTArray), 8);
-    context->nodes[ASTTagLoadDirective]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTLoadDirective), 8);
-    context->nodes[ASTTagLinkDirective]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTLinkDirective), 8);
-    context->nodes[ASTTagImportDirective]        = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTImportDirective), 8);
-    context->nodes[ASTTagIncludeDirective]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTIncludeDirective), 8);
-    context->nodes[ASTTagBlock]                  = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTBlock), 8);
-    context->nodes[ASTTagIfStatement]            = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTIfStatement), 8);
-    context->nodes[ASTTagLoopStatement]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTLoopStatement), 8);
-    context->nodes[ASTTagCaseStatement]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTCaseStatement), 8);
-    context->nodes[ASTTagSwitchStatement]        = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTSwitchStatement), 8);
-    context->nodes[ASTTagControlStatement]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTControlStatement), 8);
-    context->nodes[ASTTagReferenceExpression]    = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTReferenceExpression), 8);
-    context->nodes[ASTTagDereferenceExpression]  = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTDereferenceExpression), 8);
-    context->nodes[ASTTagUnaryExpression]        = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTUnaryExpression), 8);
-    context->nodes[ASTTagBinaryExpression]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTBinaryExpression), 8);
-    context->nodes[ASTTagIdentifierExpression]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTIdentifierExpression), 8);
-    context->nodes[ASTTagMemberAccessExpression] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTMemberAccessExpression), 8);
-    context->nodes[ASTTagAssignmentExpression]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTAssignmentExpression), 8);
-    context->nodes[ASTTagCallExpression]         = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTCallExpression), 8);
-    context->nodes[ASTTagConstantExpression]     = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTConstantExpression), 8);
-    context->nodes[ASTTagSizeOfExpression]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTSizeOfExpression), 8);
-    context->nodes[ASTTagSubscriptExpression]    = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTSubscriptExpression), 8);
-    context->nodes[ASTTagTypeOperationExpression] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTTypeOperationExpression),
-                                                                           8);
-    context->nodes[ASTTagModuleDeclaration]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTModuleDeclaration), 8);
-    context->nodes[ASTTagEnumerationDeclaration] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTEnumerationDeclaration), 8);
-    context->nodes[ASTTagFunctionDeclaration]    = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTFunctionDeclaration), 8);
-    context->nodes[ASTTagForeignFunctionDeclaration]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTFunctionDeclaration),
-                                                                              8);
-    context->nodes[ASTTagIntrinsicFunctionDeclaration] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTFunctionDeclaration),
-                                                                                8);
-    context->nodes[ASTTagStructureDeclaration]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTStructureDeclaration), 8);
-    context->nodes[ASTTagInitializerDeclaration] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTInitializerDeclaration), 8);
-    context->nodes[ASTTagValueDeclaration]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTValueDeclaration), 8);
-    context->nodes[ASTTagTypeAliasDeclaration]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTTypeAliasDeclaration), 8);
-    context->nodes[ASTTagOpaqueType]             = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTOpaqueType), 8);
-    context->nodes[ASTTagPointerType]            = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTPointerType), 8);
-    context->nodes[ASTTagArrayType]              = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTArrayType), 8);
-    context->nodes[ASTTagBuiltinType]            = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTBuiltinType), 8);
-    context->nodes[ASTTagEnumerationType]        = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTEnumerationType), 8);
-    context->nodes[ASTTagFunctionType]           = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTFunctionType), 8);
-    context->nodes[ASTTagStructureType]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTStructureType), 8);
+    context->arrayAllocator                      = BumpAllocatorCreate(allocator);
+    context->interner                            = StringInternerCreate(allocator);
+    context->symbolTable                         = SymbolTableCreate(symbolTableAllocator, context->interner);
+    context->sources                             = ArrayCreateEmpty(allocator, sizeof(ASTContextSource), 8);
+    context->lastSourceIndex                     = 0;
+    context->nextSourceOffset                    = 1;
+    context->substitutes                         = PointerMapCreate(allocator, sizeof(ASTNodeRef));
+    context->parent                              = NULL;
+    context->shards                              = ArrayCreateEmpty(allocator, sizeof(ASTContextRef), 8);
+    context->mergedShards                        = ArrayCreateEmpty(allocator, sizeof(ASTContextShardEntry), 8);
+    context->pendingSourceUnits                  = NULL;
+    context->pendingLinkDirectives               = NULL;
+    context->shardCount                          = 0;
+    context->isMerged                            = false;
+    pthread_mutex_init(&context->mutex, NULL);
+    _ASTContextInitNodes(context);
     context->module = ASTContextCreateModuleDeclaration(context, SourceRangeNull(), NULL, ASTModuleKindExecutable, moduleName, NULL, NULL);
     SymbolTableSetScopeUserdata(context->symbolTable, kScopeGlobal, context->module);
     _ASTContextInitBuiltinTypes(context);
@@ -82,13 +98,95 @@ ASTContextRef ASTContextCreate(AllocatorRef allocator, StringRef moduleName) {
     return context;
 }
 
+ASTContextRef ASTContextCreateShard(ASTContextRef context) {
+    assert(!context->parent && "Shards of shards are not supported!");
+
+    ASTContextRef shard              = AllocatorAllocate(context->allocator, sizeof(struct _ASTContext));
+    shard->allocator                 = context->allocator;
+    shard->tempAllocator             = TempAllocatorCreate(context->allocator);
+    shard->arrayAllocator            = BumpAllocatorCreate(context->allocator);
+    shard->interner                  = StringInternerCreateCache(context->allocator, context->interner);
+    shard->symbolTable               = context->symbolTable;
+    shard->module                    = context->module;
+    shard->stringType                = context->stringType;
+    shard->voidPointerType           = context->voidPointerType;
+    shard->sources                   = ArrayCreateEmpty(context->allocator, sizeof(ASTContextSource), 1);
+    shard->lastSourceIndex           = 0;
+    shard->nextSourceOffset          = 0;
+    shard->substitutes               = PointerMapCreate(context->allocator, sizeof(ASTNodeRef));
+    shard->parent                    = context;
+    shard->shards                    = NULL;
+    shard->mergedShards              = NULL;
+    shard->pendingSourceUnits        = ArrayCreateEmpty(context->allocator, sizeof(ASTSourceUnitRef), 1);
+    shard->pendingLinkDirectives     = ArrayCreateEmpty(context->allocator, sizeof(ASTLinkDirectiveRef), 1);
+    shard->shardCount                = 0;
+    shard->isMerged                  = false;
+    memcpy(shard->builtinTypes, context->builtinTypes, sizeof(context->builtinTypes));
+    pthread_mutex_init(&shard->mutex, NULL);
+    _ASTContextInitNodes(shard);
+
+    // The context stays locked for the rest of its lifetime once the first shard exists
+    pthread_mutex_lock(&context->mutex);
+    ArrayAppendElement(context->shards, &shard);
+    __atomic_store_n(&context->shardCount, ArrayGetElementCount(context->shards), __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&context->mutex);
+    return shard;
+}
+
+void ASTContextMergeShard(ASTContextRef context, ASTContextRef shard) {
+    assert(shard->parent == context && !shard->isMerged);
+
+    ASTContextShardEntry entry;
+    entry.shard = shard;
+    for (Index index = 0; index < AST_TAG_COUNT; index++) {
+        entry.nodeCounts[index] = BucketArrayGetElementCount(context->nodes[index]);
+    }
+    ArrayAppendElement(context->mergedShards, &entry);
+
+    for (Index index = 0; index < ArrayGetElementCount(shard->pendingLinkDirectives); index++) {
+        ASTLinkDirectiveRef directive = *(ASTLinkDirectiveRef *)ArrayGetElementAtIndex(shard->pendingLinkDirectives, index);
+        ASTArrayAppendElement(context->module->linkDirectives, directive);
+    }
+
+    for (Index index = 0; index < ArrayGetElementCount(shard->pendingSourceUnits); index++) {
+        ASTSourceUnitRef sourceUnit = *(ASTSourceUnitRef *)ArrayGetElementAtIndex(shard->pendingSourceUnits, index);
+        ASTArrayAppendElement(context->module->sourceUnits, sourceUnit);
+    }
+
+    ArrayRemoveAllElements(shard->pendingLinkDirectives, false);
+    ArrayRemoveAllElements(shard->pendingSourceUnits, false);
+    StringInternerMergeCacheStatistics(shard->interner);
+    shard->isMerged = true;
+}
+
 void ASTContextDestroy(ASTContextRef context) {
+    if (context->shards) {
+        for (Index index = 0; index < ArrayGetElementCount(context->shards); index++) {
+            ASTContextDestroy(*(ASTContextRef *)ArrayGetElementAtIndex(context->shards, index));
+        }
+
+        ArrayDestroy(context->shards);
+        ArrayDestroy(context->mergedShards);
+    }
+
     for (Index index = 0; index < AST_TAG_COUNT; index++) {
         BucketArrayDestroy(context->nodes[index]);
     }
 
-    SymbolTableDestroy(context->symbolTable);
+    PointerMapDestroy(context->substitutes);
+
+    if (context->parent) {
+        ArrayDestroy(context->pendingSourceUnits);
+        ArrayDestroy(context->pendingLinkDirectives);
+    } else {
+        SymbolTableDestroy(context->symbolTable);
+    }
+
+    ArrayDestroy(context->sources);
+    StringInternerDestroy(context->interner);
+    AllocatorDestroy(context->arrayAllocator);
     AllocatorDestroy(context->tempAllocator);
+    pthread_mutex_destroy(&context->mutex);
     AllocatorDeallocate(context->allocator, context);
 }
 
@@ -96,6 +194,14 @@ AllocatorRef ASTContextGetTempAllocator(ASTContextRef context) {
     return context->tempAllocator;
 }
 
+AllocatorRef ASTContextGetArrayAllocator(ASTContextRef context) {
+    return context->arrayAllocator;
+}
+
+StringInternerRef ASTContextGetStringInterner(ASTContextRef context) {
+    return context->interner;
+}
+
 SymbolTableRef ASTContextGetSymbolTable(ASTContextRef context) {
     return context->symbolTable;
 }
@@ -104,14 +210,126 @@ ASTModuleDeclarationRef ASTContextGetModule(ASTContextRef context) {
     return context->module;
 }
 
-BucketArrayRef ASTContextGetAllNodes(ASTContextRef context, ASTTag tag) {
-    return context->nodes[tag];
+Index ASTContextGetNodeCount(ASTContextRef context, ASTTag tag) {
+    Index count = BucketArrayGetElementCount(context->nodes[tag]);
+    if (context->mergedShards) {
+        for (Index index = 0; index < ArrayGetElementCount(context->mergedShards); index++) {
+            ASTContextShardEntry *entry = (ASTContextShardEntry *)ArrayGetElementAtIndex(context->mergedShards, index);
+            count += BucketArrayGetElementCount(entry->shard->nodes[tag]);
+        }
+    }
+
+    return count;
+}
+
+ASTContextNodeIterator ASTContextGetNodeIterator(ASTContextRef context, ASTTag tag) {
+    ASTContextNodeIterator iterator;
+    iterator.context = context;
+    iterator.tag     = tag;
+    iterator.segment = 0;
+    _ASTContextNodeIteratorLoadSegment(&iterator);
+    return iterator;
+}
+
+void ASTContextNodeIteratorNext(ASTContextNodeIterator *iterator) {
+    assert(iterator->node);
+
+    iterator->index += 1;
+    if (iterator->index < iterator->endIndex) {
+        iterator->node = (ASTNodeRef)BucketArrayGetElementAtIndex(iterator->nodes, iterator->index);
+        return;
+    }
+
+    iterator->segment += 1;
+    _ASTContextNodeIteratorLoadSegment(iterator);
+}
+
+Bool ASTContextAddSource(ASTContextRef context, SourceBufferRef source) {
+    const Char *characters = SourceBufferGetCharacters(source);
+    Index length           = SourceBufferGetLength(source);
+    ASTContextSource entry;
+    if (!context->parent) {
+        return _ASTContextAppendSource(context, characters, length, &entry);
+    }
+
+    Index sourceCount = ArrayGetElementCount(context->sources);
+    if (sourceCount > 0 && ((ASTContextSource *)ArrayGetElementAtIndex(context->sources, sourceCount - 1))->characters == characters) {
+        return true;
+    }
+
+    // The offset is assigned by the parent to keep the locations unique across all shards
+    if (!_ASTContextAppendSource(context->parent, characters, length, &entry)) {
+        return false;
+    }
+
+    ArrayAppendElement(context->sources, &entry);
+    context->lastSourceIndex = sourceCount;
+    return true;
+}
+
+SourceRange ASTContextGetNodeLocation(ASTContextRef context, ASTNodeRef node) {
+    if (node->location.offset < 1) {
+        return SourceRangeNull();
+    }
+
+    Bool isLocked = _ASTContextLock(context);
+    Index lower   = 0;
+    Index upper   = ArrayGetElementCount(context->sources);
+    while (upper - lower > 1) {
+        Index middle = lower + (upper - lower) / 2;
+        if (((ASTContextSource *)ArrayGetElementAtIndex(context->sources, middle))->offset <= node->location.offset) {
+            lower = middle;
+        } else {
+            upper = middle;
+        }
+    }
+
+    ASTContextSource *source = (ASTContextSource *)ArrayGetElementAtIndex(context->sources, lower);
+    const Char *start        = source->characters + (node->location.offset - source->offset);
+    _ASTContextUnlock(context, isLocked);
+    return SourceRangeMake(start, start + node->location.length);
+}
+
+void ASTContextSetNodeLocation(ASTContextRef context, ASTNodeRef node, SourceRange location) {
+    node->location = _ASTContextMakeLocation(context, location);
+}
+
+/// The flag of the node is checked first to avoid a lookup in the side table for nodes without a substitute.
+ASTNodeRef ASTContextGetSubstitute(ASTContextRef context, ASTNodeRef node) {
+    if (!(node->flags & ASTFlagsHasSubstitute)) {
+        return NULL;
+    }
+
+    return *(ASTNodeRef *)PointerMapLookup(context->substitutes, node);
+}
+
+void ASTContextSetSubstitute(ASTContextRef context, ASTNodeRef node, ASTNodeRef substitute) {
+    *(ASTNodeRef *)PointerMapInsert(context->substitutes, node) = substitute;
+    node->flags |= ASTFlagsHasSubstitute;
+}
+
+void ASTContextReserveSubstitutes(ASTContextRef context, Index count) {
+    PointerMapReserve(context->substitutes, count);
 }
 
 void ASTModuleAddSourceUnit(ASTContextRef context, ASTModuleDeclarationRef module, ASTSourceUnitRef sourceUnit) {
+    if (context->parent && module == context->module) {
+        ArrayAppendElement(context->pendingSourceUnits, &sourceUnit);
+        return;
+    }
+
     ASTArrayAppendElement(module->sourceUnits, sourceUnit);
 }
 
+void ASTModuleAddLinkDirective(ASTContextRef context, ASTModuleDeclarationRef module, ASTLinkDirectiveRef directive) {
+    if (context->parent && module == context->module) {
+        ArrayAppendElement(context->pendingLinkDirectives, &directive);
+        return;
+    }
+
+    ASTArrayAppendElement(module->linkDirectives, directive);
+}
+
 ASTSourceUnitRef ASTContextCreateSourceUnit(ASTContextRef context, SourceRange location, ScopeID scope, StringRef filePath,
                                             ArrayRef declarations) {
     assert(filePath);
@@ -125,18 +343,12 @@ ASTSourceUnitRef ASTContextCreateSourceUnit(ASTContextRef context, SourceRange l
     return node;
 }
 
-ASTLinkedListRef ASTContextCreateLinkedList(ASTContextRef context, SourceRange location, ScopeID scope) {
-    ASTLinkedListRef list = (ASTLinkedListRef)_ASTContextCreateNode(context, ASTTagLinkedList, location, scope);
-    list->node            = NULL;
-    list->next            = NULL;
-    return list;
-}
-
 ASTArrayRef ASTContextCreateArray(ASTContextRef context, SourceRange location, ScopeID scope) {
     ASTArrayRef array   = (ASTArrayRef)_ASTContextCreateNode(context, ASTTagArray, location, scope);
     array->context      = context;
     array->elementCount = 0;
-    array->list         = NULL;
+    array->capacity     = 0;
+    array->elements     = NULL;
     return array;
 }
 
@@ -301,7 +513,7 @@ ASTIdentifierExpressionRef ASTContextCreateIdentifierExpression(ASTContextRef co
 
     ASTIdentifierExpressionRef node = (ASTIdentifierExpressionRef)_ASTContextCreateNode(context, ASTTagIdentifierExpression, location,
                                                                                         scope);
-    node->name                      = StringCreateCopy(context->tempAllocator, name);
+    node->name                      = StringInternerIntern(context->interner, name);
     node->base.type                 = NULL;
     node->base.expectedType         = NULL;
     node->candidateDeclarations     = ASTContextCreateArray(context, location, scope);
@@ -316,7 +528,7 @@ ASTMemberAccessExpressionRef ASTContextCreateMemberAccessExpression(ASTContextRe
     ASTMemberAccessExpressionRef node = (ASTMemberAccessExpressionRef)_ASTContextCreateNode(context, ASTTagMemberAccessExpression, location,
                                                                                             scope);
     node->argument                    = argument;
-    node->memberName                  = StringCreateCopy(context->tempAllocator, memberName);
+    node->memberName                  = StringInternerIntern(context->interner, memberName);
     node->memberIndex                 = -1;
     node->pointerDepth                = 0;
     node->base.type                   = NULL;
@@ -490,7 +702,7 @@ ASTTypeOperationExpressionRef ASTContextCreateTypeOperationExpression(ASTContext
 ASTModuleDeclarationRef ASTContextCreateModuleDeclaration(ASTContextRef context, SourceRange location, ScopeID scope, ASTModuleKind kind,
                                                           StringRef name, ArrayRef sourceUnits, ArrayRef importedModules) {
     ASTModuleDeclarationRef node = (ASTModuleDeclarationRef)_ASTContextCreateNode(context, ASTTagModuleDeclaration, location, scope);
-    node->base.name              = StringCreateCopy(context->tempAllocator, name);
+    node->base.name              = StringInternerIntern(context->interner, name);
     node->base.mangledName       = NULL;
     node->base.type              = NULL;
     node->kind                   = kind;
@@ -498,7 +710,7 @@ ASTModuleDeclarationRef ASTContextCreateModuleDeclaration(ASTContextRef context,
     node->sourceUnits            = ASTContextCreateArray(context, location, scope);
     node->importedModules        = ASTContextCreateArray(context, location, scope);
     node->linkDirectives         = ASTContextCreateArray(context, location, scope);
-    node->entryPointName         = StringCreate(context->tempAllocator, "main");
+    node->entryPointName         = StringInternerInternCString(context->interner, "main");
     node->entryPoint             = NULL;
     if (sourceUnits) {
         ASTArrayAppendArray(node->sourceUnits, sourceUnits);
@@ -515,7 +727,7 @@ ASTEnumerationDeclarationRef ASTContextCreateEnumerationDeclaration(ASTContextRe
 
     ASTEnumerationDeclarationRef node = (ASTEnumerationDeclarationRef)_ASTContextCreateNode(context, ASTTagEnumerationDeclaration, location,
                                                                                             scope);
-    node->base.name                   = StringCreateCopy(context->tempAllocator, name);
+    node->base.name                   = StringInternerIntern(context->interner, name);
     node->base.mangledName            = NULL;
     node->elements                    = ASTContextCreateArray(context, location, scope);
     node->innerScope                  = kScopeNull;
@@ -533,7 +745,7 @@ ASTFunctionDeclarationRef ASTContextCreateFunctionDeclaration(ASTContextRef cont
     assert(name && returnType && body);
 
     ASTFunctionDeclarationRef node = (ASTFunctionDeclarationRef)_ASTContextCreateNode(context, ASTTagFunctionDeclaration, location, scope);
-    node->base.name                = StringCreateCopy(context->tempAllocator, name);
+    node->base.name                = StringInternerIntern(context->interner, name);
     node->base.mangledName         = NULL;
     node->fixity                   = ASTFixityNone;
     node->parameters               = ASTContextCreateArray(context, location, scope);
@@ -556,7 +768,7 @@ ASTFunctionDeclarationRef ASTContextCreateForeignFunctionDeclaration(ASTContextR
 
     ASTFunctionDeclarationRef node = (ASTFunctionDeclarationRef)_ASTContextCreateNode(context, ASTTagForeignFunctionDeclaration, location,
                                                                                       scope);
-    node->base.name                = StringCreateCopy(context->tempAllocator, name);
+    node->base.name                = StringInternerIntern(context->interner, name);
     node->base.mangledName         = NULL;
     node->fixity                   = fixity;
     node->parameters               = ASTContextCreateArray(context, location, scope);
@@ -578,7 +790,7 @@ ASTFunctionDeclarationRef ASTContextCreateIntrinsicFunctionDeclaration(ASTContex
 
     ASTFunctionDeclarationRef node = (ASTFunctionDeclarationRef)_ASTContextCreateNode(context, ASTTagIntrinsicFunctionDeclaration, location,
                                                                                       scope);
-    node->base.name                = StringCreateCopy(context->tempAllocator, name);
+    node->base.name                = StringInternerIntern(context->interner, name);
     node->base.mangledName         = NULL;
     node->fixity                   = fixity;
     node->parameters               = ASTContextCreateArray(context, location, scope);
@@ -599,7 +811,7 @@ ASTStructureDeclarationRef ASTContextCreateStructureDeclaration(ASTContextRef co
 
     ASTStructureDeclarationRef node = (ASTStructureDeclarationRef)_ASTContextCreateNode(context, ASTTagStructureDeclaration, location,
                                                                                         scope);
-    node->base.name                 = StringCreateCopy(context->tempAllocator, name);
+    node->base.name                 = StringInternerIntern(context->interner, name);
     node->base.mangledName          = NULL;
     node->values                    = ASTContextCreateArray(context, location, scope);
     node->initializers              = ASTContextCreateArray(context, location, scope);
@@ -620,7 +832,7 @@ ASTInitializerDeclarationRef ASTContextCreateInitializerDeclaration(ASTContextRe
                                                                     ArrayRef parameters, ASTBlockRef body) {
     ASTInitializerDeclarationRef node = (ASTInitializerDeclarationRef)_ASTContextCreateNode(context, ASTTagInitializerDeclaration, location,
                                                                                             scope);
-    node->base.name                   = StringCreate(context->tempAllocator, "init");
+    node->base.name                   = StringInternerInternCString(context->interner, "init");
     node->base.mangledName            = NULL;
     node->parameters                  = ASTContextCreateArray(context, location, scope);
     node->body                        = body;
@@ -640,7 +852,7 @@ ASTValueDeclarationRef ASTContextCreateValueDeclaration(ASTContextRef context, S
     assert((kind == ASTValueKindParameter && !initializer) || (kind == ASTValueKindVariable || kind == ASTValueKindEnumerationElement));
 
     ASTValueDeclarationRef node = (ASTValueDeclarationRef)_ASTContextCreateNode(context, ASTTagValueDeclaration, location, scope);
-    node->base.name             = StringCreateCopy(context->tempAllocator, name);
+    node->base.name             = StringInternerIntern(context->interner, name);
     node->base.mangledName      = NULL;
     node->kind                  = kind;
     node->base.type             = type;
@@ -652,7 +864,7 @@ ASTTypeAliasDeclarationRef ASTContextCreateTypeAliasDeclaration(ASTContextRef co
                                                                 ASTTypeRef type) {
     ASTTypeAliasDeclarationRef node = (ASTTypeAliasDeclarationRef)_ASTContextCreateNode(context, ASTTagTypeAliasDeclaration, location,
                                                                                         scope);
-    node->base.name                 = StringCreateCopy(context->tempAllocator, name);
+    node->base.name                 = StringInternerIntern(context->interner, name);
     node->base.mangledName          = NULL;
     node->base.type                 = type;
     return node;
@@ -662,7 +874,7 @@ ASTOpaqueTypeRef ASTContextCreateOpaqueType(ASTContextRef context, SourceRange l
     assert(name);
 
     ASTOpaqueTypeRef node = (ASTOpaqueTypeRef)_ASTContextCreateNode(context, ASTTagOpaqueType, location, scope);
-    node->name            = StringCreateCopy(context->tempAllocator, name);
+    node->name            = StringInternerIntern(context->interner, name);
     node->declaration     = NULL;
     return node;
 }
@@ -741,18 +953,170 @@ ASTStructureTypeRef ASTContextGetStringType(ASTContextRef context) {
 }
 
 ASTNodeRef _ASTContextCreateNode(ASTContextRef context, ASTTag tag, SourceRange location, ScopeID scope) {
-    ASTNodeRef node  = BucketArrayAppendUninitializedElement(context->nodes[tag]);
-    node->tag        = tag;
-    node->flags      = ASTFlagsNone;
-    node->location   = location;
-    node->scope      = scope;
-    node->substitute = NULL;
-    node->primary    = NULL;
-    node->irValue    = NULL;
-    node->irType     = NULL;
+    ASTNodeRef node = BucketArrayAppendUninitializedElement(context->nodes[tag]);
+    node->tag       = tag;
+    node->flags     = ASTFlagsNone;
+    node->scope     = scope;
+    node->location  = _ASTContextMakeLocation(context, location);
     return node;
 }
 
+/// Nodes are created while parsing a source, so the source of the previous node is checked first before searching all sources.
+static inline ASTLocation _ASTContextMakeLocation(ASTContextRef context, SourceRange range) {
+    ASTLocation location;
+    location.offset = 0;
+    location.length = 0;
+    if (!range.start) {
+        return location;
+    }
+
+    Bool isLocked     = _ASTContextLock(context);
+    Index sourceCount = ArrayGetElementCount(context->sources);
+    for (Index step = 0; step < sourceCount; step++) {
+        Index index              = (context->lastSourceIndex + sourceCount - step) % sourceCount;
+        ASTContextSource *source = (ASTContextSource *)ArrayGetElementAtIndex(context->sources, index);
+        const Char *sourceEnd    = source->characters + source->length;
+        if (source->characters <= range.start && range.start <= sourceEnd) {
+            context->lastSourceIndex = index;
+            location.offset          = source->offset + (UInt32)(range.start - source->characters);
+            if (range.start <= range.end && range.end <= sourceEnd) {
+                location.length = (UInt32)(range.end - range.start);
+            }
+            break;
+        }
+    }
+
+    _ASTContextUnlock(context, isLocked);
+    return location;
+}
+
+static inline void _ASTContextInitNodes(ASTContextRef context) {
+    context->nodes[ASTTagSourceUnit]             = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTSourceUnit), 8);
+    context->nodes[ASTTagArray]                  = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTArray), 8);
+    context->nodes[ASTTagLoadDirective]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTLoadDirective), 8);
+    context->nodes[ASTTagLinkDirective]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTLinkDirective), 8);
+    context->nodes[ASTTagImportDirective]        = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTImportDirective), 8);
+    context->nodes[ASTTagIncludeDirective]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTIncludeDirective), 8);
+    context->nodes[ASTTagBlock]                  = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTBlock), 8);
+    context->nodes[ASTTagIfStatement]            = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTIfStatement), 8);
+    context->nodes[ASTTagLoopStatement]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTLoopStatement), 8);
+    context->nodes[ASTTagCaseStatement]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTCaseStatement), 8);
+    context->nodes[ASTTagSwitchStatement]        = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTSwitchStatement), 8);
+    context->nodes[ASTTagControlStatement]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTControlStatement), 8);
+    context->nodes[ASTTagReferenceExpression]    = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTReferenceExpression), 8);
+    context->nodes[ASTTagDereferenceExpression]  = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTDereferenceExpression), 8);
+    context->nodes[ASTTagUnaryExpression]        = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTUnaryExpression), 8);
+    context->nodes[ASTTagBinaryExpression]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTBinaryExpression), 8);
+    context->nodes[ASTTagIdentifierExpression]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTIdentifierExpression), 8);
+    context->nodes[ASTTagMemberAccessExpression] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTMemberAccessExpression), 8);
+    context->nodes[ASTTagAssignmentExpression]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTAssignmentExpression), 8);
+    context->nodes[ASTTagCallExpression]         = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTCallExpression), 8);
+    context->nodes[ASTTagConstantExpression]     = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTConstantExpression), 8);
+    context->nodes[ASTTagSizeOfExpression]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTSizeOfExpression), 8);
+    context->nodes[ASTTagSubscriptExpression]    = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTSubscriptExpression), 8);
+    context->nodes[ASTTagTypeOperationExpression] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTTypeOperationExpression),
+                                                                           8);
+    context->nodes[ASTTagModuleDeclaration]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTModuleDeclaration), 8);
+    context->nodes[ASTTagEnumerationDeclaration] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTEnumerationDeclaration), 8);
+    context->nodes[ASTTagFunctionDeclaration]    = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTFunctionDeclaration), 8);
+    context->nodes[ASTTagForeignFunctionDeclaration]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTFunctionDeclaration),
+                                                                              8);
+    context->nodes[ASTTagIntrinsicFunctionDeclaration] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTFunctionDeclaration),
+                                                                                8);
+    context->nodes[ASTTagStructureDeclaration]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTStructureDeclaration), 8);
+    context->nodes[ASTTagInitializerDeclaration] = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTInitializerDeclaration), 8);
+    context->nodes[ASTTagValueDeclaration]       = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTValueDeclaration), 8);
+    context->nodes[ASTTagTypeAliasDeclaration]   = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTTypeAliasDeclaration), 8);
+    context->nodes[ASTTagOpaqueType]             = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTOpaqueType), 8);
+    context->nodes[ASTTagPointerType]            = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTPointerType), 8);
+    context->nodes[ASTTagArrayType]              = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTArrayType), 8);
+    context->nodes[ASTTagBuiltinType]            = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTBuiltinType), 8);
+    context->nodes[ASTTagEnumerationType]        = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTEnumerationType), 8);
+    context->nodes[ASTTagFunctionType]           = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTFunctionType), 8);
+    context->nodes[ASTTagStructureType]          = BucketArrayCreateEmpty(context->allocator, sizeof(struct _ASTStructureType), 8);
+}
+
+/// The context is only locked while shards are able to access it concurrently, the shards themselves are never shared between threads.
+static inline Bool _ASTContextLock(ASTContextRef context) {
+    Bool isLocked = __atomic_load_n(&context->shardCount, __ATOMIC_ACQUIRE) > 0;
+    if (isLocked) {
+        pthread_mutex_lock(&context->mutex);
+    }
+
+    return isLocked;
+}
+
+static inline void _ASTContextUnlock(ASTContextRef context, Bool isLocked) {
+    if (isLocked) {
+        pthread_mutex_unlock(&context->mutex);
+    }
+}
+
+static inline Bool _ASTContextAppendSource(ASTContextRef context, const Char *characters, Index length, ASTContextSource *entry) {
+    Bool isLocked     = _ASTContextLock(context);
+    Index sourceCount = ArrayGetElementCount(context->sources);
+    if (sourceCount > 0 && ((ASTContextSource *)ArrayGetElementAtIndex(context->sources, sourceCount - 1))->characters == characters) {
+        *entry = *(ASTContextSource *)ArrayGetElementAtIndex(context->sources, sourceCount - 1);
+        _ASTContextUnlock(context, isLocked);
+        return true;
+    }
+
+    // The offsets of the locations are 32 bit wide and are shared by all sources of the context
+    if (context->nextSourceOffset + length + 1 >= UINT32_MAX) {
+        _ASTContextUnlock(context, isLocked);
+        ReportError("Sources larger than 4 GB are not supported");
+        return false;
+    }
+
+    entry->characters = characters;
+    entry->length     = length;
+    entry->offset     = context->nextSourceOffset;
+    ArrayAppendElement(context->sources, entry);
+
+    // The end of a source is a valid location, so the next source starts one offset behind it
+    context->nextSourceOffset += (UInt32)length + 1;
+    context->lastSourceIndex = sourceCount;
+    _ASTContextUnlock(context, isLocked);
+    return true;
+}
+
+/// The even segments are the ranges of nodes created by the context itself between two merges, the odd segments are the merged shards.
+static inline void _ASTContextNodeIteratorLoadSegment(ASTContextNodeIterator *iterator) {
+    ASTContextRef context = iterator->context;
+    Index shardCount      = context->mergedShards ? ArrayGetElementCount(context->mergedShards) : 0;
+    while (iterator->segment <= shardCount * 2) {
+        Index shardIndex = iterator->segment / 2;
+        if (iterator->segment % 2 == 0) {
+            iterator->nodes = context->nodes[iterator->tag];
+            iterator->index = 0;
+            if (shardIndex > 0) {
+                iterator->index = ((ASTContextShardEntry *)ArrayGetElementAtIndex(context->mergedShards, shardIndex - 1))
+                                      ->nodeCounts[iterator->tag];
+            }
+
+            iterator->endIndex = BucketArrayGetElementCount(iterator->nodes);
+            if (shardIndex < shardCount) {
+                iterator->endIndex = ((ASTContextShardEntry *)ArrayGetElementAtIndex(context->mergedShards, shardIndex))
+                                         ->nodeCounts[iterator->tag];
+            }
+        } else {
+            ASTContextShardEntry *entry = (ASTContextShardEntry *)ArrayGetElementAtIndex(context->mergedShards, shardIndex);
+            iterator->nodes             = entry->shard->nodes[iterator->tag];
+            iterator->index             = 0;
+            iterator->endIndex          = BucketArrayGetElementCount(iterator->nodes);
+        }
+
+        if (iterator->index < iterator->endIndex) {
+            iterator->node = (ASTNodeRef)BucketArrayGetElementAtIndex(iterator->nodes, iterator->index);
+            return;
+        }
+
+        iterator->segment += 1;
+    }
+
+    iterator->node = NULL;
+}
+
 ASTBuiltinTypeRef _ASTContextCreateBuiltinType(ASTContextRef context, SourceRange location, ScopeID scope, ASTBuiltinTypeKind kind) {
     ASTBuiltinTypeRef node = (ASTBuiltinTypeRef)_ASTContextCreateNode(context, ASTTagBuiltinType, location, scope);
     node->kind             = kind;
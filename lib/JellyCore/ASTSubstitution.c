@@ -1,20 +1,20 @@
 #include "JellyCore/ASTFunctions.h"
 #include "JellyCore/ASTSubstitution.h"
 
+static inline ASTNodeRef _ASTGetLastSubstitute(ASTContextRef context, ASTNodeRef node);
 static inline void _ASTApplySubstitution(ASTContextRef context, ASTNodeRef node);
 
 void ASTPerformSubstitution(ASTContextRef context, ASTTag tag, ASTTransform transform) {
-    BucketArrayRef nodes = ASTContextGetAllNodes(context, tag);
-    for (Index index = 0; index < BucketArrayGetElementCount(nodes); index++) {
-        ASTNodeRef node = (ASTNodeRef)BucketArrayGetElementAtIndex(nodes, index);
-        if (node->substitute) {
+    ASTContextReserveSubstitutes(context, ASTContextGetNodeCount(context, tag));
+    for (ASTContextNodeIterator iterator = ASTContextGetNodeIterator(context, tag); iterator.node; ASTContextNodeIteratorNext(&iterator)) {
+        ASTNodeRef node = iterator.node;
+        if (ASTContextGetSubstitute(context, node)) {
             continue;
         }
 
         ASTNodeRef substitute = transform(context, node);
         if (substitute) {
-            substitute->primary = node;
-            node->substitute    = substitute;
+            ASTContextSetSubstitute(context, node, substitute);
         }
     }
 }
@@ -27,22 +27,32 @@ ASTNodeRef ASTUnaryExpressionUnification(ASTContextRef context, ASTNodeRef node)
     assert(node->tag == ASTTagUnaryExpression);
 
     ASTUnaryExpressionRef expression = (ASTUnaryExpressionRef)node;
-    return (ASTNodeRef)ASTContextCreateUnaryCallExpression(context, node->location, node->scope, expression->op, expression->arguments);
+    SourceRange location             = ASTContextGetNodeLocation(context, node);
+    return (ASTNodeRef)ASTContextCreateUnaryCallExpression(context, location, node->scope, expression->op, expression->arguments);
 }
 
 ASTNodeRef ASTBinaryExpressionUnification(ASTContextRef context, ASTNodeRef node) {
     assert(node->tag == ASTTagBinaryExpression);
 
     ASTBinaryExpressionRef expression = (ASTBinaryExpressionRef)node;
-    return (ASTNodeRef)ASTContextCreateBinaryCallExpression(context, node->location, node->scope, expression->op, expression->arguments);
+    SourceRange location              = ASTContextGetNodeLocation(context, node);
+    return (ASTNodeRef)ASTContextCreateBinaryCallExpression(context, location, node->scope, expression->op, expression->arguments);
 }
 
 #define _ASTApplySubstitutionInplace(__CONTEXT__, __NODE__, __TYPE__)                                                                      \
-    while (((ASTNodeRef)__NODE__)->substitute) {                                                                                           \
-        __NODE__ = (__TYPE__)((ASTNodeRef)__NODE__)->substitute;                                                                           \
-    }                                                                                                                                      \
+    __NODE__ = (__TYPE__)_ASTGetLastSubstitute(__CONTEXT__, (ASTNodeRef)__NODE__);                                                         \
     _ASTApplySubstitution(__CONTEXT__, (ASTNodeRef)__NODE__);
 
+static inline ASTNodeRef _ASTGetLastSubstitute(ASTContextRef context, ASTNodeRef node) {
+    ASTNodeRef substitute = ASTContextGetSubstitute(context, node);
+    while (substitute) {
+        node       = substitute;
+        substitute = ASTContextGetSubstitute(context, node);
+    }
+
+    return node;
+}
+
 static inline void _ASTApplySubstitution(ASTContextRef context, ASTNodeRef node) {
     if (node->tag == ASTTagSourceUnit) {
         ASTSourceUnitRef sourceUnit = (ASTSourceUnitRef)node;
@@ -1,5 +1,13 @@
 #include "JellyCore/Allocator.h"
 
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#define _AllocatorGetUsableSize(__MEMORY__) malloc_size(__MEMORY__)
+#else
+#include <malloc.h>
+#define _AllocatorGetUsableSize(__MEMORY__) malloc_usable_size(__MEMORY__)
+#endif
+
 struct _Allocator {
     struct _Allocator *allocator;
     AllocatorCallback callback;
@@ -8,6 +16,7 @@ struct _Allocator {
 
 void *_AllocatorMalloc(AllocatorMode mode, Index capacity, void *memory, void *context);
 void *_AllocatorNull(AllocatorMode mode, Index capacity, void *memory, void *context);
+static inline void _AllocatorUpdateThreadLiveBytes(Int delta);
 
 AllocatorRef _AllocatorGetDefault(AllocatorRef allocator);
 void *_AllocatorInvokeCallback(AllocatorRef allocator, AllocatorMode mode, Index capacity, void *memory);
@@ -21,7 +30,11 @@ const AllocatorRef kAllocatorSystemDefault = &_kAllocatorSystemDefault;
 const AllocatorRef kAllocatorMalloc        = &_kAllocatorMalloc;
 const AllocatorRef kAllocatorNull          = &_kAllocatorNull;
 
-static AllocatorRef kAllocatorCurrentDefault = kAllocatorDefault;
+// Every thread has its own current default so that worker threads can install their own arena without affecting other threads
+static JELLY_THREAD_LOCAL AllocatorRef _kAllocatorCurrentDefault = kAllocatorDefault;
+
+// The statistics are kept per thread to avoid any synchronization on the allocation path
+static JELLY_THREAD_LOCAL AllocatorStatistics _kAllocatorThreadStatistics = {0, 0, 0, 0};
 
 AllocatorRef AllocatorGetDefault(void) {
     return kAllocatorDefault;
@@ -40,11 +53,11 @@ AllocatorRef AllocatorGetNull(void) {
 }
 
 void AllocatorSetCurrentDefault(AllocatorRef allocator) {
-    kAllocatorCurrentDefault = allocator;
+    _kAllocatorCurrentDefault = allocator;
 }
 
 AllocatorRef AllocatorGetCurrentDefault(void) {
-    return kAllocatorCurrentDefault;
+    return _kAllocatorCurrentDefault;
 }
 
 AllocatorRef AllocatorCreate(AllocatorRef allocator, AllocatorCallback callback, void *context) {
@@ -61,6 +74,14 @@ void AllocatorDestroy(AllocatorRef allocator) {
     AllocatorDeallocate(allocator->allocator, allocator);
 }
 
+void *AllocatorGetContext(AllocatorRef allocator, AllocatorCallback callback) {
+    if (allocator->callback != callback) {
+        return NULL;
+    }
+
+    return allocator->context;
+}
+
 void *AllocatorAllocate(AllocatorRef allocator, Index capacity) {
     return _AllocatorInvokeCallback(allocator, AllocatorModeAllocate, capacity, NULL);
 }
@@ -73,15 +94,43 @@ void *AllocatorDeallocate(AllocatorRef allocator, void *memory) {
     return _AllocatorInvokeCallback(allocator, AllocatorModeDeallocate, 0, memory);
 }
 
+AllocatorStatistics AllocatorGetThreadStatistics(void) {
+    return _kAllocatorThreadStatistics;
+}
+
+Int AllocatorSetThreadPeakLiveBytes(Int peakLiveBytes) {
+    Int previousPeakLiveBytes                 = _kAllocatorThreadStatistics.peakLiveBytes;
+    _kAllocatorThreadStatistics.peakLiveBytes = peakLiveBytes;
+    return previousPeakLiveBytes;
+}
+
 void *_AllocatorMalloc(AllocatorMode mode, Index capacity, void *memory, void *context) {
     switch (mode) {
-    case AllocatorModeAllocate:
-        return malloc(capacity);
+    case AllocatorModeAllocate: {
+        _kAllocatorThreadStatistics.allocationCount += 1;
+        _kAllocatorThreadStatistics.allocatedBytes += capacity;
+        void *result = malloc(capacity);
+        if (result) {
+            _AllocatorUpdateThreadLiveBytes((Int)_AllocatorGetUsableSize(result));
+        }
+        return result;
+    }
 
-    case AllocatorModeReallocate:
-        return realloc(memory, capacity);
+    case AllocatorModeReallocate: {
+        _kAllocatorThreadStatistics.allocationCount += 1;
+        _kAllocatorThreadStatistics.allocatedBytes += capacity;
+        Int previousSize = memory ? (Int)_AllocatorGetUsableSize(memory) : 0;
+        void *result     = realloc(memory, capacity);
+        if (result) {
+            _AllocatorUpdateThreadLiveBytes((Int)_AllocatorGetUsableSize(result) - previousSize);
+        }
+        return result;
+    }
 
     case AllocatorModeDeallocate:
+        if (memory) {
+            _AllocatorUpdateThreadLiveBytes(-(Int)_AllocatorGetUsableSize(memory));
+        }
         free(memory);
         return NULL;
 
@@ -97,9 +146,14 @@ void *_AllocatorNull(AllocatorMode mode, Index capacity, void *memory, void *con
     return NULL;
 }
 
+static inline void _AllocatorUpdateThreadLiveBytes(Int delta) {
+    _kAllocatorThreadStatistics.liveBytes += delta;
+    _kAllocatorThreadStatistics.peakLiveBytes = MAX(_kAllocatorThreadStatistics.peakLiveBytes, _kAllocatorThreadStatistics.liveBytes);
+}
+
 AllocatorRef _AllocatorGetDefault(AllocatorRef allocator) {
     if (allocator == kAllocatorDefault) {
-        allocator = AllocatorGetDefault();
+        allocator = AllocatorGetCurrentDefault();
     }
 
     if (allocator == NULL) {
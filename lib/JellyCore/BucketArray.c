@@ -1,29 +1,26 @@
 #include "JellyCore/BucketArray.h"
 
-struct _BucketArrayPage {
-    struct _BucketArrayPage *next;
-    Index index;
-    UInt8 *memory;
-} __attribute__((packed));
+// The page sizes are doubling, so the page directory can never contain more pages than there are bits in an index
+#define BUCKET_ARRAY_MAX_PAGE_COUNT (sizeof(Index) * 8)
 
 struct _BucketArray {
     AllocatorRef allocator;
-    Index pageSize;
-    Index alignedPageSize;
     Index elementSize;
-    Index elementCountPerPage;
+    Index firstPageCapacity;
+    Index firstPageCapacityShift;
     Index elementCount;
-    struct _BucketArrayPage *firstPage;
-    struct _BucketArrayPage *currentPage;
+    Index pageCount;
+    UInt8 *pages[BUCKET_ARRAY_MAX_PAGE_COUNT];
 };
 
-static inline Bool _IsPowerOfTwo(Index value);
-static inline Index _Align(Index value, Index alignment);
+static inline Index _IndexGetLog2(Index value);
+static inline Index _IndexRoundUpToPowerOfTwo(Index value);
 
-static inline struct _BucketArrayPage *_BucketArrayPageCreate(AllocatorRef allocator, Index capacity);
+static inline Index _BucketArrayGetPageCapacity(BucketArrayRef array, Index pageIndex);
+static inline UInt8 *_BucketArrayGetElement(BucketArrayRef array, Index index);
 
 BucketArrayRef BucketArrayCreate(AllocatorRef allocator, Index pageSize, Index elementSize, const void *elements, Index elementCount) {
-    BucketArrayRef array = BucketArrayCreateEmpty(allocator, pageSize, elementSize);
+    BucketArrayRef array = BucketArrayCreateEmpty(allocator, elementSize, pageSize);
 
     for (Index index = 0; index < elementCount; index++) {
         const UInt8 *element = (UInt8 *)elements + elementSize * index;
@@ -34,40 +31,30 @@ BucketArrayRef BucketArrayCreate(AllocatorRef allocator, Index pageSize, Index e
 }
 
 BucketArrayRef BucketArrayCreateCopy(AllocatorRef allocator, Index pageSize, BucketArrayRef array) {
-    BucketArrayRef copy = BucketArrayCreateEmpty(allocator, pageSize, array->elementSize);
+    BucketArrayRef copy = BucketArrayCreateEmpty(allocator, array->elementSize, pageSize);
 
-    struct _BucketArrayPage *page = array->firstPage;
-    while (page) {
-        for (Index index = 0; index < page->index; index++) {
-            const UInt8 *element = page->memory + array->elementSize * index;
-            BucketArrayAppendElement(copy, element);
-        }
-
-        page = page->next;
+    for (BucketArrayIterator iterator = BucketArrayGetIterator(array); iterator.element; BucketArrayIteratorNext(&iterator)) {
+        BucketArrayAppendElement(copy, iterator.element);
     }
 
     return copy;
 }
 
 BucketArrayRef BucketArrayCreateEmpty(AllocatorRef allocator, Index elementSize, Index capacity) {
-    BucketArrayRef array       = AllocatorAllocate(allocator, sizeof(struct _BucketArray));
-    array->allocator           = allocator;
-    array->pageSize            = elementSize * capacity;
-    array->alignedPageSize     = _Align(array->pageSize, 2 * sizeof(void *));
-    array->elementSize         = elementSize;
-    array->elementCountPerPage = array->alignedPageSize / array->elementSize;
-    array->elementCount        = 0;
-    array->firstPage           = _BucketArrayPageCreate(allocator, array->alignedPageSize);
-    array->currentPage         = array->firstPage;
+    BucketArrayRef array          = AllocatorAllocate(allocator, sizeof(struct _BucketArray));
+    array->allocator              = allocator;
+    array->elementSize            = elementSize;
+    array->firstPageCapacity      = _IndexRoundUpToPowerOfTwo(MAX(capacity, 1));
+    array->firstPageCapacityShift = _IndexGetLog2(array->firstPageCapacity);
+    array->elementCount           = 0;
+    array->pageCount              = 0;
+    memset(array->pages, 0, sizeof(array->pages));
     return array;
 }
 
 void BucketArrayDestroy(BucketArrayRef array) {
-    struct _BucketArrayPage *page = array->firstPage;
-    while (page) {
-        struct _BucketArrayPage *next = page->next;
-        AllocatorDeallocate(array->allocator, page);
-        page = next;
+    for (Index pageIndex = 0; pageIndex < array->pageCount; pageIndex++) {
+        AllocatorDeallocate(array->allocator, array->pages[pageIndex]);
     }
 
     AllocatorDeallocate(array->allocator, array);
@@ -82,19 +69,8 @@ Index BucketArrayGetElementCount(BucketArrayRef array) {
 }
 
 void *BucketArrayGetElementAtIndex(BucketArrayRef array, Index index) {
-    Index pageIndex  = index / array->elementCountPerPage;
-    Index pageOffset = index % array->elementCountPerPage;
-
-    struct _BucketArrayPage *page = array->firstPage;
-    Index currentPageIndex        = 0;
-    while (currentPageIndex < pageIndex) {
-        assert(page->next);
-        page = page->next;
-        currentPageIndex += 1;
-    }
-
-    assert(pageOffset < page->index);
-    return page->memory + array->elementSize * pageOffset;
+    assert(index < array->elementCount);
+    return _BucketArrayGetElement(array, index);
 }
 
 void BucketArrayCopyElementAtIndex(BucketArrayRef array, Index index, void *element) {
@@ -108,15 +84,15 @@ void BucketArrayAppendElement(BucketArrayRef array, const void *element) {
 }
 
 void *BucketArrayAppendUninitializedElement(BucketArrayRef array) {
-    if (array->currentPage->index >= array->elementCountPerPage) {
-        struct _BucketArrayPage *page = _BucketArrayPageCreate(array->allocator, array->alignedPageSize);
-        array->currentPage->next      = page;
-        array->currentPage            = page;
+    Index pageIndex = _IndexGetLog2((array->elementCount >> array->firstPageCapacityShift) + 1);
+    if (pageIndex >= array->pageCount) {
+        assert(pageIndex == array->pageCount && pageIndex < BUCKET_ARRAY_MAX_PAGE_COUNT);
+        array->pages[pageIndex] = AllocatorAllocate(array->allocator, array->elementSize * _BucketArrayGetPageCapacity(array, pageIndex));
+        assert(array->pages[pageIndex]);
+        array->pageCount += 1;
     }
 
-    assert(array->currentPage->index < array->elementCountPerPage);
-    UInt8 *element = array->currentPage->memory + array->currentPage->index * array->elementSize;
-    array->currentPage->index += 1;
+    UInt8 *element = _BucketArrayGetElement(array, array->elementCount);
     array->elementCount += 1;
     return element;
 }
@@ -127,9 +103,8 @@ void BucketArraySetElementAtIndex(BucketArrayRef array, Index index, const void
 }
 
 Bool BucketArrayContainsElement(BucketArrayRef array, BucketArrayPredicate predicate, const void *element) {
-    for (Index index = 0; index < BucketArrayGetElementCount(array); index++) {
-        void *lhs = BucketArrayGetElementAtIndex(array, index);
-        if (predicate(lhs, element)) {
+    for (BucketArrayIterator iterator = BucketArrayGetIterator(array); iterator.element; BucketArrayIteratorNext(&iterator)) {
+        if (predicate(iterator.element, element)) {
             return true;
         }
     }
@@ -137,20 +112,56 @@ Bool BucketArrayContainsElement(BucketArrayRef array, BucketArrayPredicate predi
     return false;
 }
 
-static inline Bool _IsPowerOfTwo(Index value) {
-    return (value & (value - 1)) == 0;
+BucketArrayIterator BucketArrayGetIterator(BucketArrayRef array) {
+    BucketArrayIterator iterator;
+    iterator.array     = array;
+    iterator.index     = 0;
+    iterator.pageIndex = 0;
+    iterator.element   = array->elementCount > 0 ? array->pages[0] : NULL;
+    iterator.pageEnd   = iterator.element ? iterator.element + array->elementSize * array->firstPageCapacity : NULL;
+    return iterator;
 }
 
-static inline Index _Align(Index value, Index alignment) {
-    assert(_IsPowerOfTwo(alignment));
+void BucketArrayIteratorNext(BucketArrayIterator *iterator) {
+    BucketArrayRef array = iterator->array;
+    assert(iterator->element);
+
+    // The element count is checked on each step to also visit elements which have been appended while iterating
+    iterator->index += 1;
+    if (iterator->index >= array->elementCount) {
+        iterator->element = NULL;
+        return;
+    }
+
+    iterator->element += array->elementSize;
+    if (iterator->element >= iterator->pageEnd) {
+        iterator->pageIndex += 1;
+        iterator->element = array->pages[iterator->pageIndex];
+        iterator->pageEnd = iterator->element + array->elementSize * _BucketArrayGetPageCapacity(array, iterator->pageIndex);
+    }
+}
+
+static inline Index _IndexGetLog2(Index value) {
+    assert(value > 0);
+    return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(value);
+}
+
+static inline Index _IndexRoundUpToPowerOfTwo(Index value) {
+    Index result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+
+    return result;
+}
 
-    return (value + alignment - 1) & ~(alignment - 1);
+static inline Index _BucketArrayGetPageCapacity(BucketArrayRef array, Index pageIndex) {
+    return array->firstPageCapacity << pageIndex;
 }
 
-static inline struct _BucketArrayPage *_BucketArrayPageCreate(AllocatorRef allocator, Index capacity) {
-    struct _BucketArrayPage *page = AllocatorAllocate(allocator, sizeof(struct _BucketArrayPage) + capacity);
-    page->next                    = NULL;
-    page->index                   = 0;
-    page->memory                  = (UInt8 *)page + sizeof(struct _BucketArrayPage);
-    return page;
+// Page `k` holds `firstPageCapacity << k` elements and starts at the index `firstPageCapacity * (2^k - 1)`
+static inline UInt8 *_BucketArrayGetElement(BucketArrayRef array, Index index) {
+    Index pageIndex  = _IndexGetLog2((index >> array->firstPageCapacityShift) + 1);
+    Index pageOffset = index - ((((Index)1 << pageIndex) - 1) << array->firstPageCapacityShift);
+    return array->pages[pageIndex] + array->elementSize * pageOffset;
 }
@@ -0,0 +1,166 @@
+#include "JellyCore/Array.h"
+#include "JellyCore/BuildCache.h"
+
+const UInt64 kBuildCacheHashSeed = 0xcbf29ce484222325ULL;
+
+// The version has to be incremented whenever the format of the cache file or the fingerprint of a module changes
+const Index _kBuildCacheVersion = 1;
+
+struct _BuildCacheEntry {
+    StringRef moduleName;
+    UInt64 fingerprint;
+};
+typedef struct _BuildCacheEntry BuildCacheEntry;
+
+struct _BuildCache {
+    AllocatorRef allocator;
+    StringRef buildDirectory;
+    StringRef filePath;
+    ArrayRef entries;
+    BuildCacheStatistics statistics;
+};
+
+static inline void _BuildCacheLoad(BuildCacheRef cache);
+static inline BuildCacheEntry *_BuildCacheLookupEntry(BuildCacheRef cache, StringRef moduleName, Index *index);
+
+BuildCacheRef BuildCacheCreate(AllocatorRef allocator, StringRef buildDirectory) {
+    BuildCacheRef cache  = AllocatorAllocate(allocator, sizeof(struct _BuildCache));
+    cache->allocator      = allocator;
+    cache->buildDirectory = StringCreateCopy(allocator, buildDirectory);
+    cache->filePath       = StringCreateCopy(allocator, buildDirectory);
+    cache->entries        = ArrayCreateEmpty(allocator, sizeof(BuildCacheEntry), 8);
+    memset(&cache->statistics, 0, sizeof(BuildCacheStatistics));
+    StringAppend(cache->filePath, "/BuildCache");
+    _BuildCacheLoad(cache);
+    return cache;
+}
+
+void BuildCacheDestroy(BuildCacheRef cache) {
+    for (Index index = 0; index < ArrayGetElementCount(cache->entries); index++) {
+        BuildCacheEntry *entry = (BuildCacheEntry *)ArrayGetElementAtIndex(cache->entries, index);
+        StringDestroy(entry->moduleName);
+    }
+
+    ArrayDestroy(cache->entries);
+    StringDestroy(cache->filePath);
+    StringDestroy(cache->buildDirectory);
+    AllocatorDeallocate(cache->allocator, cache);
+}
+
+UInt64 BuildCacheHash(UInt64 hash, const void *bytes, Index length) {
+    const UInt8 *cursor = (const UInt8 *)bytes;
+    for (Index index = 0; index < length; index++) {
+        hash ^= cursor[index];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+Bool BuildCacheLookupModule(BuildCacheRef cache, StringRef moduleName, UInt64 fingerprint) {
+    BuildCacheEntry *entry = _BuildCacheLookupEntry(cache, moduleName, NULL);
+    if (!entry || entry->fingerprint != fingerprint) {
+        cache->statistics.missCount += 1;
+        return false;
+    }
+
+    StringRef objectFilePath = StringCreateCopy(cache->allocator, cache->buildDirectory);
+    StringAppendFormat(objectFilePath, "/%s.o", StringGetCharacters(moduleName));
+
+    struct stat objectFileStatus;
+    Bool exists = stat(StringGetCharacters(objectFilePath), &objectFileStatus) == 0;
+    StringDestroy(objectFilePath);
+
+    if (!exists) {
+        cache->statistics.missCount += 1;
+        return false;
+    }
+
+    cache->statistics.hitCount += 1;
+    return true;
+}
+
+void BuildCacheInsertModule(BuildCacheRef cache, StringRef moduleName, UInt64 fingerprint) {
+    BuildCacheEntry *entry = _BuildCacheLookupEntry(cache, moduleName, NULL);
+    if (entry) {
+        entry->fingerprint = fingerprint;
+        return;
+    }
+
+    BuildCacheEntry newEntry;
+    newEntry.moduleName  = StringCreateCopy(cache->allocator, moduleName);
+    newEntry.fingerprint = fingerprint;
+    ArrayAppendElement(cache->entries, &newEntry);
+}
+
+void BuildCacheRemoveModule(BuildCacheRef cache, StringRef moduleName) {
+    Index index            = 0;
+    BuildCacheEntry *entry = _BuildCacheLookupEntry(cache, moduleName, &index);
+    if (entry) {
+        StringDestroy(entry->moduleName);
+        ArrayRemoveElementAtIndex(cache->entries, index);
+    }
+}
+
+Bool BuildCacheWrite(BuildCacheRef cache) {
+    FILE *file = fopen(StringGetCharacters(cache->filePath), "w");
+    if (!file) {
+        return false;
+    }
+
+    fprintf(file, "jelly-build-cache %zu\n", _kBuildCacheVersion);
+    for (Index index = 0; index < ArrayGetElementCount(cache->entries); index++) {
+        BuildCacheEntry *entry = (BuildCacheEntry *)ArrayGetElementAtIndex(cache->entries, index);
+        fprintf(file, "%016llx %s\n", (unsigned long long)entry->fingerprint, StringGetCharacters(entry->moduleName));
+    }
+
+    fclose(file);
+    return true;
+}
+
+BuildCacheStatistics BuildCacheGetStatistics(BuildCacheRef cache) {
+    return cache->statistics;
+}
+
+static inline void _BuildCacheLoad(BuildCacheRef cache) {
+    StringRef content = StringCreateFromFile(cache->allocator, StringGetCharacters(cache->filePath));
+    if (!content) {
+        return;
+    }
+
+    const Char *cursor = StringGetCharacters(content);
+    Index version      = 0;
+    Int32 offset       = 0;
+    if (sscanf(cursor, "jelly-build-cache %zu\n%n", &version, &offset) < 1 || version != _kBuildCacheVersion) {
+        StringDestroy(content);
+        return;
+    }
+
+    cursor += offset;
+
+    Char moduleName[256];
+    unsigned long long fingerprint = 0;
+    while (sscanf(cursor, "%16llx %255s\n%n", &fingerprint, moduleName, &offset) == 2) {
+        StringRef name = StringCreate(cache->allocator, moduleName);
+        BuildCacheInsertModule(cache, name, fingerprint);
+        StringDestroy(name);
+        cursor += offset;
+    }
+
+    StringDestroy(content);
+}
+
+static inline BuildCacheEntry *_BuildCacheLookupEntry(BuildCacheRef cache, StringRef moduleName, Index *index) {
+    for (Index entryIndex = 0; entryIndex < ArrayGetElementCount(cache->entries); entryIndex++) {
+        BuildCacheEntry *entry = (BuildCacheEntry *)ArrayGetElementAtIndex(cache->entries, entryIndex);
+        if (StringIsEqual(entry->moduleName, moduleName)) {
+            if (index) {
+                *index = entryIndex;
+            }
+
+            return entry;
+        }
+    }
+
+    return NULL;
+}
@@ -1,16 +1,13 @@
 #include "JellyCore/BumpAllocator.h"
 
-// TODO: Add correct memory alignment and padding!
-
-const Index kBumpAllocatorDefaultPageCapacity = 65535;
+const Index kBumpAllocatorDefaultPageCapacity = 65536;
 
 struct _BumpAllocatorPage {
     struct _BumpAllocatorPage *next;
-    Index size;
     Index capacity;
     Index index;
     UInt8 *memory;
-} __attribute__((packed));
+};
 
 struct _BumpAllocatorContext {
     AllocatorRef allocator;
@@ -18,6 +15,8 @@ struct _BumpAllocatorContext {
     Index pageHeaderSize;
     struct _BumpAllocatorPage *firstPage;
     struct _BumpAllocatorPage *currentPage;
+    struct _BumpAllocatorPage *oversizedPages;
+    void *lastAllocation;
 };
 
 void *_AllocatorBump(AllocatorMode mode, Index capacity, void *memory, void *context);
@@ -25,6 +24,14 @@ void *_AllocatorBump(AllocatorMode mode, Index capacity, void *memory, void *con
 static inline Bool _IsPowerOfTwo(Index value);
 static inline Index _Align(Index value, Index alignment);
 
+static inline struct _BumpAllocatorContext *_BumpAllocatorGetContext(AllocatorRef allocator);
+static inline struct _BumpAllocatorPage *_BumpAllocatorPageCreate(struct _BumpAllocatorContext *context, Index capacity);
+static inline void *_BumpAllocatorPageAllocate(struct _BumpAllocatorPage *page, Index capacity, Index alignment);
+static inline void *_BumpAllocatorAllocate(struct _BumpAllocatorContext *context, Index capacity, Index alignment);
+static inline void *_BumpAllocatorReallocate(struct _BumpAllocatorContext *context, void *memory, Index capacity);
+static inline struct _BumpAllocatorPage *_BumpAllocatorFindPage(struct _BumpAllocatorPage *page, void *memory);
+static inline void _BumpAllocatorReleaseOversizedPages(struct _BumpAllocatorContext *context, struct _BumpAllocatorPage *lastPage);
+
 AllocatorRef BumpAllocatorCreate(AllocatorRef allocator) {
     struct _BumpAllocatorContext *context = AllocatorAllocate(allocator, sizeof(struct _BumpAllocatorContext));
     context->allocator                    = allocator;
@@ -32,52 +39,66 @@ AllocatorRef BumpAllocatorCreate(AllocatorRef allocator) {
     context->pageHeaderSize               = _Align(sizeof(struct _BumpAllocatorPage), context->alignment);
     context->firstPage                    = NULL;
     context->currentPage                  = NULL;
+    context->oversizedPages               = NULL;
+    context->lastAllocation               = NULL;
     return AllocatorCreate(allocator, &_AllocatorBump, context);
 }
 
+void *BumpAllocatorAllocateAligned(AllocatorRef allocator, Index capacity, Index alignment) {
+    assert(_IsPowerOfTwo(alignment));
+    return _BumpAllocatorAllocate(_BumpAllocatorGetContext(allocator), capacity, alignment);
+}
+
+BumpAllocatorMarker BumpAllocatorGetMarker(AllocatorRef allocator) {
+    struct _BumpAllocatorContext *context = _BumpAllocatorGetContext(allocator);
+    BumpAllocatorMarker marker;
+    marker.page          = context->currentPage;
+    marker.index         = context->currentPage ? context->currentPage->index : 0;
+    marker.oversizedPage = context->oversizedPages;
+    return marker;
+}
+
+void BumpAllocatorRewind(AllocatorRef allocator, BumpAllocatorMarker marker) {
+    struct _BumpAllocatorContext *context = _BumpAllocatorGetContext(allocator);
+    _BumpAllocatorReleaseOversizedPages(context, (struct _BumpAllocatorPage *)marker.oversizedPage);
+
+    // The pages following the marked page are kept and reused once the marked page is exhausted again
+    if (marker.page) {
+        context->currentPage        = (struct _BumpAllocatorPage *)marker.page;
+        context->currentPage->index = marker.index;
+    } else if (context->firstPage) {
+        context->currentPage        = context->firstPage;
+        context->currentPage->index = 0;
+    }
+
+    context->lastAllocation = NULL;
+}
+
+void BumpAllocatorReset(AllocatorRef allocator) {
+    BumpAllocatorMarker marker;
+    marker.page          = NULL;
+    marker.index         = 0;
+    marker.oversizedPage = NULL;
+    BumpAllocatorRewind(allocator, marker);
+}
+
 void *_AllocatorBump(AllocatorMode mode, Index capacity, void *memory, void *context) {
     struct _BumpAllocatorContext *bumpContext = context;
     assert(bumpContext);
 
     switch (mode) {
-    case AllocatorModeAllocate: {
-        if (bumpContext->firstPage == NULL) {
-            Index memoryCapacity            = MAX(kBumpAllocatorDefaultPageCapacity, capacity + bumpContext->pageHeaderSize);
-            memoryCapacity                  = _Align(memoryCapacity, bumpContext->alignment);
-            struct _BumpAllocatorPage *page = AllocatorAllocate(bumpContext->allocator, memoryCapacity);
-            page->size                      = memoryCapacity;
-            page->next                      = NULL;
-            page->capacity                  = memoryCapacity - bumpContext->pageHeaderSize;
-            page->index                     = 0;
-            page->memory                    = (UInt8 *)page + bumpContext->pageHeaderSize;
-            bumpContext->firstPage          = page;
-            bumpContext->currentPage        = page;
-        } else if (bumpContext->currentPage->index + capacity > bumpContext->currentPage->capacity) {
-            Index memoryCapacity            = MAX(kBumpAllocatorDefaultPageCapacity, capacity + bumpContext->pageHeaderSize);
-            memoryCapacity                  = _Align(memoryCapacity, bumpContext->alignment);
-            struct _BumpAllocatorPage *page = AllocatorAllocate(bumpContext->allocator, memoryCapacity);
-            page->size                      = memoryCapacity;
-            page->next                      = NULL;
-            page->capacity                  = memoryCapacity - bumpContext->pageHeaderSize;
-            page->index                     = 0;
-            page->memory                    = (UInt8 *)page + bumpContext->pageHeaderSize;
-            bumpContext->currentPage->next  = page;
-            bumpContext->currentPage        = page;
-        }
-
-        void *memory = bumpContext->currentPage->memory + sizeof(UInt8) * bumpContext->currentPage->index;
-        bumpContext->currentPage->index += capacity;
-        return memory;
-    }
+    case AllocatorModeAllocate:
+        return _BumpAllocatorAllocate(bumpContext, capacity, bumpContext->alignment);
 
     case AllocatorModeReallocate:
-        JELLY_UNREACHABLE("BumpAllocator doesn't support reallocation!");
-        return NULL;
+        return _BumpAllocatorReallocate(bumpContext, memory, capacity);
 
     case AllocatorModeDeallocate:
         return NULL;
 
     case AllocatorModeDestroy: {
+        _BumpAllocatorReleaseOversizedPages(bumpContext, NULL);
+
         struct _BumpAllocatorPage *page = bumpContext->firstPage;
         while (page) {
             struct _BumpAllocatorPage *next = page->next;
@@ -103,3 +124,111 @@ static inline Index _Align(Index value, Index alignment) {
 
     return (value + alignment - 1) & ~(alignment - 1);
 }
+
+static inline struct _BumpAllocatorContext *_BumpAllocatorGetContext(AllocatorRef allocator) {
+    struct _BumpAllocatorContext *context = AllocatorGetContext(allocator, &_AllocatorBump);
+    assert(context && "Allocator has not been created by BumpAllocatorCreate!");
+    return context;
+}
+
+static inline struct _BumpAllocatorPage *_BumpAllocatorPageCreate(struct _BumpAllocatorContext *context, Index capacity) {
+    struct _BumpAllocatorPage *page = AllocatorAllocate(context->allocator, context->pageHeaderSize + capacity);
+    assert(page);
+    page->next     = NULL;
+    page->capacity = capacity;
+    page->index    = 0;
+    page->memory   = (UInt8 *)page + context->pageHeaderSize;
+    return page;
+}
+
+static inline void *_BumpAllocatorPageAllocate(struct _BumpAllocatorPage *page, Index capacity, Index alignment) {
+    Index address = _Align((Index)(page->memory + page->index), alignment);
+    Index offset  = address - (Index)page->memory;
+    if (offset + capacity > page->capacity) {
+        return NULL;
+    }
+
+    page->index = offset + capacity;
+    return (void *)address;
+}
+
+static inline void *_BumpAllocatorAllocate(struct _BumpAllocatorContext *context, Index capacity, Index alignment) {
+    // Allocations larger than a quarter of a page are placed on separate pages to bound the unused tail of the regular pages
+    if (capacity + alignment > kBumpAllocatorDefaultPageCapacity / 4) {
+        struct _BumpAllocatorPage *page = _BumpAllocatorPageCreate(context, capacity + alignment);
+        page->next                      = context->oversizedPages;
+        context->oversizedPages         = page;
+        context->lastAllocation         = NULL;
+        return _BumpAllocatorPageAllocate(page, capacity, alignment);
+    }
+
+    if (!context->currentPage) {
+        context->firstPage   = _BumpAllocatorPageCreate(context, kBumpAllocatorDefaultPageCapacity - context->pageHeaderSize);
+        context->currentPage = context->firstPage;
+    }
+
+    void *memory = _BumpAllocatorPageAllocate(context->currentPage, capacity, alignment);
+    if (!memory) {
+        if (context->currentPage->next) {
+            context->currentPage        = context->currentPage->next;
+            context->currentPage->index = 0;
+        } else {
+            struct _BumpAllocatorPage *page = _BumpAllocatorPageCreate(context,
+                                                                       kBumpAllocatorDefaultPageCapacity - context->pageHeaderSize);
+            context->currentPage->next      = page;
+            context->currentPage            = page;
+        }
+
+        memory = _BumpAllocatorPageAllocate(context->currentPage, capacity, alignment);
+        assert(memory);
+    }
+
+    context->lastAllocation = memory;
+    return memory;
+}
+
+static inline void *_BumpAllocatorReallocate(struct _BumpAllocatorContext *context, void *memory, Index capacity) {
+    if (!memory) {
+        return _BumpAllocatorAllocate(context, capacity, context->alignment);
+    }
+
+    // The most recent allocation of the current page can grow in place
+    struct _BumpAllocatorPage *page = context->currentPage;
+    if (memory == context->lastAllocation && (UInt8 *)memory + capacity <= page->memory + page->capacity) {
+        page->index = (UInt8 *)memory + capacity - page->memory;
+        return memory;
+    }
+
+    // The size of the previous allocation is unknown, but all bytes up to the end of the used part of its page are readable
+    page = _BumpAllocatorFindPage(context->oversizedPages, memory);
+    if (!page) {
+        page = _BumpAllocatorFindPage(context->firstPage, memory);
+    }
+
+    assert(page && "Memory has not been allocated by this allocator!");
+    Index copyCapacity = MIN(capacity, (Index)(page->memory + page->index - (UInt8 *)memory));
+
+    void *newMemory = _BumpAllocatorAllocate(context, capacity, context->alignment);
+    memcpy(newMemory, memory, copyCapacity);
+    return newMemory;
+}
+
+static inline struct _BumpAllocatorPage *_BumpAllocatorFindPage(struct _BumpAllocatorPage *page, void *memory) {
+    while (page) {
+        if ((UInt8 *)memory >= page->memory && (UInt8 *)memory <= page->memory + page->index) {
+            return page;
+        }
+
+        page = page->next;
+    }
+
+    return NULL;
+}
+
+static inline void _BumpAllocatorReleaseOversizedPages(struct _BumpAllocatorContext *context, struct _BumpAllocatorPage *lastPage) {
+    while (context->oversizedPages && context->oversizedPages != lastPage) {
+        struct _BumpAllocatorPage *next = context->oversizedPages->next;
+        AllocatorDeallocate(context->allocator, context->oversizedPages);
+        context->oversizedPages = next;
+    }
+}
@@ -2,6 +2,7 @@
 #include "JellyCore/Allocator.h"
 #include "JellyCore/Compiler.h"
 #include "JellyCore/Diagnostic.h"
+#include "JellyCore/IRBuilder.h"
 #include "JellyCore/Workspace.h"
 
 #include <getopt.h>
@@ -21,14 +22,28 @@ Int CompilerRun(ArrayRef arguments) {
         argv[index]        = StringGetCharacters(argument);
     }
 
-    Int32 optionDumpAST          = 0;
-    Int32 optionDumpIR           = 0;
-    Int32 optionWorkingDirectory = 0;
-    Int32 optionModuleName       = 0;
-    Int32 optionTypeCheck        = 0;
-    StringRef dumpASTFilePath    = NULL;
-    StringRef workingDirectory   = NULL;
-    StringRef moduleName         = NULL;
+    Int32 optionDumpAST           = 0;
+    Int32 optionDumpIR            = 0;
+    Int32 optionWorkingDirectory  = 0;
+    Int32 optionModuleName        = 0;
+    Int32 optionTypeCheck         = 0;
+    Int32 optionJobs              = 0;
+    Int32 optionOptimizationLevel = 0;
+    Int32 optionNoCache           = 0;
+    Int32 optionCacheReport       = 0;
+    Int32 optionTimeReport        = 0;
+    Int32 optionTraceJSON         = 0;
+    Int32 optionMemoryReport      = 0;
+    Int32 optionDiagnosticsJSON   = 0;
+    Int32 optionTarget            = 0;
+    Index jobCount                = 1;
+    Bool isJobCountValid          = true;
+    const Char *invalidJobCount   = NULL;
+    StringRef dumpASTFilePath     = NULL;
+    StringRef workingDirectory    = NULL;
+    StringRef moduleName          = NULL;
+    StringRef traceFilePath       = NULL;
+    StringRef targetTriple        = NULL;
 
     struct option options[] = {
         {"dump-ast", optional_argument, &optionDumpAST, 1},
@@ -36,6 +51,19 @@ Int CompilerRun(ArrayRef arguments) {
         {"working-directory", required_argument, &optionWorkingDirectory, 1},
         {"module-name", optional_argument, &optionModuleName, 1},
         {"type-check", no_argument, &optionTypeCheck, 1},
+        {"jobs", required_argument, &optionJobs, 1},
+        {"O0", no_argument, &optionOptimizationLevel, 0},
+        {"O1", no_argument, &optionOptimizationLevel, 1},
+        {"O2", no_argument, &optionOptimizationLevel, 2},
+        {"O3", no_argument, &optionOptimizationLevel, 3},
+        {"Os", no_argument, &optionOptimizationLevel, 4},
+        {"no-cache", no_argument, &optionNoCache, 1},
+        {"cache-report", no_argument, &optionCacheReport, 1},
+        {"time-report", no_argument, &optionTimeReport, 1},
+        {"trace-json", required_argument, &optionTraceJSON, 1},
+        {"mem-report", no_argument, &optionMemoryReport, 1},
+        {"diagnostics-json", no_argument, &optionDiagnosticsJSON, 1},
+        {"target", required_argument, &optionTarget, 1},
         {0, 0, 0, 0},
     };
 
@@ -57,6 +85,26 @@ Int CompilerRun(ArrayRef arguments) {
             if (index == 3 && optarg) {
                 moduleName = StringCreate(AllocatorGetSystemDefault(), optarg);
             }
+
+            if (index == 5) {
+                Char *end = NULL;
+                Int value = strtol(optarg, &end, 10);
+                if (end == optarg || *end != '\0' || value < 1) {
+                    // The error is reported after the diagnostic engine of the workspace has been configured
+                    isJobCountValid = false;
+                    invalidJobCount = optarg;
+                } else {
+                    jobCount = value;
+                }
+            }
+
+            if (index == 14) {
+                traceFilePath = StringCreate(AllocatorGetSystemDefault(), optarg);
+            }
+
+            if (index == 17) {
+                targetTriple = StringCreate(AllocatorGetSystemDefault(), optarg);
+            }
             break;
 
         case '?':
@@ -79,6 +127,14 @@ Int CompilerRun(ArrayRef arguments) {
                 StringDestroy(moduleName);
             }
 
+            if (traceFilePath) {
+                StringDestroy(traceFilePath);
+            }
+
+            if (targetTriple) {
+                StringDestroy(targetTriple);
+            }
+
             AllocatorDeallocate(allocator, argv);
             return EXIT_FAILURE;
         }
@@ -103,6 +159,14 @@ Int CompilerRun(ArrayRef arguments) {
                 StringDestroy(moduleName);
             }
 
+            if (traceFilePath) {
+                StringDestroy(traceFilePath);
+            }
+
+            if (targetTriple) {
+                StringDestroy(targetTriple);
+            }
+
             AllocatorDeallocate(allocator, argv);
             return EXIT_FAILURE;
         }
@@ -121,6 +185,43 @@ Int CompilerRun(ArrayRef arguments) {
         workspaceOptions |= WorkspaceOptionsTypeCheck;
     }
 
+    if (optionNoCache) {
+        workspaceOptions |= WorkspaceOptionsNoCache;
+    }
+
+    if (optionCacheReport) {
+        workspaceOptions |= WorkspaceOptionsCacheReport;
+    }
+
+    if (optionTimeReport) {
+        workspaceOptions |= WorkspaceOptionsTimeReport;
+    }
+
+    if (optionMemoryReport) {
+        workspaceOptions |= WorkspaceOptionsMemoryReport;
+    }
+
+    switch (optionOptimizationLevel) {
+    case 1:
+        workspaceOptions |= WorkspaceOptionsOptimizeLess;
+        break;
+
+    case 2:
+        workspaceOptions |= WorkspaceOptionsOptimizeDefault;
+        break;
+
+    case 3:
+        workspaceOptions |= WorkspaceOptionsOptimizeAggressive;
+        break;
+
+    case 4:
+        workspaceOptions |= WorkspaceOptionsOptimizeSize;
+        break;
+
+    default:
+        break;
+    }
+
     StringRef buildDirectory = StringCreateCopy(AllocatorGetSystemDefault(), workingDirectory);
     StringAppend(buildDirectory, "/build");
 
@@ -130,6 +231,30 @@ Int CompilerRun(ArrayRef arguments) {
 
     WorkspaceRef workspace = WorkspaceCreate(AllocatorGetSystemDefault(), workingDirectory, buildDirectory, moduleName, workspaceOptions);
 
+    if (optionDiagnosticsJSON) {
+        DiagnosticEngineSetHandler(WorkspaceGetDiagnosticEngine(workspace), &DiagnosticHandlerJSON, stderr);
+    }
+
+    // Invalid options are reported through the engine of the workspace to respect the configured diagnostic format
+    DiagnosticEngineRef previousEngine = DiagnosticEngineGetCurrent();
+    DiagnosticEngineSetCurrent(WorkspaceGetDiagnosticEngine(workspace));
+
+    if (isJobCountValid) {
+        WorkspaceSetJobCount(workspace, jobCount);
+    } else {
+        ReportErrorFormat("Invalid job count '%s' expected a positive integer", invalidJobCount);
+    }
+
+    Bool isTargetSupported = true;
+    if (targetTriple) {
+        isTargetSupported = IRBuilderIsTargetTripleSupported(targetTriple);
+        if (isTargetSupported) {
+            WorkspaceSetTargetTriple(workspace, targetTriple);
+        } else {
+            ReportErrorFormat("Unsupported target triple '%s'", StringGetCharacters(targetTriple));
+        }
+    }
+
     FILE *dumpASTOutput = NULL;
     if (dumpASTFilePath) {
         dumpASTOutput = fopen(StringGetCharacters(dumpASTFilePath), "w");
@@ -137,6 +262,18 @@ Int CompilerRun(ArrayRef arguments) {
         WorkspaceSetDumpASTOutput(workspace, dumpASTOutput);
     }
 
+    FILE *traceOutput = NULL;
+    if (traceFilePath) {
+        traceOutput = fopen(StringGetCharacters(traceFilePath), "w");
+        if (traceOutput) {
+            WorkspaceSetTraceOutput(workspace, traceOutput);
+        } else {
+            ReportErrorFormat("Couldn't open trace file at path: '%s'", StringGetCharacters(traceFilePath));
+        }
+    }
+
+    DiagnosticEngineSetCurrent(previousEngine);
+
     if (optind < argc) {
         StringRef filePath = StringCreate(AllocatorGetSystemDefault(), argv[optind]);
         WorkspaceAddSourceFile(workspace, filePath);
@@ -144,8 +281,11 @@ Int CompilerRun(ArrayRef arguments) {
         optind += 1;
     }
 
-    WorkspaceStartAsync(workspace);
-    WorkspaceWaitForFinish(workspace);
+    if (isJobCountValid && isTargetSupported) {
+        WorkspaceStartAsync(workspace);
+        WorkspaceWaitForFinish(workspace);
+    }
+
     WorkspaceDestroy(workspace);
 
     if (dumpASTOutput) {
@@ -156,9 +296,21 @@ Int CompilerRun(ArrayRef arguments) {
         StringDestroy(dumpASTFilePath);
     }
 
+    if (traceOutput) {
+        fclose(traceOutput);
+    }
+
+    if (traceFilePath) {
+        StringDestroy(traceFilePath);
+    }
+
+    if (targetTriple) {
+        StringDestroy(targetTriple);
+    }
+
     StringDestroy(moduleName);
     StringDestroy(buildDirectory);
     StringDestroy(workingDirectory);
     AllocatorDeallocate(allocator, argv);
-    return EXIT_SUCCESS;
+    return isJobCountValid && isTargetSupported ? EXIT_SUCCESS : EXIT_FAILURE;
 }
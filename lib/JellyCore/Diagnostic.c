@@ -1,154 +1,385 @@
+#include "JellyCore/Array.h"
 #include "JellyCore/Diagnostic.h"
+#include "JellyCore/JSONWriter.h"
+
+#include <pthread.h>
+
+// Messages up to this length are formatted on the stack, longer messages are formatted into a buffer of the exact size
+#define _kDiagnosticFormatBufferCapacity 512
+
+struct _DiagnosticMessage {
+    DiagnosticLevel level;
+    SourceRange location;
+    StringRef message;
+};
+typedef struct _DiagnosticMessage DiagnosticMessage;
+
+struct _DiagnosticStagingBuffer {
+    DiagnosticEngineRef engine;
+    Index order;
+    ArrayRef messages;
+};
+typedef struct _DiagnosticStagingBuffer DiagnosticStagingBuffer;
+
+struct _DiagnosticSource {
+    StringRef filePath;
+    SourceBufferRef source;
+};
+typedef struct _DiagnosticSource DiagnosticSource;
 
 struct _DiagnosticEngine {
+    AllocatorRef allocator;
     DiagnosticHandler handler;
     void *context;
-    Char formatBuffer[65535];
     Index messageCount[DIAGNOSTIC_LEVEL_COUNT];
+    ArrayRef stagedBuffers;
+    ArrayRef sources;
+    pthread_mutex_t mutex;
 };
 
-void _DiagnosticHandlerStd(DiagnosticLevel level, const Char *message, void *context);
+void _DiagnosticHandlerStd(const Diagnostic *diagnostic, void *context);
 
-void _ReportDiagnostic(DiagnosticLevel level, const Char *message);
+void _ReportDiagnostic(DiagnosticLevel level, SourceRange location, const Char *message);
+void _ReportDiagnosticFormat(DiagnosticLevel level, SourceRange location, const Char *format, va_list argumentPointer);
 
-static struct _DiagnosticEngine kSharedDiagnosticEngine = {&_DiagnosticHandlerStd, NULL};
+static inline AllocatorRef _DiagnosticEngineGetAllocator(DiagnosticEngineRef engine);
+static inline void _DiagnosticEngineEmit(DiagnosticEngineRef engine, DiagnosticLevel level, SourceRange location, const Char *message);
+static inline Bool _DiagnosticStagingBufferIsOrderedAscending(const void *lhs, const void *rhs);
+static inline void _DiagnosticStagingBufferDestroy(DiagnosticStagingBuffer *buffer);
 
-void DiagnosticEngineSetDefaultHandler(DiagnosticHandler handler, void *context) {
+static struct _DiagnosticEngine kSharedDiagnosticEngine = {
+    NULL, &_DiagnosticHandlerStd, NULL, {0}, NULL, NULL, PTHREAD_MUTEX_INITIALIZER,
+};
+
+static JELLY_THREAD_LOCAL DiagnosticEngineRef _kDiagnosticEngineCurrent      = NULL;
+static JELLY_THREAD_LOCAL DiagnosticStagingBuffer *_kDiagnosticStagingBuffer = NULL;
+
+DiagnosticEngineRef DiagnosticEngineCreate(AllocatorRef allocator) {
+    DiagnosticEngineRef engine = AllocatorAllocate(allocator, sizeof(struct _DiagnosticEngine));
+    engine->allocator          = allocator;
+    engine->stagedBuffers      = ArrayCreateEmpty(allocator, sizeof(DiagnosticStagingBuffer *), 8);
+    engine->sources            = ArrayCreateEmpty(allocator, sizeof(DiagnosticSource), 8);
+    pthread_mutex_init(&engine->mutex, NULL);
+    DiagnosticEngineResetMessageCounts(engine);
+
+    pthread_mutex_lock(&kSharedDiagnosticEngine.mutex);
+    engine->handler = kSharedDiagnosticEngine.handler;
+    engine->context = kSharedDiagnosticEngine.context;
+    pthread_mutex_unlock(&kSharedDiagnosticEngine.mutex);
+    return engine;
+}
+
+void DiagnosticEngineDestroy(DiagnosticEngineRef engine) {
+    assert(engine != &kSharedDiagnosticEngine);
+    assert(_kDiagnosticEngineCurrent != engine);
+
+    DiagnosticEngineFlush(engine);
+    for (Index index = 0; index < ArrayGetElementCount(engine->sources); index++) {
+        DiagnosticSource *source = (DiagnosticSource *)ArrayGetElementAtIndex(engine->sources, index);
+        StringDestroy(source->filePath);
+    }
+
+    ArrayDestroy(engine->sources);
+    ArrayDestroy(engine->stagedBuffers);
+    pthread_mutex_destroy(&engine->mutex);
+    AllocatorDeallocate(engine->allocator, engine);
+}
+
+DiagnosticEngineRef DiagnosticEngineGetDefault(void) {
+    return &kSharedDiagnosticEngine;
+}
+
+DiagnosticEngineRef DiagnosticEngineGetCurrent(void) {
+    if (_kDiagnosticEngineCurrent) {
+        return _kDiagnosticEngineCurrent;
+    }
+
+    return &kSharedDiagnosticEngine;
+}
+
+void DiagnosticEngineSetCurrent(DiagnosticEngineRef engine) {
+    if (engine == &kSharedDiagnosticEngine) {
+        engine = NULL;
+    }
+
+    _kDiagnosticEngineCurrent = engine;
+}
+
+void DiagnosticEngineSetHandler(DiagnosticEngineRef engine, DiagnosticHandler handler, void *context) {
+    pthread_mutex_lock(&engine->mutex);
     if (handler) {
-        kSharedDiagnosticEngine.handler = handler;
+        engine->handler = handler;
     } else {
-        kSharedDiagnosticEngine.handler = &_DiagnosticHandlerStd;
+        engine->handler = &_DiagnosticHandlerStd;
+    }
+
+    engine->context = context;
+    pthread_mutex_unlock(&engine->mutex);
+}
+
+void DiagnosticEngineSetDefaultHandler(DiagnosticHandler handler, void *context) {
+    DiagnosticEngineSetHandler(&kSharedDiagnosticEngine, handler, context);
+}
+
+void DiagnosticEngineAddSource(DiagnosticEngineRef engine, StringRef filePath, SourceBufferRef source) {
+    pthread_mutex_lock(&engine->mutex);
+    if (!engine->sources) {
+        engine->sources = ArrayCreateEmpty(_DiagnosticEngineGetAllocator(engine), sizeof(DiagnosticSource), 8);
     }
 
-    kSharedDiagnosticEngine.context = context;
+    DiagnosticSource entry;
+    entry.filePath = StringCreateCopy(_DiagnosticEngineGetAllocator(engine), filePath);
+    entry.source   = source;
+    ArrayAppendElement(engine->sources, &entry);
+    pthread_mutex_unlock(&engine->mutex);
 }
 
-void DiagnosticEngineResetMessageCounts() {
+void DiagnosticEngineResetMessageCounts(DiagnosticEngineRef engine) {
     for (Index level = 0; level < DIAGNOSTIC_LEVEL_COUNT; level++) {
-        kSharedDiagnosticEngine.messageCount[level] = 0;
+        __atomic_store_n(&engine->messageCount[level], 0, __ATOMIC_RELAXED);
+    }
+}
+
+Index DiagnosticEngineGetMessageCount(DiagnosticEngineRef engine, DiagnosticLevel level) {
+    return __atomic_load_n(&engine->messageCount[level], __ATOMIC_RELAXED);
+}
+
+Bool DiagnosticEngineHasErrors(DiagnosticEngineRef engine) {
+    return DiagnosticEngineGetMessageCount(engine, DiagnosticLevelError) > 0 ||
+           DiagnosticEngineGetMessageCount(engine, DiagnosticLevelCritical) > 0;
+}
+
+void DiagnosticEngineBeginStaging(DiagnosticEngineRef engine, Index order) {
+    assert(!_kDiagnosticStagingBuffer);
+
+    AllocatorRef allocator          = _DiagnosticEngineGetAllocator(engine);
+    DiagnosticStagingBuffer *buffer = AllocatorAllocate(allocator, sizeof(DiagnosticStagingBuffer));
+    buffer->engine                  = engine;
+    buffer->order                   = order;
+    buffer->messages                = ArrayCreateEmpty(allocator, sizeof(DiagnosticMessage), 8);
+    _kDiagnosticStagingBuffer       = buffer;
+}
+
+void DiagnosticEngineEndStaging(DiagnosticEngineRef engine) {
+    DiagnosticStagingBuffer *buffer = _kDiagnosticStagingBuffer;
+    assert(buffer && buffer->engine == engine);
+    _kDiagnosticStagingBuffer = NULL;
+
+    if (ArrayGetElementCount(buffer->messages) < 1) {
+        _DiagnosticStagingBufferDestroy(buffer);
+        return;
+    }
+
+    pthread_mutex_lock(&engine->mutex);
+    if (!engine->stagedBuffers) {
+        engine->stagedBuffers = ArrayCreateEmpty(_DiagnosticEngineGetAllocator(engine), sizeof(DiagnosticStagingBuffer *), 8);
     }
+
+    Index index = ArrayGetSortedInsertionIndex(engine->stagedBuffers, &_DiagnosticStagingBufferIsOrderedAscending, &buffer);
+    ArrayInsertElementAtIndex(engine->stagedBuffers, index, &buffer);
+    pthread_mutex_unlock(&engine->mutex);
 }
 
-Index DiagnosticEngineGetMessageCount(DiagnosticLevel level) {
-    return kSharedDiagnosticEngine.messageCount[level];
+void DiagnosticEngineFlush(DiagnosticEngineRef engine) {
+    pthread_mutex_lock(&engine->mutex);
+    if (!engine->stagedBuffers) {
+        pthread_mutex_unlock(&engine->mutex);
+        return;
+    }
+
+    for (Index bufferIndex = 0; bufferIndex < ArrayGetElementCount(engine->stagedBuffers); bufferIndex++) {
+        DiagnosticStagingBuffer *buffer = *(DiagnosticStagingBuffer **)ArrayGetElementAtIndex(engine->stagedBuffers, bufferIndex);
+        for (Index index = 0; index < ArrayGetElementCount(buffer->messages); index++) {
+            DiagnosticMessage *message = (DiagnosticMessage *)ArrayGetElementAtIndex(buffer->messages, index);
+            _DiagnosticEngineEmit(engine, message->level, message->location, StringGetCharacters(message->message));
+        }
+
+        _DiagnosticStagingBufferDestroy(buffer);
+    }
+
+    ArrayRemoveAllElements(engine->stagedBuffers, true);
+    pthread_mutex_unlock(&engine->mutex);
 }
 
 void ReportDebug(const Char *message) {
-    _ReportDiagnostic(DiagnosticLevelDebug, message);
+    _ReportDiagnostic(DiagnosticLevelDebug, SourceRangeNull(), message);
 }
 
 void ReportDebugString(StringRef message) {
-    _ReportDiagnostic(DiagnosticLevelDebug, StringGetCharacters(message));
+    _ReportDiagnostic(DiagnosticLevelDebug, SourceRangeNull(), StringGetCharacters(message));
 }
 
 void ReportDebugFormat(const Char *format, ...) {
     va_list argumentPointer;
     va_start(argumentPointer, format);
-    vsprintf(&kSharedDiagnosticEngine.formatBuffer[0], format, argumentPointer);
+    _ReportDiagnosticFormat(DiagnosticLevelDebug, SourceRangeNull(), format, argumentPointer);
     va_end(argumentPointer);
-
-    ReportError(&kSharedDiagnosticEngine.formatBuffer[0]);
 }
 
 void ReportInfo(const Char *message) {
-    _ReportDiagnostic(DiagnosticLevelInfo, message);
+    _ReportDiagnostic(DiagnosticLevelInfo, SourceRangeNull(), message);
 }
 
 void ReportInfoString(StringRef message) {
-    _ReportDiagnostic(DiagnosticLevelInfo, StringGetCharacters(message));
+    _ReportDiagnostic(DiagnosticLevelInfo, SourceRangeNull(), StringGetCharacters(message));
 }
 
 void ReportInfoFormat(const Char *format, ...) {
     va_list argumentPointer;
     va_start(argumentPointer, format);
-    vsprintf(&kSharedDiagnosticEngine.formatBuffer[0], format, argumentPointer);
+    _ReportDiagnosticFormat(DiagnosticLevelInfo, SourceRangeNull(), format, argumentPointer);
     va_end(argumentPointer);
-
-    _ReportDiagnostic(DiagnosticLevelInfo, &kSharedDiagnosticEngine.formatBuffer[0]);
 }
 
 void ReportWarning(const Char *message) {
-    _ReportDiagnostic(DiagnosticLevelWarning, message);
+    _ReportDiagnostic(DiagnosticLevelWarning, SourceRangeNull(), message);
 }
 
 void ReportWarningString(StringRef message) {
-    _ReportDiagnostic(DiagnosticLevelWarning, StringGetCharacters(message));
+    _ReportDiagnostic(DiagnosticLevelWarning, SourceRangeNull(), StringGetCharacters(message));
 }
 
 void ReportWarningFormat(const Char *format, ...) {
     va_list argumentPointer;
     va_start(argumentPointer, format);
-    vsprintf(&kSharedDiagnosticEngine.formatBuffer[0], format, argumentPointer);
+    _ReportDiagnosticFormat(DiagnosticLevelWarning, SourceRangeNull(), format, argumentPointer);
     va_end(argumentPointer);
+}
 
-    _ReportDiagnostic(DiagnosticLevelWarning, &kSharedDiagnosticEngine.formatBuffer[0]);
+void ReportWarningAt(SourceRange location, const Char *format, ...) {
+    va_list argumentPointer;
+    va_start(argumentPointer, format);
+    _ReportDiagnosticFormat(DiagnosticLevelWarning, location, format, argumentPointer);
+    va_end(argumentPointer);
 }
 
 void ReportError(const Char *message) {
-    _ReportDiagnostic(DiagnosticLevelError, message);
+    _ReportDiagnostic(DiagnosticLevelError, SourceRangeNull(), message);
 }
 
 void ReportErrorString(StringRef message) {
-    _ReportDiagnostic(DiagnosticLevelError, StringGetCharacters(message));
+    _ReportDiagnostic(DiagnosticLevelError, SourceRangeNull(), StringGetCharacters(message));
 }
 
 void ReportErrorFormat(const Char *format, ...) {
     va_list argumentPointer;
     va_start(argumentPointer, format);
-    vsprintf(kSharedDiagnosticEngine.formatBuffer, format, argumentPointer);
+    _ReportDiagnosticFormat(DiagnosticLevelError, SourceRangeNull(), format, argumentPointer);
     va_end(argumentPointer);
+}
 
-    _ReportDiagnostic(DiagnosticLevelError, &kSharedDiagnosticEngine.formatBuffer[0]);
+void ReportErrorAt(SourceRange location, const Char *format, ...) {
+    va_list argumentPointer;
+    va_start(argumentPointer, format);
+    _ReportDiagnosticFormat(DiagnosticLevelError, location, format, argumentPointer);
+    va_end(argumentPointer);
 }
 
 void ReportCritical(const Char *message) {
-    _ReportDiagnostic(DiagnosticLevelCritical, message);
+    _ReportDiagnostic(DiagnosticLevelCritical, SourceRangeNull(), message);
 }
 
 void ReportCriticalString(StringRef message) {
-    _ReportDiagnostic(DiagnosticLevelCritical, StringGetCharacters(message));
+    _ReportDiagnostic(DiagnosticLevelCritical, SourceRangeNull(), StringGetCharacters(message));
 }
 
 void ReportCriticalFormat(const Char *format, ...) {
     va_list argumentPointer;
     va_start(argumentPointer, format);
-    vsprintf(&kSharedDiagnosticEngine.formatBuffer[0], format, argumentPointer);
+    _ReportDiagnosticFormat(DiagnosticLevelCritical, SourceRangeNull(), format, argumentPointer);
     va_end(argumentPointer);
+}
 
-    _ReportDiagnostic(DiagnosticLevelCritical, &kSharedDiagnosticEngine.formatBuffer[0]);
+void DiagnosticHandlerJSON(const Diagnostic *diagnostic, void *context) {
+    static const Char *levels[DIAGNOSTIC_LEVEL_COUNT] = {"debug", "info", "warning", "error", "critical"};
+
+    FILE *output = context ? (FILE *)context : stderr;
+    fprintf(output, "{\"level\":\"%s\",\"message\":", levels[diagnostic->level]);
+    JSONWriteString(output, diagnostic->message);
+    if (diagnostic->filePath) {
+        fputs(",\"file\":", output);
+        JSONWriteString(output, diagnostic->filePath);
+        fprintf(output, ",\"line\":%zu,\"column\":%zu", diagnostic->line, diagnostic->column);
+    }
+
+    fputs("}\n", output);
 }
 
-void _DiagnosticHandlerStd(DiagnosticLevel level, const Char *message, void *context) {
-    switch (level) {
+void _DiagnosticHandlerStd(const Diagnostic *diagnostic, void *context) {
+    FILE *output       = stdout;
+    const Char *prefix = NULL;
+    switch (diagnostic->level) {
     case DiagnosticLevelDebug:
-        fprintf(stdout, "[DEBUG] %s\n", message);
+        prefix = "[DEBUG]";
         break;
 
     case DiagnosticLevelInfo:
-        fprintf(stdout, "[INFO] %s\n", message);
+        prefix = "[INFO]";
         break;
 
     case DiagnosticLevelWarning:
-        fprintf(stdout, "[WARNING] %s\n", message);
+        prefix = "[WARNING]";
         break;
 
     case DiagnosticLevelError:
-        fprintf(stderr, "[ERROR] %s\n", message);
+        output = stderr;
+        prefix = "[ERROR]";
         break;
 
     case DiagnosticLevelCritical:
-        fprintf(stderr, "[CRITICAL] %s\n", message);
+        output = stderr;
+        prefix = "[CRITICAL]";
         break;
 
     default:
         JELLY_UNREACHABLE("Unknown diagnostic level!");
     }
+
+    if (diagnostic->filePath) {
+        fprintf(output, "%s %s:%zu:%zu: %s\n", prefix, diagnostic->filePath, diagnostic->line, diagnostic->column, diagnostic->message);
+    } else {
+        fprintf(output, "%s %s\n", prefix, diagnostic->message);
+    }
 }
 
-void _ReportDiagnostic(DiagnosticLevel level, const Char *message) {
-    assert(kSharedDiagnosticEngine.handler);
-    kSharedDiagnosticEngine.handler(level, message, kSharedDiagnosticEngine.context);
-    kSharedDiagnosticEngine.messageCount[level] += 1;
+void _ReportDiagnostic(DiagnosticLevel level, SourceRange location, const Char *message) {
+    DiagnosticEngineRef engine = DiagnosticEngineGetCurrent();
+    __atomic_add_fetch(&engine->messageCount[level], 1, __ATOMIC_RELAXED);
+
+    DiagnosticStagingBuffer *buffer = _kDiagnosticStagingBuffer;
+    if (buffer && buffer->engine == engine) {
+        DiagnosticMessage stagedMessage;
+        stagedMessage.level    = level;
+        stagedMessage.location = location;
+        stagedMessage.message  = StringCreate(_DiagnosticEngineGetAllocator(engine), message);
+        ArrayAppendElement(buffer->messages, &stagedMessage);
+        return;
+    }
+
+    pthread_mutex_lock(&engine->mutex);
+    _DiagnosticEngineEmit(engine, level, location, message);
+    pthread_mutex_unlock(&engine->mutex);
+}
+
+void _ReportDiagnosticFormat(DiagnosticLevel level, SourceRange location, const Char *format, va_list argumentPointer) {
+    va_list argumentPointerCopy;
+    va_copy(argumentPointerCopy, argumentPointer);
+
+    Char buffer[_kDiagnosticFormatBufferCapacity];
+    Int length = vsnprintf(buffer, _kDiagnosticFormatBufferCapacity, format, argumentPointer);
+    assert(length >= 0);
+
+    if (length < _kDiagnosticFormatBufferCapacity) {
+        _ReportDiagnostic(level, location, buffer);
+    } else {
+        AllocatorRef allocator = _DiagnosticEngineGetAllocator(DiagnosticEngineGetCurrent());
+        Char *message          = AllocatorAllocate(allocator, sizeof(Char) * (length + 1));
+        vsnprintf(message, length + 1, format, argumentPointerCopy);
+        _ReportDiagnostic(level, location, message);
+        AllocatorDeallocate(allocator, message);
+    }
+
+    va_end(argumentPointerCopy);
 }
 
 void FatalError(const Char *message) {
@@ -156,3 +387,50 @@ void FatalError(const Char *message) {
     ReportInfo(message);
     exit(EXIT_FAILURE);
 }
+
+static inline AllocatorRef _DiagnosticEngineGetAllocator(DiagnosticEngineRef engine) {
+    if (engine->allocator) {
+        return engine->allocator;
+    }
+
+    return AllocatorGetSystemDefault();
+}
+
+/// Resolves the location of the diagnostic and passes it to the handler, has to be called while holding the lock of the engine.
+static inline void _DiagnosticEngineEmit(DiagnosticEngineRef engine, DiagnosticLevel level, SourceRange location, const Char *message) {
+    Diagnostic diagnostic;
+    diagnostic.level    = level;
+    diagnostic.message  = message;
+    diagnostic.location = location;
+    diagnostic.filePath = NULL;
+    diagnostic.line     = 0;
+    diagnostic.column   = 0;
+
+    if (location.start && engine->sources) {
+        for (Index index = 0; index < ArrayGetElementCount(engine->sources); index++) {
+            DiagnosticSource *source = (DiagnosticSource *)ArrayGetElementAtIndex(engine->sources, index);
+            if (SourceBufferGetLineAndColumn(source->source, location.start, &diagnostic.line, &diagnostic.column)) {
+                diagnostic.filePath = StringGetCharacters(source->filePath);
+                break;
+            }
+        }
+    }
+
+    assert(engine->handler);
+    engine->handler(&diagnostic, engine->context);
+}
+
+static inline Bool _DiagnosticStagingBufferIsOrderedAscending(const void *lhs, const void *rhs) {
+    return (*(DiagnosticStagingBuffer **)lhs)->order < (*(DiagnosticStagingBuffer **)rhs)->order;
+}
+
+static inline void _DiagnosticStagingBufferDestroy(DiagnosticStagingBuffer *buffer) {
+    AllocatorRef allocator = _DiagnosticEngineGetAllocator(buffer->engine);
+    for (Index index = 0; index < ArrayGetElementCount(buffer->messages); index++) {
+        DiagnosticMessage *message = (DiagnosticMessage *)ArrayGetElementAtIndex(buffer->messages, index);
+        StringDestroy(message->message);
+    }
+
+    ArrayDestroy(buffer->messages);
+    AllocatorDeallocate(allocator, buffer);
+}
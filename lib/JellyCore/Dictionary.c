@@ -1,17 +1,29 @@
 #include "JellyCore/Dictionary.h"
-#include "JellyCore/TempAllocator.h"
 
-const Index _kDictionaryBufferDefaultCapacity = 65535;
-const Float32 _kDictionaryBufferGrowthFactor  = 1.5;
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
-struct _DictionaryBucket {
+// The table is using open addressing with one control byte per slot, the control bytes are probed in groups of
+// `_kDictionaryGroupWidth` and a group is matched at once using SSE2 if available. The first group of control bytes is
+// mirrored behind the last slot so that a group can always be loaded with a single unaligned read.
+
+const Index _kDictionaryGroupWidth            = 16;
+const Index _kDictionaryMinimumCapacity       = 16;
+const Index _kDictionaryBufferMinimumCapacity = 256;
+const Index _kDictionaryElementAlignment      = 8;
+const UInt8 _kDictionaryControlEmpty          = 0x80;
+const UInt8 _kDictionaryControlDeleted        = 0xFE;
+
+struct _DictionarySlot {
     UInt64 hash;
     Index keyOffset;
+    Index keySize;
     Index elementOffset;
-    Bool isFilled;
-    struct _DictionaryBucket *next;
+    Index elementSize;
+    Index elementCapacity;
 };
-typedef struct _DictionaryBucket *DictionaryBucketRef;
+typedef struct _DictionarySlot DictionarySlot;
 
 struct _DictionaryBuffer {
     Index offset;
@@ -22,43 +34,63 @@ typedef struct _DictionaryBuffer DictionaryBuffer;
 
 struct _Dictionary {
     AllocatorRef allocator;
-    AllocatorRef bucketAllocator;
     DictionaryKeyComparator comparator;
     DictionaryKeyHasher hasher;
     DictionaryKeySizeCallback keySizeCallback;
     DictionaryBuffer keyBuffer;
     DictionaryBuffer elementBuffer;
+    Index garbageSize;
     Index capacity;
     Index elementCount;
-    DictionaryBucketRef *buckets;
+    Index deletedCount;
+    UInt8 *controls;
+    DictionarySlot *slots;
 };
 
-static inline void _DictionaryBufferInit(DictionaryRef dictionary, DictionaryBuffer *buffer);
+static inline UInt64 _DictionaryHash(DictionaryRef dictionary, const void *key);
+static inline UInt8 _DictionaryHashControl(UInt64 hash);
+static inline Index _DictionaryHashIndex(DictionaryRef dictionary, UInt64 hash);
+static inline UInt32 _DictionaryGroupMatch(const UInt8 *group, UInt8 control);
+static inline UInt32 _DictionaryGroupMatchEmptyOrDeleted(const UInt8 *group);
+static inline UInt32 _DictionaryGroupMatchEmpty(const UInt8 *group);
+static inline void _DictionarySetControl(DictionaryRef dictionary, Index index, UInt8 control);
+static inline void _DictionaryAllocateTable(DictionaryRef dictionary, Index capacity);
+static inline Index _DictionaryFindSlot(DictionaryRef dictionary, const void *key, UInt64 hash);
+static inline Index _DictionaryFindInsertionSlot(DictionaryRef dictionary, UInt64 hash);
+static inline void _DictionaryRehash(DictionaryRef dictionary, Index capacity);
+static inline void _DictionaryCollectGarbageIfNeeded(DictionaryRef dictionary);
+
+static inline void _DictionaryBufferInit(DictionaryRef dictionary, DictionaryBuffer *buffer, Index capacity);
 static inline void _DictionaryBufferReserveCapacity(DictionaryRef dictionary, DictionaryBuffer *buffer, Index capacity);
 static inline void *_DictionaryBufferGetElement(DictionaryRef dictionary, DictionaryBuffer *buffer, Index offset);
 static inline Index _DictionaryBufferInsertElement(DictionaryRef dictionary, DictionaryBuffer *buffer, const void *element,
-                                                   Index elementSize);
+                                                   Index elementSize, Index alignment);
 static inline void _DictionaryBufferDeinit(DictionaryRef dictionary, DictionaryBuffer *buffer);
 
+static inline Index _Align(Index value, Index alignment);
+
 Bool _CStringDictionaryKeyComparator(const void *lhs, const void *rhs);
 UInt64 _CStringDictionaryKeyHasher(const void *key);
 void *_CStringDictionaryKeySizeCallback(const void *key);
 
 DictionaryRef DictionaryCreate(AllocatorRef allocator, DictionaryKeyComparator comparator, DictionaryKeyHasher hasher,
                                DictionaryKeySizeCallback keySizeCallback, Index capacity) {
-    DictionaryRef dictionary    = (DictionaryRef)AllocatorAllocate(allocator,
-                                                                sizeof(struct _Dictionary) + sizeof(struct _DictionaryBucket) * capacity);
+    Index slotCapacity = _kDictionaryMinimumCapacity;
+    while (slotCapacity * 7 < capacity * 8) {
+        slotCapacity *= 2;
+    }
+
+    DictionaryRef dictionary    = (DictionaryRef)AllocatorAllocate(allocator, sizeof(struct _Dictionary));
     dictionary->allocator       = allocator;
-    dictionary->bucketAllocator = TempAllocatorCreate(allocator);
     dictionary->comparator      = comparator;
     dictionary->hasher          = hasher;
     dictionary->keySizeCallback = keySizeCallback;
-    dictionary->capacity        = capacity;
+    dictionary->garbageSize     = 0;
     dictionary->elementCount    = 0;
-    dictionary->buckets         = (DictionaryBucketRef *)(((UInt8 *)dictionary) + sizeof(struct _Dictionary));
-    memset(dictionary->buckets, 0, sizeof(struct _DictionaryBucket) * capacity);
-    _DictionaryBufferInit(dictionary, &dictionary->keyBuffer);
-    _DictionaryBufferInit(dictionary, &dictionary->elementBuffer);
+    dictionary->deletedCount    = 0;
+    _DictionaryAllocateTable(dictionary, slotCapacity);
+    _DictionaryBufferInit(dictionary, &dictionary->keyBuffer, _kDictionaryBufferMinimumCapacity);
+    _DictionaryBufferInit(dictionary, &dictionary->elementBuffer, _kDictionaryBufferMinimumCapacity);
     return dictionary;
 }
 
@@ -68,9 +100,10 @@ DictionaryRef CStringDictionaryCreate(AllocatorRef allocator, Index capacity) {
 }
 
 void DictionaryDestroy(DictionaryRef dictionary) {
-    AllocatorDestroy(dictionary->bucketAllocator);
     _DictionaryBufferDeinit(dictionary, &dictionary->elementBuffer);
     _DictionaryBufferDeinit(dictionary, &dictionary->keyBuffer);
+    AllocatorDeallocate(dictionary->allocator, dictionary->controls);
+    AllocatorDeallocate(dictionary->allocator, dictionary->slots);
     AllocatorDeallocate(dictionary->allocator, dictionary);
 }
 
@@ -79,104 +112,273 @@ void DictionaryInsert(DictionaryRef dictionary, const void *key, const void *ele
         return DictionaryRemove(dictionary, key);
     }
 
-    UInt64 hash                = dictionary->hasher(key);
-    Index index                = hash % dictionary->capacity;
-    DictionaryBucketRef bucket = (DictionaryBucketRef)(((UInt8 *)dictionary->buckets) + sizeof(struct _DictionaryBucket) * index);
-    while (bucket && bucket->isFilled) {
-        const void *bucketKey = _DictionaryBufferGetElement(dictionary, &dictionary->keyBuffer, bucket->keyOffset);
-        if (bucket->hash == hash && dictionary->comparator(bucketKey, key)) {
-            // TODO: Remove old element from buffer and update all indices in buckets
-            bucket->elementOffset = _DictionaryBufferInsertElement(dictionary, &dictionary->elementBuffer, element, elementSize);
+    UInt64 hash = _DictionaryHash(dictionary, key);
+    Index index = _DictionaryFindSlot(dictionary, key, hash);
+    if (index != dictionary->capacity) {
+        DictionarySlot *slot = &dictionary->slots[index];
+        if (elementSize <= slot->elementCapacity) {
+            memcpy(_DictionaryBufferGetElement(dictionary, &dictionary->elementBuffer, slot->elementOffset), element, elementSize);
+            slot->elementSize = elementSize;
             return;
         }
 
-        if (bucket->next) {
-            bucket = bucket->next;
+        dictionary->garbageSize += slot->elementCapacity;
+        slot->elementOffset   = _DictionaryBufferInsertElement(dictionary, &dictionary->elementBuffer, element, elementSize,
+                                                             _kDictionaryElementAlignment);
+        slot->elementSize     = elementSize;
+        slot->elementCapacity = _Align(elementSize, _kDictionaryElementAlignment);
+        _DictionaryCollectGarbageIfNeeded(dictionary);
+        return;
+    }
+
+    // Grow the table if the load factor would exceed 7/8, tombstones are purged by rehashing into the same capacity as long as
+    // the live elements only occupy half of the maximum load.
+    if ((dictionary->elementCount + dictionary->deletedCount + 1) * 8 > dictionary->capacity * 7) {
+        if ((dictionary->elementCount + 1) * 16 > dictionary->capacity * 7) {
+            _DictionaryRehash(dictionary, dictionary->capacity * 2);
         } else {
-            break;
+            _DictionaryRehash(dictionary, dictionary->capacity);
         }
     }
 
-    if (bucket->isFilled) {
-        bucket->next = (DictionaryBucketRef)AllocatorAllocate(dictionary->bucketAllocator, sizeof(struct _DictionaryBucket));
-        bucket       = bucket->next;
+    index = _DictionaryFindInsertionSlot(dictionary, hash);
+    if (dictionary->controls[index] == _kDictionaryControlDeleted) {
+        dictionary->deletedCount -= 1;
     }
 
-    bucket->hash          = hash;
-    bucket->keyOffset     = _DictionaryBufferInsertElement(dictionary, &dictionary->keyBuffer, key, dictionary->keySizeCallback(key));
-    bucket->elementOffset = _DictionaryBufferInsertElement(dictionary, &dictionary->elementBuffer, element, elementSize);
-    bucket->isFilled      = true;
-    bucket->next          = NULL;
-
+    Index keySize         = (Index)dictionary->keySizeCallback(key);
+    DictionarySlot *slot  = &dictionary->slots[index];
+    slot->hash            = hash;
+    slot->keyOffset       = _DictionaryBufferInsertElement(dictionary, &dictionary->keyBuffer, key, keySize, 1);
+    slot->keySize         = keySize;
+    slot->elementOffset   = _DictionaryBufferInsertElement(dictionary, &dictionary->elementBuffer, element, elementSize,
+                                                         _kDictionaryElementAlignment);
+    slot->elementSize     = elementSize;
+    slot->elementCapacity = _Align(elementSize, _kDictionaryElementAlignment);
+    _DictionarySetControl(dictionary, index, _DictionaryHashControl(hash));
     dictionary->elementCount += 1;
 }
 
 const void *DictionaryLookup(DictionaryRef dictionary, const void *key) {
-    UInt64 hash                = dictionary->hasher(key);
-    Index index                = hash % dictionary->capacity;
-    DictionaryBucketRef bucket = (DictionaryBucketRef)(((UInt8 *)dictionary->buckets) + sizeof(struct _DictionaryBucket) * index);
-    while (bucket && bucket->isFilled) {
-        const void *bucketKey = _DictionaryBufferGetElement(dictionary, &dictionary->keyBuffer, bucket->keyOffset);
-        if (bucket->hash == hash && dictionary->comparator(bucketKey, key)) {
-            return _DictionaryBufferGetElement(dictionary, &dictionary->elementBuffer, bucket->elementOffset);
-        }
-
-        bucket = bucket->next;
+    UInt64 hash = _DictionaryHash(dictionary, key);
+    Index index = _DictionaryFindSlot(dictionary, key, hash);
+    if (index == dictionary->capacity) {
+        return NULL;
     }
 
-    return NULL;
+    return _DictionaryBufferGetElement(dictionary, &dictionary->elementBuffer, dictionary->slots[index].elementOffset);
 }
 
 void DictionaryRemove(DictionaryRef dictionary, const void *key) {
-    UInt64 hash                        = dictionary->hasher(key);
-    Index index                        = hash % dictionary->capacity;
-    DictionaryBucketRef bucket         = (DictionaryBucketRef)(((UInt8 *)dictionary->buckets) + sizeof(struct _DictionaryBucket) * index);
-    DictionaryBucketRef previousBucket = NULL;
-    while (bucket && bucket->isFilled) {
-        const void *bucketKey = _DictionaryBufferGetElement(dictionary, &dictionary->keyBuffer, bucket->keyOffset);
-        if (bucket->hash == hash && dictionary->comparator(bucketKey, key)) {
-            if (!previousBucket) {
-                if (bucket->next) {
-                    memcpy((DictionaryBucketRef)(((UInt8 *)dictionary->buckets) + sizeof(struct _DictionaryBucket) * index), bucket->next,
-                           sizeof(struct _DictionaryBucket));
-                } else {
-                    bucket->isFilled = false;
-                }
-            } else {
-                previousBucket->next = bucket->next;
-            }
-
-            // TODO: Remove key from buffer and update all indices in buckets
-
-            dictionary->elementCount -= 1;
-            return;
-        }
+    UInt64 hash = _DictionaryHash(dictionary, key);
+    Index index = _DictionaryFindSlot(dictionary, key, hash);
+    if (index == dictionary->capacity) {
+        return;
+    }
 
-        previousBucket = bucket;
-        bucket         = bucket->next;
+    DictionarySlot *slot = &dictionary->slots[index];
+    dictionary->garbageSize += slot->keySize + slot->elementCapacity;
+
+    // A slot can be reset to empty if the probe sequence of any other key would have stopped at this group anyway
+    Index groupIndex = (index - _kDictionaryGroupWidth) & (dictionary->capacity - 1);
+    UInt32 before    = _DictionaryGroupMatchEmpty(&dictionary->controls[groupIndex]);
+    UInt32 after     = _DictionaryGroupMatchEmpty(&dictionary->controls[index]);
+    Index emptyCount = (before ? __builtin_clz(before) - (32 - _kDictionaryGroupWidth) : _kDictionaryGroupWidth) +
+                       (after ? __builtin_ctz(after) : _kDictionaryGroupWidth);
+    if (emptyCount < _kDictionaryGroupWidth) {
+        _DictionarySetControl(dictionary, index, _kDictionaryControlEmpty);
+    } else {
+        _DictionarySetControl(dictionary, index, _kDictionaryControlDeleted);
+        dictionary->deletedCount += 1;
     }
+
+    dictionary->elementCount -= 1;
+    _DictionaryCollectGarbageIfNeeded(dictionary);
 }
 
 void DictionaryGetKeyBuffer(DictionaryRef dictionary, void **memory, Index *length) {
+    if (dictionary->garbageSize > 0) {
+        _DictionaryRehash(dictionary, dictionary->capacity);
+    }
+
     *memory = dictionary->keyBuffer.memory;
     *length = dictionary->keyBuffer.offset;
 }
 
 void DictionaryGetValueBuffer(DictionaryRef dictionary, void **memory, Index *length) {
+    if (dictionary->garbageSize > 0) {
+        _DictionaryRehash(dictionary, dictionary->capacity);
+    }
+
     *memory = dictionary->elementBuffer.memory;
     *length = dictionary->elementBuffer.offset;
 }
 
-static inline void _DictionaryBufferInit(DictionaryRef dictionary, DictionaryBuffer *buffer) {
+static inline UInt64 _DictionaryHash(DictionaryRef dictionary, const void *key) {
+    // Mix the hash of the user provided hasher to spread the entropy across all bits, the control byte is formed from the
+    // lower bits and the slot index from the upper bits.
+    UInt64 hash = dictionary->hasher(key);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static inline UInt8 _DictionaryHashControl(UInt64 hash) {
+    return (UInt8)(hash & 0x7F);
+}
+
+static inline Index _DictionaryHashIndex(DictionaryRef dictionary, UInt64 hash) {
+    return (Index)(hash >> 7) & (dictionary->capacity - 1);
+}
+
+static inline UInt32 _DictionaryGroupMatch(const UInt8 *group, UInt8 control) {
+#if defined(__SSE2__)
+    __m128i controls = _mm_loadu_si128((const __m128i *)group);
+    return (UInt32)_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8((char)control)));
+#else
+    UInt32 mask = 0;
+    for (Index index = 0; index < _kDictionaryGroupWidth; index++) {
+        mask |= (UInt32)(group[index] == control) << index;
+    }
+    return mask;
+#endif
+}
+
+static inline UInt32 _DictionaryGroupMatchEmptyOrDeleted(const UInt8 *group) {
+#if defined(__SSE2__)
+    __m128i controls = _mm_loadu_si128((const __m128i *)group);
+    return (UInt32)_mm_movemask_epi8(controls);
+#else
+    UInt32 mask = 0;
+    for (Index index = 0; index < _kDictionaryGroupWidth; index++) {
+        mask |= (UInt32)(group[index] >> 7) << index;
+    }
+    return mask;
+#endif
+}
+
+static inline UInt32 _DictionaryGroupMatchEmpty(const UInt8 *group) {
+    return _DictionaryGroupMatch(group, _kDictionaryControlEmpty);
+}
+
+static inline void _DictionarySetControl(DictionaryRef dictionary, Index index, UInt8 control) {
+    dictionary->controls[index] = control;
+    if (index < _kDictionaryGroupWidth) {
+        dictionary->controls[dictionary->capacity + index] = control;
+    }
+}
+
+static inline void _DictionaryAllocateTable(DictionaryRef dictionary, Index capacity) {
+    assert(capacity >= _kDictionaryMinimumCapacity && (capacity & (capacity - 1)) == 0);
+
+    dictionary->capacity = capacity;
+    dictionary->controls = (UInt8 *)AllocatorAllocate(dictionary->allocator, sizeof(UInt8) * (capacity + _kDictionaryGroupWidth));
+    dictionary->slots    = (DictionarySlot *)AllocatorAllocate(dictionary->allocator, sizeof(DictionarySlot) * capacity);
+    memset(dictionary->controls, _kDictionaryControlEmpty, sizeof(UInt8) * (capacity + _kDictionaryGroupWidth));
+}
+
+static inline Index _DictionaryFindSlot(DictionaryRef dictionary, const void *key, UInt64 hash) {
+    Index mask    = dictionary->capacity - 1;
+    Index index   = _DictionaryHashIndex(dictionary, hash);
+    Index stride  = 0;
+    UInt8 control = _DictionaryHashControl(hash);
+    while (true) {
+        const UInt8 *group = &dictionary->controls[index];
+        UInt32 matches     = _DictionaryGroupMatch(group, control);
+        while (matches) {
+            Index slotIndex      = (index + __builtin_ctz(matches)) & mask;
+            DictionarySlot *slot = &dictionary->slots[slotIndex];
+            if (slot->hash == hash &&
+                dictionary->comparator(_DictionaryBufferGetElement(dictionary, &dictionary->keyBuffer, slot->keyOffset), key)) {
+                return slotIndex;
+            }
+
+            matches &= matches - 1;
+        }
+
+        if (_DictionaryGroupMatchEmpty(group)) {
+            return dictionary->capacity;
+        }
+
+        stride += _kDictionaryGroupWidth;
+        index = (index + stride) & mask;
+    }
+}
+
+static inline Index _DictionaryFindInsertionSlot(DictionaryRef dictionary, UInt64 hash) {
+    Index mask   = dictionary->capacity - 1;
+    Index index  = _DictionaryHashIndex(dictionary, hash);
+    Index stride = 0;
+    while (true) {
+        UInt32 matches = _DictionaryGroupMatchEmptyOrDeleted(&dictionary->controls[index]);
+        if (matches) {
+            return (index + __builtin_ctz(matches)) & mask;
+        }
+
+        stride += _kDictionaryGroupWidth;
+        index = (index + stride) & mask;
+    }
+}
+
+static inline void _DictionaryRehash(DictionaryRef dictionary, Index capacity) {
+    UInt8 *controls                = dictionary->controls;
+    DictionarySlot *slots          = dictionary->slots;
+    Index oldCapacity              = dictionary->capacity;
+    DictionaryBuffer keyBuffer     = dictionary->keyBuffer;
+    DictionaryBuffer elementBuffer = dictionary->elementBuffer;
+
+    // Rehashing also compacts the key and element buffers to drop the storage of removed or replaced elements
+    _DictionaryAllocateTable(dictionary, capacity);
+    _DictionaryBufferInit(dictionary, &dictionary->keyBuffer, MAX(keyBuffer.offset, _kDictionaryBufferMinimumCapacity));
+    _DictionaryBufferInit(dictionary, &dictionary->elementBuffer, MAX(elementBuffer.offset, _kDictionaryBufferMinimumCapacity));
+    dictionary->garbageSize  = 0;
+    dictionary->deletedCount = 0;
+
+    for (Index index = 0; index < oldCapacity; index++) {
+        if (controls[index] & 0x80) {
+            continue;
+        }
+
+        DictionarySlot *slot  = &slots[index];
+        Index slotIndex       = _DictionaryFindInsertionSlot(dictionary, slot->hash);
+        DictionarySlot *entry = &dictionary->slots[slotIndex];
+        entry->hash           = slot->hash;
+        entry->keySize        = slot->keySize;
+        entry->keyOffset      = _DictionaryBufferInsertElement(
+            dictionary, &dictionary->keyBuffer, _DictionaryBufferGetElement(dictionary, &keyBuffer, slot->keyOffset), slot->keySize, 1);
+        entry->elementSize     = slot->elementSize;
+        entry->elementCapacity = _Align(slot->elementSize, _kDictionaryElementAlignment);
+        entry->elementOffset   = _DictionaryBufferInsertElement(dictionary, &dictionary->elementBuffer,
+                                                              _DictionaryBufferGetElement(dictionary, &elementBuffer, slot->elementOffset),
+                                                              slot->elementSize, _kDictionaryElementAlignment);
+        _DictionarySetControl(dictionary, slotIndex, controls[index]);
+    }
+
+    _DictionaryBufferDeinit(dictionary, &elementBuffer);
+    _DictionaryBufferDeinit(dictionary, &keyBuffer);
+    AllocatorDeallocate(dictionary->allocator, controls);
+    AllocatorDeallocate(dictionary->allocator, slots);
+}
+
+static inline void _DictionaryCollectGarbageIfNeeded(DictionaryRef dictionary) {
+    if (dictionary->garbageSize * 2 > dictionary->keyBuffer.offset + dictionary->elementBuffer.offset) {
+        _DictionaryRehash(dictionary, dictionary->capacity);
+    }
+}
+
+static inline void _DictionaryBufferInit(DictionaryRef dictionary, DictionaryBuffer *buffer, Index capacity) {
     buffer->offset   = 0;
-    buffer->capacity = _kDictionaryBufferDefaultCapacity;
+    buffer->capacity = capacity;
     buffer->memory   = AllocatorAllocate(dictionary->allocator, buffer->capacity);
 }
 
 static inline void _DictionaryBufferReserveCapacity(DictionaryRef dictionary, DictionaryBuffer *buffer, Index capacity) {
     Index newCapacity = buffer->capacity;
     while (newCapacity < capacity) {
-        newCapacity *= _kDictionaryBufferGrowthFactor;
+        newCapacity *= 2;
     }
 
     if (newCapacity > buffer->capacity) {
@@ -190,13 +392,13 @@ static inline void *_DictionaryBufferGetElement(DictionaryRef dictionary, Dictio
 }
 
 static inline Index _DictionaryBufferInsertElement(DictionaryRef dictionary, DictionaryBuffer *buffer, const void *element,
-                                                   Index elementSize) {
-    Index requiredCapacity = buffer->offset + elementSize;
+                                                   Index elementSize, Index alignment) {
+    Index offset           = _Align(buffer->offset, alignment);
+    Index requiredCapacity = offset + _Align(elementSize, alignment);
     _DictionaryBufferReserveCapacity(dictionary, buffer, requiredCapacity);
-    Index offset       = buffer->offset;
-    UInt8 *destination = ((UInt8 *)buffer->memory) + buffer->offset;
+    UInt8 *destination = ((UInt8 *)buffer->memory) + offset;
     memcpy(destination, element, elementSize);
-    buffer->offset += elementSize;
+    buffer->offset = requiredCapacity;
     return offset;
 }
 
@@ -204,6 +406,10 @@ static inline void _DictionaryBufferDeinit(DictionaryRef dictionary, DictionaryB
     AllocatorDeallocate(dictionary->allocator, buffer->memory);
 }
 
+static inline Index _Align(Index value, Index alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
 Bool _CStringDictionaryKeyComparator(const void *lhs, const void *rhs) {
     return strcmp((const char *)lhs, (const char *)rhs) == 0;
 }
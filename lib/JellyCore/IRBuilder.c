@@ -3,12 +3,17 @@
 #include "JellyCore/Allocator.h"
 #include "JellyCore/Diagnostic.h"
 #include "JellyCore/IRBuilder.h"
+#include "JellyCore/PointerMap.h"
 
 #include <llvm-c/Analysis.h>
 #include <llvm-c/Core.h>
+#include <llvm-c/Error.h>
 #include <llvm-c/ExecutionEngine.h>
 #include <llvm-c/Linker.h>
 #include <llvm-c/Support.h>
+#include <llvm-c/TargetMachine.h>
+#include <llvm-c/Transforms/PassBuilder.h>
+#include <pthread.h>
 
 #warning TODO: Always default initialize the memory of any value declaration if there is no initializer expression!
 
@@ -25,14 +30,25 @@
 //     }
 // }
 
+/// The IR values and types of the AST nodes are stored in the builder instead of the nodes, because declarations and types are shared
+/// between modules which can be built concurrently, each of them inside of its own LLVMContextRef.
+struct _IRBuilderNodeEntry {
+    LLVMValueRef value;
+    LLVMTypeRef type;
+};
+typedef struct _IRBuilderNodeEntry IRBuilderNodeEntry;
+
 // TODO: Rename this to LLVMBackend
 struct _IRBuilder {
     AllocatorRef allocator;
     ASTContextRef astContext;
     StringRef buildDirectory;
+    IROptimizationLevel optimizationLevel;
+    StringRef targetTriple;
     LLVMContextRef context;
     LLVMBuilderRef builder;
     IRModuleRef module;
+    PointerMapRef nodeEntries;
 };
 
 struct _IRModule {
@@ -40,6 +56,27 @@ struct _IRModule {
     Bool isVerified;
 };
 
+/// Creating a target machine parses the triple, cpu and feature strings and sets up the subtarget, so the machines are pooled for the
+/// lifetime of the process and shared by all builders. A machine isn't safe to be used for concurrent emission, therefore each entry is
+/// checked out by a single builder and there are at most as many machines per configuration as modules are emitted concurrently.
+struct _IRTargetMachineEntry {
+    StringRef targetTriple;
+    StringRef cpu;
+    StringRef features;
+    LLVMCodeGenOptLevel codeGenLevel;
+    LLVMTargetMachineRef machine;
+    LLVMTargetDataRef dataLayout;
+    Bool isInUse;
+    struct _IRTargetMachineEntry *next;
+};
+typedef struct _IRTargetMachineEntry IRTargetMachineEntry;
+
+static pthread_mutex_t _kIRTargetMachineMutex        = PTHREAD_MUTEX_INITIALIZER;
+static IRTargetMachineEntry *_kIRTargetMachineEntries = NULL;
+static Char *_kIRHostTargetTriple                     = NULL;
+static Char *_kIRHostCPU                              = NULL;
+static Char *_kIRHostFeatures                         = NULL;
+
 // TODO: Add correct implementation for enumeration type and cases
 // TODO: Remove initializers from backend and apply ast substitutions!
 
@@ -74,19 +111,33 @@ static inline LLVMTypeRef _IRBuilderGetIRType(IRBuilderRef builder, ASTTypeRef t
 static inline LLVMValueRef _IRBuilderBuildIntrinsic(IRBuilderRef builder, LLVMValueRef function, StringRef intrinsic,
                                                     LLVMValueRef *arguments, unsigned argumentCount, LLVMTypeRef resultType);
 
+static inline void _IRBuilderOptimizeModule(IRBuilderRef builder, LLVMTargetMachineRef machine);
+
+static inline void _IRBuilderInitializeTargets(void);
+static inline IRTargetMachineEntry *_IRBuilderAcquireTargetMachine(IRBuilderRef builder);
+static inline void _IRBuilderReleaseTargetMachine(IRTargetMachineEntry *entry);
+
+static inline LLVMValueRef _IRBuilderLookupIRValue(IRBuilderRef builder, const void *node);
+static inline void _IRBuilderSetIRValue(IRBuilderRef builder, const void *node, LLVMValueRef value);
+static inline LLVMTypeRef _IRBuilderLookupIRType(IRBuilderRef builder, const void *node);
+static inline void _IRBuilderSetIRType(IRBuilderRef builder, const void *node, LLVMTypeRef type);
+
 LLVMValueRef _IRBuilderGetConstantSizeOfType(IRBuilderRef builder, ASTTypeRef type);
 
 LLVMValueRef _IRBuilderImplicitlyConvertValue(IRBuilderRef builder, LLVMValueRef function, LLVMValueRef value,
                                               ASTExpressionRef valueExpression, ASTTypeRef targetType);
 
 IRBuilderRef IRBuilderCreate(AllocatorRef allocator, ASTContextRef context, StringRef buildDirectory) {
-    IRBuilderRef builder    = (IRBuilderRef)AllocatorAllocate(allocator, sizeof(struct _IRBuilder));
-    builder->allocator      = allocator;
-    builder->astContext     = context;
-    builder->buildDirectory = StringCreateCopy(allocator, buildDirectory);
-    builder->context        = LLVMGetGlobalContext();
-    builder->builder        = LLVMCreateBuilderInContext(builder->context);
-    builder->module         = NULL;
+    IRBuilderRef builder       = (IRBuilderRef)AllocatorAllocate(allocator, sizeof(struct _IRBuilder));
+    builder->allocator         = allocator;
+    builder->astContext        = context;
+    builder->buildDirectory    = StringCreateCopy(allocator, buildDirectory);
+    builder->optimizationLevel = IROptimizationLevelNone;
+    builder->targetTriple      = NULL;
+    builder->context           = LLVMContextCreate();
+    builder->builder           = LLVMCreateBuilderInContext(builder->context);
+    builder->module            = NULL;
+    builder->nodeEntries       = PointerMapCreate(allocator, sizeof(IRBuilderNodeEntry));
     return builder;
 }
 
@@ -97,11 +148,50 @@ void IRBuilderDestroy(IRBuilderRef builder) {
     }
 
     LLVMDisposeBuilder(builder->builder);
+    LLVMContextDispose(builder->context);
+
+    PointerMapDestroy(builder->nodeEntries);
+
+    if (builder->targetTriple) {
+        StringDestroy(builder->targetTriple);
+    }
 
     StringDestroy(builder->buildDirectory);
     AllocatorDeallocate(builder->allocator, builder);
 }
 
+void IRBuilderSetOptimizationLevel(IRBuilderRef builder, IROptimizationLevel level) {
+    builder->optimizationLevel = level;
+}
+
+void IRBuilderSetTargetTriple(IRBuilderRef builder, StringRef targetTriple) {
+    if (builder->targetTriple) {
+        StringDestroy(builder->targetTriple);
+        builder->targetTriple = NULL;
+    }
+
+    if (targetTriple) {
+        Char *normalizedTriple = LLVMNormalizeTargetTriple(StringGetCharacters(targetTriple));
+        builder->targetTriple  = StringCreate(builder->allocator, normalizedTriple);
+        LLVMDisposeMessage(normalizedTriple);
+    }
+}
+
+Bool IRBuilderIsTargetTripleSupported(StringRef targetTriple) {
+    _IRBuilderInitializeTargets();
+
+    Char *normalizedTriple = LLVMNormalizeTargetTriple(StringGetCharacters(targetTriple));
+    LLVMTargetRef target   = NULL;
+    Char *message          = NULL;
+    LLVMBool error         = LLVMGetTargetFromTriple(normalizedTriple, &target, &message);
+    if (message) {
+        LLVMDisposeMessage(message);
+    }
+
+    LLVMDisposeMessage(normalizedTriple);
+    return !error;
+}
+
 IRModuleRef IRBuilderBuild(IRBuilderRef builder, ASTModuleDeclarationRef module) {
     assert(module->base.name);
 
@@ -110,6 +200,9 @@ IRModuleRef IRBuilderBuild(IRBuilderRef builder, ASTModuleDeclarationRef module)
         AllocatorDeallocate(builder->allocator, builder->module);
     }
 
+    // The values of the previous module are invalidated, only the types would remain valid inside of the context
+    PointerMapRemoveAll(builder->nodeEntries);
+
     builder->module             = (IRModuleRef)AllocatorAllocate(builder->allocator, sizeof(struct _IRModule));
     builder->module->module     = LLVMModuleCreateWithNameInContext(StringGetCharacters(module->base.name), builder->context);
     builder->module->isVerified = false;
@@ -243,16 +336,161 @@ void IRBuilderEmitObjectFile(IRBuilderRef builder, IRModuleRef module, StringRef
     assert(builder->module == module && module);
     assert(builder->module->isVerified);
 
-    Char *targetTriple = LLVMGetDefaultTargetTriple();
-    Char *cpu          = LLVMGetHostCPUName();
-    Char *features     = LLVMGetHostCPUFeatures();
+    IRTargetMachineEntry *entry = _IRBuilderAcquireTargetMachine(builder);
+    if (!entry) {
+        return;
+    }
+
+    LLVMTargetMachineRef machine = entry->machine;
+    LLVMSetTarget(builder->module->module, StringGetCharacters(entry->targetTriple));
+    LLVMSetModuleDataLayout(builder->module->module, entry->dataLayout);
+
+    if (builder->optimizationLevel != IROptimizationLevelNone) {
+        _IRBuilderOptimizeModule(builder, machine);
+    }
+
+    StringRef objectFilePath = StringCreateCopy(builder->allocator, builder->buildDirectory);
+    StringAppendFormat(objectFilePath, "/%s.o", StringGetCharacters(fileName));
+
+    FILE *objectFile = fopen(StringGetCharacters(objectFilePath), "w+");
+    if (!objectFile) {
+        ReportErrorFormat("Couldn't create object file at path: '%s'", StringGetCharacters(objectFilePath));
+        StringDestroy(objectFilePath);
+        _IRBuilderReleaseTargetMachine(entry);
+        return;
+    } else {
+        fclose(objectFile);
+    }
+
+    Char *message  = NULL;
+    LLVMBool error = LLVMTargetMachineEmitToFile(machine, builder->module->module, StringGetCharacters(objectFilePath), LLVMObjectFile,
+                                                 &message);
+    _IRBuilderReleaseTargetMachine(entry);
+    if (error) {
+        if (message) {
+            ReportCriticalFormat("LLVM Error:\n%s\n", message);
+            LLVMDisposeMessage(message);
+        } else {
+            ReportCritical("LLVM Error");
+        }
+    }
+
+    StringDestroy(objectFilePath);
+}
+
+static inline void _IRBuilderOptimizeModule(IRBuilderRef builder, LLVMTargetMachineRef machine) {
+    const Char *pipeline = NULL;
+    switch (builder->optimizationLevel) {
+    case IROptimizationLevelLess:
+        pipeline = "default<O1>";
+        break;
+
+    case IROptimizationLevelDefault:
+        pipeline = "default<O2>";
+        break;
+
+    case IROptimizationLevelAggressive:
+        pipeline = "default<O3>";
+        break;
+
+    case IROptimizationLevelSize:
+        pipeline = "default<Os>";
+        break;
+
+    default:
+        JELLY_UNREACHABLE("Invalid optimization level given for pass pipeline!");
+    }
+
+    // The default pipelines are containing the inliner, mem2reg (sroa), gvn and the loop passes, vectorization is enabled for all
+    // levels above O1 same as in clang
+    Bool vectorize                    = builder->optimizationLevel != IROptimizationLevelLess;
+    LLVMPassBuilderOptionsRef options = LLVMCreatePassBuilderOptions();
+    LLVMPassBuilderOptionsSetLoopVectorization(options, vectorize);
+    LLVMPassBuilderOptionsSetSLPVectorization(options, vectorize);
+    LLVMPassBuilderOptionsSetLoopInterleaving(options, vectorize);
+    LLVMPassBuilderOptionsSetLoopUnrolling(options, true);
+
+    LLVMErrorRef error = LLVMRunPasses(builder->module->module, pipeline, machine, options);
+    if (error) {
+        Char *message = LLVMGetErrorMessage(error);
+        ReportErrorFormat("LLVM Error:\n%s\n", message);
+        LLVMDisposeErrorMessage(message);
+    }
+
+    LLVMDisposePassBuilderOptions(options);
+}
 
+static inline void _IRBuilderInitializeTargetsOnce(void) {
     LLVMInitializeAllTargetInfos();
     LLVMInitializeAllTargets();
     LLVMInitializeAllTargetMCs();
     LLVMInitializeAllAsmParsers();
     LLVMInitializeAllAsmPrinters();
 
+    // The host description is only queried once and is shared by all target machines of the host
+    Char *defaultTargetTriple = LLVMGetDefaultTargetTriple();
+    _kIRHostTargetTriple      = LLVMNormalizeTargetTriple(defaultTargetTriple);
+    _kIRHostCPU               = LLVMGetHostCPUName();
+    _kIRHostFeatures          = LLVMGetHostCPUFeatures();
+    LLVMDisposeMessage(defaultTargetTriple);
+}
+
+static inline void _IRBuilderInitializeTargets(void) {
+    // Object files of multiple modules can be emitted concurrently but the target registry of LLVM is global
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once(&once, &_IRBuilderInitializeTargetsOnce);
+}
+
+static inline IRTargetMachineEntry *_IRBuilderAcquireTargetMachine(IRBuilderRef builder) {
+    _IRBuilderInitializeTargets();
+
+    // Cross compilation can't make any assumptions about the cpu of the target, so the host cpu and features are only used for the host
+    const Char *targetTriple = _kIRHostTargetTriple;
+    const Char *cpu          = _kIRHostCPU;
+    const Char *features     = _kIRHostFeatures;
+    if (builder->targetTriple && strcmp(StringGetCharacters(builder->targetTriple), _kIRHostTargetTriple) != 0) {
+        targetTriple = StringGetCharacters(builder->targetTriple);
+        cpu          = "generic";
+        features     = "";
+    }
+
+    LLVMCodeGenOptLevel codeGenLevel = LLVMCodeGenLevelNone;
+    switch (builder->optimizationLevel) {
+    case IROptimizationLevelNone:
+        codeGenLevel = LLVMCodeGenLevelNone;
+        break;
+
+    case IROptimizationLevelLess:
+        codeGenLevel = LLVMCodeGenLevelLess;
+        break;
+
+    case IROptimizationLevelDefault:
+    case IROptimizationLevelSize:
+        codeGenLevel = LLVMCodeGenLevelDefault;
+        break;
+
+    case IROptimizationLevelAggressive:
+        codeGenLevel = LLVMCodeGenLevelAggressive;
+        break;
+    }
+
+    pthread_mutex_lock(&_kIRTargetMachineMutex);
+    IRTargetMachineEntry *entry = _kIRTargetMachineEntries;
+    while (entry) {
+        if (!entry->isInUse && entry->codeGenLevel == codeGenLevel && StringIsEqualToCString(entry->targetTriple, targetTriple) &&
+            StringIsEqualToCString(entry->cpu, cpu) && StringIsEqualToCString(entry->features, features)) {
+            entry->isInUse = true;
+            break;
+        }
+
+        entry = entry->next;
+    }
+    pthread_mutex_unlock(&_kIRTargetMachineMutex);
+
+    if (entry) {
+        return entry;
+    }
+
     LLVMTargetRef target = NULL;
     Char *message        = NULL;
     LLVMBool error       = LLVMGetTargetFromTriple(targetTriple, &target, &message);
@@ -264,61 +502,68 @@ void IRBuilderEmitObjectFile(IRBuilderRef builder, IRModuleRef module, StringRef
             ReportError("LLVM Target initialization failed");
         }
 
-        return;
+        return NULL;
     }
 
-    // TODO: Add configuration option to IRBuilder for LLVMCodeGenLevel
-    LLVMTargetMachineRef machine = LLVMCreateTargetMachine(target, targetTriple, cpu, features, LLVMCodeGenLevelNone, LLVMRelocDefault,
+    LLVMTargetMachineRef machine = LLVMCreateTargetMachine(target, targetTriple, cpu, features, codeGenLevel, LLVMRelocDefault,
                                                            LLVMCodeModelDefault);
-    LLVMTargetDataRef dataLayout = LLVMCreateTargetDataLayout(machine);
 
-    LLVMSetTarget(builder->module->module, targetTriple);
-    LLVMSetModuleDataLayout(builder->module->module, dataLayout);
+    // The entries are never released and are allocated independently of the builder which may be destroyed before the process ends
+    AllocatorRef allocator = AllocatorGetSystemDefault();
+    entry                  = (IRTargetMachineEntry *)AllocatorAllocate(allocator, sizeof(IRTargetMachineEntry));
+    entry->targetTriple    = StringCreate(allocator, targetTriple);
+    entry->cpu             = StringCreate(allocator, cpu);
+    entry->features        = StringCreate(allocator, features);
+    entry->codeGenLevel    = codeGenLevel;
+    entry->machine         = machine;
+    entry->dataLayout      = LLVMCreateTargetDataLayout(machine);
+    entry->isInUse         = true;
+
+    pthread_mutex_lock(&_kIRTargetMachineMutex);
+    entry->next              = _kIRTargetMachineEntries;
+    _kIRTargetMachineEntries = entry;
+    pthread_mutex_unlock(&_kIRTargetMachineMutex);
+    return entry;
+}
 
-    StringRef objectFilePath = StringCreateCopy(builder->allocator, builder->buildDirectory);
-    StringAppendFormat(objectFilePath, "/%s.o", StringGetCharacters(fileName));
+static inline void _IRBuilderReleaseTargetMachine(IRTargetMachineEntry *entry) {
+    pthread_mutex_lock(&_kIRTargetMachineMutex);
+    entry->isInUse = false;
+    pthread_mutex_unlock(&_kIRTargetMachineMutex);
+}
 
-    FILE *objectFile = fopen(StringGetCharacters(objectFilePath), "w+");
-    if (!objectFile) {
-        ReportErrorFormat("Couldn't create object file at path: '%s'", StringGetCharacters(objectFilePath));
-        // TODO: Dispose all LLVM references
-        return;
-    } else {
-        fclose(objectFile);
-    }
+static inline LLVMValueRef _IRBuilderLookupIRValue(IRBuilderRef builder, const void *node) {
+    IRBuilderNodeEntry *entry = (IRBuilderNodeEntry *)PointerMapLookup(builder->nodeEntries, node);
+    return entry ? entry->value : NULL;
+}
 
-    error = LLVMTargetMachineEmitToFile(machine, builder->module->module, StringGetCharacters(objectFilePath), LLVMObjectFile, &message);
-    if (error) {
-        if (message) {
-            ReportCriticalFormat("LLVM Error:\n%s\n", message);
-            LLVMDisposeMessage(message);
-        } else {
-            ReportCritical("LLVM Error");
-        }
+static inline void _IRBuilderSetIRValue(IRBuilderRef builder, const void *node, LLVMValueRef value) {
+    IRBuilderNodeEntry *entry = (IRBuilderNodeEntry *)PointerMapInsert(builder->nodeEntries, node);
+    entry->value              = value;
+}
 
-        // TODO: Dispose all LLVM references
-        return;
-    }
+static inline LLVMTypeRef _IRBuilderLookupIRType(IRBuilderRef builder, const void *node) {
+    IRBuilderNodeEntry *entry = (IRBuilderNodeEntry *)PointerMapLookup(builder->nodeEntries, node);
+    return entry ? entry->type : NULL;
+}
 
-    StringDestroy(objectFilePath);
-    LLVMDisposeTargetData(dataLayout);
-    LLVMDisposeTargetMachine(machine);
-    LLVMDisposeMessage(targetTriple);
-    LLVMDisposeMessage(cpu);
-    LLVMDisposeMessage(features);
+static inline void _IRBuilderSetIRType(IRBuilderRef builder, const void *node, LLVMTypeRef type) {
+    IRBuilderNodeEntry *entry = (IRBuilderNodeEntry *)PointerMapInsert(builder->nodeEntries, node);
+    entry->type               = type;
 }
 
 static inline void _IRBuilderBuildEntryPoint(IRBuilderRef builder, ASTModuleDeclarationRef module) {
     if (module->entryPoint) {
-        assert(module->entryPoint->base.base.irValue);
-        LLVMTypeRef entryPointParameterTypes[] = {LLVMInt32Type(), LLVMPointerType(LLVMInt8Type(), 0)};
-        LLVMTypeRef entryPointType             = LLVMFunctionType(LLVMInt32Type(), entryPointParameterTypes, 2, false);
+        assert(_IRBuilderLookupIRValue(builder, module->entryPoint));
+        LLVMTypeRef int32Type                  = LLVMInt32TypeInContext(builder->context);
+        LLVMTypeRef entryPointParameterTypes[] = {int32Type, LLVMPointerType(LLVMInt8TypeInContext(builder->context), 0)};
+        LLVMTypeRef entryPointType             = LLVMFunctionType(int32Type, entryPointParameterTypes, 2, false);
         LLVMValueRef entryPoint                = LLVMAddFunction(builder->module->module, "main", entryPointType);
         LLVMSetFunctionCallConv(entryPoint, LLVMCCallConv);
-        LLVMBasicBlockRef entryBB = LLVMAppendBasicBlock(entryPoint, "entry");
+        LLVMBasicBlockRef entryBB = LLVMAppendBasicBlockInContext(builder->context, entryPoint, "entry");
         LLVMPositionBuilder(builder->builder, entryBB, NULL);
-        LLVMBuildCall(builder->builder, (LLVMValueRef)module->entryPoint->base.base.irValue, NULL, 0, "");
-        LLVMBuildRet(builder->builder, LLVMConstInt(LLVMInt32Type(), 0, true));
+        LLVMBuildCall(builder->builder, _IRBuilderLookupIRValue(builder, module->entryPoint), NULL, 0, "");
+        LLVMBuildRet(builder->builder, LLVMConstInt(int32Type, 0, true));
     }
 }
 
@@ -333,7 +578,8 @@ static inline void _IRBuilderBuildTypes(IRBuilderRef builder, ASTModuleDeclarati
             ASTNodeRef child = (ASTNodeRef)ASTArrayGetElementAtIndex(sourceUnit->declarations, index);
             if (child->tag == ASTTagStructureDeclaration) {
                 ASTDeclarationRef declaration = (ASTDeclarationRef)child;
-                declaration->base.irType      = LLVMStructCreateNamed(builder->context, StringGetCharacters(declaration->mangledName));
+                LLVMTypeRef structureType     = LLVMStructCreateNamed(builder->context, StringGetCharacters(declaration->mangledName));
+                _IRBuilderSetIRType(builder, declaration, structureType);
             }
         }
     }
@@ -352,25 +598,26 @@ static inline void _IRBuilderBuildTypes(IRBuilderRef builder, ASTModuleDeclarati
                     ASTValueDeclarationRef parameter = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(declaration->parameters, index);
                     LLVMTypeRef parameterType        = _IRBuilderGetIRType(builder, parameter->base.type);
                     assert(parameterType);
-                    parameter->base.base.irType = parameterType;
+                    _IRBuilderSetIRType(builder, parameter, parameterType);
                     ArrayAppendElement(temporaryTypes, &parameterType);
                 }
 
-                declaration->base.base.irType = LLVMFunctionType(_IRBuilderGetIRType(builder, declaration->returnType),
-                                                                 (LLVMTypeRef *)ArrayGetMemoryPointer(temporaryTypes),
-                                                                 ArrayGetElementCount(temporaryTypes), false);
+                LLVMTypeRef functionType = LLVMFunctionType(_IRBuilderGetIRType(builder, declaration->returnType),
+                                                            (LLVMTypeRef *)ArrayGetMemoryPointer(temporaryTypes),
+                                                            ArrayGetElementCount(temporaryTypes), false);
+                _IRBuilderSetIRType(builder, declaration, functionType);
             }
 
             if (child->tag == ASTTagStructureDeclaration) {
                 ASTStructureDeclarationRef declaration = (ASTStructureDeclarationRef)child;
-                LLVMTypeRef structureType              = (LLVMTypeRef)declaration->base.base.irType;
+                LLVMTypeRef structureType              = _IRBuilderLookupIRType(builder, declaration);
                 assert(structureType);
 
                 for (Index index = 0; index < ASTArrayGetElementCount(declaration->values); index++) {
                     ASTValueDeclarationRef value = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(declaration->values, index);
                     LLVMTypeRef valueType        = _IRBuilderGetIRType(builder, value->base.type);
                     assert(valueType);
-                    value->base.base.irType = valueType;
+                    _IRBuilderSetIRType(builder, value, valueType);
                     ArrayAppendElement(temporaryTypes, &valueType);
                 }
                 LLVMStructSetBody(structureType, (LLVMTypeRef *)ArrayGetMemoryPointer(temporaryTypes), ArrayGetElementCount(temporaryTypes),
@@ -386,19 +633,20 @@ static inline void _IRBuilderBuildTypes(IRBuilderRef builder, ASTModuleDeclarati
                                                                                                              index);
                         LLVMTypeRef parameterType        = _IRBuilderGetIRType(builder, parameter->base.type);
                         assert(parameterType);
-                        parameter->base.base.irType = parameterType;
+                        _IRBuilderSetIRType(builder, parameter, parameterType);
                         ArrayAppendElement(temporaryTypes, &parameterType);
                     }
 
-                    initializer->base.base.irType = LLVMFunctionType(structureType, (LLVMTypeRef *)ArrayGetMemoryPointer(temporaryTypes),
-                                                                     ArrayGetElementCount(temporaryTypes), false);
-                    iterator                      = ASTArrayIteratorNext(iterator);
+                    LLVMTypeRef initializerType = LLVMFunctionType(structureType, (LLVMTypeRef *)ArrayGetMemoryPointer(temporaryTypes),
+                                                                   ArrayGetElementCount(temporaryTypes), false);
+                    _IRBuilderSetIRType(builder, initializer, initializerType);
+                    iterator = ASTArrayIteratorNext(iterator);
                 }
             }
 
             if (child->tag == ASTTagValueDeclaration) {
                 ASTValueDeclarationRef declaration = (ASTValueDeclarationRef)child;
-                declaration->base.base.irType      = _IRBuilderGetIRType(builder, declaration->base.type);
+                _IRBuilderSetIRType(builder, declaration, _IRBuilderGetIRType(builder, declaration->base.type));
             }
         }
     }
@@ -418,10 +666,10 @@ static inline void _IRBuilderBuildGlobalVariables(IRBuilderRef builder, ASTModul
 }
 
 static inline void _IRBuilderBuildGlobalVariable(IRBuilderRef builder, ASTValueDeclarationRef declaration) {
-    assert(!declaration->base.base.irValue);
-    assert(declaration->base.base.irType);
+    assert(!_IRBuilderLookupIRValue(builder, declaration));
+    assert(_IRBuilderLookupIRType(builder, declaration));
 
-    LLVMTypeRef type   = (LLVMTypeRef)declaration->base.base.irType;
+    LLVMTypeRef type   = _IRBuilderLookupIRType(builder, declaration);
     LLVMValueRef value = LLVMAddGlobal(builder->module->module, type, StringGetCharacters(declaration->base.mangledName));
     if (declaration->initializer) {
         // TODO: Check if initializer is constant, if so set initializer of global else emit initialization of value into program entry
@@ -429,7 +677,7 @@ static inline void _IRBuilderBuildGlobalVariable(IRBuilderRef builder, ASTValueD
         // initializations in global scope and also be helpful for topological sorting of initialization instructions
         if ((declaration->initializer->base.flags & ASTFlagsIsConstantEvaluable)) {
             _IRBuilderBuildConstantExpression(builder, declaration->initializer);
-            LLVMSetInitializer(value, declaration->initializer->base.irValue);
+            LLVMSetInitializer(value, _IRBuilderLookupIRValue(builder, declaration->initializer));
         } else {
             ReportError("Expression is either not constant or it is currently not supported by the compiler!");
         }
@@ -438,7 +686,7 @@ static inline void _IRBuilderBuildGlobalVariable(IRBuilderRef builder, ASTValueD
         LLVMSetInitializer(value, initializer);
     }
 
-    declaration->base.base.irValue = value;
+    _IRBuilderSetIRValue(builder, declaration, value);
     declaration->base.base.flags |= ASTFlagsIsValuePointer;
 }
 
@@ -448,7 +696,7 @@ static inline void _IRBuilderBuildEnumerationElements(IRBuilderRef builder, ASTE
         ASTValueDeclarationRef value = ASTArrayIteratorGetElement(iterator);
         assert(value->initializer && value->base.mangledName);
 
-        value->base.base.irType = _IRBuilderGetIRType(builder, value->base.type);
+        _IRBuilderSetIRType(builder, value, _IRBuilderGetIRType(builder, value->base.type));
         _IRBuilderBuildGlobalVariable(builder, value);
 
         iterator = ASTArrayIteratorNext(iterator);
@@ -456,31 +704,32 @@ static inline void _IRBuilderBuildEnumerationElements(IRBuilderRef builder, ASTE
 }
 
 static inline void _IRBuilderBuildFunctionSignature(IRBuilderRef builder, ASTFunctionDeclarationRef declaration) {
-    if (declaration->base.base.irValue) {
+    if (_IRBuilderLookupIRValue(builder, declaration)) {
         return;
     }
 
     assert(declaration->base.base.tag == ASTTagFunctionDeclaration);
-    assert(declaration->base.base.irType);
+    assert(_IRBuilderLookupIRType(builder, declaration));
 
-    declaration->base.base.irValue = LLVMAddFunction(builder->module->module, StringGetCharacters(declaration->base.mangledName),
-                                                     (LLVMTypeRef)declaration->base.base.irType);
+    LLVMValueRef function = LLVMAddFunction(builder->module->module, StringGetCharacters(declaration->base.mangledName),
+                                            _IRBuilderLookupIRType(builder, declaration));
+    _IRBuilderSetIRValue(builder, declaration, function);
 }
 
 static inline void _IRBuilderBuildFunctionBody(IRBuilderRef builder, ASTFunctionDeclarationRef declaration) {
     // TODO: Check if function has already been build and assert if so
     assert(declaration->base.base.tag == ASTTagFunctionDeclaration);
-    assert(declaration->base.base.irType);
-    assert(declaration->base.base.irValue);
+    assert(_IRBuilderLookupIRType(builder, declaration));
+    assert(_IRBuilderLookupIRValue(builder, declaration));
 
-    LLVMValueRef function = (LLVMValueRef)declaration->base.base.irValue;
+    LLVMValueRef function = _IRBuilderLookupIRValue(builder, declaration);
 
     for (Index index = 0; index < ASTArrayGetElementCount(declaration->parameters); index++) {
         ASTValueDeclarationRef parameter = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(declaration->parameters, index);
-        parameter->base.base.irValue     = LLVMGetParam(function, index);
+        _IRBuilderSetIRValue(builder, parameter, LLVMGetParam(function, index));
     }
 
-    LLVMBasicBlockRef entry = LLVMAppendBasicBlock(function, "entry");
+    LLVMBasicBlockRef entry = LLVMAppendBasicBlockInContext(builder->context, function, "entry");
     LLVMPositionBuilder(builder->builder, entry, NULL);
 
     for (Index index = 0; index < ASTArrayGetElementCount(declaration->body->statements); index++) {
@@ -499,25 +748,25 @@ static inline void _IRBuilderBuildFunctionBody(IRBuilderRef builder, ASTFunction
 }
 
 static inline void _IRBuilderBuildForeignFunctionSignature(IRBuilderRef builder, ASTFunctionDeclarationRef declaration) {
-    if (declaration->base.base.irValue) {
+    if (_IRBuilderLookupIRValue(builder, declaration)) {
         return;
     }
 
     assert(declaration->base.base.tag == ASTTagForeignFunctionDeclaration);
 
-    if (declaration->base.base.irType == NULL) {
-        declaration->base.base.irType = _IRBuilderGetIRType(builder, declaration->base.type);
+    if (_IRBuilderLookupIRType(builder, declaration) == NULL) {
+        _IRBuilderSetIRType(builder, declaration, _IRBuilderGetIRType(builder, declaration->base.type));
     }
 
-    assert(declaration->base.base.irType);
+    assert(_IRBuilderLookupIRType(builder, declaration));
 
-    LLVMValueRef function          = LLVMAddFunction(builder->module->module, StringGetCharacters(declaration->foreignName),
-                                            (LLVMTypeRef)declaration->base.base.irType);
-    declaration->base.base.irValue = function;
+    LLVMValueRef function = LLVMAddFunction(builder->module->module, StringGetCharacters(declaration->foreignName),
+                                            _IRBuilderLookupIRType(builder, declaration));
+    _IRBuilderSetIRValue(builder, declaration, function);
 
     for (Index index = 0; index < ASTArrayGetElementCount(declaration->parameters); index++) {
         ASTValueDeclarationRef parameter = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(declaration->parameters, index);
-        parameter->base.base.irValue     = LLVMGetParam(function, index);
+        _IRBuilderSetIRValue(builder, parameter, LLVMGetParam(function, index));
     }
 
     // We are using the C calling convention for all foreign function declarations for now because we do not allow to specify the
@@ -526,25 +775,26 @@ static inline void _IRBuilderBuildForeignFunctionSignature(IRBuilderRef builder,
 }
 
 static inline void _IRBuilderBuildInitializerSignature(IRBuilderRef builder, ASTInitializerDeclarationRef declaration) {
-    if (declaration->base.base.irValue) {
+    if (_IRBuilderLookupIRValue(builder, declaration)) {
         return;
     }
 
-    assert(declaration->base.base.irType);
+    assert(_IRBuilderLookupIRType(builder, declaration));
 
-    declaration->base.base.irValue = LLVMAddFunction(builder->module->module, StringGetCharacters(declaration->base.mangledName),
-                                                     (LLVMTypeRef)declaration->base.base.irType);
+    LLVMValueRef function = LLVMAddFunction(builder->module->module, StringGetCharacters(declaration->base.mangledName),
+                                            _IRBuilderLookupIRType(builder, declaration));
+    _IRBuilderSetIRValue(builder, declaration, function);
 }
 
 static inline void _IRBuilderBuildInitializerBody(IRBuilderRef builder, ASTStructureDeclarationRef structure,
                                                   ASTInitializerDeclarationRef declaration) {
-    LLVMValueRef function = (LLVMValueRef)declaration->base.base.irValue;
+    LLVMValueRef function = _IRBuilderLookupIRValue(builder, declaration);
     for (Index index = 0; index < ASTArrayGetElementCount(declaration->parameters); index++) {
         ASTValueDeclarationRef parameter = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(declaration->parameters, index);
-        parameter->base.base.irValue     = LLVMGetParam(function, index);
+        _IRBuilderSetIRValue(builder, parameter, LLVMGetParam(function, index));
     }
 
-    LLVMBasicBlockRef entry = LLVMAppendBasicBlock(function, "entry");
+    LLVMBasicBlockRef entry = LLVMAppendBasicBlockInContext(builder->context, function, "entry");
     LLVMPositionBuilder(builder->builder, entry, NULL);
 
     for (Index index = 0; index < ASTArrayGetElementCount(declaration->body->statements); index++) {
@@ -558,30 +808,30 @@ static inline void _IRBuilderBuildInitializerBody(IRBuilderRef builder, ASTStruc
     }
 
     if (!(declaration->body->base.flags & ASTFlagsStatementIsAlwaysReturning)) {
-        assert(declaration->implicitSelf->base.base.irValue);
-        LLVMBuildRet(builder->builder, LLVMBuildLoad(builder->builder, (LLVMValueRef)declaration->implicitSelf->base.base.irValue, ""));
+        assert(_IRBuilderLookupIRValue(builder, declaration->implicitSelf));
+        LLVMBuildRet(builder->builder, LLVMBuildLoad(builder->builder, _IRBuilderLookupIRValue(builder, declaration->implicitSelf), ""));
     }
 }
 
 static inline void _IRBuilderBuildLocalVariable(IRBuilderRef builder, LLVMValueRef function, ASTValueDeclarationRef declaration) {
     // For now we will always alloca every local variable because we are not tracking in earlier passes if the value is referenced inside
     // the scope performing an alloca by default will guarantee some grade of correctness and could still be optimized by llvm passes
-    assert(!declaration->base.base.irValue);
+    assert(!_IRBuilderLookupIRValue(builder, declaration));
     assert(!declaration->base.mangledName);
 
-    declaration->base.base.irType = _IRBuilderGetIRType(builder, declaration->base.type);
+    _IRBuilderSetIRType(builder, declaration, _IRBuilderGetIRType(builder, declaration->base.type));
 
     if (declaration->initializer) {
         _IRBuilderBuildExpression(builder, function, declaration->initializer);
     }
 
-    LLVMTypeRef type   = (LLVMTypeRef)declaration->base.base.irType;
+    LLVMTypeRef type   = _IRBuilderLookupIRType(builder, declaration);
     LLVMValueRef value = LLVMBuildAlloca(builder->builder, type, StringGetCharacters(declaration->base.name));
     if (declaration->initializer) {
         LLVMBuildStore(builder->builder, _IRBuilderLoadExpression(builder, function, declaration->initializer), value);
     }
 
-    declaration->base.base.irValue = value;
+    _IRBuilderSetIRValue(builder, declaration, value);
     declaration->base.base.flags |= ASTFlagsIsValuePointer;
 }
 
@@ -629,10 +879,10 @@ static inline void _IRBuilderBuildStatement(IRBuilderRef builder, LLVMValueRef f
 
 static inline void _IRBuilderBuildIfStatement(IRBuilderRef builder, LLVMValueRef function, ASTIfStatementRef statement) {
     LLVMBasicBlockRef entryBB  = LLVMGetInsertBlock(builder->builder);
-    LLVMBasicBlockRef branchBB = LLVMAppendBasicBlock(function, "if-branch");
-    LLVMBasicBlockRef thenBB   = LLVMAppendBasicBlock(function, "if-then");
-    LLVMBasicBlockRef elseBB   = LLVMAppendBasicBlock(function, "if-else");
-    LLVMBasicBlockRef mergeBB  = LLVMAppendBasicBlock(function, "if-merge");
+    LLVMBasicBlockRef branchBB = LLVMAppendBasicBlockInContext(builder->context, function, "if-branch");
+    LLVMBasicBlockRef thenBB   = LLVMAppendBasicBlockInContext(builder->context, function, "if-then");
+    LLVMBasicBlockRef elseBB   = LLVMAppendBasicBlockInContext(builder->context, function, "if-else");
+    LLVMBasicBlockRef mergeBB  = LLVMAppendBasicBlockInContext(builder->context, function, "if-merge");
 
     LLVMPositionBuilder(builder->builder, entryBB, NULL);
     LLVMBuildBr(builder->builder, branchBB);
@@ -658,9 +908,9 @@ static inline void _IRBuilderBuildIfStatement(IRBuilderRef builder, LLVMValueRef
 
 static inline void _IRBuilderBuildLoopStatement(IRBuilderRef builder, LLVMValueRef function, ASTLoopStatementRef statement) {
     LLVMBasicBlockRef entryBB  = LLVMGetInsertBlock(builder->builder);
-    LLVMBasicBlockRef branchBB = LLVMAppendBasicBlock(function, "loop-branch");
-    LLVMBasicBlockRef bodyBB   = LLVMAppendBasicBlock(function, "loop-body");
-    LLVMBasicBlockRef endBB    = LLVMAppendBasicBlock(function, "loop-end");
+    LLVMBasicBlockRef branchBB = LLVMAppendBasicBlockInContext(builder->context, function, "loop-branch");
+    LLVMBasicBlockRef bodyBB   = LLVMAppendBasicBlockInContext(builder->context, function, "loop-body");
+    LLVMBasicBlockRef endBB    = LLVMAppendBasicBlockInContext(builder->context, function, "loop-end");
 
     statement->irEntry = bodyBB;
     statement->irExit  = endBB;
@@ -700,8 +950,8 @@ static inline void _IRBuilderBuildLoopStatement(IRBuilderRef builder, LLVMValueR
 
 static inline void _IRBuilderBuildSwitchStatement(IRBuilderRef builder, LLVMValueRef function, ASTSwitchStatementRef statement) {
     LLVMBasicBlockRef insertBB = LLVMGetInsertBlock(builder->builder);
-    LLVMBasicBlockRef branchBB = LLVMAppendBasicBlock(function, "switch-branch");
-    LLVMBasicBlockRef endBB    = LLVMAppendBasicBlock(function, "switch-end");
+    LLVMBasicBlockRef branchBB = LLVMAppendBasicBlockInContext(builder->context, function, "switch-branch");
+    LLVMBasicBlockRef endBB    = LLVMAppendBasicBlockInContext(builder->context, function, "switch-end");
 
     statement->irExit = endBB;
 
@@ -713,7 +963,7 @@ static inline void _IRBuilderBuildSwitchStatement(IRBuilderRef builder, LLVMValu
 
     assert(ASTArrayGetElementCount(statement->cases) > 0);
 
-    LLVMBasicBlockRef caseBodyBB = LLVMAppendBasicBlock(function, "switch-body");
+    LLVMBasicBlockRef caseBodyBB = LLVMAppendBasicBlockInContext(builder->context, function, "switch-body");
 
     ASTArrayIteratorRef iterator = ASTArrayGetIterator(statement->cases);
     while (iterator) {
@@ -727,8 +977,8 @@ static inline void _IRBuilderBuildSwitchStatement(IRBuilderRef builder, LLVMValu
         LLVMBasicBlockRef nextBodyBB   = NULL;
         LLVMBasicBlockRef nextBranchBB = endBB;
         if (iteratorNext) {
-            nextBodyBB    = LLVMAppendBasicBlock(function, "switch-body");
-            nextBranchBB  = LLVMAppendBasicBlock(function, "switch-branch");
+            nextBodyBB    = LLVMAppendBasicBlockInContext(builder->context, function, "switch-body");
+            nextBranchBB  = LLVMAppendBasicBlockInContext(builder->context, function, "switch-branch");
             child->irNext = nextBodyBB;
         }
 
@@ -842,37 +1092,38 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
         _IRBuilderBuildExpression(builder, function, reference->argument);
         LLVMValueRef pointer = NULL;
         if (reference->argument->base.flags & ASTFlagsIsValuePointer) {
-            pointer = reference->argument->base.irValue;
+            pointer = _IRBuilderLookupIRValue(builder, reference->argument);
         } else {
-            pointer = LLVMBuildAlloca(builder->builder, (LLVMTypeRef)reference->argument->base.irType, "");
+            pointer = LLVMBuildAlloca(builder->builder, _IRBuilderLookupIRType(builder, reference->argument), "");
             LLVMBuildStore(builder->builder, _IRBuilderLoadExpression(builder, function, reference->argument), pointer);
         }
 
-        reference->base.base.irType  = _IRBuilderGetIRType(builder, reference->base.type);
-        reference->base.base.irValue = pointer;
+        _IRBuilderSetIRType(builder, reference, _IRBuilderGetIRType(builder, reference->base.type));
+        _IRBuilderSetIRValue(builder, reference, pointer);
         return;
     }
 
     case ASTTagDereferenceExpression: {
         ASTDereferenceExpressionRef dereference = (ASTDereferenceExpressionRef)expression;
         _IRBuilderBuildExpression(builder, function, dereference->argument);
-        dereference->base.base.irType  = _IRBuilderGetIRType(builder, dereference->base.type);
-        dereference->base.base.irValue = LLVMBuildLoad(builder->builder, (LLVMValueRef)dereference->argument->base.irValue, "");
+        _IRBuilderSetIRType(builder, dereference, _IRBuilderGetIRType(builder, dereference->base.type));
+        LLVMValueRef value = LLVMBuildLoad(builder->builder, _IRBuilderLookupIRValue(builder, dereference->argument), "");
+        _IRBuilderSetIRValue(builder, dereference, value);
         return;
     }
 
     case ASTTagIdentifierExpression: {
         ASTIdentifierExpressionRef identifier = (ASTIdentifierExpressionRef)expression;
-        assert(identifier->resolvedDeclaration && identifier->resolvedDeclaration->base.irValue);
+        assert(identifier->resolvedDeclaration && _IRBuilderLookupIRValue(builder, identifier->resolvedDeclaration));
         if (identifier->resolvedDeclaration->base.flags & ASTFlagsIsValuePointer) {
             identifier->base.base.flags |= ASTFlagsIsValuePointer;
         }
 
-        identifier->base.base.irType  = identifier->resolvedDeclaration->base.irType;
-        identifier->base.base.irValue = identifier->resolvedDeclaration->base.irValue;
+        _IRBuilderSetIRType(builder, identifier, _IRBuilderLookupIRType(builder, identifier->resolvedDeclaration));
+        _IRBuilderSetIRValue(builder, identifier, _IRBuilderLookupIRValue(builder, identifier->resolvedDeclaration));
 
         if (identifier->resolvedDeclaration->base.tag == ASTTagFunctionDeclaration) {
-            identifier->base.base.irType = LLVMPointerType((LLVMTypeRef)identifier->base.base.irType, 0);
+            _IRBuilderSetIRType(builder, identifier, LLVMPointerType(_IRBuilderLookupIRType(builder, identifier), 0));
             identifier->base.base.flags |= ASTFlagsIsValuePointer;
         }
 
@@ -886,7 +1137,7 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
         _IRBuilderBuildExpression(builder, function, memberAccess->argument);
         LLVMValueRef pointer = NULL;
         if (memberAccess->argument->base.flags & ASTFlagsIsValuePointer) {
-            pointer = memberAccess->argument->base.irValue;
+            pointer = _IRBuilderLookupIRValue(builder, memberAccess->argument);
         } else {
             LLVMTypeRef argumentType = _IRBuilderGetIRType(builder, memberAccess->argument->type);
             pointer                  = LLVMBuildAlloca(builder->builder, argumentType, "");
@@ -899,8 +1150,8 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
             pointerDepth -= 1;
         }
 
-        memberAccess->base.base.irType  = memberAccess->argument->base.irType;
-        memberAccess->base.base.irValue = LLVMBuildStructGEP(builder->builder, pointer, memberAccess->memberIndex, "");
+        _IRBuilderSetIRType(builder, memberAccess, _IRBuilderLookupIRType(builder, memberAccess->argument));
+        _IRBuilderSetIRValue(builder, memberAccess, LLVMBuildStructGEP(builder->builder, pointer, memberAccess->memberIndex, ""));
         memberAccess->base.base.flags |= ASTFlagsIsValuePointer;
         return;
     }
@@ -910,10 +1161,10 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
         assert(assignment->op == ASTBinaryOperatorAssign && "Composite assignment operations are not supported yet!");
         _IRBuilderBuildExpression(builder, function, assignment->variable);
         _IRBuilderBuildExpression(builder, function, assignment->expression);
-        assignment->base.base.irType  = LLVMVoidType();
-        assignment->base.base.irValue = LLVMBuildStore(builder->builder,
-                                                       _IRBuilderLoadExpression(builder, function, assignment->expression),
-                                                       (LLVMValueRef)assignment->variable->base.irValue);
+        LLVMValueRef value = LLVMBuildStore(builder->builder, _IRBuilderLoadExpression(builder, function, assignment->expression),
+                                            _IRBuilderLookupIRValue(builder, assignment->variable));
+        _IRBuilderSetIRType(builder, assignment, LLVMVoidTypeInContext(builder->context));
+        _IRBuilderSetIRValue(builder, assignment, value);
         return;
     }
 
@@ -926,7 +1177,7 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
         // Prefix and infix functions are currently not added to the declarations of the module and are just contained inside the global
         // scope, so we will force the IR generation of the function here for now...
         // TODO: Remove this after finishing implementation for foreign and prefix infix functions
-        if (!call->callee->type->irType) {
+        if (!_IRBuilderLookupIRType(builder, call->callee->type)) {
             _IRBuilderGetIRType(builder, call->callee->type);
         }
 
@@ -946,9 +1197,9 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
                 ArrayAppendElement(arguments, &argumentValue);
             }
 
-            call->base.base.irValue = (LLVMValueRef)LLVMBuildCall(builder->builder, (LLVMValueRef)initializer->base.base.irValue,
-                                                                  (LLVMValueRef *)ArrayGetMemoryPointer(arguments),
-                                                                  ArrayGetElementCount(arguments), "");
+            LLVMValueRef value = LLVMBuildCall(builder->builder, _IRBuilderLookupIRValue(builder, initializer),
+                                               (LLVMValueRef *)ArrayGetMemoryPointer(arguments), ArrayGetElementCount(arguments), "");
+            _IRBuilderSetIRValue(builder, call, value);
 
             ArrayDestroy(arguments);
             return;
@@ -959,9 +1210,9 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
             ASTExpressionRef arguments[] = {ASTArrayGetElementAtIndex(call->arguments, 0), ASTArrayGetElementAtIndex(call->arguments, 1)};
             _IRBuilderBuildExpression(builder, function, arguments[0]);
             _IRBuilderBuildExpression(builder, function, arguments[1]);
-            LLVMValueRef pointer    = _IRBuilderLoadExpression(builder, function, arguments[0]);
-            LLVMValueRef indices[]  = {_IRBuilderLoadExpression(builder, function, arguments[1])};
-            call->base.base.irValue = LLVMBuildGEP(builder->builder, pointer, indices, 1, "");
+            LLVMValueRef pointer   = _IRBuilderLoadExpression(builder, function, arguments[0]);
+            LLVMValueRef indices[] = {_IRBuilderLoadExpression(builder, function, arguments[1])};
+            _IRBuilderSetIRValue(builder, call, LLVMBuildGEP(builder->builder, pointer, indices, 1, ""));
             return;
         }
 
@@ -970,14 +1221,14 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
         if (call->callee->type->tag == ASTTagPointerType) {
             ASTPointerTypeRef pointerType = (ASTPointerTypeRef)call->callee->type;
             functionType                  = (ASTFunctionTypeRef)pointerType->pointeeType;
-            assert(functionType->resultType->irType);
-            call->base.base.irType = functionType->resultType->irType;
-            declaration            = functionType->declaration;
+            assert(_IRBuilderLookupIRType(builder, functionType->resultType));
+            _IRBuilderSetIRType(builder, call, _IRBuilderLookupIRType(builder, functionType->resultType));
+            declaration = functionType->declaration;
         } else {
             functionType = (ASTFunctionTypeRef)call->callee->type;
-            assert(functionType->resultType->irType);
-            call->base.base.irType = functionType->resultType->irType;
-            declaration            = functionType->declaration;
+            assert(_IRBuilderLookupIRType(builder, functionType->resultType));
+            _IRBuilderSetIRType(builder, call, _IRBuilderLookupIRType(builder, functionType->resultType));
+            declaration = functionType->declaration;
         }
 
         if (!declaration || declaration->base.base.tag == ASTTagFunctionDeclaration) {
@@ -993,13 +1244,14 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
                 ArrayAppendElement(arguments, &argumentValue);
             }
 
-            LLVMValueRef callee = call->callee->base.irValue;
+            LLVMValueRef callee = _IRBuilderLookupIRValue(builder, call->callee);
             if (call->callee->type->tag == ASTTagPointerType) {
                 callee = _IRBuilderLoadExpression(builder, function, call->callee);
             }
 
-            call->base.base.irValue = (LLVMValueRef)LLVMBuildCall(
-                builder->builder, callee, (LLVMValueRef *)ArrayGetMemoryPointer(arguments), ArrayGetElementCount(arguments), "");
+            LLVMValueRef value = LLVMBuildCall(builder->builder, callee, (LLVMValueRef *)ArrayGetMemoryPointer(arguments),
+                                               ArrayGetElementCount(arguments), "");
+            _IRBuilderSetIRValue(builder, call, value);
 
             ArrayDestroy(arguments);
         } else if (declaration->base.base.tag == ASTTagForeignFunctionDeclaration) {
@@ -1015,8 +1267,9 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
                 ArrayAppendElement(arguments, &argumentValue);
             }
 
-            call->base.base.irValue = LLVMBuildCall(builder->builder, (LLVMValueRef)declaration->base.base.irValue,
-                                                    (LLVMValueRef *)ArrayGetMemoryPointer(arguments), ArrayGetElementCount(arguments), "");
+            LLVMValueRef value = LLVMBuildCall(builder->builder, _IRBuilderLookupIRValue(builder, declaration),
+                                               (LLVMValueRef *)ArrayGetMemoryPointer(arguments), ArrayGetElementCount(arguments), "");
+            _IRBuilderSetIRValue(builder, call, value);
             ArrayDestroy(arguments);
         } else if (declaration->base.base.tag == ASTTagIntrinsicFunctionDeclaration) {
             ArrayRef arguments = ArrayCreateEmpty(builder->allocator, sizeof(LLVMValueRef), ASTArrayGetElementCount(call->arguments));
@@ -1024,15 +1277,15 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
                 ASTExpressionRef argument        = (ASTExpressionRef)ASTArrayGetElementAtIndex(call->arguments, index);
                 ASTValueDeclarationRef parameter = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(declaration->parameters, index);
                 _IRBuilderBuildExpression(builder, function, argument);
-                argument->base.irValue = _IRBuilderLoadExpression(builder, function, argument);
-                argument->base.irValue = _IRBuilderImplicitlyConvertValue(builder, function, argument->base.irValue, argument,
-                                                                          parameter->base.type);
-                ArrayAppendElement(arguments, &argument->base.irValue);
+                LLVMValueRef argumentValue = _IRBuilderLoadExpression(builder, function, argument);
+                argumentValue = _IRBuilderImplicitlyConvertValue(builder, function, argumentValue, argument, parameter->base.type);
+                ArrayAppendElement(arguments, &argumentValue);
             }
 
-            call->base.base.irValue = _IRBuilderBuildIntrinsic(
-                builder, function, declaration->intrinsicName, (LLVMValueRef *)ArrayGetMemoryPointer(arguments),
-                ArrayGetElementCount(arguments), (LLVMTypeRef)declaration->returnType->irType);
+            LLVMValueRef value = _IRBuilderBuildIntrinsic(builder, function, declaration->intrinsicName,
+                                                          (LLVMValueRef *)ArrayGetMemoryPointer(arguments), ArrayGetElementCount(arguments),
+                                                          _IRBuilderLookupIRType(builder, declaration->returnType));
+            _IRBuilderSetIRValue(builder, call, value);
             ArrayDestroy(arguments);
         } else {
             JELLY_UNREACHABLE("Invalid tag given for ASTFunctionDeclaration!");
@@ -1046,7 +1299,7 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
 
     case ASTTagSizeOfExpression: {
         ASTSizeOfExpressionRef sizeOf = (ASTSizeOfExpressionRef)expression;
-        sizeOf->base.base.irValue     = _IRBuilderGetConstantSizeOfType(builder, sizeOf->sizeType);
+        _IRBuilderSetIRValue(builder, sizeOf, _IRBuilderGetConstantSizeOfType(builder, sizeOf->sizeType));
         return;
     }
 
@@ -1062,10 +1315,10 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
         _IRBuilderBuildExpression(builder, function, subscript->expression);
         _IRBuilderBuildExpression(builder, function, argument);
 
-        LLVMValueRef pointer         = subscript->expression->base.irValue;
-        LLVMValueRef indices[]       = {LLVMConstInt((LLVMTypeRef)argument->type->irType, 0, false),
+        LLVMValueRef pointer   = _IRBuilderLookupIRValue(builder, subscript->expression);
+        LLVMValueRef indices[] = {LLVMConstInt(_IRBuilderLookupIRType(builder, argument->type), 0, false),
                                   _IRBuilderLoadExpression(builder, function, argument)};
-        subscript->base.base.irValue = LLVMBuildInBoundsGEP(builder->builder, pointer, indices, 2, "");
+        _IRBuilderSetIRValue(builder, subscript, LLVMBuildInBoundsGEP(builder->builder, pointer, indices, 2, ""));
         subscript->base.base.flags |= ASTFlagsIsValuePointer;
         return;
     }
@@ -1086,7 +1339,7 @@ static inline void _IRBuilderBuildExpression(IRBuilderRef builder, LLVMValueRef
         case ASTTypeOperationTypeBitcast: {
             LLVMValueRef value                = _IRBuilderLoadExpression(builder, function, typeExpression->expression);
             LLVMTypeRef targetType            = _IRBuilderGetIRType(builder, typeExpression->argumentType);
-            typeExpression->base.base.irValue = LLVMBuildBitCast(builder->builder, value, targetType, "");
+            _IRBuilderSetIRValue(builder, typeExpression, LLVMBuildBitCast(builder->builder, value, targetType, ""));
             return;
         }
         }
@@ -1107,35 +1360,38 @@ static inline void _IRBuilderBuildConstantExpression(IRBuilderRef builder, ASTEx
         ASTConstantExpressionRef constant = (ASTConstantExpressionRef)expression;
         switch (constant->kind) {
         case ASTConstantKindNil:
-            constant->base.base.irValue = LLVMConstNull(type);
+            _IRBuilderSetIRValue(builder, constant, LLVMConstNull(type));
             return;
 
         case ASTConstantKindBool:
-            constant->base.base.irValue = LLVMConstInt(type, constant->boolValue ? 1 : 0, false);
+            _IRBuilderSetIRValue(builder, constant, LLVMConstInt(type, constant->boolValue ? 1 : 0, false));
             return;
 
         case ASTConstantKindInt:
-            constant->base.base.irValue = LLVMConstInt(type, constant->intValue, false);
+            _IRBuilderSetIRValue(builder, constant, LLVMConstInt(type, constant->intValue, false));
             return;
 
         case ASTConstantKindFloat:
-            constant->base.base.irValue = LLVMConstReal(type, constant->floatValue);
+            _IRBuilderSetIRValue(builder, constant, LLVMConstReal(type, constant->floatValue));
             return;
 
         case ASTConstantKindString: {
+            LLVMTypeRef int8Type   = LLVMInt8TypeInContext(builder->context);
+            LLVMTypeRef int32Type  = LLVMInt32TypeInContext(builder->context);
+            LLVMTypeRef int64Type  = LLVMInt64TypeInContext(builder->context);
             LLVMValueRef buffer    = LLVMConstStringInContext(builder->context, StringGetCharacters(constant->stringValue),
                                                            StringGetLength(constant->stringValue), false);
             LLVMValueRef bufferVar = LLVMAddGlobal(builder->module->module,
-                                                   LLVMArrayType(LLVMInt8Type(), StringGetLength(constant->stringValue) + 1), "");
+                                                   LLVMArrayType(int8Type, StringGetLength(constant->stringValue) + 1), "");
             LLVMSetInitializer(bufferVar, buffer);
             LLVMSetGlobalConstant(bufferVar, true);
 
-            LLVMValueRef indices[]      = {LLVMConstInt(LLVMInt32Type(), 0, false), LLVMConstInt(LLVMInt32Type(), 0, false)};
+            LLVMValueRef indices[]      = {LLVMConstInt(int32Type, 0, false), LLVMConstInt(int32Type, 0, false)};
             LLVMValueRef bufferPtr      = LLVMConstGEP(bufferVar, indices, 2);
-            LLVMValueRef stringValues[] = {bufferPtr, LLVMConstInt(LLVMInt64Type(), StringGetLength(constant->stringValue), true)};
+            LLVMValueRef stringValues[] = {bufferPtr, LLVMConstInt(int64Type, StringGetLength(constant->stringValue), true)};
             LLVMTypeRef stringType      = _IRBuilderGetIRType(builder, (ASTTypeRef)ASTContextGetStringType(builder->astContext));
             LLVMValueRef initializer    = LLVMConstNamedStruct(stringType, stringValues, 2);
-            constant->base.base.irValue = initializer;
+            _IRBuilderSetIRValue(builder, constant, initializer);
             return;
         }
 
@@ -1152,48 +1408,50 @@ static inline LLVMValueRef _IRBuilderBuildBinaryExpression(IRBuilderRef builder,
                                                            LLVMValueRef *arguments) {
     // Infix functions are currently not added to the declarations of the module and are just contained inside the global scope, so we
     // will force the IR generation of the function here for now...
-    if (!callee->base.base.irType) {
+    if (!_IRBuilderLookupIRType(builder, callee)) {
         assert(ASTArrayGetElementCount(callee->parameters) == 2);
         ASTValueDeclarationRef lhsParameter = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(callee->parameters, 0);
         ASTValueDeclarationRef rhsParameter = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(callee->parameters, 1);
         LLVMTypeRef parameterTypes[]        = {_IRBuilderGetIRType(builder, lhsParameter->base.type),
                                         _IRBuilderGetIRType(builder, rhsParameter->base.type)};
-        callee->base.base.irType            = LLVMFunctionType(_IRBuilderGetIRType(builder, callee->returnType), parameterTypes, 2, false);
+        LLVMTypeRef calleeType              = LLVMFunctionType(_IRBuilderGetIRType(builder, callee->returnType), parameterTypes, 2, false);
+        _IRBuilderSetIRType(builder, callee, calleeType);
     }
 
     if (callee->base.base.tag == ASTTagFunctionDeclaration) {
         _IRBuilderBuildFunctionBody(builder, callee);
-        LLVMValueRef opFunction = (LLVMValueRef)callee->base.base.irValue;
+        LLVMValueRef opFunction = _IRBuilderLookupIRValue(builder, callee);
         return LLVMBuildCall(builder->builder, opFunction, arguments, 2, "");
     } else if (callee->base.base.tag == ASTTagForeignFunctionDeclaration) {
         _IRBuilderBuildForeignFunctionSignature(builder, callee);
-        LLVMValueRef opFunction = (LLVMValueRef)callee->base.base.irValue;
+        LLVMValueRef opFunction = _IRBuilderLookupIRValue(builder, callee);
         return LLVMBuildCall(builder->builder, opFunction, arguments, 2, "");
     } else if (callee->base.base.tag == ASTTagIntrinsicFunctionDeclaration) {
-        return _IRBuilderBuildIntrinsic(builder, function, callee->intrinsicName, arguments, 2, (LLVMTypeRef)callee->returnType->irType);
+        return _IRBuilderBuildIntrinsic(builder, function, callee->intrinsicName, arguments, 2,
+                                        _IRBuilderLookupIRType(builder, callee->returnType));
     } else {
         JELLY_UNREACHABLE("Invalid tag given for ASTFunctionDeclaration!");
     }
 }
 
 static inline LLVMValueRef _IRBuilderLoadExpression(IRBuilderRef builder, LLVMValueRef function, ASTExpressionRef expression) {
-    assert(expression->base.irValue);
+    assert(_IRBuilderLookupIRValue(builder, expression));
 
     if (expression->base.flags & ASTFlagsIsValuePointer) {
-        return LLVMBuildLoad(builder->builder, (LLVMValueRef)expression->base.irValue, "");
+        return LLVMBuildLoad(builder->builder, _IRBuilderLookupIRValue(builder, expression), "");
     }
 
-    return (LLVMValueRef)expression->base.irValue;
+    return _IRBuilderLookupIRValue(builder, expression);
 }
 
 static inline LLVMTypeRef _IRBuilderGetIRType(IRBuilderRef builder, ASTTypeRef type) {
     assert(type && type->tag != ASTTagOpaqueType);
 
-    if (type->irType) {
-        return (LLVMTypeRef)type->irType;
+    LLVMTypeRef llvmType = _IRBuilderLookupIRType(builder, type);
+    if (llvmType) {
+        return llvmType;
     }
 
-    LLVMTypeRef llvmType = NULL;
     switch (type->tag) {
     case ASTTagPointerType: {
         ASTPointerTypeRef pointerType = (ASTPointerTypeRef)type;
@@ -1217,42 +1475,42 @@ static inline LLVMTypeRef _IRBuilderGetIRType(IRBuilderRef builder, ASTTypeRef t
         ASTBuiltinTypeRef builtinType = (ASTBuiltinTypeRef)type;
         switch (builtinType->kind) {
         case ASTBuiltinTypeKindVoid:
-            llvmType = LLVMVoidType();
+            llvmType = LLVMVoidTypeInContext(builder->context);
             break;
 
         case ASTBuiltinTypeKindBool:
-            llvmType = LLVMInt1Type();
+            llvmType = LLVMInt1TypeInContext(builder->context);
             break;
 
         case ASTBuiltinTypeKindInt8:
         case ASTBuiltinTypeKindUInt8:
-            llvmType = LLVMInt8Type();
+            llvmType = LLVMInt8TypeInContext(builder->context);
             break;
 
         case ASTBuiltinTypeKindInt16:
         case ASTBuiltinTypeKindUInt16:
-            llvmType = LLVMInt16Type();
+            llvmType = LLVMInt16TypeInContext(builder->context);
             break;
 
         case ASTBuiltinTypeKindInt32:
         case ASTBuiltinTypeKindUInt32:
-            llvmType = LLVMInt32Type();
+            llvmType = LLVMInt32TypeInContext(builder->context);
             break;
 
         case ASTBuiltinTypeKindInt64:
         case ASTBuiltinTypeKindUInt64:
         case ASTBuiltinTypeKindInt:
         case ASTBuiltinTypeKindUInt:
-            llvmType = LLVMInt64Type();
+            llvmType = LLVMInt64TypeInContext(builder->context);
             break;
 
         case ASTBuiltinTypeKindFloat32:
-            llvmType = LLVMFloatType();
+            llvmType = LLVMFloatTypeInContext(builder->context);
             break;
 
         case ASTBuiltinTypeKindFloat64:
         case ASTBuiltinTypeKindFloat:
-            llvmType = LLVMDoubleType();
+            llvmType = LLVMDoubleTypeInContext(builder->context);
             break;
 
         default:
@@ -1265,7 +1523,7 @@ static inline LLVMTypeRef _IRBuilderGetIRType(IRBuilderRef builder, ASTTypeRef t
 
     case ASTTagEnumerationType: {
         // TODO: Replace enumeration type with the least required bit size int based on the represented values of the enumeration elements
-        llvmType = LLVMInt64Type();
+        llvmType = LLVMInt64TypeInContext(builder->context);
         break;
     }
 
@@ -1275,26 +1533,25 @@ static inline LLVMTypeRef _IRBuilderGetIRType(IRBuilderRef builder, ASTTypeRef t
                                                    ASTArrayGetElementCount(functionType->parameterTypes));
         ASTArrayIteratorRef iterator    = ASTArrayGetIterator(functionType->parameterTypes);
         while (iterator) {
-            ASTTypeRef parameterType = ASTArrayIteratorGetElement(iterator);
-            parameterType->irType    = _IRBuilderGetIRType(builder, parameterType);
-            ArrayAppendElement(parameterTypes, &parameterType->irType);
+            LLVMTypeRef parameterType = _IRBuilderGetIRType(builder, (ASTTypeRef)ASTArrayIteratorGetElement(iterator));
+            ArrayAppendElement(parameterTypes, &parameterType);
             iterator = ASTArrayIteratorNext(iterator);
         }
 
-        functionType->resultType->irType = _IRBuilderGetIRType(builder, functionType->resultType);
-
-        llvmType = LLVMFunctionType((LLVMTypeRef)functionType->resultType->irType, (LLVMTypeRef *)ArrayGetMemoryPointer(parameterTypes),
-                                    ArrayGetElementCount(parameterTypes), false);
+        LLVMTypeRef resultType = _IRBuilderGetIRType(builder, functionType->resultType);
+        llvmType = LLVMFunctionType(resultType, (LLVMTypeRef *)ArrayGetMemoryPointer(parameterTypes), ArrayGetElementCount(parameterTypes),
+                                    false);
         ArrayDestroy(parameterTypes);
         break;
     }
 
     case ASTTagStructureType: {
         ASTStructureTypeRef structureType = (ASTStructureTypeRef)type;
-        if (structureType->declaration->base.base.irType) {
-            llvmType = (LLVMTypeRef)structureType->declaration->base.base.irType;
-        } else {
+        llvmType                          = _IRBuilderLookupIRType(builder, structureType->declaration);
+        if (!llvmType) {
+            // Structures of imported modules are not part of the module being built, so their named type is created on first use
             llvmType = LLVMStructCreateNamed(builder->context, StringGetCharacters(structureType->declaration->base.mangledName));
+            _IRBuilderSetIRType(builder, structureType->declaration, llvmType);
 
             ArrayRef temporaryTypes = ArrayCreateEmpty(builder->allocator, sizeof(LLVMTypeRef),
                                                        ASTArrayGetElementCount(structureType->declaration->values));
@@ -1314,7 +1571,7 @@ static inline LLVMTypeRef _IRBuilderGetIRType(IRBuilderRef builder, ASTTypeRef t
         break;
     }
 
-    type->irType = llvmType;
+    _IRBuilderSetIRType(builder, type, llvmType);
     return llvmType;
 }
 
@@ -1326,8 +1583,8 @@ static inline LLVMValueRef _IRBuilderBuildIntrinsic(IRBuilderRef builder, LLVMVa
             return LLVMGetUndef(resultType);
         }
 
-        return LLVMBuildSelect(builder->builder, arguments[0], LLVMConstInt(LLVMInt1Type(), 0, false),
-                               LLVMConstInt(LLVMInt1Type(), 1, false), "");
+        return LLVMBuildSelect(builder->builder, arguments[0], LLVMConstInt(LLVMInt1TypeInContext(builder->context), 0, false),
+                               LLVMConstInt(LLVMInt1TypeInContext(builder->context), 1, false), "");
     }
 
     if (StringIsEqualToCString(intrinsic, "bitwise_neg_i8")) {
@@ -1336,7 +1593,7 @@ static inline LLVMValueRef _IRBuilderBuildIntrinsic(IRBuilderRef builder, LLVMVa
             return LLVMGetUndef(resultType);
         }
 
-        LLVMValueRef mask = LLVMConstInt(LLVMInt8Type(), 0xFF, false);
+        LLVMValueRef mask = LLVMConstInt(LLVMInt8TypeInContext(builder->context), 0xFF, false);
         return LLVMBuildSub(builder->builder, mask, arguments[0], "");
     }
 
@@ -1346,7 +1603,7 @@ static inline LLVMValueRef _IRBuilderBuildIntrinsic(IRBuilderRef builder, LLVMVa
             return LLVMGetUndef(resultType);
         }
 
-        LLVMValueRef mask = LLVMConstInt(LLVMInt16Type(), 0xFFFF, false);
+        LLVMValueRef mask = LLVMConstInt(LLVMInt16TypeInContext(builder->context), 0xFFFF, false);
         return LLVMBuildSub(builder->builder, mask, arguments[0], "");
     }
 
@@ -1356,7 +1613,7 @@ static inline LLVMValueRef _IRBuilderBuildIntrinsic(IRBuilderRef builder, LLVMVa
             return LLVMGetUndef(resultType);
         }
 
-        LLVMValueRef mask = LLVMConstInt(LLVMInt32Type(), 0xFFFFFFFF, false);
+        LLVMValueRef mask = LLVMConstInt(LLVMInt32TypeInContext(builder->context), 0xFFFFFFFF, false);
         return LLVMBuildSub(builder->builder, mask, arguments[0], "");
     }
 
@@ -1366,7 +1623,7 @@ static inline LLVMValueRef _IRBuilderBuildIntrinsic(IRBuilderRef builder, LLVMVa
             return LLVMGetUndef(resultType);
         }
 
-        LLVMValueRef mask = LLVMConstInt(LLVMInt64Type(), 0xFFFFFFFFFFFFFFFF, false);
+        LLVMValueRef mask = LLVMConstInt(LLVMInt64TypeInContext(builder->context), 0xFFFFFFFFFFFFFFFF, false);
         return LLVMBuildSub(builder->builder, mask, arguments[0], "");
     }
 
@@ -1707,8 +1964,8 @@ static inline LLVMValueRef _IRBuilderBuildIntrinsic(IRBuilderRef builder, LLVMVa
             return LLVMGetUndef(resultType);
         }
 
-        LLVMValueRef lhs = LLVMBuildPtrToInt(builder->builder, arguments[0], LLVMInt64Type(), "");
-        LLVMValueRef rhs = LLVMBuildPtrToInt(builder->builder, arguments[1], LLVMInt64Type(), "");
+        LLVMValueRef lhs = LLVMBuildPtrToInt(builder->builder, arguments[0], LLVMInt64TypeInContext(builder->context), "");
+        LLVMValueRef rhs = LLVMBuildPtrToInt(builder->builder, arguments[1], LLVMInt64TypeInContext(builder->context), "");
         return LLVMBuildICmp(builder->builder, LLVMIntEQ, lhs, rhs, "");
     }
 
@@ -1737,8 +1994,8 @@ static inline LLVMValueRef _IRBuilderBuildIntrinsic(IRBuilderRef builder, LLVMVa
             return LLVMGetUndef(resultType);
         }
 
-        LLVMValueRef lhs = LLVMBuildPtrToInt(builder->builder, arguments[0], LLVMInt64Type(), "");
-        LLVMValueRef rhs = LLVMBuildPtrToInt(builder->builder, arguments[1], LLVMInt64Type(), "");
+        LLVMValueRef lhs = LLVMBuildPtrToInt(builder->builder, arguments[0], LLVMInt64TypeInContext(builder->context), "");
+        LLVMValueRef rhs = LLVMBuildPtrToInt(builder->builder, arguments[1], LLVMInt64TypeInContext(builder->context), "");
         return LLVMBuildICmp(builder->builder, LLVMIntNE, lhs, rhs, "");
     }
 
@@ -1748,8 +2005,8 @@ static inline LLVMValueRef _IRBuilderBuildIntrinsic(IRBuilderRef builder, LLVMVa
             return LLVMGetUndef(resultType);
         }
 
-        LLVMValueRef lhs = LLVMBuildPtrToInt(builder->builder, arguments[0], LLVMInt64Type(), "");
-        LLVMValueRef rhs = LLVMBuildPtrToInt(builder->builder, arguments[1], LLVMInt64Type(), "");
+        LLVMValueRef lhs = LLVMBuildPtrToInt(builder->builder, arguments[0], LLVMInt64TypeInContext(builder->context), "");
+        LLVMValueRef rhs = LLVMBuildPtrToInt(builder->builder, arguments[1], LLVMInt64TypeInContext(builder->context), "");
         return LLVMBuildSub(builder->builder, lhs, rhs, "");
     }
 
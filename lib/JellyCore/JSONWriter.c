@@ -0,0 +1,33 @@
+#include "JellyCore/JSONWriter.h"
+
+void JSONWriteString(FILE *output, const Char *string) {
+    fputc('"', output);
+    for (const Char *cursor = string; *cursor; cursor++) {
+        switch (*cursor) {
+        case '"':
+            fputs("\\\"", output);
+            break;
+
+        case '\\':
+            fputs("\\\\", output);
+            break;
+
+        case '\n':
+            fputs("\\n", output);
+            break;
+
+        case '\t':
+            fputs("\\t", output);
+            break;
+
+        default:
+            if ((UInt8)*cursor < 0x20) {
+                fprintf(output, "\\u%04x", (UInt8)*cursor);
+            } else {
+                fputc(*cursor, output);
+            }
+            break;
+        }
+    }
+    fputc('"', output);
+}
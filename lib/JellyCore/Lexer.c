@@ -2,9 +2,131 @@
 #include "JellyCore/Diagnostic.h"
 #include "JellyCore/Lexer.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+enum _LexerCharacterClass {
+    LexerCharacterClassLetter           = 1 << 0,
+    LexerCharacterClassUnderscore       = 1 << 1,
+    LexerCharacterClassBinaryDigit      = 1 << 2,
+    LexerCharacterClassOctalDigit       = 1 << 3,
+    LexerCharacterClassDecimalDigit     = 1 << 4,
+    LexerCharacterClassHexadecimalDigit = 1 << 5,
+};
+
+static const UInt8 _kLexerCharacterClasses[256] = {
+    ['0' ... '1'] = LexerCharacterClassBinaryDigit | LexerCharacterClassOctalDigit | LexerCharacterClassDecimalDigit |
+                    LexerCharacterClassHexadecimalDigit,
+    ['2' ... '7'] = LexerCharacterClassOctalDigit | LexerCharacterClassDecimalDigit | LexerCharacterClassHexadecimalDigit,
+    ['8' ... '9'] = LexerCharacterClassDecimalDigit | LexerCharacterClassHexadecimalDigit,
+    ['A' ... 'F'] = LexerCharacterClassLetter | LexerCharacterClassHexadecimalDigit,
+    ['G' ... 'Z'] = LexerCharacterClassLetter,
+    ['_']         = LexerCharacterClassUnderscore,
+    ['a' ... 'f'] = LexerCharacterClassLetter | LexerCharacterClassHexadecimalDigit,
+    ['g' ... 'z'] = LexerCharacterClassLetter,
+};
+
+struct _LexerKeyword {
+    const Char *name;
+    TokenKind kind;
+};
+typedef struct _LexerKeyword LexerKeyword;
+
+// The keywords are grouped by their length and each group is terminated by a NULL entry, the lookup only has to compare the first
+// character of the few keywords with the same length before comparing the remaining characters.
+static const LexerKeyword _kLexerKeywords2[] = {
+    {"as", TokenKindKeywordAs},
+    {"do", TokenKindKeywordDo},
+    {"if", TokenKindKeywordIf},
+    {"is", TokenKindKeywordIs},
+    {NULL, 0},
+};
+
+static const LexerKeyword _kLexerKeywords3[] = {
+    {"Int", TokenKindKeywordInt},
+    {"nil", TokenKindKeywordNil},
+    {"var", TokenKindKeywordVar},
+    {NULL, 0},
+};
+
+static const LexerKeyword _kLexerKeywords4[] = {
+    {"Bool", TokenKindKeywordBool}, {"Int8", TokenKindKeywordInt8}, {"UInt", TokenKindKeywordUInt}, {"Void", TokenKindKeywordVoid},
+    {"case", TokenKindKeywordCase}, {"else", TokenKindKeywordElse}, {"enum", TokenKindKeywordEnum}, {"func", TokenKindKeywordFunc},
+    {"init", TokenKindKeywordInit}, {"true", TokenKindKeywordTrue}, {NULL, 0},
+};
+
+static const LexerKeyword _kLexerKeywords5[] = {
+    {"Float", TokenKindKeywordFloat}, {"Int16", TokenKindKeywordInt16}, {"Int32", TokenKindKeywordInt32},
+    {"Int64", TokenKindKeywordInt64}, {"UInt8", TokenKindKeywordUInt8}, {"break", TokenKindKeywordBreak},
+    {"false", TokenKindKeywordFalse}, {"while", TokenKindKeywordWhile}, {NULL, 0},
+};
+
+static const LexerKeyword _kLexerKeywords6[] = {
+    {"UInt16", TokenKindKeywordUInt16}, {"UInt32", TokenKindKeywordUInt32}, {"UInt64", TokenKindKeywordUInt64},
+    {"module", TokenKindKeywordModule}, {"return", TokenKindKeywordReturn}, {"sizeof", TokenKindKeywordSizeOf},
+    {"struct", TokenKindKeywordStruct}, {"switch", TokenKindKeywordSwitch}, {NULL, 0},
+};
+
+static const LexerKeyword _kLexerKeywords7[] = {
+    {"Float32", TokenKindKeywordFloat32},
+    {"Float64", TokenKindKeywordFloat64},
+    {NULL, 0},
+};
+
+static const LexerKeyword _kLexerKeywords8[] = {
+    {"continue", TokenKindKeywordContinue},
+    {NULL, 0},
+};
+
+static const LexerKeyword _kLexerKeywords9[] = {
+    {"typealias", TokenKindKeywordTypeAlias},
+    {NULL, 0},
+};
+
+static const LexerKeyword _kLexerKeywords11[] = {
+    {"fallthrough", TokenKindKeywordFallthrough},
+    {NULL, 0},
+};
+
+#define _kLexerKeywordMaxLength 11
+
+static const LexerKeyword *_kLexerKeywords[_kLexerKeywordMaxLength + 1] = {
+    [2] = _kLexerKeywords2, [3] = _kLexerKeywords3, [4] = _kLexerKeywords4, [5] = _kLexerKeywords5,   [6] = _kLexerKeywords6,
+    [7] = _kLexerKeywords7, [8] = _kLexerKeywords8, [9] = _kLexerKeywords9, [11] = _kLexerKeywords11,
+};
+
+static const LexerKeyword _kLexerDirectives4[] = {
+    {"link", TokenKindDirectiveLink},
+    {"load", TokenKindDirectiveLoad},
+    {NULL, 0},
+};
+
+static const LexerKeyword _kLexerDirectives6[] = {
+    {"import", TokenKindDirectiveImport},
+    {NULL, 0},
+};
+
+static const LexerKeyword _kLexerDirectives7[] = {
+    {"foreign", TokenKindDirectiveForeign},
+    {"include", TokenKindDirectiveInclude},
+    {NULL, 0},
+};
+
+static const LexerKeyword _kLexerDirectives9[] = {
+    {"intrinsic", TokenKindDirectiveIntrinsic},
+    {NULL, 0},
+};
+
+static const LexerKeyword *_kLexerDirectives[_kLexerKeywordMaxLength + 1] = {
+    [4] = _kLexerDirectives4,
+    [6] = _kLexerDirectives6,
+    [7] = _kLexerDirectives7,
+    [9] = _kLexerDirectives9,
+};
+
 struct _Lexer {
     AllocatorRef allocator;
-    StringRef buffer;
     const Char *bufferStart;
     const Char *bufferEnd;
     struct _LexerState state;
@@ -18,16 +140,27 @@ static inline Bool _CharIsOctalDigit(Char character);
 static inline Bool _CharIsDecimalDigit(Char character);
 static inline Bool _CharIsHexadecimalDigit(Char character);
 
+static inline LexerRef _LexerCreate(AllocatorRef allocator, const Char *bufferStart, Index bufferLength);
 static inline void _LexerLexNextToken(LexerRef lexer);
+static inline Index _LexerScanIdentifierTail(const Char *cursor, const Char *end);
+static inline TokenKind _LexerLookupKeyword(const LexerKeyword **keywords, SourceRange range, TokenKind defaultKind);
 
 LexerRef LexerCreate(AllocatorRef allocator, StringRef buffer) {
     assert(buffer);
+    return _LexerCreate(allocator, StringGetCharacters(buffer), StringGetLength(buffer));
+}
+
+LexerRef LexerCreateFromSourceBuffer(AllocatorRef allocator, SourceBufferRef buffer) {
+    assert(buffer);
+    return _LexerCreate(allocator, SourceBufferGetCharacters(buffer), SourceBufferGetLength(buffer));
+}
+
+static inline LexerRef _LexerCreate(AllocatorRef allocator, const Char *bufferStart, Index bufferLength) {
     LexerRef lexer = (LexerRef)AllocatorAllocate(allocator, sizeof(struct _Lexer));
     assert(lexer);
     lexer->allocator    = allocator;
-    lexer->buffer       = buffer;
-    lexer->bufferStart  = StringGetCharacters(buffer);
-    lexer->bufferEnd    = lexer->bufferStart + StringGetLength(buffer);
+    lexer->bufferStart  = bufferStart;
+    lexer->bufferEnd    = bufferStart + bufferLength;
     lexer->state.lexer  = lexer;
     lexer->state.cursor = lexer->bufferStart;
     lexer->state.line   = 1;
@@ -57,43 +190,128 @@ void LexerNextToken(LexerRef lexer, Token *token) {
     memcpy(token, &lexer->state.token, sizeof(Token));
 }
 
+StringView TokenGetView(const Token *token) {
+    return StringViewMake(token->location.start, token->location.end);
+}
+
+/// Skips the whole run of whitespace and newline characters at the cursor and returns true if at least one character has been skipped.
+/// Each of the characters 0x0A to 0x0D starts a new line. The run is classified 16 characters at once if SSE2 is available.
 static inline Bool _LexerSkipWhitespaceAndNewlines(LexerRef lexer) {
+    const Char *start = lexer->state.cursor;
+
+#if defined(__SSE2__)
+    const __m128i space               = _mm_set1_epi8(0x20);
+    const __m128i tab                 = _mm_set1_epi8(0x09);
+    const __m128i lineBreakLowerBound = _mm_set1_epi8(0x0A - 1);
+    const __m128i lineBreakUpperBound = _mm_set1_epi8(0x0D + 1);
+    while (lexer->state.cursor + 16 <= lexer->bufferEnd) {
+        __m128i characters = _mm_loadu_si128((const __m128i *)lexer->state.cursor);
+        __m128i lineBreaks = _mm_and_si128(_mm_cmpgt_epi8(characters, lineBreakLowerBound),
+                                           _mm_cmpgt_epi8(lineBreakUpperBound, characters));
+        __m128i blanks     = _mm_or_si128(_mm_cmpeq_epi8(characters, space), _mm_cmpeq_epi8(characters, tab));
+        UInt32 mask          = (UInt32)_mm_movemask_epi8(_mm_or_si128(lineBreaks, blanks));
+        UInt32 count         = (UInt32)__builtin_ctz(~mask);
+        UInt32 lineBreakMask = (UInt32)_mm_movemask_epi8(lineBreaks) & ((1u << count) - 1);
+        if (lineBreakMask) {
+            // The column restarts after the last line break of the run
+            lexer->state.line += __builtin_popcount(lineBreakMask);
+            lexer->state.column = count - (32 - __builtin_clz(lineBreakMask));
+        } else {
+            lexer->state.column += count;
+        }
+
+        lexer->state.cursor += count;
+        if (count < 16) {
+            return lexer->state.cursor != start;
+        }
+    }
+#endif
+
     while (lexer->state.cursor < lexer->bufferEnd) {
-        switch (*lexer->state.cursor) {
-        case 0x09:
-        case 0x20:
-            lexer->state.cursor += 1;
+        Char character = *lexer->state.cursor;
+        if (character == 0x09 || character == 0x20) {
             lexer->state.column += 1;
-            return true;
-
-        case 0x0A:
-        case 0x0B:
-        case 0x0C:
-        case 0x0D:
-            lexer->state.cursor += 1;
+        } else if (character >= 0x0A && character <= 0x0D) {
             lexer->state.line += 1;
             lexer->state.column = 0;
-            return true;
-
-        default:
-            return false;
+        } else {
+            break;
         }
+
+        lexer->state.cursor += 1;
     }
 
-    return false;
+    return lexer->state.cursor != start;
 }
 
 static inline void _LexerSkipToEndOfLine(LexerRef lexer) {
+#if defined(__SSE2__)
+    const __m128i lineFeed       = _mm_set1_epi8('\n');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    while (lexer->state.cursor + 16 <= lexer->bufferEnd) {
+        __m128i characters = _mm_loadu_si128((const __m128i *)lexer->state.cursor);
+        UInt32 mask        = (UInt32)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(characters, lineFeed), _mm_cmpeq_epi8(characters, carriageReturn)));
+        if (mask) {
+            UInt32 count = (UInt32)__builtin_ctz(mask);
+            lexer->state.cursor += count;
+            lexer->state.column += count;
+            return;
+        }
+
+        lexer->state.cursor += 16;
+        lexer->state.column += 16;
+    }
+#endif
+
     while (lexer->state.cursor < lexer->bufferEnd && *lexer->state.cursor != '\n' && *lexer->state.cursor != '\r') {
         lexer->state.cursor += 1;
         lexer->state.column += 1;
     }
 }
 
+/// Skips all characters of a multiline comment which can't end the comment, open a nested comment or start a new line.
+static inline void _LexerSkipCommentText(LexerRef lexer) {
+#if defined(__SSE2__)
+    const __m128i asterisk            = _mm_set1_epi8('*');
+    const __m128i slash               = _mm_set1_epi8('/');
+    const __m128i lineBreakLowerBound = _mm_set1_epi8(0x0A - 1);
+    const __m128i lineBreakUpperBound = _mm_set1_epi8(0x0D + 1);
+    while (lexer->state.cursor + 16 <= lexer->bufferEnd) {
+        __m128i characters = _mm_loadu_si128((const __m128i *)lexer->state.cursor);
+        __m128i lineBreaks = _mm_and_si128(_mm_cmpgt_epi8(characters, lineBreakLowerBound),
+                                           _mm_cmpgt_epi8(lineBreakUpperBound, characters));
+        __m128i delimiters = _mm_or_si128(_mm_cmpeq_epi8(characters, asterisk), _mm_cmpeq_epi8(characters, slash));
+        UInt32 mask        = (UInt32)_mm_movemask_epi8(_mm_or_si128(lineBreaks, delimiters));
+        UInt32 count       = mask ? (UInt32)__builtin_ctz(mask) : 16;
+        lexer->state.cursor += count;
+        lexer->state.column += count;
+        if (count < 16) {
+            return;
+        }
+    }
+#endif
+
+    while (lexer->state.cursor < lexer->bufferEnd) {
+        Char character = *lexer->state.cursor;
+        if (character == '*' || character == '/' || (character >= 0x0A && character <= 0x0D)) {
+            return;
+        }
+
+        lexer->state.cursor += 1;
+        lexer->state.column += 1;
+    }
+}
+
 static inline Bool _LexerSkipMultilineCommentTail(LexerRef lexer) {
     assert((*(lexer->state.cursor - 2) == '/' && *(lexer->state.cursor - 1) == '*') && "Invalid start of multiline comment!");
 
     while (lexer->state.cursor < lexer->bufferEnd) {
+        _LexerSkipCommentText(lexer);
+        if (lexer->state.cursor >= lexer->bufferEnd) {
+            break;
+        }
+
         if (*lexer->state.cursor == '*' && *(lexer->state.cursor + 1) == '/') {
             lexer->state.cursor += 2;
             lexer->state.column += 2;
@@ -165,7 +383,7 @@ static inline TokenKind _LexerLexNumericLiteral(LexerRef lexer) {
             location.end              = lexer->state.cursor;
             SourceRange valueLocation = {location.start + 2, location.end};
             if (valueLocation.end - valueLocation.start - 1 > 64) {
-                ReportError("Integer literal overflows");
+                ReportErrorAt(location, "Integer literal overflows");
             }
 
             UInt64 value = 0;
@@ -214,7 +432,7 @@ static inline TokenKind _LexerLexNumericLiteral(LexerRef lexer) {
             }
 
             if (overflow) {
-                ReportError("Integer literal overflows");
+                ReportErrorAt(location, "Integer literal overflows");
             }
 
             lexer->state.token.valueKind = TokenValueKindInt;
@@ -267,7 +485,7 @@ static inline TokenKind _LexerLexNumericLiteral(LexerRef lexer) {
                 }
 
                 if (overflow) {
-                    ReportError("Integer literal overflows");
+                    ReportErrorAt(location, "Integer literal overflows");
                 }
 
                 lexer->state.token.valueKind = TokenValueKindInt;
@@ -433,7 +651,7 @@ static inline TokenKind _LexerLexNumericLiteral(LexerRef lexer) {
         }
 
         if (overflow) {
-            ReportError("Integer literal overflows");
+            ReportErrorAt(location, "Integer literal overflows");
         }
 
         lexer->state.token.valueKind = TokenValueKindInt;
@@ -548,34 +766,12 @@ static inline TokenKind _LexerLexDirective(LexerRef lexer) {
     assert(*(lexer->state.cursor - 1) == '#');
 
     SourceRange range = SourceRangeMake(lexer->state.cursor, lexer->state.cursor);
+    Index length      = _LexerScanIdentifierTail(lexer->state.cursor, lexer->bufferEnd);
+    lexer->state.cursor += length;
+    lexer->state.column += length;
+    range.end = lexer->state.cursor;
 
-    while (lexer->state.cursor < lexer->bufferEnd) {
-        if (_CharIsContinuationOfIdentifier(*lexer->state.cursor)) {
-            lexer->state.cursor += 1;
-            lexer->state.column += 1;
-        } else {
-            break;
-        }
-    }
-
-    range.end      = lexer->state.cursor;
-    TokenKind kind = TokenKindUnknown;
-
-    if (SourceRangeIsEqual(range, "load")) {
-        kind = TokenKindDirectiveLoad;
-    } else if (SourceRangeIsEqual(range, "link")) {
-        kind = TokenKindDirectiveLink;
-    } else if (SourceRangeIsEqual(range, "intrinsic")) {
-        kind = TokenKindDirectiveIntrinsic;
-    } else if (SourceRangeIsEqual(range, "foreign")) {
-        kind = TokenKindDirectiveForeign;
-    } else if (SourceRangeIsEqual(range, "import")) {
-        kind = TokenKindDirectiveImport;
-    } else if (SourceRangeIsEqual(range, "include")) {
-        kind = TokenKindDirectiveInclude;
-    }
-
-    return kind;
+    return _LexerLookupKeyword(_kLexerDirectives, range, TokenKindUnknown);
 }
 
 static inline TokenKind _LexerLexStringLiteral(LexerRef lexer) {
@@ -640,107 +836,68 @@ static inline TokenKind _LexerLexIdentifierOrKeyword(LexerRef lexer) {
     assert(_CharIsStartOfIdentifier(*(lexer->state.cursor - 1)));
 
     SourceRange range = SourceRangeMake(lexer->state.cursor - 1, lexer->state.cursor - 1);
+    Index length      = _LexerScanIdentifierTail(lexer->state.cursor, lexer->bufferEnd);
+    lexer->state.cursor += length;
+    lexer->state.column += length;
+    range.end = lexer->state.cursor;
 
-    while (lexer->state.cursor < lexer->bufferEnd) {
-        if (_CharIsContinuationOfIdentifier(*lexer->state.cursor)) {
-            lexer->state.cursor += 1;
-            lexer->state.column += 1;
-        } else {
-            break;
+    TokenKind kind = _LexerLookupKeyword(_kLexerKeywords, range, TokenKindIdentifier);
+    if (kind == TokenKindKeywordAs && lexer->state.cursor < lexer->bufferEnd && *lexer->state.cursor == '!') {
+        lexer->state.cursor += 1;
+        lexer->state.column += 1;
+        kind = TokenKindKeywordAsExclamationMark;
+    }
+
+    return kind;
+}
+
+/// Returns the amount of characters matching [A-Za-z0-9_] at the start of `cursor`, 16 characters are classified at once if SSE2 is
+/// available.
+static inline Index _LexerScanIdentifierTail(const Char *cursor, const Char *end) {
+    const Char *start = cursor;
+
+#if defined(__SSE2__)
+    const __m128i caseBit          = _mm_set1_epi8(0x20);
+    const __m128i letterLowerBound = _mm_set1_epi8('a' - 1);
+    const __m128i letterUpperBound = _mm_set1_epi8('z' + 1);
+    const __m128i digitLowerBound  = _mm_set1_epi8('0' - 1);
+    const __m128i digitUpperBound  = _mm_set1_epi8('9' + 1);
+    const __m128i underscore       = _mm_set1_epi8('_');
+    while (cursor + 16 <= end) {
+        __m128i characters = _mm_loadu_si128((const __m128i *)cursor);
+        __m128i lowercase  = _mm_or_si128(characters, caseBit);
+        __m128i letters    = _mm_and_si128(_mm_cmpgt_epi8(lowercase, letterLowerBound), _mm_cmpgt_epi8(letterUpperBound, lowercase));
+        __m128i digits     = _mm_and_si128(_mm_cmpgt_epi8(characters, digitLowerBound), _mm_cmpgt_epi8(digitUpperBound, characters));
+        __m128i matches    = _mm_or_si128(_mm_or_si128(letters, digits), _mm_cmpeq_epi8(characters, underscore));
+        UInt32 mask        = (UInt32)_mm_movemask_epi8(matches);
+        UInt32 count       = (UInt32)__builtin_ctz(~mask);
+        cursor += count;
+        if (count < 16) {
+            return (Index)(cursor - start);
         }
     }
+#endif
 
-    range.end      = lexer->state.cursor;
-    TokenKind kind = TokenKindUnknown;
+    while (cursor < end && _CharIsContinuationOfIdentifier(*cursor)) {
+        cursor += 1;
+    }
 
-    if (SourceRangeIsEqual(range, "is")) {
-        kind = TokenKindKeywordIs;
-    } else if (SourceRangeIsEqual(range, "as")) {
-        if (*lexer->state.cursor == '!') {
-            lexer->state.cursor += 1;
-            lexer->state.column += 1;
-            range.end = lexer->state.cursor;
-            kind      = TokenKindKeywordAsExclamationMark;
-        } else {
-            kind = TokenKindKeywordAs;
+    return (Index)(cursor - start);
+}
+
+static inline TokenKind _LexerLookupKeyword(const LexerKeyword **keywords, SourceRange range, TokenKind defaultKind) {
+    Index length = SourceRangeLength(range);
+    if (length > _kLexerKeywordMaxLength || !keywords[length]) {
+        return defaultKind;
+    }
+
+    for (const LexerKeyword *keyword = keywords[length]; keyword->name; keyword++) {
+        if (keyword->name[0] == range.start[0] && memcmp(keyword->name + 1, range.start + 1, length - 1) == 0) {
+            return keyword->kind;
         }
-    } else if (SourceRangeIsEqual(range, "if")) {
-        kind = TokenKindKeywordIf;
-    } else if (SourceRangeIsEqual(range, "else")) {
-        kind = TokenKindKeywordElse;
-    } else if (SourceRangeIsEqual(range, "while")) {
-        kind = TokenKindKeywordWhile;
-    } else if (SourceRangeIsEqual(range, "do")) {
-        kind = TokenKindKeywordDo;
-    } else if (SourceRangeIsEqual(range, "case")) {
-        kind = TokenKindKeywordCase;
-    } else if (SourceRangeIsEqual(range, "switch")) {
-        kind = TokenKindKeywordSwitch;
-    } else if (SourceRangeIsEqual(range, "break")) {
-        kind = TokenKindKeywordBreak;
-    } else if (SourceRangeIsEqual(range, "continue")) {
-        kind = TokenKindKeywordContinue;
-    } else if (SourceRangeIsEqual(range, "fallthrough")) {
-        kind = TokenKindKeywordFallthrough;
-    } else if (SourceRangeIsEqual(range, "return")) {
-        kind = TokenKindKeywordReturn;
-    } else if (SourceRangeIsEqual(range, "nil")) {
-        kind = TokenKindKeywordNil;
-    } else if (SourceRangeIsEqual(range, "true")) {
-        kind = TokenKindKeywordTrue;
-    } else if (SourceRangeIsEqual(range, "false")) {
-        kind = TokenKindKeywordFalse;
-    } else if (SourceRangeIsEqual(range, "enum")) {
-        kind = TokenKindKeywordEnum;
-    } else if (SourceRangeIsEqual(range, "func")) {
-        kind = TokenKindKeywordFunc;
-    } else if (SourceRangeIsEqual(range, "struct")) {
-        kind = TokenKindKeywordStruct;
-    } else if (SourceRangeIsEqual(range, "var")) {
-        kind = TokenKindKeywordVar;
-    } else if (SourceRangeIsEqual(range, "init")) {
-        kind = TokenKindKeywordInit;
-    } else if (SourceRangeIsEqual(range, "typealias")) {
-        kind = TokenKindKeywordTypeAlias;
-    } else if (SourceRangeIsEqual(range, "sizeof")) {
-        kind = TokenKindKeywordSizeOf;
-    } else if (SourceRangeIsEqual(range, "Void")) {
-        kind = TokenKindKeywordVoid;
-    } else if (SourceRangeIsEqual(range, "Bool")) {
-        kind = TokenKindKeywordBool;
-    } else if (SourceRangeIsEqual(range, "Int8")) {
-        kind = TokenKindKeywordInt8;
-    } else if (SourceRangeIsEqual(range, "Int16")) {
-        kind = TokenKindKeywordInt16;
-    } else if (SourceRangeIsEqual(range, "Int32")) {
-        kind = TokenKindKeywordInt32;
-    } else if (SourceRangeIsEqual(range, "Int64")) {
-        kind = TokenKindKeywordInt64;
-    } else if (SourceRangeIsEqual(range, "Int")) {
-        kind = TokenKindKeywordInt;
-    } else if (SourceRangeIsEqual(range, "UInt8")) {
-        kind = TokenKindKeywordUInt8;
-    } else if (SourceRangeIsEqual(range, "UInt16")) {
-        kind = TokenKindKeywordUInt16;
-    } else if (SourceRangeIsEqual(range, "UInt32")) {
-        kind = TokenKindKeywordUInt32;
-    } else if (SourceRangeIsEqual(range, "UInt64")) {
-        kind = TokenKindKeywordUInt64;
-    } else if (SourceRangeIsEqual(range, "UInt")) {
-        kind = TokenKindKeywordUInt;
-    } else if (SourceRangeIsEqual(range, "Float32")) {
-        kind = TokenKindKeywordFloat32;
-    } else if (SourceRangeIsEqual(range, "Float64")) {
-        kind = TokenKindKeywordFloat64;
-    } else if (SourceRangeIsEqual(range, "Float")) {
-        kind = TokenKindKeywordFloat;
-    } else if (SourceRangeIsEqual(range, "module")) {
-        kind = TokenKindKeywordModule;
-    } else {
-        kind = TokenKindIdentifier;
     }
 
-    return kind;
+    return defaultKind;
 }
 
 static inline void _LexerLexNextToken(LexerRef lexer) {
@@ -1098,75 +1255,30 @@ static inline void _LexerLexNextToken(LexerRef lexer) {
 }
 
 static inline Bool _CharIsAlphaNumeric(Char character) {
-    switch (character) {
-    case 'a' ... 'z':
-    case 'A' ... 'Z':
-    case '0' ... '9':
-        return true;
-    default:
-        return false;
-    }
+    return (_kLexerCharacterClasses[(UInt8)character] & (LexerCharacterClassLetter | LexerCharacterClassDecimalDigit)) > 0;
 }
 
 static inline Bool _CharIsStartOfIdentifier(Char character) {
-    switch (character) {
-    case 'a' ... 'z':
-    case 'A' ... 'Z':
-    case '_':
-        return true;
-
-    default:
-        return false;
-    }
+    return (_kLexerCharacterClasses[(UInt8)character] & (LexerCharacterClassLetter | LexerCharacterClassUnderscore)) > 0;
 }
 
 static inline Bool _CharIsContinuationOfIdentifier(Char character) {
-    switch (character) {
-    case 'a' ... 'z':
-    case 'A' ... 'Z':
-    case '_':
-    case '0' ... '9':
-        return true;
-
-    default:
-        return false;
-    }
+    const UInt8 mask = LexerCharacterClassLetter | LexerCharacterClassUnderscore | LexerCharacterClassDecimalDigit;
+    return (_kLexerCharacterClasses[(UInt8)character] & mask) > 0;
 }
 
 static inline Bool _CharIsBinaryDigit(Char character) {
-    switch (character) {
-    case '0' ... '1':
-        return true;
-    default:
-        return false;
-    }
+    return (_kLexerCharacterClasses[(UInt8)character] & LexerCharacterClassBinaryDigit) > 0;
 }
 
 static inline Bool _CharIsOctalDigit(Char character) {
-    switch (character) {
-    case '0' ... '7':
-        return true;
-    default:
-        return false;
-    }
+    return (_kLexerCharacterClasses[(UInt8)character] & LexerCharacterClassOctalDigit) > 0;
 }
 
 static inline Bool _CharIsDecimalDigit(Char character) {
-    switch (character) {
-    case '0' ... '9':
-        return true;
-    default:
-        return false;
-    }
+    return (_kLexerCharacterClasses[(UInt8)character] & LexerCharacterClassDecimalDigit) > 0;
 }
 
 static inline Bool _CharIsHexadecimalDigit(Char character) {
-    switch (character) {
-    case '0' ... '9':
-    case 'a' ... 'f':
-    case 'A' ... 'F':
-        return true;
-    default:
-        return false;
-    }
+    return (_kLexerCharacterClasses[(UInt8)character] & LexerCharacterClassHexadecimalDigit) > 0;
 }
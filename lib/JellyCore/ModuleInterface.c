@@ -0,0 +1,875 @@
+#include "JellyCore/Array.h"
+#include "JellyCore/Dictionary.h"
+#include "JellyCore/ModuleInterface.h"
+#include "JellyCore/SourceBuffer.h"
+#include "JellyCore/StringInterner.h"
+
+// The version has to be incremented whenever the layout of a record or the meaning of one of its fields changes
+static const UInt32 _kModuleInterfaceMagic     = 0x444F4D4A;
+static const UInt32 _kModuleInterfaceVersion   = 1;
+static const UInt32 _kModuleInterfaceIndexNull = 0xFFFFFFFF;
+
+enum _ModuleInterfaceTypeKind {
+    ModuleInterfaceTypeKindBuiltin,
+    ModuleInterfaceTypeKindNamed,
+    ModuleInterfaceTypeKindPointer,
+    ModuleInterfaceTypeKindArray,
+    ModuleInterfaceTypeKindFunction,
+
+    MODULE_INTERFACE_TYPE_KIND_COUNT
+};
+typedef enum _ModuleInterfaceTypeKind ModuleInterfaceTypeKind;
+
+/// All offsets are relative to the start of the file, the tables are stored in the order of the fields and each table is aligned to
+/// 8 bytes by the sizes of the records preceding it.
+struct _ModuleInterfaceHeader {
+    UInt32 magic;
+    UInt32 version;
+    UInt64 fingerprint;
+    UInt32 sourceUnitOffset;
+    UInt32 sourceUnitCount;
+    UInt32 linkOffset;
+    UInt32 linkCount;
+    UInt32 declarationOffset;
+    UInt32 declarationCount;
+    UInt32 typeOffset;
+    UInt32 typeCount;
+    UInt32 typeListOffset;
+    UInt32 typeListCount;
+    UInt32 stringTableOffset;
+    UInt32 stringTableSize;
+};
+typedef struct _ModuleInterfaceHeader ModuleInterfaceHeader;
+
+struct _ModuleInterfaceSourceUnit {
+    UInt32 filePath;
+    UInt32 firstDeclaration;
+    UInt32 declarationCount;
+    UInt32 reserved;
+};
+typedef struct _ModuleInterfaceSourceUnit ModuleInterfaceSourceUnit;
+
+struct _ModuleInterfaceLink {
+    UInt32 library;
+    UInt32 isFramework;
+};
+typedef struct _ModuleInterfaceLink ModuleInterfaceLink;
+
+/// The `kind` is the `ASTValueKind` of a value or the `ASTFixity` of a function and the `value` is the constant of an enumeration element.
+/// The children of a declaration are the elements of an enumeration, the parameters of a function or initializer and the values followed
+/// by the initializers of a structure, they are stored after their parent as a contiguous block.
+struct _ModuleInterfaceDeclaration {
+    UInt64 value;
+    UInt16 tag;
+    UInt16 kind;
+    UInt32 name;
+    UInt32 mangledName;
+    UInt32 type;
+    UInt32 foreignName;
+    UInt32 firstChild;
+    UInt32 childCount;
+    UInt32 reserved;
+};
+typedef struct _ModuleInterfaceDeclaration ModuleInterfaceDeclaration;
+
+/// The `operand` is the name of a named type, the pointee of a pointer, the element of an array or the result of a function and the
+/// `value` is the `ASTBuiltinTypeKind` of a builtin or the size of a static array. The operands of a type are always stored before it.
+struct _ModuleInterfaceType {
+    UInt64 value;
+    UInt16 kind;
+    UInt16 flags;
+    UInt32 operand;
+    UInt32 firstType;
+    UInt32 typeCount;
+};
+typedef struct _ModuleInterfaceType ModuleInterfaceType;
+
+struct _ModuleInterfaceWriter {
+    AllocatorRef allocator;
+    ArrayRef sourceUnits;
+    ArrayRef links;
+    ArrayRef declarations;
+    ArrayRef types;
+    ArrayRef typeList;
+    ArrayRef strings;
+    DictionaryRef stringOffsets;
+};
+typedef struct _ModuleInterfaceWriter ModuleInterfaceWriter;
+
+struct _ModuleInterface {
+    AllocatorRef allocator;
+    SourceBufferRef buffer;
+    const ModuleInterfaceHeader *header;
+    const ModuleInterfaceSourceUnit *sourceUnits;
+    const ModuleInterfaceLink *links;
+    const ModuleInterfaceDeclaration *declarations;
+    const ModuleInterfaceType *types;
+    const UInt32 *typeList;
+    const Char *strings;
+};
+
+static inline UInt32 _ModuleInterfaceWriterAppendString(ModuleInterfaceWriter *writer, StringRef string);
+static inline UInt32 _ModuleInterfaceWriterAppendType(ModuleInterfaceWriter *writer, ASTTypeRef type);
+static inline UInt32 _ModuleInterfaceWriterReserveDeclarations(ModuleInterfaceWriter *writer, Index count);
+static inline Bool _ModuleInterfaceWriterWriteChildren(ModuleInterfaceWriter *writer, ModuleInterfaceDeclaration *record,
+                                                       ASTArrayRef children, ASTArrayRef trailingChildren);
+static inline Bool _ModuleInterfaceWriterWriteDeclaration(ModuleInterfaceWriter *writer, UInt32 index, ASTNodeRef node);
+static inline Bool _ModuleInterfaceWriterWriteFile(ModuleInterfaceWriter *writer, UInt64 fingerprint, StringRef filePath);
+
+static inline Bool _ModuleInterfaceIsValidTable(Index length, UInt32 offset, UInt32 count, Index elementSize, Index alignment);
+static inline Bool _ModuleInterfaceIsValidString(ModuleInterfaceRef interface, UInt32 offset, Bool isOptional);
+static inline Bool _ModuleInterfaceIsValidType(ModuleInterfaceRef interface, UInt32 index);
+static inline Bool _ModuleInterfaceIsValidDeclaration(ModuleInterfaceRef interface, UInt32 index, ASTTag parentTag);
+static inline Bool _ModuleInterfaceIsValid(ModuleInterfaceRef interface);
+
+static inline StringRef _ModuleInterfaceGetString(ModuleInterfaceRef interface, ASTContextRef context, UInt32 offset);
+static inline ASTTypeRef _ModuleInterfaceLoadType(ModuleInterfaceRef interface, ASTContextRef context, UInt32 index, ScopeID scope);
+static inline ArrayRef _ModuleInterfaceLoadChildren(ModuleInterfaceRef interface, ASTContextRef context,
+                                                    const ModuleInterfaceDeclaration *record, ScopeID scope);
+static inline ASTNodeRef _ModuleInterfaceLoadDeclaration(ModuleInterfaceRef interface, ASTContextRef context, UInt32 index,
+                                                         ScopeID scope);
+
+Bool ModuleInterfaceWrite(AllocatorRef allocator, ASTModuleDeclarationRef module, UInt64 fingerprint, StringRef filePath) {
+    if (ASTArrayGetElementCount(module->importedModules) > 0) {
+        return false;
+    }
+
+    ModuleInterfaceWriter writer;
+    writer.allocator     = allocator;
+    writer.sourceUnits   = ArrayCreateEmpty(allocator, sizeof(ModuleInterfaceSourceUnit), ASTArrayGetElementCount(module->sourceUnits));
+    writer.links         = ArrayCreateEmpty(allocator, sizeof(ModuleInterfaceLink), ASTArrayGetElementCount(module->linkDirectives));
+    writer.declarations  = ArrayCreateEmpty(allocator, sizeof(ModuleInterfaceDeclaration), 64);
+    writer.types         = ArrayCreateEmpty(allocator, sizeof(ModuleInterfaceType), 64);
+    writer.typeList      = ArrayCreateEmpty(allocator, sizeof(UInt32), 16);
+    writer.strings       = ArrayCreateEmpty(allocator, sizeof(Char), 1024);
+    writer.stringOffsets = CStringDictionaryCreate(allocator, 64);
+
+    // The offset 0 is reserved for missing strings
+    Char terminator = '\0';
+    ArrayAppendElement(writer.strings, &terminator);
+
+    Bool success                 = true;
+    ASTArrayIteratorRef iterator = ASTArrayGetIterator(module->sourceUnits);
+    while (iterator && success) {
+        ASTSourceUnitRef sourceUnit = (ASTSourceUnitRef)ASTArrayIteratorGetElement(iterator);
+        Index declarationCount      = 0;
+        for (Index index = 0; index < ASTArrayGetElementCount(sourceUnit->declarations); index++) {
+            ASTNodeRef child = (ASTNodeRef)ASTArrayGetElementAtIndex(sourceUnit->declarations, index);
+            if (child->tag != ASTTagLoadDirective) {
+                declarationCount += 1;
+            }
+        }
+
+        ModuleInterfaceSourceUnit record;
+        record.filePath         = _ModuleInterfaceWriterAppendString(&writer, sourceUnit->filePath);
+        record.firstDeclaration = _ModuleInterfaceWriterReserveDeclarations(&writer, declarationCount);
+        record.declarationCount = (UInt32)declarationCount;
+        record.reserved         = 0;
+        ArrayAppendElement(writer.sourceUnits, &record);
+
+        UInt32 declarationIndex = record.firstDeclaration;
+        for (Index index = 0; index < ASTArrayGetElementCount(sourceUnit->declarations) && success; index++) {
+            ASTNodeRef child = (ASTNodeRef)ASTArrayGetElementAtIndex(sourceUnit->declarations, index);
+            if (child->tag != ASTTagLoadDirective) {
+                success = _ModuleInterfaceWriterWriteDeclaration(&writer, declarationIndex, child);
+                declarationIndex += 1;
+            }
+        }
+
+        iterator = ASTArrayIteratorNext(iterator);
+    }
+
+    iterator = ASTArrayGetIterator(module->linkDirectives);
+    while (iterator) {
+        ASTLinkDirectiveRef link = (ASTLinkDirectiveRef)ASTArrayIteratorGetElement(iterator);
+        ModuleInterfaceLink record;
+        record.library     = _ModuleInterfaceWriterAppendString(&writer, link->library);
+        record.isFramework = link->isFramework ? 1 : 0;
+        ArrayAppendElement(writer.links, &record);
+        iterator = ASTArrayIteratorNext(iterator);
+    }
+
+    if (success) {
+        success = _ModuleInterfaceWriterWriteFile(&writer, fingerprint, filePath);
+    }
+
+    DictionaryDestroy(writer.stringOffsets);
+    ArrayDestroy(writer.strings);
+    ArrayDestroy(writer.typeList);
+    ArrayDestroy(writer.types);
+    ArrayDestroy(writer.declarations);
+    ArrayDestroy(writer.links);
+    ArrayDestroy(writer.sourceUnits);
+    return success;
+}
+
+ModuleInterfaceRef ModuleInterfaceCreateFromFile(AllocatorRef allocator, const Char *filePath) {
+    SourceBufferRef buffer = SourceBufferCreateFromFile(allocator, filePath);
+    if (!buffer) {
+        return NULL;
+    }
+
+    const Char *memory = SourceBufferGetCharacters(buffer);
+    Index length       = SourceBufferGetLength(buffer);
+    if (length < sizeof(ModuleInterfaceHeader)) {
+        SourceBufferDestroy(buffer);
+        return NULL;
+    }
+
+    const ModuleInterfaceHeader *header = (const ModuleInterfaceHeader *)memory;
+    if (header->magic != _kModuleInterfaceMagic || header->version != _kModuleInterfaceVersion ||
+        !_ModuleInterfaceIsValidTable(length, header->sourceUnitOffset, header->sourceUnitCount, sizeof(ModuleInterfaceSourceUnit), 4) ||
+        !_ModuleInterfaceIsValidTable(length, header->linkOffset, header->linkCount, sizeof(ModuleInterfaceLink), 4) ||
+        !_ModuleInterfaceIsValidTable(length, header->declarationOffset, header->declarationCount, sizeof(ModuleInterfaceDeclaration),
+                                      8) ||
+        !_ModuleInterfaceIsValidTable(length, header->typeOffset, header->typeCount, sizeof(ModuleInterfaceType), 8) ||
+        !_ModuleInterfaceIsValidTable(length, header->typeListOffset, header->typeListCount, sizeof(UInt32), 4) ||
+        !_ModuleInterfaceIsValidTable(length, header->stringTableOffset, header->stringTableSize, sizeof(Char), 1) ||
+        header->stringTableSize < 1 || memory[header->stringTableOffset + header->stringTableSize - 1] != '\0') {
+        SourceBufferDestroy(buffer);
+        return NULL;
+    }
+
+    ModuleInterfaceRef interface = AllocatorAllocate(allocator, sizeof(struct _ModuleInterface));
+    interface->allocator         = allocator;
+    interface->buffer            = buffer;
+    interface->header            = header;
+    interface->sourceUnits       = (const ModuleInterfaceSourceUnit *)(memory + header->sourceUnitOffset);
+    interface->links             = (const ModuleInterfaceLink *)(memory + header->linkOffset);
+    interface->declarations      = (const ModuleInterfaceDeclaration *)(memory + header->declarationOffset);
+    interface->types             = (const ModuleInterfaceType *)(memory + header->typeOffset);
+    interface->typeList          = (const UInt32 *)(memory + header->typeListOffset);
+    interface->strings           = memory + header->stringTableOffset;
+
+    if (!_ModuleInterfaceIsValid(interface)) {
+        ModuleInterfaceDestroy(interface);
+        return NULL;
+    }
+
+    return interface;
+}
+
+void ModuleInterfaceDestroy(ModuleInterfaceRef interface) {
+    SourceBufferDestroy(interface->buffer);
+    AllocatorDeallocate(interface->allocator, interface);
+}
+
+UInt64 ModuleInterfaceGetFingerprint(ModuleInterfaceRef interface) {
+    return interface->header->fingerprint;
+}
+
+Index ModuleInterfaceGetSourceUnitCount(ModuleInterfaceRef interface) {
+    return interface->header->sourceUnitCount;
+}
+
+const Char *ModuleInterfaceGetSourceUnitFilePath(ModuleInterfaceRef interface, Index index) {
+    assert(index < interface->header->sourceUnitCount);
+    return interface->strings + interface->sourceUnits[index].filePath;
+}
+
+void ModuleInterfaceLoadDeclarations(ModuleInterfaceRef interface, ASTContextRef context, ASTModuleDeclarationRef module) {
+    for (Index index = 1; index < interface->header->sourceUnitCount; index++) {
+        const ModuleInterfaceSourceUnit *record = &interface->sourceUnits[index];
+        ArrayRef declarations = ArrayCreateEmpty(interface->allocator, sizeof(ASTNodeRef), record->declarationCount);
+        for (UInt32 offset = 0; offset < record->declarationCount; offset++) {
+            ASTNodeRef declaration = _ModuleInterfaceLoadDeclaration(interface, context, record->firstDeclaration + offset, kScopeGlobal);
+            ArrayAppendElement(declarations, &declaration);
+        }
+
+        StringRef filePath          = _ModuleInterfaceGetString(interface, context, record->filePath);
+        ASTSourceUnitRef sourceUnit = ASTContextCreateSourceUnit(context, SourceRangeNull(), kScopeGlobal, filePath, declarations);
+        ASTModuleAddSourceUnit(context, module, sourceUnit);
+        ArrayDestroy(declarations);
+    }
+
+    // The links declared in the module declaration itself have already been added by the parser
+    for (Index index = 0; index < interface->header->linkCount; index++) {
+        const ModuleInterfaceLink *record = &interface->links[index];
+        const Char *library               = interface->strings + record->library;
+        Bool isFramework                  = record->isFramework != 0;
+        Bool isLinked                     = false;
+        ASTArrayIteratorRef iterator      = ASTArrayGetIterator(module->linkDirectives);
+        while (iterator && !isLinked) {
+            ASTLinkDirectiveRef link = (ASTLinkDirectiveRef)ASTArrayIteratorGetElement(iterator);
+            isLinked                 = link->isFramework == isFramework && StringIsEqualToCString(link->library, library);
+            iterator                 = ASTArrayIteratorNext(iterator);
+        }
+
+        if (!isLinked) {
+            StringRef name           = _ModuleInterfaceGetString(interface, context, record->library);
+            ASTLinkDirectiveRef link = ASTContextCreateLinkDirective(context, SourceRangeNull(), kScopeGlobal, isFramework, name);
+            ASTArrayAppendElement(module->linkDirectives, link);
+        }
+    }
+}
+
+static inline UInt32 _ModuleInterfaceWriterAppendString(ModuleInterfaceWriter *writer, StringRef string) {
+    if (!string) {
+        return 0;
+    }
+
+    const UInt32 *cachedOffset = (const UInt32 *)DictionaryLookup(writer->stringOffsets, StringGetCharacters(string));
+    if (cachedOffset) {
+        return *cachedOffset;
+    }
+
+    UInt32 offset = (UInt32)ArrayGetElementCount(writer->strings);
+    for (Index index = 0; index <= StringGetLength(string); index++) {
+        ArrayAppendElement(writer->strings, &StringGetCharacters(string)[index]);
+    }
+
+    DictionaryInsert(writer->stringOffsets, StringGetCharacters(string), &offset, sizeof(UInt32));
+    return offset;
+}
+
+static inline UInt32 _ModuleInterfaceWriterAppendType(ModuleInterfaceWriter *writer, ASTTypeRef type) {
+    ModuleInterfaceType record;
+    memset(&record, 0, sizeof(ModuleInterfaceType));
+
+    switch (type->tag) {
+    case ASTTagBuiltinType: {
+        ASTBuiltinTypeRef builtin = (ASTBuiltinTypeRef)type;
+        if (builtin->kind == ASTBuiltinTypeKindError) {
+            return _kModuleInterfaceIndexNull;
+        }
+
+        record.kind  = ModuleInterfaceTypeKindBuiltin;
+        record.value = builtin->kind;
+        break;
+    }
+
+    // Named types are stored unresolved and get resolved again by their name after loading
+    case ASTTagEnumerationType:
+        record.kind    = ModuleInterfaceTypeKindNamed;
+        record.operand = _ModuleInterfaceWriterAppendString(writer, ((ASTEnumerationTypeRef)type)->declaration->base.name);
+        break;
+
+    case ASTTagStructureType:
+        record.kind    = ModuleInterfaceTypeKindNamed;
+        record.operand = _ModuleInterfaceWriterAppendString(writer, ((ASTStructureTypeRef)type)->declaration->base.name);
+        break;
+
+    case ASTTagPointerType:
+        record.kind    = ModuleInterfaceTypeKindPointer;
+        record.operand = _ModuleInterfaceWriterAppendType(writer, ((ASTPointerTypeRef)type)->pointeeType);
+        if (record.operand == _kModuleInterfaceIndexNull) {
+            return _kModuleInterfaceIndexNull;
+        }
+        break;
+
+    case ASTTagArrayType: {
+        ASTArrayTypeRef array = (ASTArrayTypeRef)type;
+        record.kind           = ModuleInterfaceTypeKindArray;
+        record.flags          = array->base.flags & ASTFlagsArrayTypeIsStatic;
+        record.value          = array->sizeValue;
+        record.operand        = _ModuleInterfaceWriterAppendType(writer, array->elementType);
+        if (record.operand == _kModuleInterfaceIndexNull) {
+            return _kModuleInterfaceIndexNull;
+        }
+        break;
+    }
+
+    case ASTTagFunctionType: {
+        ASTFunctionTypeRef function  = (ASTFunctionTypeRef)type;
+        Index parameterCount         = ASTArrayGetElementCount(function->parameterTypes);
+        ArrayRef parameterTypes      = ArrayCreateEmpty(writer->allocator, sizeof(UInt32), parameterCount);
+        ASTArrayIteratorRef iterator = ASTArrayGetIterator(function->parameterTypes);
+        while (iterator) {
+            UInt32 parameterType = _ModuleInterfaceWriterAppendType(writer, (ASTTypeRef)ASTArrayIteratorGetElement(iterator));
+            if (parameterType == _kModuleInterfaceIndexNull) {
+                ArrayDestroy(parameterTypes);
+                return _kModuleInterfaceIndexNull;
+            }
+
+            ArrayAppendElement(parameterTypes, &parameterType);
+            iterator = ASTArrayIteratorNext(iterator);
+        }
+
+        record.kind      = ModuleInterfaceTypeKindFunction;
+        record.operand   = _ModuleInterfaceWriterAppendType(writer, function->resultType);
+        record.firstType = (UInt32)ArrayGetElementCount(writer->typeList);
+        record.typeCount = (UInt32)ArrayGetElementCount(parameterTypes);
+        ArrayAppendArray(writer->typeList, parameterTypes);
+        ArrayDestroy(parameterTypes);
+        if (record.operand == _kModuleInterfaceIndexNull) {
+            return _kModuleInterfaceIndexNull;
+        }
+        break;
+    }
+
+    default:
+        return _kModuleInterfaceIndexNull;
+    }
+
+    UInt32 index = (UInt32)ArrayGetElementCount(writer->types);
+    ArrayAppendElement(writer->types, &record);
+    return index;
+}
+
+static inline UInt32 _ModuleInterfaceWriterReserveDeclarations(ModuleInterfaceWriter *writer, Index count) {
+    ModuleInterfaceDeclaration record;
+    memset(&record, 0, sizeof(ModuleInterfaceDeclaration));
+
+    UInt32 index = (UInt32)ArrayGetElementCount(writer->declarations);
+    for (Index offset = 0; offset < count; offset++) {
+        ArrayAppendElement(writer->declarations, &record);
+    }
+
+    return index;
+}
+
+static inline Bool _ModuleInterfaceWriterWriteChildren(ModuleInterfaceWriter *writer, ModuleInterfaceDeclaration *record,
+                                                       ASTArrayRef children, ASTArrayRef trailingChildren) {
+    Index childCount = ASTArrayGetElementCount(children);
+    if (trailingChildren) {
+        childCount += ASTArrayGetElementCount(trailingChildren);
+    }
+
+    record->firstChild = _ModuleInterfaceWriterReserveDeclarations(writer, childCount);
+    record->childCount = (UInt32)childCount;
+
+    UInt32 index = record->firstChild;
+    for (Index offset = 0; offset < ASTArrayGetElementCount(children); offset++) {
+        if (!_ModuleInterfaceWriterWriteDeclaration(writer, index, (ASTNodeRef)ASTArrayGetElementAtIndex(children, offset))) {
+            return false;
+        }
+
+        index += 1;
+    }
+
+    for (Index offset = 0; trailingChildren && offset < ASTArrayGetElementCount(trailingChildren); offset++) {
+        if (!_ModuleInterfaceWriterWriteDeclaration(writer, index, (ASTNodeRef)ASTArrayGetElementAtIndex(trailingChildren, offset))) {
+            return false;
+        }
+
+        index += 1;
+    }
+
+    return true;
+}
+
+static inline Bool _ModuleInterfaceWriterWriteDeclaration(ModuleInterfaceWriter *writer, UInt32 index, ASTNodeRef node) {
+    ModuleInterfaceDeclaration record;
+    memset(&record, 0, sizeof(ModuleInterfaceDeclaration));
+    record.tag  = node->tag;
+    record.type = _kModuleInterfaceIndexNull;
+
+    Bool success = true;
+    switch (node->tag) {
+    case ASTTagEnumerationDeclaration: {
+        ASTEnumerationDeclarationRef enumeration = (ASTEnumerationDeclarationRef)node;
+        success                                  = _ModuleInterfaceWriterWriteChildren(writer, &record, enumeration->elements, NULL);
+        break;
+    }
+
+    case ASTTagForeignFunctionDeclaration: {
+        ASTFunctionDeclarationRef function = (ASTFunctionDeclarationRef)node;
+        record.kind                        = function->fixity;
+        record.type                        = _ModuleInterfaceWriterAppendType(writer, function->returnType);
+        record.foreignName                 = _ModuleInterfaceWriterAppendString(writer, function->foreignName);
+        success = record.type != _kModuleInterfaceIndexNull && _ModuleInterfaceWriterWriteChildren(writer, &record, function->parameters,
+                                                                                                   NULL);
+        break;
+    }
+
+    case ASTTagStructureDeclaration: {
+        ASTStructureDeclarationRef structure = (ASTStructureDeclarationRef)node;
+        success = _ModuleInterfaceWriterWriteChildren(writer, &record, structure->values, structure->initializers);
+        break;
+    }
+
+    case ASTTagInitializerDeclaration: {
+        ASTInitializerDeclarationRef initializer = (ASTInitializerDeclarationRef)node;
+        success                                  = _ModuleInterfaceWriterWriteChildren(writer, &record, initializer->parameters, NULL);
+        break;
+    }
+
+    case ASTTagValueDeclaration: {
+        ASTValueDeclarationRef value = (ASTValueDeclarationRef)node;
+        record.kind                  = value->kind;
+        record.type                  = _ModuleInterfaceWriterAppendType(writer, value->base.type);
+        success                      = record.type != _kModuleInterfaceIndexNull;
+
+        // The values of enumeration elements are assigned by the TypeChecker and are required by the importing module
+        if (value->kind == ASTValueKindEnumerationElement) {
+            ASTConstantExpressionRef constant = (ASTConstantExpressionRef)value->initializer;
+            if (constant && constant->base.base.tag == ASTTagConstantExpression && constant->kind == ASTConstantKindInt) {
+                record.value = constant->intValue;
+            } else {
+                success = false;
+            }
+        }
+        break;
+    }
+
+    case ASTTagTypeAliasDeclaration:
+        record.type = _ModuleInterfaceWriterAppendType(writer, ((ASTDeclarationRef)node)->type);
+        success     = record.type != _kModuleInterfaceIndexNull;
+        break;
+
+    default:
+        return false;
+    }
+
+    record.name        = _ModuleInterfaceWriterAppendString(writer, ((ASTDeclarationRef)node)->name);
+    record.mangledName = _ModuleInterfaceWriterAppendString(writer, ((ASTDeclarationRef)node)->mangledName);
+    ArraySetElementAtIndex(writer->declarations, index, &record);
+    return success;
+}
+
+static inline Bool _ModuleInterfaceWriterWriteFile(ModuleInterfaceWriter *writer, UInt64 fingerprint, StringRef filePath) {
+    ArrayRef tables[] = {writer->sourceUnits, writer->links, writer->declarations, writer->types, writer->typeList, writer->strings};
+    UInt32 offsets[6];
+    UInt64 offset = sizeof(ModuleInterfaceHeader);
+    for (Index index = 0; index < 6; index++) {
+        offsets[index] = (UInt32)offset;
+        offset += ArrayGetElementCount(tables[index]) * ArrayGetElementSize(tables[index]);
+    }
+
+    if (offset > _kModuleInterfaceIndexNull) {
+        return false;
+    }
+
+    ModuleInterfaceHeader header;
+    memset(&header, 0, sizeof(ModuleInterfaceHeader));
+    header.magic             = _kModuleInterfaceMagic;
+    header.version           = _kModuleInterfaceVersion;
+    header.fingerprint       = fingerprint;
+    header.sourceUnitOffset  = offsets[0];
+    header.sourceUnitCount   = (UInt32)ArrayGetElementCount(writer->sourceUnits);
+    header.linkOffset        = offsets[1];
+    header.linkCount         = (UInt32)ArrayGetElementCount(writer->links);
+    header.declarationOffset = offsets[2];
+    header.declarationCount  = (UInt32)ArrayGetElementCount(writer->declarations);
+    header.typeOffset        = offsets[3];
+    header.typeCount         = (UInt32)ArrayGetElementCount(writer->types);
+    header.typeListOffset    = offsets[4];
+    header.typeListCount     = (UInt32)ArrayGetElementCount(writer->typeList);
+    header.stringTableOffset = offsets[5];
+    header.stringTableSize   = (UInt32)ArrayGetElementCount(writer->strings);
+
+    // The file is written next to its final path and renamed afterwards, so that a reader never observes a partially written file
+    StringRef temporaryFilePath = StringCreateCopy(writer->allocator, filePath);
+    StringAppend(temporaryFilePath, ".tmp");
+
+    FILE *file = fopen(StringGetCharacters(temporaryFilePath), "wb");
+    if (!file) {
+        StringDestroy(temporaryFilePath);
+        return false;
+    }
+
+    Bool success = fwrite(&header, sizeof(ModuleInterfaceHeader), 1, file) == 1;
+    for (Index index = 0; index < 6 && success; index++) {
+        Index count = ArrayGetElementCount(tables[index]);
+        success     = count < 1 || fwrite(ArrayGetMemoryPointer(tables[index]), ArrayGetElementSize(tables[index]), count, file) == count;
+    }
+
+    success = (fclose(file) == 0) && success;
+    success = success && rename(StringGetCharacters(temporaryFilePath), StringGetCharacters(filePath)) == 0;
+    if (!success) {
+        remove(StringGetCharacters(temporaryFilePath));
+    }
+
+    StringDestroy(temporaryFilePath);
+    return success;
+}
+
+static inline Bool _ModuleInterfaceIsValidTable(Index length, UInt32 offset, UInt32 count, Index elementSize, Index alignment) {
+    return offset >= sizeof(ModuleInterfaceHeader) && (offset % alignment) == 0 && (UInt64)offset + (UInt64)count * elementSize <= length;
+}
+
+static inline Bool _ModuleInterfaceIsValidString(ModuleInterfaceRef interface, UInt32 offset, Bool isOptional) {
+    if (offset == 0) {
+        return isOptional;
+    }
+
+    return offset < interface->header->stringTableSize;
+}
+
+static inline Bool _ModuleInterfaceIsValidType(ModuleInterfaceRef interface, UInt32 index) {
+    if (index >= interface->header->typeCount) {
+        return false;
+    }
+
+    const ModuleInterfaceType *record = &interface->types[index];
+    switch (record->kind) {
+    case ModuleInterfaceTypeKindBuiltin:
+        return record->value != ASTBuiltinTypeKindError && record->value < AST_BUILTIN_TYPE_KIND_COUNT;
+
+    case ModuleInterfaceTypeKindNamed:
+        return _ModuleInterfaceIsValidString(interface, record->operand, false);
+
+    case ModuleInterfaceTypeKindPointer:
+    case ModuleInterfaceTypeKindArray:
+        return record->operand < index;
+
+    case ModuleInterfaceTypeKindFunction: {
+        if (record->operand >= index || (UInt64)record->firstType + record->typeCount > interface->header->typeListCount) {
+            return false;
+        }
+
+        for (UInt32 offset = 0; offset < record->typeCount; offset++) {
+            if (interface->typeList[record->firstType + offset] >= index) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+/// Verifies that the declaration is allowed inside of its parent, that all referenced strings and types exist and that the children are
+/// stored after the declaration which guarantees that the declarations form a tree.
+static inline Bool _ModuleInterfaceIsValidDeclaration(ModuleInterfaceRef interface, UInt32 index, ASTTag parentTag) {
+    const ModuleInterfaceDeclaration *record = &interface->declarations[index];
+    if (!_ModuleInterfaceIsValidString(interface, record->name, false) ||
+        !_ModuleInterfaceIsValidString(interface, record->mangledName, true)) {
+        return false;
+    }
+
+    if (record->childCount > 0 &&
+        (record->firstChild <= index || (UInt64)record->firstChild + record->childCount > interface->header->declarationCount)) {
+        return false;
+    }
+
+    Bool isValid = false;
+    switch (record->tag) {
+    case ASTTagEnumerationDeclaration:
+    case ASTTagStructureDeclaration:
+    case ASTTagTypeAliasDeclaration:
+        isValid = parentTag == ASTTagSourceUnit;
+        break;
+
+    case ASTTagForeignFunctionDeclaration:
+        isValid = parentTag == ASTTagSourceUnit && record->kind <= ASTFixityPostfix &&
+                  _ModuleInterfaceIsValidString(interface, record->foreignName, false);
+        break;
+
+    case ASTTagInitializerDeclaration:
+        isValid = parentTag == ASTTagStructureDeclaration;
+        break;
+
+    case ASTTagValueDeclaration:
+        isValid = record->childCount == 0 &&
+                  ((record->kind == ASTValueKindVariable && (parentTag == ASTTagSourceUnit || parentTag == ASTTagStructureDeclaration)) ||
+                   (record->kind == ASTValueKindParameter &&
+                    (parentTag == ASTTagForeignFunctionDeclaration || parentTag == ASTTagInitializerDeclaration)) ||
+                   (record->kind == ASTValueKindEnumerationElement && parentTag == ASTTagEnumerationDeclaration));
+        break;
+
+    default:
+        return false;
+    }
+
+    Bool requiresType = record->tag == ASTTagForeignFunctionDeclaration || record->tag == ASTTagValueDeclaration ||
+                        record->tag == ASTTagTypeAliasDeclaration;
+    if (!isValid || (requiresType && !_ModuleInterfaceIsValidType(interface, record->type))) {
+        return false;
+    }
+
+    for (UInt32 offset = 0; offset < record->childCount; offset++) {
+        if (!_ModuleInterfaceIsValidDeclaration(interface, record->firstChild + offset, (ASTTag)record->tag)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static inline Bool _ModuleInterfaceIsValid(ModuleInterfaceRef interface) {
+    const ModuleInterfaceHeader *header = interface->header;
+    if (header->sourceUnitCount < 1) {
+        return false;
+    }
+
+    for (UInt32 index = 0; index < header->typeCount; index++) {
+        if (!_ModuleInterfaceIsValidType(interface, index)) {
+            return false;
+        }
+    }
+
+    for (UInt32 index = 0; index < header->sourceUnitCount; index++) {
+        const ModuleInterfaceSourceUnit *record = &interface->sourceUnits[index];
+        if (!_ModuleInterfaceIsValidString(interface, record->filePath, false) ||
+            (UInt64)record->firstDeclaration + record->declarationCount > header->declarationCount) {
+            return false;
+        }
+
+        for (UInt32 offset = 0; offset < record->declarationCount; offset++) {
+            if (!_ModuleInterfaceIsValidDeclaration(interface, record->firstDeclaration + offset, ASTTagSourceUnit)) {
+                return false;
+            }
+        }
+    }
+
+    for (UInt32 index = 0; index < header->linkCount; index++) {
+        if (!_ModuleInterfaceIsValidString(interface, interface->links[index].library, false)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static inline StringRef _ModuleInterfaceGetString(ModuleInterfaceRef interface, ASTContextRef context, UInt32 offset) {
+    assert(offset > 0);
+    return StringInternerInternCString(ASTContextGetStringInterner(context), interface->strings + offset);
+}
+
+static inline ASTTypeRef _ModuleInterfaceLoadType(ModuleInterfaceRef interface, ASTContextRef context, UInt32 index, ScopeID scope) {
+    const ModuleInterfaceType *record = &interface->types[index];
+    switch (record->kind) {
+    case ModuleInterfaceTypeKindBuiltin:
+        return (ASTTypeRef)ASTContextGetBuiltinType(context, (ASTBuiltinTypeKind)record->value);
+
+    case ModuleInterfaceTypeKindNamed:
+        return (ASTTypeRef)ASTContextCreateOpaqueType(context, SourceRangeNull(), scope,
+                                                      _ModuleInterfaceGetString(interface, context, record->operand));
+
+    case ModuleInterfaceTypeKindPointer:
+        return (ASTTypeRef)ASTContextCreatePointerType(context, SourceRangeNull(), scope,
+                                                       _ModuleInterfaceLoadType(interface, context, record->operand, scope));
+
+    case ModuleInterfaceTypeKindArray: {
+        ASTTypeRef elementType = _ModuleInterfaceLoadType(interface, context, record->operand, scope);
+        ASTExpressionRef size  = NULL;
+        if (record->flags & ASTFlagsArrayTypeIsStatic) {
+            size = (ASTExpressionRef)ASTContextCreateConstantIntExpression(context, SourceRangeNull(), scope, record->value);
+        }
+
+        return (ASTTypeRef)ASTContextCreateArrayType(context, SourceRangeNull(), scope, elementType, size);
+    }
+
+    case ModuleInterfaceTypeKindFunction: {
+        ArrayRef parameterTypes = ArrayCreateEmpty(interface->allocator, sizeof(ASTTypeRef), record->typeCount);
+        for (UInt32 offset = 0; offset < record->typeCount; offset++) {
+            ASTTypeRef parameterType = _ModuleInterfaceLoadType(interface, context, interface->typeList[record->firstType + offset], scope);
+            ArrayAppendElement(parameterTypes, &parameterType);
+        }
+
+        ASTTypeRef resultType = _ModuleInterfaceLoadType(interface, context, record->operand, scope);
+        ASTTypeRef type = (ASTTypeRef)ASTContextCreateFunctionType(context, SourceRangeNull(), scope, parameterTypes, resultType);
+        ArrayDestroy(parameterTypes);
+        return type;
+    }
+
+    default:
+        JELLY_UNREACHABLE("Invalid kind given for ModuleInterfaceType!");
+        return NULL;
+    }
+}
+
+static inline ArrayRef _ModuleInterfaceLoadChildren(ModuleInterfaceRef interface, ASTContextRef context,
+                                                    const ModuleInterfaceDeclaration *record, ScopeID scope) {
+    ArrayRef children = ArrayCreateEmpty(interface->allocator, sizeof(ASTNodeRef), record->childCount);
+    for (UInt32 offset = 0; offset < record->childCount; offset++) {
+        ASTNodeRef child = _ModuleInterfaceLoadDeclaration(interface, context, record->firstChild + offset, scope);
+        ArrayAppendElement(children, &child);
+    }
+
+    return children;
+}
+
+/// Creates the declaration and the scopes of its children in the same way as the `Parser` would have created them.
+static inline ASTNodeRef _ModuleInterfaceLoadDeclaration(ModuleInterfaceRef interface, ASTContextRef context, UInt32 index,
+                                                         ScopeID scope) {
+    SymbolTableRef symbolTable               = ASTContextGetSymbolTable(context);
+    const ModuleInterfaceDeclaration *record = &interface->declarations[index];
+    StringRef name                           = _ModuleInterfaceGetString(interface, context, record->name);
+    ASTDeclarationRef declaration            = NULL;
+
+    switch (record->tag) {
+    case ASTTagEnumerationDeclaration: {
+        ScopeID innerScope                       = SymbolTableInsertScope(symbolTable, ScopeKindEnumeration, scope, NULL);
+        ArrayRef elements                        = _ModuleInterfaceLoadChildren(interface, context, record, innerScope);
+        ASTEnumerationDeclarationRef enumeration = ASTContextCreateEnumerationDeclaration(context, SourceRangeNull(), scope, name,
+                                                                                          elements);
+        enumeration->innerScope                  = innerScope;
+        SymbolTableSetScopeUserdata(symbolTable, innerScope, enumeration);
+        ArrayDestroy(elements);
+        declaration = (ASTDeclarationRef)enumeration;
+        break;
+    }
+
+    case ASTTagForeignFunctionDeclaration: {
+        ScopeID innerScope                 = SymbolTableInsertScope(symbolTable, ScopeKindFunction, scope, NULL);
+        ArrayRef parameters                = _ModuleInterfaceLoadChildren(interface, context, record, innerScope);
+        ASTTypeRef returnType              = _ModuleInterfaceLoadType(interface, context, record->type, innerScope);
+        StringRef foreignName              = _ModuleInterfaceGetString(interface, context, record->foreignName);
+        ASTFunctionDeclarationRef function = ASTContextCreateForeignFunctionDeclaration(
+            context, SourceRangeNull(), scope, (ASTFixity)record->kind, name, parameters, returnType, foreignName);
+        function->innerScope = innerScope;
+        SymbolTableSetScopeUserdata(symbolTable, innerScope, function);
+        ArrayDestroy(parameters);
+        declaration = (ASTDeclarationRef)function;
+        break;
+    }
+
+    case ASTTagStructureDeclaration: {
+        ScopeID innerScope    = SymbolTableInsertScope(symbolTable, ScopeKindStructure, scope, NULL);
+        ArrayRef children     = _ModuleInterfaceLoadChildren(interface, context, record, innerScope);
+        ArrayRef values       = ArrayCreateEmpty(interface->allocator, sizeof(ASTNodeRef), record->childCount);
+        ArrayRef initializers = ArrayCreateEmpty(interface->allocator, sizeof(ASTNodeRef), record->childCount);
+        for (Index offset = 0; offset < ArrayGetElementCount(children); offset++) {
+            ASTNodeRef child = *((ASTNodeRef *)ArrayGetElementAtIndex(children, offset));
+            ArrayAppendElement(child->tag == ASTTagInitializerDeclaration ? initializers : values, &child);
+        }
+
+        ASTStructureDeclarationRef structure = ASTContextCreateStructureDeclaration(context, SourceRangeNull(), scope, name, values,
+                                                                                    initializers);
+        structure->innerScope                = innerScope;
+        SymbolTableSetScopeUserdata(symbolTable, innerScope, structure);
+        ArrayDestroy(initializers);
+        ArrayDestroy(values);
+        ArrayDestroy(children);
+        declaration = (ASTDeclarationRef)structure;
+        break;
+    }
+
+    // The body of the initializer is part of the object file of the module and is left empty
+    case ASTTagInitializerDeclaration: {
+        ScopeID innerScope                       = SymbolTableInsertScope(symbolTable, ScopeKindInitializer, scope, NULL);
+        ArrayRef parameters                      = _ModuleInterfaceLoadChildren(interface, context, record, innerScope);
+        ASTBlockRef body                         = ASTContextCreateBlock(context, SourceRangeNull(), innerScope, NULL);
+        ASTInitializerDeclarationRef initializer = ASTContextCreateInitializerDeclaration(context, SourceRangeNull(), scope, parameters,
+                                                                                          body);
+        initializer->innerScope                  = innerScope;
+        SymbolTableSetScopeUserdata(symbolTable, innerScope, initializer);
+        ArrayDestroy(parameters);
+        declaration = (ASTDeclarationRef)initializer;
+        break;
+    }
+
+    case ASTTagValueDeclaration: {
+        ASTTypeRef type              = _ModuleInterfaceLoadType(interface, context, record->type, scope);
+        ASTExpressionRef initializer = NULL;
+        if (record->kind == ASTValueKindEnumerationElement) {
+            initializer = (ASTExpressionRef)ASTContextCreateConstantIntExpression(context, SourceRangeNull(), scope, record->value);
+        }
+
+        declaration = (ASTDeclarationRef)ASTContextCreateValueDeclaration(context, SourceRangeNull(), scope, (ASTValueKind)record->kind,
+                                                                          name, type, initializer);
+        break;
+    }
+
+    case ASTTagTypeAliasDeclaration: {
+        ASTTypeRef type = _ModuleInterfaceLoadType(interface, context, record->type, scope);
+        declaration     = (ASTDeclarationRef)ASTContextCreateTypeAliasDeclaration(context, SourceRangeNull(), scope, name, type);
+        break;
+    }
+
+    default:
+        JELLY_UNREACHABLE("Invalid tag given for ModuleInterfaceDeclaration!");
+        return NULL;
+    }
+
+    if (record->mangledName) {
+        declaration->mangledName = StringCreate(ASTContextGetTempAllocator(context), interface->strings + record->mangledName);
+    }
+
+    return (ASTNodeRef)declaration;
+}
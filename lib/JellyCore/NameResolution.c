@@ -39,9 +39,9 @@ void PerformNameResolution(ASTContextRef context, ASTModuleDeclarationRef module
         _AddSourceUnitRecordDeclarationsToScope(context, sourceUnit);
     }
 
-    BucketArrayRef enumerations = ASTContextGetAllNodes(context, ASTTagEnumerationDeclaration);
-    for (Index index = 0; index < BucketArrayGetElementCount(enumerations); index++) {
-        ASTEnumerationDeclarationRef enumeration = (ASTEnumerationDeclarationRef)BucketArrayGetElementAtIndex(enumerations, index);
+    for (ASTContextNodeIterator enumerationIterator = ASTContextGetNodeIterator(context, ASTTagEnumerationDeclaration);
+         enumerationIterator.node; ASTContextNodeIteratorNext(&enumerationIterator)) {
+        ASTEnumerationDeclarationRef enumeration = (ASTEnumerationDeclarationRef)enumerationIterator.node;
         ASTArrayIteratorRef iterator             = ASTArrayGetIterator(enumeration->elements);
         while (iterator) {
             ASTValueDeclarationRef element = (ASTValueDeclarationRef)ASTArrayIteratorGetElement(iterator);
@@ -64,7 +64,7 @@ void PerformNameResolution(ASTContextRef context, ASTModuleDeclarationRef module
                         Index entryIndex = SymbolTableInsertSymbolGroupEntry(symbolTable, symbol);
                         SymbolTableSetSymbolGroupDefinition(symbolTable, symbol, entryIndex, child);
                     } else {
-                        ReportError("Invalid redeclaration of identifier");
+                        ReportErrorAt(ASTContextGetNodeLocation(context, child), "Invalid redeclaration of identifier");
                     }
                 }
             }
@@ -82,7 +82,8 @@ void PerformNameResolution(ASTContextRef context, ASTModuleDeclarationRef module
                             Index entryIndex = SymbolTableInsertSymbolGroupEntry(symbolTable, symbol);
                             SymbolTableSetSymbolGroupDefinition(symbolTable, symbol, entryIndex, initializer);
                         } else {
-                            ReportError("Invalid redeclaration of initializer");
+                            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)initializer),
+                                          "Invalid redeclaration of initializer");
                         }
                     }
 
@@ -148,9 +149,9 @@ void PerformNameResolution(ASTContextRef context, ASTModuleDeclarationRef module
     }
 
     // Substitute predefined types with resolved members of the declaration...
-    BucketArrayRef functionTypes = ASTContextGetAllNodes(context, ASTTagFunctionType);
-    for (Index index = 0; index < BucketArrayGetElementCount(functionTypes); index++) {
-        ASTFunctionTypeRef type = (ASTFunctionTypeRef)BucketArrayGetElementAtIndex(functionTypes, index);
+    for (ASTContextNodeIterator functionTypeIterator = ASTContextGetNodeIterator(context, ASTTagFunctionType); functionTypeIterator.node;
+         ASTContextNodeIteratorNext(&functionTypeIterator)) {
+        ASTFunctionTypeRef type = (ASTFunctionTypeRef)functionTypeIterator.node;
         if (!type->declaration) {
             continue;
         }
@@ -182,7 +183,7 @@ static inline void _AddSourceUnitRecordDeclarationsToScope(ASTContextRef context
                 symbol = SymbolTableInsertSymbol(symbolTable, child->scope, declaration->name);
                 SymbolTableSetSymbolDefinition(symbolTable, symbol, declaration);
             } else {
-                ReportError("Invalid redeclaration of identifier");
+                ReportErrorAt(ASTContextGetNodeLocation(context, child), "Invalid redeclaration of identifier");
             }
         }
     }
@@ -244,7 +245,8 @@ static inline Bool _ResolveDeclarationsOfTypeAndSubstituteType(ASTContextRef con
         }
 
         *type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
-        ReportErrorFormat("Use of unresolved type '%s'", StringGetCharacters(opaque->name));
+        ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)opaque), "Use of unresolved type '%s'",
+                      StringGetCharacters(opaque->name));
         return false;
     }
 
@@ -301,7 +303,7 @@ static inline void _PerformNameResolutionForEnumerationBody(ASTContextRef contex
             symbol = SymbolTableInsertSymbol(symbolTable, enumeration->innerScope, element->base.name);
             SymbolTableSetSymbolDefinition(symbolTable, symbol, element);
         } else {
-            ReportError("Invalid redeclaration of identifier");
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)element), "Invalid redeclaration of identifier");
         }
 
         if (element->initializer) {
@@ -321,7 +323,7 @@ static inline void _PerformNameResolutionForFunctionBody(ASTContextRef context,
             symbol = SymbolTableInsertSymbol(symbolTable, function->innerScope, parameter->base.name);
             SymbolTableSetSymbolDefinition(symbolTable, symbol, parameter);
         } else {
-            ReportError("Invalid redeclaration of identifier");
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)parameter), "Invalid redeclaration of identifier");
         }
     }
 
@@ -344,7 +346,7 @@ static inline void _PerformNameResolutionForStructureBody(ASTContextRef context,
                 symbol = SymbolTableInsertSymbol(symbolTable, structure->innerScope, value->base.name);
                 SymbolTableSetSymbolDefinition(symbolTable, symbol, value);
             } else {
-                ReportError("Invalid redeclaration of identifier");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)value), "Invalid redeclaration of identifier");
             }
         }
     }
@@ -418,7 +420,8 @@ static inline void _PerformNameResolutionForNode(ASTContextRef context, ASTNodeR
             if (comparator) {
                 statement->comparator = comparator;
             } else {
-                ReportError("'case' condition is not comparable with 'switch' argument");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)statement),
+                              "'case' condition is not comparable with 'switch' argument");
             }
 
             ArrayDestroy(parameterTypes);
@@ -479,7 +482,7 @@ static inline void _PerformNameResolutionForNode(ASTContextRef context, ASTNodeR
                 symbol = SymbolTableInsertSymbol(symbolTable, value->base.base.scope, value->base.name);
                 SymbolTableSetSymbolDefinition(symbolTable, symbol, value);
             } else {
-                ReportError("Invalid redeclaration of identifier");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)value), "Invalid redeclaration of identifier");
             }
         }
 
@@ -511,24 +514,25 @@ static inline void _PerformNameResolutionForNode(ASTContextRef context, ASTNodeR
                     symbol = SymbolTableInsertSymbol(symbolTable, initializer->innerScope, parameter->base.name);
                     SymbolTableSetSymbolDefinition(symbolTable, symbol, parameter);
                 } else {
-                    ReportError("Invalid redeclaration of identifier");
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)parameter), "Invalid redeclaration of identifier");
                 }
 
                 parameterIterator = ASTArrayIteratorNext(parameterIterator);
             }
 
-            initializer->base.type = (ASTTypeRef)ASTContextCreateFunctionType(
-                context, initializer->base.base.location, initializer->base.base.scope, parameterTypes, initializer->structure->base.type);
+            SourceRange location   = ASTContextGetNodeLocation(context, (ASTNodeRef)initializer);
+            initializer->base.type = (ASTTypeRef)ASTContextCreateFunctionType(context, location, initializer->base.base.scope,
+                                                                              parameterTypes, initializer->structure->base.type);
             ArrayDestroy(parameterTypes);
 
             StringRef implicitSelfName = StringCreate(AllocatorGetSystemDefault(), "self");
-            initializer->implicitSelf  = ASTContextCreateValueDeclaration(context, initializer->base.base.location, initializer->innerScope,
-                                                                         ASTValueKindVariable, implicitSelfName,
-                                                                         initializer->structure->base.type, NULL);
+            initializer->implicitSelf  = ASTContextCreateValueDeclaration(context, location, initializer->innerScope, ASTValueKindVariable,
+                                                                         implicitSelfName, initializer->structure->base.type, NULL);
             ASTArrayInsertElementAtIndex(initializer->body->statements, 0, initializer->implicitSelf);
             StringDestroy(implicitSelfName);
         } else {
-            ReportError("Initializer can only be declared in a structure!");
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)initializer),
+                          "Initializer can only be declared in a structure!");
             initializer->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
         }
         break;
@@ -555,8 +559,9 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
             ((ASTBuiltinTypeRef)reference->argument->type)->kind == ASTBuiltinTypeKindError) {
             reference->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
         } else {
-            reference->base.type = (ASTTypeRef)ASTContextCreatePointerType(context, reference->base.base.location,
-                                                                           reference->base.base.scope, reference->argument->type);
+            SourceRange location = ASTContextGetNodeLocation(context, (ASTNodeRef)reference);
+            reference->base.type = (ASTTypeRef)ASTContextCreatePointerType(context, location, reference->base.base.scope,
+                                                                           reference->argument->type);
         }
         return;
     }
@@ -575,7 +580,8 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
             } else {
                 dereference->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
                 if (reportErrors) {
-                    ReportError("Cannot derefence expression of non pointer type");
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)dereference),
+                                  "Cannot derefence expression of non pointer type");
                 }
             }
         }
@@ -597,13 +603,14 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
             } else {
                 identifier->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
                 if (reportErrors) {
-                    ReportErrorFormat("Use of unresolved identifier '%s'", StringGetCharacters(identifier->name));
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)identifier), "Use of unresolved identifier '%s'",
+                                  StringGetCharacters(identifier->name));
                 }
             }
         } else {
-            BucketArrayRef enumerations = ASTContextGetAllNodes(context, ASTTagEnumerationDeclaration);
-            for (Index index = 0; index < BucketArrayGetElementCount(enumerations); index++) {
-                ASTEnumerationDeclarationRef enumeration = (ASTEnumerationDeclarationRef)BucketArrayGetElementAtIndex(enumerations, index);
+            for (ASTContextNodeIterator enumerationIterator = ASTContextGetNodeIterator(context, ASTTagEnumerationDeclaration);
+                 enumerationIterator.node; ASTContextNodeIteratorNext(&enumerationIterator)) {
+                ASTEnumerationDeclarationRef enumeration = (ASTEnumerationDeclarationRef)enumerationIterator.node;
                 SymbolID symbol                          = SymbolTableLookupSymbol(symbolTable, enumeration->innerScope, identifier->name);
                 if (symbol != kSymbolNull && !SymbolTableIsSymbolGroup(symbolTable, symbol)) {
                     ASTDeclarationRef declaration = (ASTDeclarationRef)SymbolTableGetSymbolDefinition(symbolTable, symbol);
@@ -660,9 +667,11 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
                 identifier->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
                 if (reportErrors) {
                     if (ASTArrayGetElementCount(identifier->candidateDeclarations) > 0) {
-                        ReportErrorFormat("Ambiguous use of identifier '%s'", StringGetCharacters(identifier->name));
+                        ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)identifier), "Ambiguous use of identifier '%s'",
+                                      StringGetCharacters(identifier->name));
                     } else {
-                        ReportErrorFormat("Use of unresolved identifier '%s'", StringGetCharacters(identifier->name));
+                        ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)identifier), "Use of unresolved identifier '%s'",
+                                      StringGetCharacters(identifier->name));
                     }
                 }
             }
@@ -690,7 +699,8 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
             ASTStructureDeclarationRef structDeclaration = structType->declaration;
             for (Index index = 0; index < ASTArrayGetElementCount(structDeclaration->values); index++) {
                 ASTValueDeclarationRef value = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(structDeclaration->values, index);
-                if (StringIsEqual(value->base.name, memberAccess->memberName)) {
+                // Identifiers are interned by the ASTContext so equal names share the same string
+                if (value->base.name == memberAccess->memberName) {
                     memberAccess->memberIndex         = index;
                     memberAccess->base.type           = value->base.type;
                     memberAccess->resolvedDeclaration = (ASTDeclarationRef)value;
@@ -701,27 +711,29 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
             if (memberAccess->memberIndex < 0) {
                 memberAccess->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
                 if (reportErrors) {
-                    ReportErrorFormat("Use of undeclared member '%s'", StringGetCharacters(memberAccess->memberName));
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)memberAccess), "Use of undeclared member '%s'",
+                                  StringGetCharacters(memberAccess->memberName));
                 }
             }
         } else if (type->tag == ASTTagArrayType && ((ASTArrayTypeRef)type)->size) {
             if (StringIsEqualToCString(memberAccess->memberName, "count")) {
-                assert(!memberAccess->base.base.substitute);
+                assert(!ASTContextGetSubstitute(context, (ASTNodeRef)memberAccess));
 
-                ASTExpressionRef count                      = ((ASTArrayTypeRef)type)->size;
-                memberAccess->base.base.substitute          = (ASTNodeRef)count;
-                memberAccess->base.base.substitute->primary = (ASTNodeRef)memberAccess;
+                ASTExpressionRef count = ((ASTArrayTypeRef)type)->size;
+                ASTContextSetSubstitute(context, (ASTNodeRef)memberAccess, (ASTNodeRef)count);
                 _PerformNameResolutionForExpression(context, count, reportErrors);
             } else {
                 memberAccess->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
                 if (reportErrors) {
-                    ReportErrorFormat("Use of undeclared member '%s'", StringGetCharacters(memberAccess->memberName));
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)memberAccess), "Use of undeclared member '%s'",
+                                  StringGetCharacters(memberAccess->memberName));
                 }
             }
         } else {
             memberAccess->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
             if (type->tag != ASTTagBuiltinType && ((ASTBuiltinTypeRef)type)->kind != ASTBuiltinTypeKindError && reportErrors) {
-                ReportError("Cannot access named member of non structure type");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)memberAccess),
+                              "Cannot access named member of non structure type");
             }
         }
         return;
@@ -752,7 +764,8 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
                 if (ASTTypeIsVoid(pointerType->pointeeType)) {
                     call->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
                     if (reportErrors) {
-                        ReportError("Cannot perform arithmetic operations on a 'Void' pointer");
+                        ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)call),
+                                      "Cannot perform arithmetic operations on a 'Void' pointer");
                     }
                     return;
                 }
@@ -762,8 +775,9 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
                 ArrayRef parameterTypes = ArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(ASTTypeRef), 2);
                 ArrayAppendElement(parameterTypes, &arguments[0]->type);
                 ArrayAppendElement(parameterTypes, &arguments[1]->type);
-                call->callee->type = (ASTTypeRef)ASTContextCreateFunctionType(context, call->callee->base.location,
-                                                                              call->callee->base.scope, parameterTypes, arguments[0]->type);
+                SourceRange location = ASTContextGetNodeLocation(context, (ASTNodeRef)call->callee);
+                call->callee->type   = (ASTTypeRef)ASTContextCreateFunctionType(context, location, call->callee->base.scope, parameterTypes,
+                                                                              arguments[0]->type);
                 ArrayDestroy(parameterTypes);
                 return;
             }
@@ -883,7 +897,7 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
                             continue;
                         }
 
-                        if (!StringIsEqual(declaration->name, identifier->name)) {
+                        if (declaration->name != identifier->name) {
                             continue;
                         }
 
@@ -1039,13 +1053,15 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
                 } else {
                     identifier->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
                     if (reportErrors) {
-                        ReportErrorFormat("Use of unresolved identifier '%s'", StringGetCharacters(identifier->name));
+                        ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)identifier), "Use of unresolved identifier '%s'",
+                                      StringGetCharacters(identifier->name));
                     }
                 }
             } else {
                 identifier->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
                 if (reportErrors) {
-                    ReportErrorFormat("Ambiguous use of identifier '%s'", StringGetCharacters(identifier->name));
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)identifier), "Ambiguous use of identifier '%s'",
+                                  StringGetCharacters(identifier->name));
                 }
             }
 
@@ -1071,7 +1087,7 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
                     ((ASTBuiltinTypeRef)call->callee->type)->kind != ASTBuiltinTypeKindError)) {
             call->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
             if (reportErrors) {
-                ReportError("Cannot call a non function type");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)call), "Cannot call a non function type");
             }
         } else {
             call->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
@@ -1189,7 +1205,8 @@ static inline void _PerformNameResolutionForExpression(ASTContextRef context, AS
                      ((ASTBuiltinTypeRef)subscript->expression->type)->kind == ASTBuiltinTypeKindError)) {
             subscript->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
             if (reportErrors) {
-                ReportError("Subscript expressions are only supported for array types");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)subscript),
+                              "Subscript expressions are only supported for array types");
             }
         }
         return;
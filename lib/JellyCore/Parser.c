@@ -6,21 +6,28 @@
 #include "JellyCore/Parser.h"
 #include "JellyCore/SourceRange.h"
 #include "JellyCore/TempAllocator.h"
+#include "JellyCore/TokenBuffer.h"
 
 // TODO: Write tests for correct scope creation and population!
 
 struct _Parser {
     AllocatorRef allocator;
     AllocatorRef tempAllocator;
+    AllocatorRef lexerAllocator;
     ASTContextRef context;
     ScopeID currentScope;
-    LexerRef lexer;
+    TokenBufferRef tokens;
+    Index tokenIndex;
     Token token;
 };
 
 static inline Bool _StringIsValidFilePath(StringRef string);
 static inline Bool _SourceRangeContainsLineBreakCharacter(SourceRange range);
 
+static inline void _ParserBeginTokens(ParserRef parser, SourceBufferRef source);
+static inline void _ParserEndTokens(ParserRef parser);
+static inline void _ParserNextToken(ParserRef parser);
+static inline void _ParserRewindToken(ParserRef parser, Index tokenIndex);
 static inline Bool _ParserIsToken(ParserRef parser, TokenKind kind);
 static inline Bool _ParserConsumeToken(ParserRef parser, TokenKind kind);
 
@@ -62,31 +69,32 @@ static inline ASTNodeRef _ParserParseTopLevelInterfaceNode(ParserRef parser);
 static inline ScopeID _ParserPushScope(ParserRef parser, SourceRange location, ASTNodeRef node, ScopeKind kind);
 static inline void _ParserPopScope(ParserRef parser);
 
-ParserRef ParserCreate(AllocatorRef allocator, ASTContextRef context) {
+ParserRef ParserCreate(AllocatorRef allocator, AllocatorRef lexerAllocator, ASTContextRef context) {
     ParserRef parser  = AllocatorAllocate(allocator, sizeof(struct _Parser));
     parser->allocator = allocator;
-    // TODO: Replace tempAllocator with a pool allocator which resets after finishing a top level parse action.
-    parser->tempAllocator = TempAllocatorCreate(allocator);
-    parser->context       = context;
-    parser->currentScope  = kScopeGlobal;
-    parser->lexer         = NULL;
+    // TODO: Reset tempAllocator after finishing a top level parse action.
+    parser->tempAllocator  = TempAllocatorCreate(allocator);
+    parser->lexerAllocator = lexerAllocator;
+    parser->context        = context;
+    parser->currentScope   = kScopeGlobal;
+    parser->tokens         = NULL;
+    parser->tokenIndex     = 0;
     return parser;
 }
 
 void ParserDestroy(ParserRef parser) {
-    if (parser->lexer) {
-        LexerDestroy(parser->lexer);
+    if (parser->tokens) {
+        TokenBufferDestroy(parser->tokens);
     }
 
     AllocatorDestroy(parser->tempAllocator);
     AllocatorDeallocate(parser->allocator, parser);
 }
 
-ASTSourceUnitRef ParserParseSourceUnit(ParserRef parser, StringRef filePath, StringRef source) {
+ASTSourceUnitRef ParserParseSourceUnit(ParserRef parser, StringRef filePath, SourceBufferRef source) {
     ASTModuleDeclarationRef module = ASTContextGetModule(parser->context);
 
-    parser->lexer = LexerCreate(parser->allocator, source);
-    LexerNextToken(parser->lexer, &parser->token);
+    _ParserBeginTokens(parser, source);
 
     SourceRange location  = parser->token.location;
     ArrayRef declarations = ArrayCreateEmpty(parser->tempAllocator, sizeof(ASTNodeRef), 8);
@@ -98,11 +106,11 @@ ASTSourceUnitRef ParserParseSourceUnit(ParserRef parser, StringRef filePath, Str
         }
 
         if (ArrayGetElementCount(declarations) > 0 && !_SourceRangeContainsLineBreakCharacter(leadingTrivia)) {
-            ReportError("Consecutive statements on a line are not allowed");
+            ReportErrorAt(parser->token.location, "Consecutive statements on a line are not allowed");
         }
 
         if (topLevelNode->tag == ASTTagLinkDirective) {
-            ASTArrayAppendElement(module->linkDirectives, topLevelNode);
+            ASTModuleAddLinkDirective(parser->context, module, (ASTLinkDirectiveRef)topLevelNode);
         } else {
             ArrayAppendElement(declarations, &topLevelNode);
         }
@@ -112,15 +120,13 @@ ASTSourceUnitRef ParserParseSourceUnit(ParserRef parser, StringRef filePath, Str
     ASTSourceUnitRef sourceUnit = ASTContextCreateSourceUnit(parser->context, location, parser->currentScope, filePath, declarations);
     ASTModuleAddSourceUnit(parser->context, module, sourceUnit);
 
-    LexerDestroy(parser->lexer);
-    parser->lexer = NULL;
+    _ParserEndTokens(parser);
 
     return sourceUnit;
 }
 
-ASTSourceUnitRef ParserParseModuleSourceUnit(ParserRef parser, ASTModuleDeclarationRef module, StringRef filePath, StringRef source) {
-    parser->lexer = LexerCreate(parser->allocator, source);
-    LexerNextToken(parser->lexer, &parser->token);
+ASTSourceUnitRef ParserParseModuleSourceUnit(ParserRef parser, ASTModuleDeclarationRef module, StringRef filePath, SourceBufferRef source) {
+    _ParserBeginTokens(parser, source);
 
     SourceRange location  = parser->token.location;
     ArrayRef declarations = ArrayCreateEmpty(parser->tempAllocator, sizeof(ASTNodeRef), 8);
@@ -132,11 +138,11 @@ ASTSourceUnitRef ParserParseModuleSourceUnit(ParserRef parser, ASTModuleDeclarat
         }
 
         if (ArrayGetElementCount(declarations) > 0 && !_SourceRangeContainsLineBreakCharacter(leadingTrivia)) {
-            ReportError("Consecutive statements on a line are not allowed");
+            ReportErrorAt(parser->token.location, "Consecutive statements on a line are not allowed");
         }
 
         if (topLevelNode->tag == ASTTagLinkDirective) {
-            ASTArrayAppendElement(module->linkDirectives, topLevelNode);
+            ASTModuleAddLinkDirective(parser->context, module, (ASTLinkDirectiveRef)topLevelNode);
         } else {
             ArrayAppendElement(declarations, &topLevelNode);
         }
@@ -146,30 +152,28 @@ ASTSourceUnitRef ParserParseModuleSourceUnit(ParserRef parser, ASTModuleDeclarat
     ASTSourceUnitRef sourceUnit = ASTContextCreateSourceUnit(parser->context, location, parser->currentScope, filePath, declarations);
     ASTModuleAddSourceUnit(parser->context, module, sourceUnit);
 
-    LexerDestroy(parser->lexer);
-    parser->lexer = NULL;
+    _ParserEndTokens(parser);
 
     return sourceUnit;
 }
 
 // grammar: module-declaration := "module" identifier "{" [ { directive } ] "}"
-ASTModuleDeclarationRef ParserParseModuleDeclaration(ParserRef parser, StringRef filePath, StringRef source) {
-    parser->lexer = LexerCreate(parser->allocator, source);
-    LexerNextToken(parser->lexer, &parser->token);
+ASTModuleDeclarationRef ParserParseModuleDeclaration(ParserRef parser, StringRef filePath, SourceBufferRef source) {
+    _ParserBeginTokens(parser, source);
 
     if (!_ParserConsumeToken(parser, TokenKindKeywordModule)) {
-        ReportError("Expected keyword 'module' in imported interface");
+        ReportErrorAt(parser->token.location, "Expected keyword 'module' in imported interface");
         return NULL;
     }
 
     StringRef moduleName = _ParserConsumeIdentifier(parser);
     if (!moduleName) {
-        ReportError("Expected identifier for module declaration");
+        ReportErrorAt(parser->token.location, "Expected identifier for module declaration");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindLeftCurlyBracket)) {
-        ReportError("Expected '{' after module declaration");
+        ReportErrorAt(parser->token.location, "Expected '{' after module declaration");
         return NULL;
     }
 
@@ -181,7 +185,7 @@ ASTModuleDeclarationRef ParserParseModuleDeclaration(ParserRef parser, StringRef
 
         if (!_ParserIsToken(parser, TokenKindDirectiveLoad) && !_ParserIsToken(parser, TokenKindDirectiveLink) &&
             !_ParserIsToken(parser, TokenKindDirectiveInclude)) {
-            ReportError("Expected '#load', '#link' or '#include' directive in module");
+            ReportErrorAt(parser->token.location, "Expected '#load', '#link' or '#include' directive in module");
             return NULL;
         }
 
@@ -191,7 +195,7 @@ ASTModuleDeclarationRef ParserParseModuleDeclaration(ParserRef parser, StringRef
         }
 
         if (ArrayGetElementCount(directives) > 0 && !_SourceRangeContainsLineBreakCharacter(leadingTrivia)) {
-            ReportError("Consecutive statements on a line are not allowed");
+            ReportErrorAt(parser->token.location, "Consecutive statements on a line are not allowed");
         }
 
         // TODO: Check where all directives have to be stored...
@@ -203,12 +207,12 @@ ASTModuleDeclarationRef ParserParseModuleDeclaration(ParserRef parser, StringRef
     }
 
     if (!_ParserConsumeToken(parser, TokenKindRightCurlyBracket)) {
-        ReportError("Expected '}' at end of module declaration");
+        ReportErrorAt(parser->token.location, "Expected '}' at end of module declaration");
         return NULL;
     }
 
     if (!_ParserIsToken(parser, TokenKindEndOfFile)) {
-        ReportError("Expected end of file after module declaration");
+        ReportErrorAt(parser->token.location, "Expected end of file after module declaration");
         return NULL;
     }
 
@@ -219,8 +223,7 @@ ASTModuleDeclarationRef ParserParseModuleDeclaration(ParserRef parser, StringRef
     ASTSourceUnitRef sourceUnit = ASTContextCreateSourceUnit(parser->context, location, parser->currentScope, filePath, directives);
     ASTModuleAddSourceUnit(parser->context, module, sourceUnit);
 
-    LexerDestroy(parser->lexer);
-    parser->lexer = NULL;
+    _ParserEndTokens(parser);
 
     return module;
 }
@@ -247,6 +250,36 @@ static inline Bool _SourceRangeContainsLineBreakCharacter(SourceRange range) {
     return false;
 }
 
+/// The whole source unit is lexed once into a token buffer, so that backtracking after a speculative parse only resets the token index.
+static inline void _ParserBeginTokens(ParserRef parser, SourceBufferRef source) {
+    _ParserEndTokens(parser);
+    ASTContextAddSource(parser->context, source);
+    parser->tokens     = TokenBufferCreateFromSourceBuffer(parser->lexerAllocator, source);
+    parser->tokenIndex = 0;
+    TokenBufferGetToken(parser->tokens, parser->tokenIndex, &parser->token);
+}
+
+static inline void _ParserEndTokens(ParserRef parser) {
+    if (parser->tokens) {
+        TokenBufferDestroy(parser->tokens);
+        parser->tokens = NULL;
+    }
+}
+
+static inline void _ParserNextToken(ParserRef parser) {
+    // The last token is always the end of file which is returned repeatedly same as by the lexer
+    if (parser->tokenIndex + 1 < TokenBufferGetCount(parser->tokens)) {
+        parser->tokenIndex += 1;
+    }
+
+    TokenBufferGetToken(parser->tokens, parser->tokenIndex, &parser->token);
+}
+
+static inline void _ParserRewindToken(ParserRef parser, Index tokenIndex) {
+    parser->tokenIndex = tokenIndex;
+    TokenBufferGetToken(parser->tokens, parser->tokenIndex, &parser->token);
+}
+
 static inline Bool _ParserIsToken(ParserRef parser, TokenKind kind) {
     return parser->token.kind == kind;
 }
@@ -265,7 +298,7 @@ static inline Bool _ParserIsTokenIdentifierMatchingCString(ParserRef parser, con
 
 static inline Bool _ParserConsumeToken(ParserRef parser, TokenKind kind) {
     if (parser->token.kind == kind) {
-        LexerNextToken(parser->lexer, &parser->token);
+        _ParserNextToken(parser);
         return true;
     }
 
@@ -277,27 +310,23 @@ static inline Bool _ParserConsumeToken(ParserRef parser, TokenKind kind) {
 /// grammar: identifier-tail := identifier-head | "0" ... "9"
 static inline StringRef _ParserConsumeIdentifier(ParserRef parser) {
     if (parser->token.kind == TokenKindIdentifier) {
-        StringRef result = StringCreateRange(parser->tempAllocator, parser->token.location.start, parser->token.location.end);
-        LexerNextToken(parser->lexer, &parser->token);
+        StringRef result = StringCreateFromView(parser->tempAllocator, TokenGetView(&parser->token));
+        _ParserNextToken(parser);
         return result;
     }
 
     return NULL;
 }
 
+/// Consumes the next identifier and returns true if it matches `string`, the identifier is compared in place without being copied.
 static inline Bool _ParserConsumeIdentifierMatchingCString(ParserRef parser, const Char *string) {
-    StringRef identifier = _ParserConsumeIdentifier(parser);
-    if (!identifier) {
-        return false;
-    }
-
-    if (!StringIsEqualToCString(identifier, string)) {
-        StringDestroy(identifier);
+    if (parser->token.kind != TokenKindIdentifier) {
         return false;
     }
 
-    StringDestroy(identifier);
-    return true;
+    Bool isMatching = StringViewIsEqualToCString(TokenGetView(&parser->token), string);
+    _ParserNextToken(parser);
+    return isMatching;
 }
 
 static inline ASTUnaryOperator _ParserConsumeUnaryOperator(ParserRef parser) {
@@ -424,14 +453,14 @@ static inline ASTNodeRef _ParserParseDirective(ParserRef parser) {
     if (_ParserConsumeToken(parser, TokenKindDirectiveLoad)) {
         ASTConstantExpressionRef filePath = _ParserParseConstantExpression(parser);
         if (!filePath || filePath->kind != ASTConstantKindString) {
-            ReportError("Expected string literal after `#load` directive");
+            ReportErrorAt(parser->token.location, "Expected string literal after `#load` directive");
             return NULL;
         }
 
         assert(filePath->kind == ASTConstantKindString);
 
         if (!_StringIsValidFilePath(filePath->stringValue)) {
-            ReportError("Expected valid file path after `#load` directive");
+            ReportErrorAt(parser->token.location, "Expected valid file path after `#load` directive");
             return NULL;
         }
 
@@ -443,20 +472,20 @@ static inline ASTNodeRef _ParserParseDirective(ParserRef parser) {
         Bool isFramework = false;
 
         if (_ParserIsToken(parser, TokenKindIdentifier)) {
-            StringRef identifier = _ParserConsumeIdentifier(parser);
-            assert(identifier);
-
-            if (StringIsEqualToCString(identifier, "framework")) {
-                isFramework = true;
-            } else {
-                ReportErrorFormat("Expected keyword 'framework' or string-literal found identifier '%s'", StringGetCharacters(identifier));
+            StringView identifier          = TokenGetView(&parser->token);
+            SourceRange identifierLocation = parser->token.location;
+            if (!_ParserConsumeIdentifierMatchingCString(parser, "framework")) {
+                ReportErrorAt(identifierLocation, "Expected keyword 'framework' or string-literal found identifier '%.*s'",
+                              (Int32)identifier.length, identifier.characters);
                 return NULL;
             }
+
+            isFramework = true;
         }
 
         ASTConstantExpressionRef filePath = _ParserParseConstantExpression(parser);
         if (!filePath || filePath->kind != ASTConstantKindString) {
-            ReportError("Expected string literal after `#link` directive");
+            ReportErrorAt(parser->token.location, "Expected string literal after `#link` directive");
             return NULL;
         }
 
@@ -470,7 +499,7 @@ static inline ASTNodeRef _ParserParseDirective(ParserRef parser) {
     if (_ParserConsumeToken(parser, TokenKindDirectiveImport)) {
         ASTConstantExpressionRef filePath = _ParserParseConstantExpression(parser);
         if (!filePath || filePath->kind != ASTConstantKindString) {
-            ReportError("Expected string literal after `#import` directive");
+            ReportErrorAt(parser->token.location, "Expected string literal after `#import` directive");
             return NULL;
         }
 
@@ -483,7 +512,7 @@ static inline ASTNodeRef _ParserParseDirective(ParserRef parser) {
     if (_ParserConsumeToken(parser, TokenKindDirectiveInclude)) {
         ASTConstantExpressionRef filePath = _ParserParseConstantExpression(parser);
         if (!filePath || filePath->kind != ASTConstantKindString) {
-            ReportError("Expected string literal after `#include` directive");
+            ReportErrorAt(parser->token.location, "Expected string literal after `#include` directive");
             return NULL;
         }
 
@@ -493,7 +522,7 @@ static inline ASTNodeRef _ParserParseDirective(ParserRef parser) {
         return (ASTNodeRef)ASTContextCreateIncludeDirective(parser->context, location, parser->currentScope, filePath->stringValue);
     }
 
-    ReportError("Unknown compiler directive");
+    ReportErrorAt(parser->token.location, "Unknown compiler directive");
     return NULL;
 }
 
@@ -502,7 +531,7 @@ static inline ASTBlockRef _ParserParseBlock(ParserRef parser) {
     SourceRange location = parser->token.location;
 
     if (!_ParserConsumeToken(parser, TokenKindLeftCurlyBracket)) {
-        ReportError("Expected '{' at start of `block-statement`");
+        ReportErrorAt(parser->token.location, "Expected '{' at start of `block-statement`");
         return NULL;
     }
 
@@ -515,7 +544,7 @@ static inline ASTBlockRef _ParserParseBlock(ParserRef parser) {
         }
 
         if (ArrayGetElementCount(statements) > 0 && !_SourceRangeContainsLineBreakCharacter(leadingTrivia)) {
-            ReportError("Consecutive statements on a line are not allowed");
+            ReportErrorAt(parser->token.location, "Consecutive statements on a line are not allowed");
         }
 
         ArrayAppendElement(statements, &statement);
@@ -630,7 +659,7 @@ static inline ASTLoopStatementRef _ParserParseLoopStatement(ParserRef parser) {
         }
 
         if (!_ParserConsumeToken(parser, TokenKindKeywordWhile)) {
-            ReportError("Expected 'while' after block of 'do' statement");
+            ReportErrorAt(parser->token.location, "Expected 'while' after block of 'do' statement");
             return NULL;
         }
 
@@ -648,7 +677,7 @@ static inline ASTLoopStatementRef _ParserParseLoopStatement(ParserRef parser) {
         return loop;
     }
 
-    ReportError("Expected 'while' or 'do' at start of loop-statement!");
+    ReportErrorAt(parser->token.location, "Expected 'while' or 'do' at start of loop-statement!");
     return NULL;
 }
 
@@ -673,9 +702,9 @@ static inline ASTCaseStatementRef _ParserParseCaseStatement(ParserRef parser) {
 
     if (!_ParserConsumeToken(parser, TokenKindColon)) {
         if (kind == ASTCaseKindConditional) {
-            ReportError("Expected ':' after 'case'");
+            ReportErrorAt(parser->token.location, "Expected ':' after 'case'");
         } else {
-            ReportError("Expected ':' after 'else'");
+            ReportErrorAt(parser->token.location, "Expected ':' after 'else'");
         }
         return NULL;
     }
@@ -694,14 +723,14 @@ static inline ASTCaseStatementRef _ParserParseCaseStatement(ParserRef parser) {
         }
 
         if (ArrayGetElementCount(statements) > 0 && !_SourceRangeContainsLineBreakCharacter(leadingTrivia)) {
-            ReportError("Consecutive statements on a line are not allowed");
+            ReportErrorAt(parser->token.location, "Consecutive statements on a line are not allowed");
         }
 
         ArrayAppendElement(statements, &statement);
     }
 
     if (ArrayGetElementSize(statements) < 1) {
-        ReportError("case statement in a switch should contain at least one statement");
+        ReportErrorAt(parser->token.location, "case statement in a switch should contain at least one statement");
     }
 
     _ParserPopScope(parser);
@@ -726,12 +755,12 @@ static inline ASTSwitchStatementRef _ParserParseSwitchStatement(ParserRef parser
 
     ASTExpressionRef argument = _ParserParseExpression(parser, 0, true);
     if (!argument) {
-        ReportError("Expected expression in 'switch' statement");
+        ReportErrorAt(parser->token.location, "Expected expression in 'switch' statement");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindLeftCurlyBracket)) {
-        ReportError("Expected '{' at start of 'switch' statement");
+        ReportErrorAt(parser->token.location, "Expected '{' at start of 'switch' statement");
         return NULL;
     }
 
@@ -740,7 +769,7 @@ static inline ASTSwitchStatementRef _ParserParseSwitchStatement(ParserRef parser
     ArrayRef statements = ArrayCreateEmpty(parser->tempAllocator, sizeof(ASTNodeRef), 8);
 
     if (_ParserIsToken(parser, TokenKindRightCurlyBracket)) {
-        ReportError("'switch' statement body must have at least one 'case' or 'else' block");
+        ReportErrorAt(parser->token.location, "'switch' statement body must have at least one 'case' or 'else' block");
     }
 
     while (!_ParserIsToken(parser, TokenKindRightCurlyBracket)) {
@@ -748,14 +777,14 @@ static inline ASTSwitchStatementRef _ParserParseSwitchStatement(ParserRef parser
         ASTCaseStatementRef statement = _ParserParseCaseStatement(parser);
         if (!statement) {
             if (ArrayGetElementCount(statements) > 0) {
-                ReportError("All statements inside a switch must be covered by a 'case' or 'else'");
+                ReportErrorAt(parser->token.location, "All statements inside a switch must be covered by a 'case' or 'else'");
             }
 
             break;
         }
 
         if (ArrayGetElementCount(statements) > 0 && !_SourceRangeContainsLineBreakCharacter(leadingTrivia)) {
-            ReportError("Consecutive statements on a line are not allowed");
+            ReportErrorAt(parser->token.location, "Consecutive statements on a line are not allowed");
         }
 
         ArrayAppendElement(statements, &statement);
@@ -793,14 +822,13 @@ static inline ASTControlStatementRef _ParserParseControlStatement(ParserRef pars
     } else if (_ParserConsumeToken(parser, TokenKindKeywordReturn)) {
         kind = ASTControlKindReturn;
 
-        LexerState state = LexerGetState(parser->lexer);
+        Index checkpoint = parser->tokenIndex;
         result           = _ParserParseExpression(parser, 0, true);
         if (!result) {
-            LexerSetState(parser->lexer, state);
-            LexerPeekToken(parser->lexer, &parser->token);
+            _ParserRewindToken(parser, checkpoint);
         }
     } else {
-        ReportError("Expected 'break', 'continue', 'fallthrough' or 'return' at start of control-statement!");
+        ReportErrorAt(parser->token.location, "Expected 'break', 'continue', 'fallthrough' or 'return' at start of control-statement!");
         return NULL;
     }
 
@@ -840,7 +868,7 @@ static inline ASTNodeRef _ParserParseStatement(ParserRef parser) {
 
     ASTExpressionRef expression = _ParserParseExpression(parser, 0, true);
     if (!expression) {
-        ReportError("Expected statement");
+        ReportErrorAt(parser->token.location, "Expected statement");
         return NULL;
     }
 
@@ -865,8 +893,8 @@ static inline ASTExpressionRef _ParserParseAtomExpression(ParserRef parser) {
             return NULL;
         }
 
-        location.end              = parser->token.location.start;
-        expression->base.location = location;
+        location.end = parser->token.location.start;
+        ASTContextSetNodeLocation(parser->context, (ASTNodeRef)expression, location);
         return expression;
     }
 
@@ -941,8 +969,8 @@ static inline ASTUnaryExpressionRef _ParserParseUnaryExpression(ParserRef parser
         return NULL;
     }
 
-    if (location.end != arguments[0]->base.location.start) {
-        ReportError("Unary operator cannot be separated from its operand");
+    if (location.end != ASTContextGetNodeLocation(parser->context, (ASTNodeRef)arguments[0]).start) {
+        ReportErrorAt(parser->token.location, "Unary operator cannot be separated from its operand");
         return NULL;
     }
 
@@ -960,14 +988,14 @@ static inline ASTExpressionRef _ParserParseExpression(ParserRef parser, ASTOpera
     ASTExpressionRef result = _ParserParsePrimaryExpression(parser);
     if (!result) {
         if (!silentDiagnostics) {
-            ReportError("Expected expression");
+            ReportErrorAt(parser->token.location, "Expected expression");
         }
 
         return NULL;
     }
 
     location.end                     = parser->token.location.start;
-    LexerState state                 = LexerGetState(parser->lexer);
+    Index checkpoint                 = parser->tokenIndex;
     ASTBinaryOperator binary         = _ParserConsumeBinaryOperator(parser);
     ASTOperatorPrecedence precedence = ASTGetBinaryOperatorPrecedence(binary);
 
@@ -982,8 +1010,7 @@ static inline ASTExpressionRef _ParserParseExpression(ParserRef parser, ASTOpera
     }
 
     if (minPrecedence >= precedence) {
-        LexerSetState(parser->lexer, state);
-        LexerPeekToken(parser->lexer, &parser->token);
+        _ParserRewindToken(parser, checkpoint);
         return result;
     }
 
@@ -1080,7 +1107,7 @@ static inline ASTExpressionRef _ParserParseExpression(ParserRef parser, ASTOpera
             return NULL;
         }
 
-        state      = LexerGetState(parser->lexer);
+        checkpoint = parser->tokenIndex;
         binary     = _ParserConsumeBinaryOperator(parser);
         precedence = ASTGetBinaryOperatorPrecedence(binary);
         postfix    = ASTPostfixOperatorUnknown;
@@ -1095,8 +1122,7 @@ static inline ASTExpressionRef _ParserParseExpression(ParserRef parser, ASTOpera
         }
 
         if (minPrecedence >= precedence) {
-            LexerSetState(parser->lexer, state);
-            LexerPeekToken(parser->lexer, &parser->token);
+            _ParserRewindToken(parser, checkpoint);
             return result;
         }
     }
@@ -1120,7 +1146,7 @@ static inline ASTIdentifierExpressionRef _ParserParseIdentifierExpression(Parser
 
 /// grammar: call-expression := expression "(" [ expression { "," expression } ] ")"
 static inline ASTCallExpressionRef _ParserParseCallExpression(ParserRef parser, ASTExpressionRef callee) {
-    SourceRange location = {callee->base.location.start, parser->token.location.start};
+    SourceRange location = {ASTContextGetNodeLocation(parser->context, (ASTNodeRef)callee).start, parser->token.location.start};
 
     // We expect that the postfix operator head is already consumed earlier
     //    if (!_ParserConsumePostfixOperatorHead(parser)) {
@@ -1207,12 +1233,12 @@ static inline ASTEnumerationDeclarationRef _ParserParseEnumerationDeclaration(Pa
 
     StringRef name = _ParserConsumeIdentifier(parser);
     if (!name) {
-        ReportError("Expected `name` of `enum-declaration`");
+        ReportErrorAt(parser->token.location, "Expected `name` of `enum-declaration`");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindLeftCurlyBracket)) {
-        ReportError("Expected '{' after `name` of `enum-declaration`");
+        ReportErrorAt(parser->token.location, "Expected '{' after `name` of `enum-declaration`");
         return NULL;
     }
 
@@ -1230,11 +1256,11 @@ static inline ASTEnumerationDeclarationRef _ParserParseEnumerationDeclaration(Pa
             assert(element->kind == ASTValueKindEnumerationElement);
 
             if (ArrayGetElementCount(elements) > 0 && !_SourceRangeContainsLineBreakCharacter(leadingTrivia)) {
-                ReportError("Consecutive statements on a line are not allowed");
+                ReportErrorAt(parser->token.location, "Consecutive statements on a line are not allowed");
             }
 
             if (element->kind != ASTValueKindEnumerationElement) {
-                ReportError("Only `enum-element`(s) are allowed inside of `enum-declaration`");
+                ReportErrorAt(parser->token.location, "Only `enum-element`(s) are allowed inside of `enum-declaration`");
                 return NULL;
             }
 
@@ -1272,12 +1298,12 @@ static inline ASTFunctionDeclarationRef _ParserParseFunctionDeclaration(ParserRe
 
     StringRef name = _ParserConsumeIdentifier(parser);
     if (!name) {
-        ReportError("Expected name of 'func'");
+        ReportErrorAt(parser->token.location, "Expected name of 'func'");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindLeftParenthesis)) {
-        ReportError("Expected parameter list after name of 'func'");
+        ReportErrorAt(parser->token.location, "Expected parameter list after name of 'func'");
         return NULL;
     }
 
@@ -1301,32 +1327,32 @@ static inline ASTFunctionDeclarationRef _ParserParseFunctionDeclaration(ParserRe
             }
 
             if (!_ParserConsumeToken(parser, TokenKindComma)) {
-                ReportError("Expected ',' or ')' in parameter list of 'func'");
+                ReportErrorAt(parser->token.location, "Expected ',' or ')' in parameter list of 'func'");
                 return NULL;
             }
         }
     }
 
     if (!_ParserConsumeToken(parser, TokenKindRightParenthesis)) {
-        ReportError("Expected ')' after parameter list of 'func'");
+        ReportErrorAt(parser->token.location, "Expected ')' after parameter list of 'func'");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindArrow)) {
-        ReportError("Expected '->' after parameter list of 'func'");
+        ReportErrorAt(parser->token.location, "Expected '->' after parameter list of 'func'");
         return NULL;
     }
 
     ASTTypeRef returnType = _ParserParseType(parser);
     if (!returnType) {
-        ReportError("Expected type for function result");
+        ReportErrorAt(parser->token.location, "Expected type for function result");
         return NULL;
     }
 
     if (_ParserConsumeToken(parser, TokenKindDirectiveIntrinsic)) {
         ASTConstantExpressionRef intrinsic = _ParserParseConstantExpression(parser);
         if (!intrinsic || intrinsic->kind != ASTConstantKindString) {
-            ReportError("Expected string literal after `#intrinsic` directive");
+            ReportErrorAt(parser->token.location, "Expected string literal after `#intrinsic` directive");
             return NULL;
         }
 
@@ -1372,12 +1398,12 @@ static inline ASTFunctionDeclarationRef _ParserParseForeignFunctionDeclaration(P
 
     StringRef name = _ParserConsumeIdentifier(parser);
     if (!name) {
-        ReportError("Expected name of 'func'");
+        ReportErrorAt(parser->token.location, "Expected name of 'func'");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindLeftParenthesis)) {
-        ReportError("Expected parameter list after name of 'func'");
+        ReportErrorAt(parser->token.location, "Expected parameter list after name of 'func'");
         return NULL;
     }
 
@@ -1401,31 +1427,31 @@ static inline ASTFunctionDeclarationRef _ParserParseForeignFunctionDeclaration(P
             }
 
             if (!_ParserConsumeToken(parser, TokenKindComma)) {
-                ReportError("Expected ',' or ')' in parameter list of 'func'");
+                ReportErrorAt(parser->token.location, "Expected ',' or ')' in parameter list of 'func'");
                 return NULL;
             }
         }
     }
 
     if (!_ParserConsumeToken(parser, TokenKindRightParenthesis)) {
-        ReportError("Expected ')' after parameter list of 'func'");
+        ReportErrorAt(parser->token.location, "Expected ')' after parameter list of 'func'");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindArrow)) {
-        ReportError("Expected '->' after parameter list of 'func'");
+        ReportErrorAt(parser->token.location, "Expected '->' after parameter list of 'func'");
         return NULL;
     }
 
     ASTTypeRef returnType = _ParserParseType(parser);
     if (!returnType) {
-        ReportError("Expected type for function result");
+        ReportErrorAt(parser->token.location, "Expected type for function result");
         return NULL;
     }
 
     ASTConstantExpressionRef foreign = _ParserParseConstantExpression(parser);
     if (!foreign || foreign->kind != ASTConstantKindString) {
-        ReportError("Expected string literal after signature of foreign function declaration");
+        ReportErrorAt(parser->token.location, "Expected string literal after signature of foreign function declaration");
         return NULL;
     }
 
@@ -1449,20 +1475,20 @@ static inline ASTFunctionDeclarationRef _ParserParsePrefixFunctionDeclaration(Pa
     }
 
     if (!_ParserConsumeToken(parser, TokenKindKeywordFunc)) {
-        ReportError("Expected keyword 'func' after 'prefix'");
+        ReportErrorAt(parser->token.location, "Expected keyword 'func' after 'prefix'");
         return NULL;
     }
 
     ASTUnaryOperator op = _ParserConsumeUnaryOperator(parser);
     if (op == ASTUnaryOperatorUnknown) {
-        ReportError("Expected unary operator of prefix func");
+        ReportErrorAt(parser->token.location, "Expected unary operator of prefix func");
         return NULL;
     }
 
     StringRef name = ASTGetPrefixOperatorName(parser->tempAllocator, op);
 
     if (!_ParserConsumeToken(parser, TokenKindLeftParenthesis)) {
-        ReportError("Expected parameter list after name of 'func'");
+        ReportErrorAt(parser->token.location, "Expected parameter list after name of 'func'");
         return NULL;
     }
 
@@ -1486,36 +1512,36 @@ static inline ASTFunctionDeclarationRef _ParserParsePrefixFunctionDeclaration(Pa
             }
 
             if (!_ParserConsumeToken(parser, TokenKindComma)) {
-                ReportError("Expected ',' or ')' in parameter list of 'func'");
+                ReportErrorAt(parser->token.location, "Expected ',' or ')' in parameter list of 'func'");
                 return NULL;
             }
         }
     }
 
     if (!_ParserConsumeToken(parser, TokenKindRightParenthesis)) {
-        ReportError("Expected ')' after parameter list of 'func'");
+        ReportErrorAt(parser->token.location, "Expected ')' after parameter list of 'func'");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindArrow)) {
-        ReportError("Expected '->' after parameter list of 'func'");
+        ReportErrorAt(parser->token.location, "Expected '->' after parameter list of 'func'");
         return NULL;
     }
 
     ASTTypeRef returnType = _ParserParseType(parser);
     if (!returnType) {
-        ReportError("Expected type for function result");
+        ReportErrorAt(parser->token.location, "Expected type for function result");
         return NULL;
     }
 
     if (ArrayGetElementCount(parameters) != 1) {
-        ReportError("Prefix functions must have exactly one argument");
+        ReportErrorAt(parser->token.location, "Prefix functions must have exactly one argument");
     }
 
     if (_ParserConsumeToken(parser, TokenKindDirectiveIntrinsic)) {
         ASTConstantExpressionRef intrinsic = _ParserParseConstantExpression(parser);
         if (!intrinsic || intrinsic->kind != ASTConstantKindString) {
-            ReportError("Expected string literal after `#intrinsic` directive");
+            ReportErrorAt(parser->token.location, "Expected string literal after `#intrinsic` directive");
             return NULL;
         }
 
@@ -1556,20 +1582,20 @@ static inline ASTFunctionDeclarationRef _ParserParseInfixFunctionDeclaration(Par
     }
 
     if (!_ParserConsumeToken(parser, TokenKindKeywordFunc)) {
-        ReportError("Expected keyword 'func' after 'infix'");
+        ReportErrorAt(parser->token.location, "Expected keyword 'func' after 'infix'");
         return NULL;
     }
 
     ASTBinaryOperator op = _ParserConsumeBinaryOperator(parser);
     if (op == ASTBinaryOperatorUnknown) {
-        ReportError("Expected binary operator of infix func");
+        ReportErrorAt(parser->token.location, "Expected binary operator of infix func");
         return NULL;
     }
 
     StringRef name = ASTGetInfixOperatorName(parser->tempAllocator, op);
 
     if (!_ParserConsumeToken(parser, TokenKindLeftParenthesis)) {
-        ReportError("Expected parameter list after name of 'func'");
+        ReportErrorAt(parser->token.location, "Expected parameter list after name of 'func'");
         return NULL;
     }
 
@@ -1593,36 +1619,36 @@ static inline ASTFunctionDeclarationRef _ParserParseInfixFunctionDeclaration(Par
             }
 
             if (!_ParserConsumeToken(parser, TokenKindComma)) {
-                ReportError("Expected ',' or ')' in parameter list of 'func'");
+                ReportErrorAt(parser->token.location, "Expected ',' or ')' in parameter list of 'func'");
                 return NULL;
             }
         }
     }
 
     if (!_ParserConsumeToken(parser, TokenKindRightParenthesis)) {
-        ReportError("Expected ')' after parameter list of 'func'");
+        ReportErrorAt(parser->token.location, "Expected ')' after parameter list of 'func'");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindArrow)) {
-        ReportError("Expected '->' after parameter list of 'func'");
+        ReportErrorAt(parser->token.location, "Expected '->' after parameter list of 'func'");
         return NULL;
     }
 
     ASTTypeRef returnType = _ParserParseType(parser);
     if (!returnType) {
-        ReportError("Expected type for function result");
+        ReportErrorAt(parser->token.location, "Expected type for function result");
         return NULL;
     }
 
     if (ArrayGetElementCount(parameters) != 2) {
-        ReportError("Infix functions must have exactly two arguments");
+        ReportErrorAt(parser->token.location, "Infix functions must have exactly two arguments");
     }
 
     if (_ParserConsumeToken(parser, TokenKindDirectiveIntrinsic)) {
         ASTConstantExpressionRef intrinsic = _ParserParseConstantExpression(parser);
         if (!intrinsic || intrinsic->kind != ASTConstantKindString) {
-            ReportError("Expected string literal after `#intrinsic` directive");
+            ReportErrorAt(parser->token.location, "Expected string literal after `#intrinsic` directive");
             return NULL;
         }
 
@@ -1664,12 +1690,12 @@ static inline ASTStructureDeclarationRef _ParserParseStructureDeclaration(Parser
 
     StringRef name = _ParserConsumeIdentifier(parser);
     if (!name) {
-        ReportError("Expected `name` of `struct-declaration`");
+        ReportErrorAt(parser->token.location, "Expected `name` of `struct-declaration`");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindLeftCurlyBracket)) {
-        ReportError("Expected '{' after name of `struct-declaration`");
+        ReportErrorAt(parser->token.location, "Expected '{' after name of `struct-declaration`");
         return NULL;
     }
 
@@ -1698,13 +1724,13 @@ static inline ASTStructureDeclarationRef _ParserParseStructureDeclaration(Parser
 
                 ArrayAppendElement(initializers, &initializer);
             } else {
-                ReportError("Expected 'var' or 'init' in structure body");
+                ReportErrorAt(parser->token.location, "Expected 'var' or 'init' in structure body");
                 return NULL;
             }
 
             if ((ArrayGetElementCount(values) > 0 || ArrayGetElementCount(initializers)) &&
                 !_SourceRangeContainsLineBreakCharacter(leadingTrivia)) {
-                ReportError("Consecutive statements on a line are not allowed");
+                ReportErrorAt(parser->token.location, "Consecutive statements on a line are not allowed");
             }
 
             if (_ParserIsToken(parser, TokenKindRightCurlyBracket)) {
@@ -1758,7 +1784,7 @@ static inline ASTInitializerDeclarationRef _ParserParseInitializerDeclaration(Pa
             }
 
             if (!_ParserConsumeToken(parser, TokenKindComma)) {
-                ReportError("Expected ',' or ')' in parameter list of 'init'");
+                ReportErrorAt(parser->token.location, "Expected ',' or ')' in parameter list of 'init'");
                 return NULL;
             }
         }
@@ -1788,24 +1814,25 @@ static inline ASTValueDeclarationRef _ParserParseVariableDeclaration(ParserRef p
     SourceRange location = parser->token.location;
 
     if (!_ParserConsumeToken(parser, TokenKindKeywordVar)) {
-        ReportErrorFormat("Expected 'var' found '%.*s'", (Int32)SourceRangeLength(parser->token.location), parser->token.location.start);
+        ReportErrorAt(parser->token.location, "Expected 'var' found '%.*s'", (Int32)SourceRangeLength(parser->token.location),
+                      parser->token.location.start);
         return NULL;
     }
 
     StringRef name = _ParserConsumeIdentifier(parser);
     if (!name) {
-        ReportError("Expected name of variable declaration");
+        ReportErrorAt(parser->token.location, "Expected name of variable declaration");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindColon)) {
-        ReportError("Expected ':' after name of variable declaration");
+        ReportErrorAt(parser->token.location, "Expected ':' after name of variable declaration");
         return NULL;
     }
 
     ASTTypeRef type = _ParserParseType(parser);
     if (!type) {
-        ReportError("Expected type of variable declaration");
+        ReportErrorAt(parser->token.location, "Expected type of variable declaration");
         return NULL;
     }
 
@@ -1814,11 +1841,11 @@ static inline ASTValueDeclarationRef _ParserParseVariableDeclaration(ParserRef p
     if (binary == ASTBinaryOperatorAssign) {
         initializer = _ParserParseExpression(parser, 0, true);
         if (!initializer) {
-            ReportError("Expected expression");
+            ReportErrorAt(parser->token.location, "Expected expression");
             return NULL;
         }
     } else if (binary != ASTBinaryOperatorUnknown) {
-        ReportError("Unexpected binary operator found!");
+        ReportErrorAt(parser->token.location, "Unexpected binary operator found!");
         return NULL;
     }
 
@@ -1831,24 +1858,24 @@ static inline ASTTypeAliasDeclarationRef _ParserParseTypeAliasDeclaration(Parser
     SourceRange location = parser->token.location;
 
     if (!_ParserConsumeToken(parser, TokenKindKeywordTypeAlias)) {
-        ReportError("Expected keyword 'typealias' at start of type alias!");
+        ReportErrorAt(parser->token.location, "Expected keyword 'typealias' at start of type alias!");
         return NULL;
     }
 
     StringRef name = _ParserConsumeIdentifier(parser);
     if (!name) {
-        ReportError("Expected identifier of 'typealias'");
+        ReportErrorAt(parser->token.location, "Expected identifier of 'typealias'");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindEqualsSign)) {
-        ReportError("Expected '=' after identifier of 'typealias'");
+        ReportErrorAt(parser->token.location, "Expected '=' after identifier of 'typealias'");
         return NULL;
     }
 
     ASTTypeRef type = _ParserParseType(parser);
     if (!type) {
-        ReportError("Expected type of 'typealias'");
+        ReportErrorAt(parser->token.location, "Expected type of 'typealias'");
         return NULL;
     }
 
@@ -1862,13 +1889,13 @@ static inline ASTValueDeclarationRef _ParserParseEnumerationElementDeclaration(P
 
     if (!_ParserConsumeToken(parser, TokenKindKeywordCase)) {
         // We assume that we are in a enumeration declaration here...
-        ReportError("Expected 'case' or '}' in enumeration declaration");
+        ReportErrorAt(parser->token.location, "Expected 'case' or '}' in enumeration declaration");
         return NULL;
     }
 
     StringRef name = _ParserConsumeIdentifier(parser);
     if (!name) {
-        ReportError("Expected name of enumeration element");
+        ReportErrorAt(parser->token.location, "Expected name of enumeration element");
         return NULL;
     }
 
@@ -1877,11 +1904,11 @@ static inline ASTValueDeclarationRef _ParserParseEnumerationElementDeclaration(P
     if (binary == ASTBinaryOperatorAssign) {
         initializer = _ParserParseExpression(parser, 0, true);
         if (!initializer) {
-            ReportError("Expected expression after '='");
+            ReportErrorAt(parser->token.location, "Expected expression after '='");
             return NULL;
         }
     } else if (binary != ASTBinaryOperatorUnknown) {
-        ReportError("Unexpected binary operator found!");
+        ReportErrorAt(parser->token.location, "Unexpected binary operator found!");
         return NULL;
     }
 
@@ -1899,18 +1926,18 @@ static inline ASTValueDeclarationRef _ParserParseParameterDeclaration(ParserRef
 
     StringRef name = _ParserConsumeIdentifier(parser);
     if (!name) {
-        ReportError("Expected parameter name followed by ':'");
+        ReportErrorAt(parser->token.location, "Expected parameter name followed by ':'");
         return NULL;
     }
 
     if (!_ParserConsumeToken(parser, TokenKindColon)) {
-        ReportError("Expected ':' after name of parameter");
+        ReportErrorAt(parser->token.location, "Expected ':' after name of parameter");
         return NULL;
     }
 
     ASTTypeRef type = _ParserParseType(parser);
     if (!type) {
-        ReportError("Expected type of parameter");
+        ReportErrorAt(parser->token.location, "Expected type of parameter");
         return NULL;
     }
 
@@ -1992,12 +2019,12 @@ static inline ASTTypeRef _ParserParseType(ParserRef parser) {
         }
 
         if (!_ParserConsumeToken(parser, TokenKindRightParenthesis)) {
-            ReportError("Expected ')' after parameter list of type");
+            ReportErrorAt(parser->token.location, "Expected ')' after parameter list of type");
             return NULL;
         }
 
         if (!_ParserConsumeToken(parser, TokenKindArrow)) {
-            ReportError("Expected '->' after parameter list of type");
+            ReportErrorAt(parser->token.location, "Expected '->' after parameter list of type");
             return NULL;
         }
 
@@ -2064,7 +2091,8 @@ static inline ASTExpressionRef _ParserParseConditionList(ParserRef parser) {
             return NULL;
         }
 
-        SourceRange location         = {condition->base.location.start, expression->base.location.end};
+        SourceRange location         = {ASTContextGetNodeLocation(parser->context, (ASTNodeRef)condition).start,
+                                        ASTContextGetNodeLocation(parser->context, (ASTNodeRef)expression).end};
         ASTExpressionRef arguments[] = {condition, expression};
         condition                    = (ASTExpressionRef)ASTContextCreateBinaryExpression(parser->context, location, parser->currentScope,
                                                                        ASTBinaryOperatorLogicalAnd, arguments);
@@ -2122,7 +2150,7 @@ static inline ASTNodeRef _ParserParseTopLevelNode(ParserRef parser) {
         return (ASTNodeRef)_ParserParseTypeAliasDeclaration(parser);
     }
 
-    ReportError("Expected top level node!");
+    ReportErrorAt(parser->token.location, "Expected top level node!");
     return NULL;
 }
 
@@ -2163,7 +2191,7 @@ static inline ASTNodeRef _ParserParseTopLevelInterfaceNode(ParserRef parser) {
         return (ASTNodeRef)_ParserParseTypeAliasDeclaration(parser);
     }
 
-    ReportError("Expected top level interface node!");
+    ReportErrorAt(parser->token.location, "Expected top level interface node!");
     return NULL;
 }
 
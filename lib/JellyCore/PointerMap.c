@@ -0,0 +1,140 @@
+#include "JellyCore/PointerMap.h"
+
+// The table is using open addressing with linear probing, each slot stores the key followed by the value. The capacity is always a
+// power of two and the load factor is kept at or below 1/2 to keep the probe sequences short.
+const Index _kPointerMapMinimumCapacity = 16;
+const Index _kPointerMapValueAlignment  = 8;
+
+struct _PointerMap {
+    AllocatorRef allocator;
+    Index valueSize;
+    Index slotSize;
+    Index capacity;
+    Index count;
+    UInt8 *slots;
+};
+
+static inline Index _Align(Index value, Index alignment);
+static inline UInt64 _PointerMapHash(const void *key);
+static inline const void **_PointerMapGetSlot(PointerMapRef map, Index index);
+static inline const void **_PointerMapFindSlot(PointerMapRef map, const void *key);
+static inline void _PointerMapRehash(PointerMapRef map, Index capacity);
+
+PointerMapRef PointerMapCreate(AllocatorRef allocator, Index valueSize) {
+    PointerMapRef map = AllocatorAllocate(allocator, sizeof(struct _PointerMap));
+    map->allocator    = allocator;
+    map->valueSize    = valueSize;
+    map->slotSize     = sizeof(void *) + _Align(valueSize, _kPointerMapValueAlignment);
+    map->capacity     = 0;
+    map->count        = 0;
+    map->slots        = NULL;
+    return map;
+}
+
+void PointerMapDestroy(PointerMapRef map) {
+    if (map->slots) {
+        AllocatorDeallocate(map->allocator, map->slots);
+    }
+
+    AllocatorDeallocate(map->allocator, map);
+}
+
+Index PointerMapGetCount(PointerMapRef map) {
+    return map->count;
+}
+
+void *PointerMapLookup(PointerMapRef map, const void *key) {
+    assert(key);
+
+    if (map->count < 1) {
+        return NULL;
+    }
+
+    const void **slot = _PointerMapFindSlot(map, key);
+    return *slot ? (void *)(slot + 1) : NULL;
+}
+
+void *PointerMapInsert(PointerMapRef map, const void *key) {
+    assert(key);
+
+    if ((map->count + 1) * 2 > map->capacity) {
+        _PointerMapRehash(map, MAX(map->capacity * 2, _kPointerMapMinimumCapacity));
+    }
+
+    const void **slot = _PointerMapFindSlot(map, key);
+    if (!*slot) {
+        *slot = key;
+        memset(slot + 1, 0, map->valueSize);
+        map->count += 1;
+    }
+
+    return (void *)(slot + 1);
+}
+
+void PointerMapReserve(PointerMapRef map, Index count) {
+    Index capacity = MAX(map->capacity, _kPointerMapMinimumCapacity);
+    while ((map->count + count) * 2 > capacity) {
+        capacity *= 2;
+    }
+
+    if (capacity > map->capacity) {
+        _PointerMapRehash(map, capacity);
+    }
+}
+
+void PointerMapRemoveAll(PointerMapRef map) {
+    if (map->slots) {
+        memset(map->slots, 0, map->slotSize * map->capacity);
+    }
+
+    map->count = 0;
+}
+
+static inline Index _Align(Index value, Index alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static inline UInt64 _PointerMapHash(const void *key) {
+    // The low bits of addresses are mostly zero because of the alignment, so the bits of the address are mixed before masking
+    UInt64 hash = (UInt64)(uintptr_t)key;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static inline const void **_PointerMapGetSlot(PointerMapRef map, Index index) {
+    return (const void **)(map->slots + index * map->slotSize);
+}
+
+/// Returns the slot of `key` or the empty slot where `key` has to be inserted.
+static inline const void **_PointerMapFindSlot(PointerMapRef map, const void *key) {
+    Index mask        = map->capacity - 1;
+    Index index       = _PointerMapHash(key) & mask;
+    const void **slot = _PointerMapGetSlot(map, index);
+    while (*slot && *slot != key) {
+        index = (index + 1) & mask;
+        slot  = _PointerMapGetSlot(map, index);
+    }
+
+    return slot;
+}
+
+static inline void _PointerMapRehash(PointerMapRef map, Index capacity) {
+    UInt8 *slots       = map->slots;
+    Index slotCapacity = map->capacity;
+    map->capacity      = capacity;
+    map->slots         = AllocatorAllocate(map->allocator, map->slotSize * capacity);
+    memset(map->slots, 0, map->slotSize * capacity);
+
+    for (Index index = 0; index < slotCapacity; index++) {
+        const void **slot = (const void **)(slots + index * map->slotSize);
+        if (*slot) {
+            memcpy(_PointerMapFindSlot(map, *slot), slot, map->slotSize);
+        }
+    }
+
+    if (slots) {
+        AllocatorDeallocate(map->allocator, slots);
+    }
+}
@@ -0,0 +1,237 @@
+#include "JellyCore/Array.h"
+#include "JellyCore/JSONWriter.h"
+#include "JellyCore/Profiler.h"
+
+#include <pthread.h>
+#include <sys/resource.h>
+#include <time.h>
+
+struct _ProfilerSpan {
+    const Char *phase;
+    StringRef unitName;
+    Index threadID;
+    UInt64 wallStart;
+    UInt64 wallEnd;
+    UInt64 cpuStart;
+    UInt64 cpuEnd;
+    Index allocationCount;
+    Index allocatedBytes;
+    Int liveBytes;
+    Int outerPeakLiveBytes;
+    Index peakBytes;
+};
+typedef struct _ProfilerSpan ProfilerSpan;
+
+struct _ProfilerReportEntry {
+    const Char *phase;
+    StringRef unitName;
+    UInt64 wallTime;
+    UInt64 cpuTime;
+    Index allocationCount;
+    Index allocatedBytes;
+    Index peakBytes;
+};
+typedef struct _ProfilerReportEntry ProfilerReportEntry;
+
+struct _Profiler {
+    AllocatorRef allocator;
+    UInt64 wallStart;
+    ArrayRef spans;
+    pthread_mutex_t mutex;
+};
+
+static Index _kProfilerNextThreadID                = 1;
+static JELLY_THREAD_LOCAL Index _kProfilerThreadID = 0;
+
+static inline UInt64 _ProfilerGetTime(clockid_t clock);
+static inline Index _ProfilerGetThreadID(void);
+static inline Index _ProfilerGetPeakResidentBytes(void);
+static inline void _ProfilerReportEntryAppendSpan(ArrayRef entries, const Char *phase, StringRef unitName, ProfilerSpan *span);
+static inline void _ProfilerPrintReportEntry(FILE *output, ProfilerReportEntry *entry, Index indentation);
+
+ProfilerRef ProfilerCreate(AllocatorRef allocator) {
+    ProfilerRef profiler = AllocatorAllocate(allocator, sizeof(struct _Profiler));
+    profiler->allocator  = allocator;
+    profiler->wallStart  = _ProfilerGetTime(CLOCK_MONOTONIC);
+    profiler->spans      = ArrayCreateEmpty(allocator, sizeof(ProfilerSpan), 64);
+    pthread_mutex_init(&profiler->mutex, NULL);
+    return profiler;
+}
+
+void ProfilerDestroy(ProfilerRef profiler) {
+    for (Index index = 0; index < ArrayGetElementCount(profiler->spans); index++) {
+        ProfilerSpan *span = (ProfilerSpan *)ArrayGetElementAtIndex(profiler->spans, index);
+        StringDestroy(span->unitName);
+    }
+
+    ArrayDestroy(profiler->spans);
+    pthread_mutex_destroy(&profiler->mutex);
+    AllocatorDeallocate(profiler->allocator, profiler);
+}
+
+Index ProfilerBeginSpan(ProfilerRef profiler, const Char *phase, StringRef unitName) {
+    ProfilerSpan span;
+    span.phase    = phase;
+    span.unitName = unitName ? StringCreateCopy(profiler->allocator, unitName) : StringCreateEmpty(profiler->allocator);
+    span.threadID = _ProfilerGetThreadID();
+
+    pthread_mutex_lock(&profiler->mutex);
+    Index spanIndex = ArrayGetElementCount(profiler->spans);
+    ArrayAppendElement(profiler->spans, &span);
+    pthread_mutex_unlock(&profiler->mutex);
+
+    // The start is sampled after appending the span to exclude the bookkeeping of the profiler from the measurements, the peak of the
+    // thread is restarted at the current live bytes and the peak of an enclosing span is restored when ending the span
+    AllocatorStatistics statistics = AllocatorGetThreadStatistics();
+    Int outerPeakLiveBytes         = AllocatorSetThreadPeakLiveBytes(statistics.liveBytes);
+    UInt64 wallStart               = _ProfilerGetTime(CLOCK_MONOTONIC);
+    UInt64 cpuStart                = _ProfilerGetTime(CLOCK_THREAD_CPUTIME_ID);
+
+    pthread_mutex_lock(&profiler->mutex);
+    ProfilerSpan *entry       = (ProfilerSpan *)ArrayGetElementAtIndex(profiler->spans, spanIndex);
+    entry->wallStart          = wallStart;
+    entry->cpuStart           = cpuStart;
+    entry->allocationCount    = statistics.allocationCount;
+    entry->allocatedBytes     = statistics.allocatedBytes;
+    entry->liveBytes          = statistics.liveBytes;
+    entry->outerPeakLiveBytes = outerPeakLiveBytes;
+    pthread_mutex_unlock(&profiler->mutex);
+    return spanIndex;
+}
+
+void ProfilerEndSpan(ProfilerRef profiler, Index span) {
+    UInt64 cpuEnd                  = _ProfilerGetTime(CLOCK_THREAD_CPUTIME_ID);
+    UInt64 wallEnd                 = _ProfilerGetTime(CLOCK_MONOTONIC);
+    AllocatorStatistics statistics = AllocatorGetThreadStatistics();
+
+    pthread_mutex_lock(&profiler->mutex);
+    ProfilerSpan *entry = (ProfilerSpan *)ArrayGetElementAtIndex(profiler->spans, span);
+    assert(entry->threadID == _ProfilerGetThreadID());
+    entry->wallEnd         = wallEnd;
+    entry->cpuEnd          = cpuEnd;
+    entry->allocationCount = statistics.allocationCount - entry->allocationCount;
+    entry->allocatedBytes  = statistics.allocatedBytes - entry->allocatedBytes;
+    entry->peakBytes       = (Index)(statistics.peakLiveBytes - entry->liveBytes);
+    AllocatorSetThreadPeakLiveBytes(MAX(entry->outerPeakLiveBytes, statistics.peakLiveBytes));
+    pthread_mutex_unlock(&profiler->mutex);
+}
+
+void ProfilerPrintReport(ProfilerRef profiler, FILE *output) {
+    pthread_mutex_lock(&profiler->mutex);
+
+    // Phases are reported in the order of their first span followed by their units in the order of their first span
+    ArrayRef phases = ArrayCreateEmpty(profiler->allocator, sizeof(ProfilerReportEntry), 16);
+    ArrayRef units  = ArrayCreateEmpty(profiler->allocator, sizeof(ProfilerReportEntry), 64);
+    for (Index index = 0; index < ArrayGetElementCount(profiler->spans); index++) {
+        ProfilerSpan *span = (ProfilerSpan *)ArrayGetElementAtIndex(profiler->spans, index);
+        _ProfilerReportEntryAppendSpan(phases, span->phase, NULL, span);
+        _ProfilerReportEntryAppendSpan(units, span->phase, span->unitName, span);
+    }
+
+    fprintf(output, "===------------------------------------------------------------------------------===\n");
+    fprintf(output, "                            Jelly Compilation Time Report\n");
+    fprintf(output, "===------------------------------------------------------------------------------===\n");
+    fprintf(output, "%12s %12s %12s %16s %16s  %s\n", "Wall (s)", "CPU (s)", "Allocations", "Allocated (KiB)", "Peak Heap (KiB)",
+            "Phase / Unit");
+
+    for (Index phaseIndex = 0; phaseIndex < ArrayGetElementCount(phases); phaseIndex++) {
+        ProfilerReportEntry *phase = (ProfilerReportEntry *)ArrayGetElementAtIndex(phases, phaseIndex);
+        _ProfilerPrintReportEntry(output, phase, 0);
+
+        for (Index unitIndex = 0; unitIndex < ArrayGetElementCount(units); unitIndex++) {
+            ProfilerReportEntry *unit = (ProfilerReportEntry *)ArrayGetElementAtIndex(units, unitIndex);
+            if (strcmp(unit->phase, phase->phase) == 0 && StringGetLength(unit->unitName) > 0) {
+                _ProfilerPrintReportEntry(output, unit, 2);
+            }
+        }
+    }
+
+    // The resident set size is only available for the whole process and can't be attributed to a single phase
+    fprintf(output, "\nPeak resident set size of the process: %zu KiB\n", _ProfilerGetPeakResidentBytes() / 1024);
+
+    ArrayDestroy(units);
+    ArrayDestroy(phases);
+    pthread_mutex_unlock(&profiler->mutex);
+}
+
+void ProfilerWriteTrace(ProfilerRef profiler, FILE *output) {
+    pthread_mutex_lock(&profiler->mutex);
+
+    fprintf(output, "{\"traceEvents\":[");
+    for (Index index = 0; index < ArrayGetElementCount(profiler->spans); index++) {
+        ProfilerSpan *span = (ProfilerSpan *)ArrayGetElementAtIndex(profiler->spans, index);
+        UInt64 timestamp   = (span->wallStart - profiler->wallStart) / 1000;
+        UInt64 duration    = (span->wallEnd - span->wallStart) / 1000;
+
+        fprintf(output, "%s\n{\"name\":", index > 0 ? "," : "");
+        JSONWriteString(output, span->phase);
+        fprintf(output, ",\"cat\":\"jelly\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%llu,\"dur\":%llu", span->threadID,
+                (unsigned long long)timestamp, (unsigned long long)duration);
+        fprintf(output, ",\"args\":{\"detail\":");
+        JSONWriteString(output, StringGetCharacters(span->unitName));
+        fprintf(output, ",\"cpu_us\":%llu,\"allocations\":%zu,\"allocated_bytes\":%zu,\"peak_bytes\":%zu}}",
+                (unsigned long long)((span->cpuEnd - span->cpuStart) / 1000), span->allocationCount, span->allocatedBytes, span->peakBytes);
+    }
+    fprintf(output, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    pthread_mutex_unlock(&profiler->mutex);
+}
+
+static inline UInt64 _ProfilerGetTime(clockid_t clock) {
+    struct timespec time;
+    clock_gettime(clock, &time);
+    return (UInt64)time.tv_sec * 1000000000ULL + (UInt64)time.tv_nsec;
+}
+
+static inline Index _ProfilerGetThreadID(void) {
+    if (_kProfilerThreadID == 0) {
+        _kProfilerThreadID = __atomic_fetch_add(&_kProfilerNextThreadID, 1, __ATOMIC_RELAXED);
+    }
+
+    return _kProfilerThreadID;
+}
+
+static inline Index _ProfilerGetPeakResidentBytes(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+#if defined(__APPLE__)
+    return (Index)usage.ru_maxrss;
+#else
+    return (Index)usage.ru_maxrss * 1024;
+#endif
+}
+
+static inline void _ProfilerReportEntryAppendSpan(ArrayRef entries, const Char *phase, StringRef unitName, ProfilerSpan *span) {
+    ProfilerReportEntry *entry = NULL;
+    for (Index index = 0; index < ArrayGetElementCount(entries); index++) {
+        ProfilerReportEntry *candidate = (ProfilerReportEntry *)ArrayGetElementAtIndex(entries, index);
+        if (strcmp(candidate->phase, phase) == 0 && (!unitName || StringIsEqual(candidate->unitName, unitName))) {
+            entry = candidate;
+            break;
+        }
+    }
+
+    if (!entry) {
+        ProfilerReportEntry newEntry;
+        memset(&newEntry, 0, sizeof(ProfilerReportEntry));
+        newEntry.phase    = phase;
+        newEntry.unitName = unitName;
+        ArrayAppendElement(entries, &newEntry);
+        entry = (ProfilerReportEntry *)ArrayGetElementAtIndex(entries, ArrayGetElementCount(entries) - 1);
+    }
+
+    entry->wallTime += span->wallEnd - span->wallStart;
+    entry->cpuTime += span->cpuEnd - span->cpuStart;
+    entry->allocationCount += span->allocationCount;
+    entry->allocatedBytes += span->allocatedBytes;
+    entry->peakBytes = MAX(entry->peakBytes, span->peakBytes);
+}
+
+static inline void _ProfilerPrintReportEntry(FILE *output, ProfilerReportEntry *entry, Index indentation) {
+    fprintf(output, "%12.4f %12.4f %12zu %16.1f %16zu  %*s%s\n", entry->wallTime / 1e9, entry->cpuTime / 1e9, entry->allocationCount,
+            entry->allocatedBytes / 1024.0, entry->peakBytes / 1024, (int)indentation, "",
+            entry->unitName ? StringGetCharacters(entry->unitName) : entry->phase);
+}
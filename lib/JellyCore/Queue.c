@@ -1,33 +1,188 @@
-#include "JellyCore/Array.h"
 #include "JellyCore/Queue.h"
 
+// The capacity is always a power of two to map the indices into the ring buffer with a mask
+const Index _kQueueMinimumCapacity = 8;
+
+// Each segment of a concurrent queue is filled exactly once, the enqueue and dequeue indices are only advancing which avoids the ABA
+// problem without having to reclaim segments while the queue is in use
+const Index _kConcurrentQueueSegmentCapacity = 256;
+
 struct _Queue {
     AllocatorRef allocator;
-    ArrayRef elements;
+    void **elements;
+    Index capacity;
+    Index head;
+    Index count;
+};
+
+struct _ConcurrentQueueSegment {
+    struct _ConcurrentQueueSegment *next;
+    Index enqueueIndex;
+    Index dequeueIndex;
+    void *elements[];
+};
+typedef struct _ConcurrentQueueSegment ConcurrentQueueSegment;
+
+struct _ConcurrentQueue {
+    AllocatorRef allocator;
+    ConcurrentQueueSegment *firstSegment;
+    ConcurrentQueueSegment *head;
+    ConcurrentQueueSegment *tail;
 };
 
+static inline void _QueueGrow(QueueRef queue);
+
+static inline ConcurrentQueueSegment *_ConcurrentQueueSegmentCreate(ConcurrentQueueRef queue);
+static inline Bool _ConcurrentQueueSegmentEnqueue(ConcurrentQueueSegment *segment, void *element);
+static inline void *_ConcurrentQueueSegmentDequeue(ConcurrentQueueSegment *segment, Bool *isExhausted);
+
 QueueRef QueueCreate(AllocatorRef allocator) {
     QueueRef queue   = AllocatorAllocate(allocator, sizeof(struct _Queue));
     queue->allocator = allocator;
-    queue->elements  = ArrayCreateEmpty(allocator, sizeof(void *), 8);
+    queue->elements  = AllocatorAllocate(allocator, sizeof(void *) * _kQueueMinimumCapacity);
+    queue->capacity  = _kQueueMinimumCapacity;
+    queue->head      = 0;
+    queue->count     = 0;
     return queue;
 }
 
 void QueueDestroy(QueueRef queue) {
-    ArrayDestroy(queue->elements);
+    AllocatorDeallocate(queue->allocator, queue->elements);
     AllocatorDeallocate(queue->allocator, queue);
 }
 
+Index QueueGetElementCount(QueueRef queue) {
+    return queue->count;
+}
+
 void QueueEnqueue(QueueRef queue, void *element) {
-    ArrayAppendElement(queue->elements, &element);
+    if (queue->count == queue->capacity) {
+        _QueueGrow(queue);
+    }
+
+    queue->elements[(queue->head + queue->count) & (queue->capacity - 1)] = element;
+    queue->count += 1;
 }
 
 void *QueueDequeue(QueueRef queue) {
-    if (ArrayGetElementCount(queue->elements) < 1) {
+    if (queue->count < 1) {
         return NULL;
     }
 
-    void *element = *((void **)ArrayGetElementAtIndex(queue->elements, 0));
-    ArrayRemoveElementAtIndex(queue->elements, 0);
+    void *element = queue->elements[queue->head];
+    queue->head   = (queue->head + 1) & (queue->capacity - 1);
+    queue->count -= 1;
     return element;
 }
+
+static inline void _QueueGrow(QueueRef queue) {
+    Index capacity  = queue->capacity * 2;
+    queue->elements = AllocatorReallocate(queue->allocator, queue->elements, sizeof(void *) * capacity);
+    assert(queue->elements);
+
+    // The wrapped around front of the ring is moved behind the old end to restore a contiguous sequence
+    if (queue->head + queue->count > queue->capacity) {
+        Index wrappedCount = queue->head + queue->count - queue->capacity;
+        memcpy(&queue->elements[queue->capacity], &queue->elements[0], sizeof(void *) * wrappedCount);
+    }
+
+    queue->capacity = capacity;
+}
+
+ConcurrentQueueRef ConcurrentQueueCreate(AllocatorRef allocator) {
+    ConcurrentQueueRef queue = AllocatorAllocate(allocator, sizeof(struct _ConcurrentQueue));
+    queue->allocator         = allocator;
+    queue->firstSegment      = _ConcurrentQueueSegmentCreate(queue);
+    queue->head              = queue->firstSegment;
+    queue->tail              = queue->firstSegment;
+    return queue;
+}
+
+void ConcurrentQueueDestroy(ConcurrentQueueRef queue) {
+    ConcurrentQueueSegment *segment = queue->firstSegment;
+    while (segment) {
+        ConcurrentQueueSegment *next = segment->next;
+        AllocatorDeallocate(queue->allocator, segment);
+        segment = next;
+    }
+
+    AllocatorDeallocate(queue->allocator, queue);
+}
+
+void ConcurrentQueueEnqueue(ConcurrentQueueRef queue, void *element) {
+    assert(element);
+
+    ConcurrentQueueSegment *segment = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    while (!_ConcurrentQueueSegmentEnqueue(segment, element)) {
+        ConcurrentQueueSegment *next = __atomic_load_n(&segment->next, __ATOMIC_ACQUIRE);
+        if (!next) {
+            ConcurrentQueueSegment *newSegment = _ConcurrentQueueSegmentCreate(queue);
+            if (__atomic_compare_exchange_n(&segment->next, &next, newSegment, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                next = newSegment;
+            } else {
+                AllocatorDeallocate(queue->allocator, newSegment);
+            }
+        }
+
+        // Failing to advance the tail means that another producer already did so
+        __atomic_compare_exchange_n(&queue->tail, &segment, next, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        segment = next;
+    }
+}
+
+void *ConcurrentQueueDequeue(ConcurrentQueueRef queue) {
+    ConcurrentQueueSegment *segment = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    while (true) {
+        Bool isExhausted = false;
+        void *element    = _ConcurrentQueueSegmentDequeue(segment, &isExhausted);
+        if (element || !isExhausted) {
+            return element;
+        }
+
+        ConcurrentQueueSegment *next = __atomic_load_n(&segment->next, __ATOMIC_ACQUIRE);
+        if (!next) {
+            return NULL;
+        }
+
+        __atomic_compare_exchange_n(&queue->head, &segment, next, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        segment = next;
+    }
+}
+
+static inline ConcurrentQueueSegment *_ConcurrentQueueSegmentCreate(ConcurrentQueueRef queue) {
+    Index size                      = sizeof(ConcurrentQueueSegment) + sizeof(void *) * _kConcurrentQueueSegmentCapacity;
+    ConcurrentQueueSegment *segment = AllocatorAllocate(queue->allocator, size);
+    assert(segment);
+    memset(segment, 0, size);
+    return segment;
+}
+
+static inline Bool _ConcurrentQueueSegmentEnqueue(ConcurrentQueueSegment *segment, void *element) {
+    Index index = __atomic_fetch_add(&segment->enqueueIndex, 1, __ATOMIC_ACQ_REL);
+    if (index >= _kConcurrentQueueSegmentCapacity) {
+        return false;
+    }
+
+    // Publishing the element into its zero initialized slot marks it as ready for the consumers
+    __atomic_store_n(&segment->elements[index], element, __ATOMIC_RELEASE);
+    return true;
+}
+
+static inline void *_ConcurrentQueueSegmentDequeue(ConcurrentQueueSegment *segment, Bool *isExhausted) {
+    Index index = __atomic_load_n(&segment->dequeueIndex, __ATOMIC_ACQUIRE);
+    while (true) {
+        if (index >= _kConcurrentQueueSegmentCapacity) {
+            *isExhausted = true;
+            return NULL;
+        }
+
+        void *element = __atomic_load_n(&segment->elements[index], __ATOMIC_ACQUIRE);
+        if (!element) {
+            return NULL;
+        }
+
+        if (__atomic_compare_exchange_n(&segment->dequeueIndex, &index, index + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return element;
+        }
+    }
+}
@@ -0,0 +1,221 @@
+#include "JellyCore/SourceBuffer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+struct _SourceBuffer {
+    AllocatorRef allocator;
+    Index length;
+    Char *memory;
+    Bool isMapped;
+    Index lineCount;
+    UInt32 *lineOffsets;
+};
+
+static inline SourceBufferRef _SourceBufferCreateFromFileDescriptor(AllocatorRef allocator, Int32 fileDescriptor, Index length);
+static inline void _SourceBufferBuildLineTable(SourceBufferRef buffer);
+static inline Index _SourceBufferScanLineBreaks(const Char *memory, Index length, UInt32 *lineOffsets);
+
+SourceBufferRef SourceBufferCreateFromFile(AllocatorRef allocator, const Char *filePath) {
+    Int32 fileDescriptor = open(filePath, O_RDONLY);
+    if (fileDescriptor < 0) {
+        return NULL;
+    }
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode)) {
+        close(fileDescriptor);
+        return NULL;
+    }
+
+    Index length     = (Index)fileStatus.st_size;
+    Index pageSize   = (Index)sysconf(_SC_PAGESIZE);
+    void *mapping    = MAP_FAILED;
+    Bool canBeMapped = length > 0 && (length % pageSize) != 0;
+    if (canBeMapped) {
+        // The remainder of the last page is zero filled by the kernel which provides the null terminator for the lexer
+        mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    }
+
+    if (mapping == MAP_FAILED) {
+        SourceBufferRef buffer = _SourceBufferCreateFromFileDescriptor(allocator, fileDescriptor, length);
+        close(fileDescriptor);
+        return buffer;
+    }
+
+    close(fileDescriptor);
+    madvise(mapping, length, MADV_SEQUENTIAL);
+    madvise(mapping, length, MADV_WILLNEED);
+
+    SourceBufferRef buffer = AllocatorAllocate(allocator, sizeof(struct _SourceBuffer));
+    assert(buffer);
+    buffer->allocator   = allocator;
+    buffer->length      = length;
+    buffer->memory      = (Char *)mapping;
+    buffer->isMapped    = true;
+    buffer->lineCount   = 0;
+    buffer->lineOffsets = NULL;
+    return buffer;
+}
+
+SourceBufferRef SourceBufferCreateFromString(AllocatorRef allocator, StringRef string) {
+    SourceBufferRef buffer = AllocatorAllocate(allocator, sizeof(struct _SourceBuffer));
+    assert(buffer);
+    buffer->allocator   = allocator;
+    buffer->length      = StringGetLength(string);
+    buffer->memory      = AllocatorAllocate(allocator, sizeof(Char) * (buffer->length + 1));
+    buffer->isMapped    = false;
+    buffer->lineCount   = 0;
+    buffer->lineOffsets = NULL;
+    assert(buffer->memory);
+    memcpy(buffer->memory, StringGetCharacters(string), sizeof(Char) * (buffer->length + 1));
+    return buffer;
+}
+
+void SourceBufferDestroy(SourceBufferRef buffer) {
+    if (buffer->lineOffsets) {
+        AllocatorDeallocate(buffer->allocator, buffer->lineOffsets);
+    }
+
+    if (buffer->isMapped) {
+        munmap(buffer->memory, buffer->length);
+    } else {
+        AllocatorDeallocate(buffer->allocator, buffer->memory);
+    }
+
+    AllocatorDeallocate(buffer->allocator, buffer);
+}
+
+const Char *SourceBufferGetCharacters(SourceBufferRef buffer) {
+    return buffer->memory;
+}
+
+Index SourceBufferGetLength(SourceBufferRef buffer) {
+    return buffer->length;
+}
+
+Bool SourceBufferIsMapped(SourceBufferRef buffer) {
+    return buffer->isMapped;
+}
+
+Bool SourceBufferContainsPosition(SourceBufferRef buffer, const Char *position) {
+    return buffer->memory <= position && position <= buffer->memory + buffer->length;
+}
+
+Index SourceBufferGetLineCount(SourceBufferRef buffer) {
+    _SourceBufferBuildLineTable(buffer);
+    return buffer->lineCount;
+}
+
+Bool SourceBufferGetLineAndColumn(SourceBufferRef buffer, const Char *position, Index *line, Index *column) {
+    if (!SourceBufferContainsPosition(buffer, position)) {
+        return false;
+    }
+
+    _SourceBufferBuildLineTable(buffer);
+
+    // Finds the last line starting at or before the position, the first line always starts at offset 0
+    UInt32 offset = (UInt32)(position - buffer->memory);
+    Index lower   = 0;
+    Index upper   = buffer->lineCount;
+    while (upper - lower > 1) {
+        Index middle = lower + (upper - lower) / 2;
+        if (buffer->lineOffsets[middle] <= offset) {
+            lower = middle;
+        } else {
+            upper = middle;
+        }
+    }
+
+    *line   = lower + 1;
+    *column = offset - buffer->lineOffsets[lower] + 1;
+    return true;
+}
+
+static inline SourceBufferRef _SourceBufferCreateFromFileDescriptor(AllocatorRef allocator, Int32 fileDescriptor, Index length) {
+    Char *memory = AllocatorAllocate(allocator, sizeof(Char) * (length + 1));
+    assert(memory);
+
+    Index offset = 0;
+    while (offset < length) {
+        ssize_t readLength = read(fileDescriptor, memory + offset, length - offset);
+        if (readLength <= 0) {
+            break;
+        }
+
+        offset += readLength;
+    }
+
+    memory[offset] = 0;
+
+    SourceBufferRef buffer = AllocatorAllocate(allocator, sizeof(struct _SourceBuffer));
+    assert(buffer);
+    buffer->allocator   = allocator;
+    buffer->length      = offset;
+    buffer->memory      = memory;
+    buffer->isMapped    = false;
+    buffer->lineCount   = 0;
+    buffer->lineOffsets = NULL;
+    return buffer;
+}
+
+static inline void _SourceBufferBuildLineTable(SourceBufferRef buffer) {
+    if (buffer->lineOffsets) {
+        return;
+    }
+
+    // Offsets are stored as 32-bit values to keep the table compact, source files beyond 4 GiB are not supported
+    assert(buffer->length < UINT32_MAX);
+
+    Index lineBreakCount   = _SourceBufferScanLineBreaks(buffer->memory, buffer->length, NULL);
+    buffer->lineCount      = lineBreakCount + 1;
+    buffer->lineOffsets    = AllocatorAllocate(buffer->allocator, sizeof(UInt32) * buffer->lineCount);
+    assert(buffer->lineOffsets);
+    buffer->lineOffsets[0] = 0;
+    _SourceBufferScanLineBreaks(buffer->memory, buffer->length, buffer->lineOffsets + 1);
+}
+
+/// Returns the number of '\n' characters in `memory` and writes the offset of the character following each of them into `lineOffsets`
+/// if it is not NULL. The scan compares 16 bytes at once if SSE2 is available and falls back to `memchr` which is vectorized by libc.
+static inline Index _SourceBufferScanLineBreaks(const Char *memory, Index length, UInt32 *lineOffsets) {
+    Index count = 0;
+    Index index = 0;
+
+#if defined(__SSE2__)
+    const __m128i lineBreak = _mm_set1_epi8('\n');
+    for (; index + 16 <= length; index += 16) {
+        __m128i characters = _mm_loadu_si128((const __m128i *)(memory + index));
+        UInt32 mask        = (UInt32)_mm_movemask_epi8(_mm_cmpeq_epi8(characters, lineBreak));
+        if (!lineOffsets) {
+            count += __builtin_popcount(mask);
+            continue;
+        }
+
+        while (mask) {
+            lineOffsets[count] = (UInt32)(index + __builtin_ctz(mask) + 1);
+            count += 1;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    while (index < length) {
+        const Char *lineBreak = memchr(memory + index, '\n', length - index);
+        if (!lineBreak) {
+            break;
+        }
+
+        index = (Index)(lineBreak - memory) + 1;
+        if (lineOffsets) {
+            lineOffsets[count] = (UInt32)index;
+        }
+
+        count += 1;
+    }
+
+    return count;
+}
@@ -1,52 +1,47 @@
 #include "JellyCore/String.h"
 
-// TODO: Allow dynamic buffer sizes for string formatting, this buffer is only a temporary solution and unlikely to cause memory issues for
-// now because there won't be any known string which more than 65535 characters...
-static Char _kStringFormatBuffer[65535] = {};
+// Strings which fit into the inline buffer including their terminator are stored within the same allocation as the string itself
+#define _kStringInlineCapacity 32
 
 struct _String {
     AllocatorRef allocator;
     Index length;
+    Index capacity;
     Char *memory;
-} __attribute__((packed));
+    Char inlineMemory[_kStringInlineCapacity];
+};
 
+static inline StringRef _StringCreate(AllocatorRef allocator, Index length);
+static inline void _StringReserveCapacity(StringRef string, Index capacity);
+static inline void _StringAppendCharacters(StringRef string, const Char *characters, Index length);
 static inline Bool _StringHasPrefix(StringRef string, const Char *rawPrefix);
 
 StringRef StringCreate(AllocatorRef allocator, const Char *rawString) {
-    StringRef string = AllocatorAllocate(allocator, sizeof(struct _String));
-    assert(string);
-    string->allocator = allocator;
-    string->length    = strlen(rawString);
-    string->memory    = AllocatorAllocate(allocator, sizeof(Char) * (string->length + 1));
-    assert(string->memory);
-    memcpy(string->memory, rawString, sizeof(Char) * (string->length + 1));
+    Index length     = strlen(rawString);
+    StringRef string = _StringCreate(allocator, length);
+    memcpy(string->memory, rawString, sizeof(Char) * length);
     return string;
 }
 
 StringRef StringCreateRange(AllocatorRef allocator, const Char *start, const Char *end) {
     Index length     = end - start;
-    StringRef string = AllocatorAllocate(allocator, sizeof(struct _String));
-    assert(string);
-    string->allocator = allocator;
-    string->length    = length;
-    string->memory    = AllocatorAllocate(allocator, sizeof(Char) * (length + 1));
-    assert(string->memory);
+    StringRef string = _StringCreate(allocator, length);
     memcpy(string->memory, start, sizeof(Char) * length);
-    string->memory[sizeof(Char) * length] = '\0';
     return string;
 }
 
 StringRef StringCreateCopy(AllocatorRef allocator, StringRef string) {
-    StringRef copy = AllocatorAllocate(allocator, sizeof(struct _String));
-    assert(copy);
-    copy->allocator = allocator;
-    copy->length    = string->length;
-    copy->memory    = AllocatorAllocate(allocator, sizeof(Char) * (string->length + 1));
-    assert(copy->memory);
-    memcpy(copy->memory, string->memory, sizeof(Char) * (string->length + 1));
+    StringRef copy = _StringCreate(allocator, string->length);
+    memcpy(copy->memory, string->memory, sizeof(Char) * string->length);
     return copy;
 }
 
+StringRef StringCreateFromView(AllocatorRef allocator, StringView view) {
+    StringRef string = _StringCreate(allocator, view.length);
+    memcpy(string->memory, view.characters, sizeof(Char) * view.length);
+    return string;
+}
+
 StringRef StringCreateCopyFromLastOccurenceOf(AllocatorRef allocator, StringRef string, Char character) {
     for (Index index = 0; index < StringGetLength(string); index++) {
         const Char *current = &string->memory[string->length - index - 1];
@@ -96,14 +91,7 @@ StringRef StringCreateCopyRemovingPrefix(AllocatorRef allocator, StringRef strin
 }
 
 StringRef StringCreateEmpty(AllocatorRef allocator) {
-    StringRef string = AllocatorAllocate(allocator, sizeof(struct _String));
-    assert(string);
-    string->allocator = allocator;
-    string->length    = 0;
-    string->memory    = AllocatorAllocate(allocator, sizeof(Char) * 8);
-    assert(string->memory);
-    memset(string->memory, 0, sizeof(Char) * 8);
-    return string;
+    return _StringCreate(allocator, 0);
 }
 
 StringRef StringCreateFromFile(AllocatorRef allocator, const Char *filePath) {
@@ -115,17 +103,9 @@ StringRef StringCreateFromFile(AllocatorRef allocator, const Char *filePath) {
     fseek(file, 0, SEEK_END);
     Index length = ftell(file);
     fseek(file, 0, SEEK_SET);
-    Char *memory = AllocatorAllocate(allocator, sizeof(Char) * (length + 1));
-    assert(memory);
-    fread(memory, sizeof(Char), length, file);
-    memory[length] = 0;
+    StringRef string = _StringCreate(allocator, length);
+    fread(string->memory, sizeof(Char), length, file);
     fclose(file);
-
-    StringRef string = AllocatorAllocate(allocator, sizeof(struct _String));
-    assert(string);
-    string->allocator = allocator;
-    string->length    = length;
-    string->memory    = memory;
     return string;
 }
 
@@ -139,7 +119,10 @@ void StringReplaceOccurenciesOf(StringRef string, Char character, Char replaceme
 }
 
 void StringDestroy(StringRef string) {
-    AllocatorDeallocate(string->allocator, string->memory);
+    if (string->memory != string->inlineMemory) {
+        AllocatorDeallocate(string->allocator, string->memory);
+    }
+
     AllocatorDeallocate(string->allocator, string);
 }
 
@@ -151,41 +134,46 @@ Char *StringGetCharacters(StringRef string) {
     return string->memory;
 }
 
+StringView StringGetView(StringRef string) {
+    return StringViewMake(string->memory, string->memory + string->length);
+}
+
 void StringAppend(StringRef string, const Char *rawString) {
-    Index length = strlen(rawString);
-    if (length > 0) {
-        Index newCapacity = sizeof(Char) * (string->length + length + 1);
-        Char *newMemory   = AllocatorReallocate(string->allocator, string->memory, newCapacity);
-        assert(newMemory);
-        memcpy(newMemory + sizeof(Char) * string->length, rawString, length);
-        memset(newMemory + sizeof(Char) * (string->length + length), 0, sizeof(Char));
-        string->length += length;
-        string->memory = newMemory;
-    }
+    _StringAppendCharacters(string, rawString, strlen(rawString));
 }
 
 void StringAppendString(StringRef string, StringRef other) {
-    if (other->length > 0) {
-        Index newCapacity = sizeof(Char) * (string->length + other->length + 1);
-        Char *newMemory   = AllocatorReallocate(string->allocator, string->memory, newCapacity);
-        assert(newMemory);
-        memcpy(newMemory + sizeof(Char) * string->length, other->memory, other->length);
-        memset(newMemory + sizeof(Char) * (string->length + other->length), 0, sizeof(Char));
-        string->length += other->length;
-        string->memory = newMemory;
-    }
+    _StringAppendCharacters(string, other->memory, other->length);
+}
+
+void StringAppendView(StringRef string, StringView view) {
+    _StringAppendCharacters(string, view.characters, view.length);
 }
 
 void StringAppendFormat(StringRef string, const Char *format, ...) {
     va_list argumentPointer;
     va_start(argumentPointer, format);
-    vsprintf(&_kStringFormatBuffer[0], format, argumentPointer);
-    va_end(argumentPointer);
+    va_list measureArgumentPointer;
+    va_copy(measureArgumentPointer, argumentPointer);
+    Int length = vsnprintf(NULL, 0, format, measureArgumentPointer);
+    va_end(measureArgumentPointer);
+    assert(length >= 0);
 
-    StringAppend(string, &_kStringFormatBuffer[0]);
+    if (length > 0) {
+        // The formatted characters are written directly behind the current contents without an intermediate buffer
+        _StringReserveCapacity(string, string->length + length + 1);
+        vsnprintf(string->memory + string->length, length + 1, format, argumentPointer);
+        string->length += length;
+    }
+
+    va_end(argumentPointer);
 }
 
 Bool StringIsEqual(StringRef lhs, StringRef rhs) {
+    if (lhs == rhs) {
+        return true;
+    }
+
     if (lhs->length != rhs->length) {
         return false;
     }
@@ -218,6 +206,82 @@ void StringRemovePrefix(StringRef string, const Char *prefix) {
     }
 }
 
+StringView StringViewMake(const Char *start, const Char *end) {
+    StringView view;
+    view.characters = start;
+    view.length     = end - start;
+    return view;
+}
+
+Bool StringViewIsEqual(StringView lhs, StringView rhs) {
+    if (lhs.length != rhs.length) {
+        return false;
+    }
+
+    return lhs.length < 1 || memcmp(lhs.characters, rhs.characters, sizeof(Char) * lhs.length) == 0;
+}
+
+Bool StringViewIsEqualToCString(StringView view, const Char *rawString) {
+    Index index = 0;
+    while (index < view.length && rawString[index] == view.characters[index]) {
+        index += 1;
+    }
+
+    return index == view.length && rawString[index] == '\0';
+}
+
+static inline StringRef _StringCreate(AllocatorRef allocator, Index length) {
+    StringRef string = AllocatorAllocate(allocator, sizeof(struct _String));
+    assert(string);
+    string->allocator = allocator;
+    string->length    = length;
+    string->capacity  = _kStringInlineCapacity;
+    string->memory    = string->inlineMemory;
+    if (length + 1 > _kStringInlineCapacity) {
+        string->capacity = length + 1;
+        string->memory   = AllocatorAllocate(allocator, sizeof(Char) * string->capacity);
+        assert(string->memory);
+    }
+
+    string->memory[length] = '\0';
+    return string;
+}
+
+static inline void _StringReserveCapacity(StringRef string, Index capacity) {
+    if (capacity <= string->capacity) {
+        return;
+    }
+
+    // Growing geometrically keeps repeated appends at amortized constant cost
+    Index newCapacity = MAX(capacity, string->capacity * 2);
+    if (string->memory == string->inlineMemory) {
+        string->memory = AllocatorAllocate(string->allocator, sizeof(Char) * newCapacity);
+        assert(string->memory);
+        memcpy(string->memory, string->inlineMemory, sizeof(Char) * (string->length + 1));
+    } else {
+        string->memory = AllocatorReallocate(string->allocator, string->memory, sizeof(Char) * newCapacity);
+        assert(string->memory);
+    }
+
+    string->capacity = newCapacity;
+}
+
+static inline void _StringAppendCharacters(StringRef string, const Char *characters, Index length) {
+    if (length > 0) {
+        // The characters can alias the string itself and would be invalidated by growing its memory
+        Bool isAliasing = characters >= string->memory && characters < string->memory + string->capacity;
+        Index offset    = isAliasing ? characters - string->memory : 0;
+        _StringReserveCapacity(string, string->length + length + 1);
+        if (isAliasing) {
+            characters = string->memory + offset;
+        }
+
+        memmove(string->memory + string->length, characters, sizeof(Char) * length);
+        string->length += length;
+        string->memory[string->length] = '\0';
+    }
+}
+
 static inline Bool _StringHasPrefix(StringRef string, const Char *rawPrefix) {
     Index prefixLength = strlen(rawPrefix);
     if (string->length < prefixLength) {
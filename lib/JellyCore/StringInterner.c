@@ -0,0 +1,236 @@
+#include "JellyCore/BumpAllocator.h"
+#include "JellyCore/StringInterner.h"
+
+#include <pthread.h>
+
+const Index _kStringInternerMinimumCapacity = 256;
+
+struct _StringInternerEntry {
+    UInt64 hash;
+    StringRef string;
+};
+typedef struct _StringInternerEntry StringInternerEntry;
+
+struct _StringInterner {
+    AllocatorRef allocator;
+    AllocatorRef stringAllocator;
+    Index capacity;
+    Index count;
+    StringInternerEntry *entries;
+    StringInternerStatistics statistics;
+    StringInternerRef parent;
+    Index cacheCount;
+    Index forwardedInternCount;
+    Index forwardedLookupCount;
+    pthread_mutex_t mutex;
+};
+
+static inline UInt64 _StringInternerHash(const Char *characters, Index length);
+static inline Index _StringInternerFindIndex(StringInternerRef interner, const Char *characters, Index length, UInt64 hash);
+static inline StringRef _StringInternerIntern(StringInternerRef interner, const Char *characters, Index length, UInt64 hash);
+static inline StringRef _StringInternerLookup(StringInternerRef interner, const Char *characters, Index length, UInt64 hash);
+static inline void _StringInternerInsert(StringInternerRef interner, Index index, StringRef string, UInt64 hash);
+static inline void _StringInternerReserveCapacity(StringInternerRef interner, Index capacity);
+
+StringInternerRef StringInternerCreate(AllocatorRef allocator) {
+    StringInternerRef interner     = AllocatorAllocate(allocator, sizeof(struct _StringInterner));
+    interner->allocator            = allocator;
+    interner->stringAllocator      = BumpAllocatorCreate(allocator);
+    interner->capacity             = _kStringInternerMinimumCapacity;
+    interner->count                = 0;
+    interner->entries              = AllocatorAllocate(allocator, sizeof(StringInternerEntry) * interner->capacity);
+    interner->parent               = NULL;
+    interner->cacheCount           = 0;
+    interner->forwardedInternCount = 0;
+    interner->forwardedLookupCount = 0;
+    memset(interner->entries, 0, sizeof(StringInternerEntry) * interner->capacity);
+    memset(&interner->statistics, 0, sizeof(StringInternerStatistics));
+    pthread_mutex_init(&interner->mutex, NULL);
+    return interner;
+}
+
+StringInternerRef StringInternerCreateCache(AllocatorRef allocator, StringInternerRef interner) {
+    assert(!interner->parent && "Caches of caches are not supported!");
+
+    StringInternerRef cache = StringInternerCreate(allocator);
+    cache->parent           = interner;
+    __atomic_add_fetch(&interner->cacheCount, 1, __ATOMIC_ACQ_REL);
+    return cache;
+}
+
+void StringInternerDestroy(StringInternerRef interner) {
+    pthread_mutex_destroy(&interner->mutex);
+    AllocatorDeallocate(interner->allocator, interner->entries);
+    AllocatorDestroy(interner->stringAllocator);
+    AllocatorDeallocate(interner->allocator, interner);
+}
+
+StringRef StringInternerIntern(StringInternerRef interner, StringRef string) {
+    const Char *characters = StringGetCharacters(string);
+    Index length           = StringGetLength(string);
+    return _StringInternerIntern(interner, characters, length, _StringInternerHash(characters, length));
+}
+
+StringRef StringInternerInternCString(StringInternerRef interner, const Char *rawString) {
+    Index length = strlen(rawString);
+    return _StringInternerIntern(interner, rawString, length, _StringInternerHash(rawString, length));
+}
+
+StringRef StringInternerLookup(StringInternerRef interner, StringRef string) {
+    const Char *characters = StringGetCharacters(string);
+    Index length           = StringGetLength(string);
+    return _StringInternerLookup(interner, characters, length, _StringInternerHash(characters, length));
+}
+
+StringInternerStatistics StringInternerGetStatistics(StringInternerRef interner) {
+    return interner->statistics;
+}
+
+void StringInternerMergeCacheStatistics(StringInternerRef cache) {
+    assert(cache->parent);
+
+    // Requests forwarded to the interner have already been counted by the interner itself
+    StringInternerRef interner = cache->parent;
+    pthread_mutex_lock(&interner->mutex);
+    interner->statistics.internCount += cache->statistics.internCount - cache->forwardedInternCount;
+    interner->statistics.lookupCount += cache->statistics.lookupCount - cache->forwardedLookupCount;
+    interner->statistics.probeCount += cache->statistics.probeCount;
+    interner->statistics.savedMemorySize += cache->statistics.savedMemorySize;
+    pthread_mutex_unlock(&interner->mutex);
+
+    memset(&cache->statistics, 0, sizeof(StringInternerStatistics));
+    cache->forwardedInternCount = 0;
+    cache->forwardedLookupCount = 0;
+}
+
+void StringInternerPrintReport(StringInternerRef interner, FILE *output) {
+    StringInternerStatistics statistics = StringInternerGetStatistics(interner);
+    Index requestCount                  = statistics.internCount + statistics.lookupCount;
+    fprintf(output, "===------------------------------------------------------------------------------===\n");
+    fprintf(output, "                            Jelly String Interner Report\n");
+    fprintf(output, "===------------------------------------------------------------------------------===\n");
+    fprintf(output, "%12zu unique strings using %.1f KiB\n", statistics.stringCount, statistics.stringMemorySize / 1024.0);
+    fprintf(output, "%12zu intern requests saving %.1f KiB of copies\n", statistics.internCount, statistics.savedMemorySize / 1024.0);
+    fprintf(output, "%12zu lookups\n", statistics.lookupCount);
+    fprintf(output, "%12zu probes, %.2f per request\n", statistics.probeCount,
+            requestCount > 0 ? (Float64)statistics.probeCount / requestCount : 0.0);
+}
+
+static inline UInt64 _StringInternerHash(const Char *characters, Index length) {
+    UInt64 hash = 14695981039346656037ULL;
+    for (Index index = 0; index < length; index++) {
+        hash ^= (UInt8)characters[index];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static inline Index _StringInternerFindIndex(StringInternerRef interner, const Char *characters, Index length, UInt64 hash) {
+    Index mask  = interner->capacity - 1;
+    Index index = hash & mask;
+    while (true) {
+        StringInternerEntry *entry = &interner->entries[index];
+        interner->statistics.probeCount += 1;
+        if (!entry->string) {
+            return index;
+        }
+
+        if (entry->hash == hash && StringGetLength(entry->string) == length &&
+            memcmp(StringGetCharacters(entry->string), characters, length) == 0) {
+            return index;
+        }
+
+        index = (index + 1) & mask;
+    }
+}
+
+/// The lock is only taken by interners which have caches, the caches themselves are only accessed by a single thread.
+static inline StringRef _StringInternerIntern(StringInternerRef interner, const Char *characters, Index length, UInt64 hash) {
+    Bool isShared = __atomic_load_n(&interner->cacheCount, __ATOMIC_ACQUIRE) > 0;
+    if (isShared) {
+        pthread_mutex_lock(&interner->mutex);
+    }
+
+    Index index      = _StringInternerFindIndex(interner, characters, length, hash);
+    StringRef string = interner->entries[index].string;
+    interner->statistics.internCount += 1;
+    if (string) {
+        interner->statistics.savedMemorySize += length + 1;
+    } else {
+        if (interner->parent) {
+            string = _StringInternerIntern(interner->parent, characters, length, hash);
+            interner->forwardedInternCount += 1;
+        } else {
+            string = StringCreateRange(interner->stringAllocator, characters, characters + length);
+            interner->statistics.stringCount += 1;
+            interner->statistics.stringMemorySize += length + 1;
+        }
+
+        _StringInternerInsert(interner, index, string, hash);
+    }
+
+    if (isShared) {
+        pthread_mutex_unlock(&interner->mutex);
+    }
+
+    return string;
+}
+
+static inline StringRef _StringInternerLookup(StringInternerRef interner, const Char *characters, Index length, UInt64 hash) {
+    Bool isShared = __atomic_load_n(&interner->cacheCount, __ATOMIC_ACQUIRE) > 0;
+    if (isShared) {
+        pthread_mutex_lock(&interner->mutex);
+    }
+
+    Index index      = _StringInternerFindIndex(interner, characters, length, hash);
+    StringRef string = interner->entries[index].string;
+    interner->statistics.lookupCount += 1;
+    if (!string && interner->parent) {
+        string = _StringInternerLookup(interner->parent, characters, length, hash);
+        interner->forwardedLookupCount += 1;
+    }
+
+    if (isShared) {
+        pthread_mutex_unlock(&interner->mutex);
+    }
+
+    return string;
+}
+
+static inline void _StringInternerInsert(StringInternerRef interner, Index index, StringRef string, UInt64 hash) {
+    // Keep the load factor at or below 1/2 to keep the probe sequences short
+    if ((interner->count + 1) * 2 > interner->capacity) {
+        _StringInternerReserveCapacity(interner, interner->capacity * 2);
+        index = _StringInternerFindIndex(interner, StringGetCharacters(string), StringGetLength(string), hash);
+    }
+
+    interner->entries[index].hash   = hash;
+    interner->entries[index].string = string;
+    interner->count += 1;
+}
+
+static inline void _StringInternerReserveCapacity(StringInternerRef interner, Index capacity) {
+    StringInternerEntry *entries = interner->entries;
+    Index oldCapacity            = interner->capacity;
+
+    interner->capacity = capacity;
+    interner->entries  = AllocatorAllocate(interner->allocator, sizeof(StringInternerEntry) * capacity);
+    memset(interner->entries, 0, sizeof(StringInternerEntry) * capacity);
+
+    Index mask = capacity - 1;
+    for (Index index = 0; index < oldCapacity; index++) {
+        if (!entries[index].string) {
+            continue;
+        }
+
+        Index newIndex = entries[index].hash & mask;
+        while (interner->entries[newIndex].string) {
+            newIndex = (newIndex + 1) & mask;
+        }
+
+        interner->entries[newIndex] = entries[index];
+    }
+
+    AllocatorDeallocate(interner->allocator, entries);
+}
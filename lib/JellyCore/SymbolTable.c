@@ -1,9 +1,12 @@
 #include "JellyCore/Array.h"
-#include "JellyCore/Dictionary.h"
+#include "JellyCore/PointerMap.h"
 #include "JellyCore/SymbolTable.h"
 
-const Index kDefaultSymbolDictionaryCapacity = 64;
-const Index kDefaultSymbolArrayCapacity      = 8;
+#include <pthread.h>
+
+const Index kDefaultSymbolArrayCapacity   = 8;
+const Index kDefaultScopeSymbolCapacity   = 4;
+const Index kScopeSymbolLinearSearchLimit = 8;
 
 struct _SymbolEntry {
     void *definition;
@@ -13,6 +16,7 @@ typedef struct _SymbolEntry SymbolEntry;
 
 struct _Symbol {
     SymbolID id;
+    StringRef name;
     Bool isGroup;
     union {
         SymbolEntry entry;
@@ -25,34 +29,41 @@ struct _Scope {
     ScopeID id;
     ScopeID parent;
     const Char *location;
-    DictionaryRef symbols;
+    Index symbolCount;
+    Index symbolCapacity;
+    SymbolID *symbols;
+    PointerMapRef index;
     void *userdata;
 };
 typedef struct _Scope *ScopeRef;
 
 struct _SymbolTable {
     AllocatorRef allocator;
+    StringInternerRef interner;
     ScopeID nextScopeID;
     SymbolID nextSymbolID;
     ArrayRef scopes;
     ArrayRef symbols;
+    pthread_mutex_t scopeMutex;
 };
 
-SymbolTableRef SymbolTableCreate(AllocatorRef allocator) {
+static inline void _ScopeInitialize(ScopeRef scope, ScopeKind kind, ScopeID id, ScopeID parent, const Char *location);
+static inline SymbolID _SymbolTableScopeLookup(SymbolTableRef table, ScopeRef scope, StringRef name);
+static inline void _SymbolTableScopeInsert(SymbolTableRef table, ScopeRef scope, SymbolRef symbol);
+
+SymbolTableRef SymbolTableCreate(AllocatorRef allocator, StringInternerRef interner) {
     SymbolTableRef table = (SymbolTableRef)AllocatorAllocate(allocator, sizeof(struct _SymbolTable));
     table->allocator     = allocator;
+    table->interner      = interner;
     table->nextScopeID   = kScopeGlobal + 1;
     table->scopes        = ArrayCreateEmpty(table->allocator, sizeof(struct _Scope), 8);
     table->nextSymbolID  = 0;
     table->symbols       = ArrayCreateEmpty(table->allocator, sizeof(struct _Symbol), kDefaultSymbolArrayCapacity);
 
-    ScopeRef globalScope  = ArrayAppendUninitializedElement(table->scopes);
-    globalScope->kind     = ScopeKindGlobal;
-    globalScope->id       = kScopeGlobal;
-    globalScope->parent   = kScopeNull;
-    globalScope->location = NULL;
-    globalScope->symbols  = CStringDictionaryCreate(table->allocator, kDefaultSymbolDictionaryCapacity);
-    globalScope->userdata = NULL;
+    pthread_mutex_init(&table->scopeMutex, NULL);
+
+    ScopeRef globalScope = ArrayAppendUninitializedElement(table->scopes);
+    _ScopeInitialize(globalScope, ScopeKindGlobal, kScopeGlobal, kScopeNull, NULL);
 
     return table;
 }
@@ -67,24 +78,31 @@ void SymbolTableDestroy(SymbolTableRef table) {
 
     for (Index index = 0; index < ArrayGetElementCount(table->scopes); index++) {
         ScopeRef scope = (ScopeRef)ArrayGetElementAtIndex(table->scopes, index);
-        DictionaryDestroy(scope->symbols);
+        if (scope->symbols) {
+            AllocatorDeallocate(table->allocator, scope->symbols);
+        }
+
+        if (scope->index) {
+            PointerMapDestroy(scope->index);
+        }
     }
 
+    pthread_mutex_destroy(&table->scopeMutex);
     ArrayDestroy(table->scopes);
     ArrayDestroy(table->symbols);
     AllocatorDeallocate(table->allocator, table);
 }
 
+/// Inserting scopes, reading their parents and setting their userdata is locked because the parsers of multiple files are sharing the
+/// symbol table.
 ScopeID SymbolTableInsertScope(SymbolTableRef table, ScopeKind kind, ScopeID parent, const Char *location) {
-    ScopeRef scope  = ArrayAppendUninitializedElement(table->scopes);
-    scope->kind     = kind;
-    scope->id       = table->nextScopeID;
-    scope->parent   = parent;
-    scope->location = location;
-    scope->symbols  = CStringDictionaryCreate(table->allocator, kDefaultSymbolDictionaryCapacity);
-    scope->userdata = NULL;
+    pthread_mutex_lock(&table->scopeMutex);
+    ScopeRef scope = ArrayAppendUninitializedElement(table->scopes);
+    ScopeID id     = table->nextScopeID;
+    _ScopeInitialize(scope, kind, id, parent, location);
     table->nextScopeID += 1;
-    return scope->id;
+    pthread_mutex_unlock(&table->scopeMutex);
+    return id;
 }
 
 ScopeID SymbolTableGetScopeParent(SymbolTableRef table, ScopeID id) {
@@ -92,8 +110,11 @@ ScopeID SymbolTableGetScopeParent(SymbolTableRef table, ScopeID id) {
         return kScopeNull;
     }
 
+    pthread_mutex_lock(&table->scopeMutex);
     ScopeRef scope = (ScopeRef)ArrayGetElementAtIndex(table->scopes, id);
-    return scope->parent;
+    ScopeID parent = scope->parent;
+    pthread_mutex_unlock(&table->scopeMutex);
+    return parent;
 }
 
 ScopeID SymbolTableGetScopeOrParentOfKinds(SymbolTableRef table, ScopeID id, ScopeKind kinds) {
@@ -184,23 +205,20 @@ void *SymbolTableGetScopeUserdata(SymbolTableRef table, ScopeID id) {
 }
 
 void SymbolTableSetScopeUserdata(SymbolTableRef table, ScopeID id, void *userdata) {
+    pthread_mutex_lock(&table->scopeMutex);
     assert(0 <= id && id < ArrayGetElementCount(table->scopes));
 
     ScopeRef scope  = (ScopeRef)ArrayGetElementAtIndex(table->scopes, id);
     scope->userdata = userdata;
+    pthread_mutex_unlock(&table->scopeMutex);
 }
 
 void SymbolTableGetScopeSymbols(SymbolTableRef table, ScopeID id, SymbolID **symbols, Index *count) {
     assert(0 <= id && id < ArrayGetElementCount(table->scopes));
 
     ScopeRef scope = (ScopeRef)ArrayGetElementAtIndex(table->scopes, id);
-
-    void *buffer;
-    Index length;
-    DictionaryGetValueBuffer(scope->symbols, &buffer, &length);
-
-    *symbols = (SymbolID *)buffer;
-    *count   = length / sizeof(SymbolID);
+    *symbols       = scope->symbols;
+    *count         = scope->symbolCount;
 }
 
 Bool SymbolTableIsSymbolGroup(SymbolTableRef table, SymbolID id) {
@@ -215,12 +233,13 @@ SymbolID SymbolTableInsertSymbol(SymbolTableRef table, ScopeID id, StringRef nam
 
     SymbolRef symbol = ArrayAppendUninitializedElement(table->symbols);
     memset(symbol, 0, sizeof(struct _Symbol));
-    symbol->id = table->nextSymbolID;
+    symbol->id   = table->nextSymbolID;
+    symbol->name = StringInternerIntern(table->interner, name);
     table->nextSymbolID += 1;
 
     assert(0 <= id && id < ArrayGetElementCount(table->scopes));
     ScopeRef scope = ArrayGetElementAtIndex(table->scopes, id);
-    DictionaryInsert(scope->symbols, StringGetCharacters(name), &symbol->id, sizeof(SymbolID));
+    _SymbolTableScopeInsert(table, scope, symbol);
 
     return symbol->id;
 }
@@ -237,21 +256,31 @@ SymbolID SymbolTableInsertOrGetSymbol(SymbolTableRef table, ScopeID id, StringRe
 SymbolID SymbolTableLookupSymbol(SymbolTableRef table, ScopeID id, StringRef name) {
     assert(0 <= id && id < ArrayGetElementCount(table->scopes));
     ScopeRef scope = ArrayGetElementAtIndex(table->scopes, id);
+    if (scope->symbolCount < 1) {
+        return kSymbolNull;
+    }
 
-    const void *ref = DictionaryLookup(scope->symbols, StringGetCharacters(name));
-    if (ref == NULL) {
+    // A name which has never been interned can't be contained in any scope
+    StringRef internedName = StringInternerLookup(table->interner, name);
+    if (!internedName) {
         return kSymbolNull;
     }
 
-    return *((SymbolID *)ref);
+    return _SymbolTableScopeLookup(table, scope, internedName);
 }
 
 SymbolID SymbolTableLookupSymbolInHierarchy(SymbolTableRef table, ScopeID id, StringRef name) {
     assert(0 <= id && id < ArrayGetElementCount(table->scopes));
 
-    SymbolID nextID = id;
+    StringRef internedName = StringInternerLookup(table->interner, name);
+    if (!internedName) {
+        return kSymbolNull;
+    }
+
+    ScopeID nextID = id;
     while (nextID != kScopeNull) {
-        SymbolID symbol = SymbolTableLookupSymbol(table, nextID, name);
+        ScopeRef scope  = ArrayGetElementAtIndex(table->scopes, nextID);
+        SymbolID symbol = _SymbolTableScopeLookup(table, scope, internedName);
         if (symbol != kSymbolNull) {
             return symbol;
         } else {
@@ -372,3 +401,66 @@ void SymbolTableSetSymbolGroupType(SymbolTableRef table, SymbolID id, Index inde
     SymbolEntry *entry = (SymbolEntry *)ArrayGetElementAtIndex(symbol->entries, index);
     entry->type        = type;
 }
+
+static inline void _ScopeInitialize(ScopeRef scope, ScopeKind kind, ScopeID id, ScopeID parent, const Char *location) {
+    scope->kind           = kind;
+    scope->id             = id;
+    scope->parent         = parent;
+    scope->location       = location;
+    scope->symbolCount    = 0;
+    scope->symbolCapacity = 0;
+    scope->symbols        = NULL;
+    scope->index          = NULL;
+    scope->userdata       = NULL;
+}
+
+static inline SymbolID _SymbolTableScopeLookup(SymbolTableRef table, ScopeRef scope, StringRef name) {
+    if (!scope->index) {
+        for (Index index = 0; index < scope->symbolCount; index++) {
+            SymbolRef symbol = (SymbolRef)ArrayGetElementAtIndex(table->symbols, scope->symbols[index]);
+            if (symbol->name == name) {
+                return symbol->id;
+            }
+        }
+
+        return kSymbolNull;
+    }
+
+    // Names are interned so the index is keyed by the address of the interned string
+    SymbolID *symbol = (SymbolID *)PointerMapLookup(scope->index, name);
+    return symbol ? *symbol : kSymbolNull;
+}
+
+static inline void _SymbolTableScopeInsert(SymbolTableRef table, ScopeRef scope, SymbolRef symbol) {
+    if (scope->symbolCount + 1 > scope->symbolCapacity) {
+        Index capacity = MAX(scope->symbolCapacity * 2, kDefaultScopeSymbolCapacity);
+        if (scope->symbols) {
+            scope->symbols = AllocatorReallocate(table->allocator, scope->symbols, sizeof(SymbolID) * capacity);
+        } else {
+            scope->symbols = AllocatorAllocate(table->allocator, sizeof(SymbolID) * capacity);
+        }
+
+        scope->symbolCapacity = capacity;
+    }
+
+    scope->symbols[scope->symbolCount] = symbol->id;
+    scope->symbolCount += 1;
+
+    // Small scopes are searched linearly, the hash index is only built once a scope outgrows the linear search limit
+    if (scope->symbolCount <= kScopeSymbolLinearSearchLimit) {
+        return;
+    }
+
+    if (!scope->index) {
+        scope->index = PointerMapCreate(table->allocator, sizeof(SymbolID));
+        PointerMapReserve(scope->index, kScopeSymbolLinearSearchLimit * 2);
+        for (Index index = 0; index < scope->symbolCount - 1; index++) {
+            SymbolRef indexedSymbol = (SymbolRef)ArrayGetElementAtIndex(table->symbols, scope->symbols[index]);
+            SymbolID *value         = (SymbolID *)PointerMapInsert(scope->index, indexedSymbol->name);
+            *value                  = indexedSymbol->id;
+        }
+    }
+
+    SymbolID *value = (SymbolID *)PointerMapInsert(scope->index, symbol->name);
+    *value          = symbol->id;
+}
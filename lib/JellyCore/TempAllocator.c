@@ -1,19 +1,59 @@
-#include "JellyCore/Array.h"
 #include "JellyCore/TempAllocator.h"
 
+// Small allocations are served from power of two size classes between 16 bytes and 4 KiB which are carved out of slabs, larger ones are
+// allocated separately and linked into a list to release them on destroy
+#define _kTempAllocatorSizeClassCount 9
+
+const Index _kTempAllocatorSlabCapacity          = 65536;
+const Index _kTempAllocatorMinimumSizeClassShift = 4;
+const Index _kTempAllocatorLargeSizeClass        = _kTempAllocatorSizeClassCount;
+
+struct _TempAllocatorHeader {
+    Index sizeClass;
+    Index capacity;
+};
+
+struct _TempAllocatorLargeBlock {
+    struct _TempAllocatorLargeBlock *previous;
+    struct _TempAllocatorLargeBlock *next;
+    struct _TempAllocatorHeader header;
+};
+
+struct _TempAllocatorFreeBlock {
+    struct _TempAllocatorFreeBlock *next;
+};
+
+// The slab header is padded to keep the blocks of a slab 16 byte aligned
+struct _TempAllocatorSlab {
+    struct _TempAllocatorSlab *next;
+    Index reserved;
+};
+
 struct _TempAllocatorContext {
     AllocatorRef allocator;
-    ArrayRef allocations;
+    struct _TempAllocatorSlab *slabs;
+    UInt8 *slabCursor;
+    UInt8 *slabEnd;
+    struct _TempAllocatorFreeBlock *freeBlocks[_kTempAllocatorSizeClassCount];
+    struct _TempAllocatorLargeBlock *largeBlocks;
 };
 
-static inline Bool _IsPointerEqual(const void *elementLeft, const void *elementRight);
-
 void *_AllocatorTemp(AllocatorMode mode, Index capacity, void *memory, void *context);
 
+static inline Index _TempAllocatorGetSizeClass(Index capacity);
+static inline struct _TempAllocatorHeader *_TempAllocatorGetHeader(void *memory);
+static inline struct _TempAllocatorLargeBlock *_TempAllocatorGetLargeBlock(void *memory);
+static inline void *_TempAllocatorAllocate(struct _TempAllocatorContext *context, Index capacity);
+static inline void *_TempAllocatorAllocateLarge(struct _TempAllocatorContext *context, Index capacity);
+static inline void *_TempAllocatorReallocate(struct _TempAllocatorContext *context, void *memory, Index capacity);
+static inline void _TempAllocatorDeallocate(struct _TempAllocatorContext *context, void *memory);
+static inline void _TempAllocatorLinkLargeBlock(struct _TempAllocatorContext *context, struct _TempAllocatorLargeBlock *block);
+static inline void _TempAllocatorUnlinkLargeBlock(struct _TempAllocatorContext *context, struct _TempAllocatorLargeBlock *block);
+
 AllocatorRef TempAllocatorCreate(AllocatorRef allocator) {
     struct _TempAllocatorContext *context = AllocatorAllocate(allocator, sizeof(struct _TempAllocatorContext));
-    context->allocator                    = allocator;
-    context->allocations                  = ArrayCreateEmpty(allocator, sizeof(void *), 8);
+    memset(context, 0, sizeof(struct _TempAllocatorContext));
+    context->allocator = allocator;
     return AllocatorCreate(allocator, &_AllocatorTemp, context);
 }
 
@@ -22,34 +62,31 @@ void *_AllocatorTemp(AllocatorMode mode, Index capacity, void *memory, void *con
     assert(tempContext);
 
     switch (mode) {
-    case AllocatorModeAllocate: {
-        void *memory = AllocatorAllocate(tempContext->allocator, capacity);
-        assert(memory);
-        ArrayAppendElement(tempContext->allocations, &memory);
-        return memory;
-    }
+    case AllocatorModeAllocate:
+        return _TempAllocatorAllocate(tempContext, capacity);
 
-    case AllocatorModeReallocate: {
-        void *newMemory = AllocatorReallocate(tempContext->allocator, memory, capacity);
-        if (newMemory) {
-            Index index = ArrayGetIndexOfElement(tempContext->allocations, &_IsPointerEqual, memory);
-            if (index != kArrayElementNotFound) {
-                ArraySetElementAtIndex(tempContext->allocations, index, &newMemory);
-            }
-        }
-        return newMemory;
-    }
+    case AllocatorModeReallocate:
+        return _TempAllocatorReallocate(tempContext, memory, capacity);
 
     case AllocatorModeDeallocate:
+        _TempAllocatorDeallocate(tempContext, memory);
         return NULL;
 
     case AllocatorModeDestroy: {
-        for (Index index = 0; index < ArrayGetElementCount(tempContext->allocations); index++) {
-            void *memory = *((void **)ArrayGetElementAtIndex(tempContext->allocations, index));
-            AllocatorDeallocate(tempContext->allocator, memory);
+        struct _TempAllocatorLargeBlock *block = tempContext->largeBlocks;
+        while (block) {
+            struct _TempAllocatorLargeBlock *next = block->next;
+            AllocatorDeallocate(tempContext->allocator, block);
+            block = next;
+        }
+
+        struct _TempAllocatorSlab *slab = tempContext->slabs;
+        while (slab) {
+            struct _TempAllocatorSlab *next = slab->next;
+            AllocatorDeallocate(tempContext->allocator, slab);
+            slab = next;
         }
 
-        ArrayDestroy(tempContext->allocations);
         AllocatorDeallocate(tempContext->allocator, tempContext);
         return NULL;
     }
@@ -59,6 +96,125 @@ void *_AllocatorTemp(AllocatorMode mode, Index capacity, void *memory, void *con
     }
 }
 
-static inline Bool _IsPointerEqual(const void *elementLeft, const void *elementRight) {
-    return *((void **)elementLeft) == elementRight;
+static inline Index _TempAllocatorGetSizeClass(Index capacity) {
+    if (capacity <= ((Index)1 << _kTempAllocatorMinimumSizeClassShift)) {
+        return 0;
+    }
+
+    Index sizeClass = sizeof(unsigned long long) * 8 - __builtin_clzll(capacity - 1) - _kTempAllocatorMinimumSizeClassShift;
+    return MIN(sizeClass, _kTempAllocatorLargeSizeClass);
+}
+
+static inline struct _TempAllocatorHeader *_TempAllocatorGetHeader(void *memory) {
+    return (struct _TempAllocatorHeader *)memory - 1;
+}
+
+static inline struct _TempAllocatorLargeBlock *_TempAllocatorGetLargeBlock(void *memory) {
+    // The header is the last member of a large block so the memory directly follows the block
+    return (struct _TempAllocatorLargeBlock *)memory - 1;
+}
+
+static inline void *_TempAllocatorAllocate(struct _TempAllocatorContext *context, Index capacity) {
+    Index sizeClass = _TempAllocatorGetSizeClass(capacity);
+    if (sizeClass == _kTempAllocatorLargeSizeClass) {
+        return _TempAllocatorAllocateLarge(context, capacity);
+    }
+
+    struct _TempAllocatorFreeBlock *freeBlock = context->freeBlocks[sizeClass];
+    if (freeBlock) {
+        context->freeBlocks[sizeClass] = freeBlock->next;
+        return freeBlock;
+    }
+
+    Index blockCapacity = (Index)1 << (sizeClass + _kTempAllocatorMinimumSizeClassShift);
+    Index totalCapacity = sizeof(struct _TempAllocatorHeader) + blockCapacity;
+    if (!context->slabCursor || context->slabCursor + totalCapacity > context->slabEnd) {
+        struct _TempAllocatorSlab *slab = AllocatorAllocate(context->allocator, _kTempAllocatorSlabCapacity);
+        assert(slab);
+        slab->next          = context->slabs;
+        context->slabs      = slab;
+        context->slabCursor = (UInt8 *)(slab + 1);
+        context->slabEnd    = (UInt8 *)slab + _kTempAllocatorSlabCapacity;
+    }
+
+    struct _TempAllocatorHeader *header = (struct _TempAllocatorHeader *)context->slabCursor;
+    header->sizeClass                   = sizeClass;
+    header->capacity                    = blockCapacity;
+    context->slabCursor += totalCapacity;
+    return header + 1;
+}
+
+static inline void *_TempAllocatorAllocateLarge(struct _TempAllocatorContext *context, Index capacity) {
+    struct _TempAllocatorLargeBlock *block = AllocatorAllocate(context->allocator, sizeof(struct _TempAllocatorLargeBlock) + capacity);
+    assert(block);
+    block->header.sizeClass = _kTempAllocatorLargeSizeClass;
+    block->header.capacity  = capacity;
+    _TempAllocatorLinkLargeBlock(context, block);
+    return block + 1;
+}
+
+static inline void *_TempAllocatorReallocate(struct _TempAllocatorContext *context, void *memory, Index capacity) {
+    if (!memory) {
+        return _TempAllocatorAllocate(context, capacity);
+    }
+
+    struct _TempAllocatorHeader *header = _TempAllocatorGetHeader(memory);
+    if (header->sizeClass == _kTempAllocatorLargeSizeClass) {
+        struct _TempAllocatorLargeBlock *block = _TempAllocatorGetLargeBlock(memory);
+        _TempAllocatorUnlinkLargeBlock(context, block);
+        block = AllocatorReallocate(context->allocator, block, sizeof(struct _TempAllocatorLargeBlock) + capacity);
+        assert(block);
+        block->header.capacity = capacity;
+        _TempAllocatorLinkLargeBlock(context, block);
+        return block + 1;
+    }
+
+    if (capacity <= header->capacity) {
+        return memory;
+    }
+
+    void *newMemory = _TempAllocatorAllocate(context, capacity);
+    memcpy(newMemory, memory, header->capacity);
+    _TempAllocatorDeallocate(context, memory);
+    return newMemory;
+}
+
+static inline void _TempAllocatorDeallocate(struct _TempAllocatorContext *context, void *memory) {
+    if (!memory) {
+        return;
+    }
+
+    struct _TempAllocatorHeader *header = _TempAllocatorGetHeader(memory);
+    if (header->sizeClass == _kTempAllocatorLargeSizeClass) {
+        struct _TempAllocatorLargeBlock *block = _TempAllocatorGetLargeBlock(memory);
+        _TempAllocatorUnlinkLargeBlock(context, block);
+        AllocatorDeallocate(context->allocator, block);
+        return;
+    }
+
+    struct _TempAllocatorFreeBlock *freeBlock = memory;
+    freeBlock->next                           = context->freeBlocks[header->sizeClass];
+    context->freeBlocks[header->sizeClass]    = freeBlock;
+}
+
+static inline void _TempAllocatorLinkLargeBlock(struct _TempAllocatorContext *context, struct _TempAllocatorLargeBlock *block) {
+    block->previous = NULL;
+    block->next     = context->largeBlocks;
+    if (block->next) {
+        block->next->previous = block;
+    }
+
+    context->largeBlocks = block;
+}
+
+static inline void _TempAllocatorUnlinkLargeBlock(struct _TempAllocatorContext *context, struct _TempAllocatorLargeBlock *block) {
+    if (block->previous) {
+        block->previous->next = block->next;
+    } else {
+        context->largeBlocks = block->next;
+    }
+
+    if (block->next) {
+        block->next->previous = block->previous;
+    }
 }
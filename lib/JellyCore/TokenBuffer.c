@@ -0,0 +1,170 @@
+#include "JellyCore/TokenBuffer.h"
+
+const UInt32 _kTokenBufferNoValue = UINT32_MAX;
+
+struct _TokenValue {
+    TokenValueKind kind;
+    union {
+        Bool boolValue;
+        UInt64 intValue;
+        Float64 floatValue;
+    };
+};
+typedef struct _TokenValue TokenValue;
+
+/// The tokens are stored as a struct of arrays, so that walking the kinds of the tokens only touches one byte per token and the rare
+/// literal values are kept out of the way in a separate array.
+struct _TokenBuffer {
+    AllocatorRef allocator;
+    const Char *characters;
+    Index count;
+    Index capacity;
+    UInt8 *kinds;
+    UInt32 *offsets;
+    UInt32 *lengths;
+    UInt32 *trailingTriviaLengths;
+    UInt32 *valueIndices;
+    Index valueCount;
+    Index valueCapacity;
+    TokenValue *values;
+};
+
+static inline TokenBufferRef _TokenBufferCreate(AllocatorRef allocator, LexerRef lexer, const Char *characters, Index length);
+static inline void _TokenBufferAppendToken(TokenBufferRef buffer, const Token *token);
+
+TokenBufferRef TokenBufferCreate(AllocatorRef allocator, StringRef buffer) {
+    assert(buffer);
+    LexerRef lexer        = LexerCreate(allocator, buffer);
+    TokenBufferRef result = _TokenBufferCreate(allocator, lexer, StringGetCharacters(buffer), StringGetLength(buffer));
+    LexerDestroy(lexer);
+    return result;
+}
+
+TokenBufferRef TokenBufferCreateFromSourceBuffer(AllocatorRef allocator, SourceBufferRef buffer) {
+    assert(buffer);
+    LexerRef lexer        = LexerCreateFromSourceBuffer(allocator, buffer);
+    TokenBufferRef result = _TokenBufferCreate(allocator, lexer, SourceBufferGetCharacters(buffer), SourceBufferGetLength(buffer));
+    LexerDestroy(lexer);
+    return result;
+}
+
+void TokenBufferDestroy(TokenBufferRef buffer) {
+    AllocatorDeallocate(buffer->allocator, buffer->kinds);
+    AllocatorDeallocate(buffer->allocator, buffer->offsets);
+    AllocatorDeallocate(buffer->allocator, buffer->lengths);
+    AllocatorDeallocate(buffer->allocator, buffer->trailingTriviaLengths);
+    AllocatorDeallocate(buffer->allocator, buffer->valueIndices);
+    if (buffer->values) {
+        AllocatorDeallocate(buffer->allocator, buffer->values);
+    }
+
+    AllocatorDeallocate(buffer->allocator, buffer);
+}
+
+Index TokenBufferGetCount(TokenBufferRef buffer) {
+    return buffer->count;
+}
+
+TokenKind TokenBufferGetKind(TokenBufferRef buffer, Index index) {
+    assert(index < buffer->count);
+    return (TokenKind)buffer->kinds[index];
+}
+
+void TokenBufferGetToken(TokenBufferRef buffer, Index index, Token *token) {
+    assert(index < buffer->count);
+    const Char *start  = buffer->characters + buffer->offsets[index];
+    const Char *end    = start + buffer->lengths[index];
+    const Char *trivia = buffer->characters;
+    if (index > 0) {
+        trivia = buffer->characters + buffer->offsets[index - 1] + buffer->lengths[index - 1];
+    }
+
+    token->kind           = (TokenKind)buffer->kinds[index];
+    token->location       = SourceRangeMake(start, end);
+    token->line           = 0;
+    token->column         = 0;
+    token->leadingTrivia  = SourceRangeMake(trivia, start);
+    token->trailingTrivia = SourceRangeMake(end, end + buffer->trailingTriviaLengths[index]);
+    token->valueKind      = TokenValueKindNone;
+    token->intValue       = 0;
+
+    // The value union is copied through its widest member
+    UInt32 valueIndex = buffer->valueIndices[index];
+    if (valueIndex != _kTokenBufferNoValue) {
+        token->valueKind = buffer->values[valueIndex].kind;
+        token->intValue  = buffer->values[valueIndex].intValue;
+    }
+}
+
+static inline TokenBufferRef _TokenBufferCreate(AllocatorRef allocator, LexerRef lexer, const Char *characters, Index length) {
+    assert(length < UINT32_MAX && "Source buffers larger than 4 GB are not supported!");
+
+    // Sources average around five characters per token including the trivia, reserving a token per three characters avoids reallocations
+    // for typical sources without reserving more than 6 bytes per source byte, denser sources grow geometrically
+    Index capacity                = MAX(length / 3, 16);
+    TokenBufferRef buffer         = (TokenBufferRef)AllocatorAllocate(allocator, sizeof(struct _TokenBuffer));
+    buffer->allocator             = allocator;
+    buffer->characters            = characters;
+    buffer->count                 = 0;
+    buffer->capacity              = capacity;
+    buffer->kinds                 = (UInt8 *)AllocatorAllocate(allocator, sizeof(UInt8) * capacity);
+    buffer->offsets               = (UInt32 *)AllocatorAllocate(allocator, sizeof(UInt32) * capacity);
+    buffer->lengths               = (UInt32 *)AllocatorAllocate(allocator, sizeof(UInt32) * capacity);
+    buffer->trailingTriviaLengths = (UInt32 *)AllocatorAllocate(allocator, sizeof(UInt32) * capacity);
+    buffer->valueIndices          = (UInt32 *)AllocatorAllocate(allocator, sizeof(UInt32) * capacity);
+    buffer->valueCount            = 0;
+    buffer->valueCapacity         = 0;
+    buffer->values                = NULL;
+
+    Token token;
+    do {
+        LexerNextToken(lexer, &token);
+        _TokenBufferAppendToken(buffer, &token);
+    } while (token.kind != TokenKindEndOfFile);
+
+    return buffer;
+}
+
+static inline void _TokenBufferAppendToken(TokenBufferRef buffer, const Token *token) {
+    assert(token->kind <= UINT8_MAX);
+
+    if (buffer->count == buffer->capacity) {
+        buffer->capacity *= 2;
+        buffer->kinds                 = (UInt8 *)AllocatorReallocate(buffer->allocator, buffer->kinds, sizeof(UInt8) * buffer->capacity);
+        buffer->offsets               = (UInt32 *)AllocatorReallocate(buffer->allocator, buffer->offsets,
+                                                                      sizeof(UInt32) * buffer->capacity);
+        buffer->lengths               = (UInt32 *)AllocatorReallocate(buffer->allocator, buffer->lengths,
+                                                                      sizeof(UInt32) * buffer->capacity);
+        buffer->trailingTriviaLengths = (UInt32 *)AllocatorReallocate(buffer->allocator, buffer->trailingTriviaLengths,
+                                                                      sizeof(UInt32) * buffer->capacity);
+        buffer->valueIndices          = (UInt32 *)AllocatorReallocate(buffer->allocator, buffer->valueIndices,
+                                                                      sizeof(UInt32) * buffer->capacity);
+    }
+
+    Index index                          = buffer->count;
+    buffer->kinds[index]                 = (UInt8)token->kind;
+    buffer->offsets[index]               = (UInt32)(token->location.start - buffer->characters);
+    buffer->lengths[index]               = (UInt32)(token->location.end - token->location.start);
+    buffer->trailingTriviaLengths[index] = (UInt32)(token->trailingTrivia.end - token->trailingTrivia.start);
+    buffer->valueIndices[index]          = _kTokenBufferNoValue;
+    buffer->count += 1;
+
+    if (token->valueKind == TokenValueKindNone) {
+        return;
+    }
+
+    if (!buffer->values) {
+        buffer->valueCapacity = 16;
+        buffer->values        = (TokenValue *)AllocatorAllocate(buffer->allocator, sizeof(TokenValue) * buffer->valueCapacity);
+    } else if (buffer->valueCount == buffer->valueCapacity) {
+        buffer->valueCapacity *= 2;
+        buffer->values = (TokenValue *)AllocatorReallocate(buffer->allocator, buffer->values, sizeof(TokenValue) * buffer->valueCapacity);
+    }
+
+    TokenValue *value = &buffer->values[buffer->valueCount];
+    value->kind       = token->valueKind;
+    value->intValue   = token->intValue;
+
+    buffer->valueIndices[index] = (UInt32)buffer->valueCount;
+    buffer->valueCount += 1;
+}
@@ -0,0 +1,257 @@
+#include "JellyCore/TrackingAllocator.h"
+
+#include <pthread.h>
+
+struct _TrackingAllocatorHeader {
+    struct _TrackingAllocatorHeader *previous;
+    struct _TrackingAllocatorHeader *next;
+    Index capacity;
+    const Char *callSite;
+};
+
+struct _TrackingAllocatorContext {
+    AllocatorRef allocator;
+    const Char *tag;
+    struct _TrackingAllocatorHeader *allocations;
+    TrackingAllocatorStatistics statistics;
+    pthread_mutex_t mutex;
+};
+
+struct _TrackingAllocatorCallSite {
+    const Char *name;
+    Index allocationCount;
+    Index allocatedBytes;
+};
+
+static JELLY_THREAD_LOCAL const Char *_kTrackingAllocatorCallSite = NULL;
+
+void *_AllocatorTracking(AllocatorMode mode, Index capacity, void *memory, void *context);
+
+static inline struct _TrackingAllocatorContext *_TrackingAllocatorGetContext(AllocatorRef allocator);
+static inline Index _TrackingAllocatorGetHistogramBucket(Index capacity);
+static inline void _TrackingAllocatorInsert(struct _TrackingAllocatorContext *context, struct _TrackingAllocatorHeader *header,
+                                            Index capacity);
+static inline void _TrackingAllocatorRemove(struct _TrackingAllocatorContext *context, struct _TrackingAllocatorHeader *header);
+
+AllocatorRef TrackingAllocatorCreate(AllocatorRef allocator, const Char *tag) {
+    struct _TrackingAllocatorContext *context = AllocatorAllocate(allocator, sizeof(struct _TrackingAllocatorContext));
+    memset(context, 0, sizeof(struct _TrackingAllocatorContext));
+    context->allocator = allocator;
+    context->tag       = tag;
+    pthread_mutex_init(&context->mutex, NULL);
+    return AllocatorCreate(allocator, &_AllocatorTracking, context);
+}
+
+const Char *TrackingAllocatorGetTag(AllocatorRef allocator) {
+    return _TrackingAllocatorGetContext(allocator)->tag;
+}
+
+TrackingAllocatorStatistics TrackingAllocatorGetStatistics(AllocatorRef allocator) {
+    struct _TrackingAllocatorContext *context = _TrackingAllocatorGetContext(allocator);
+    pthread_mutex_lock(&context->mutex);
+    TrackingAllocatorStatistics statistics = context->statistics;
+    pthread_mutex_unlock(&context->mutex);
+    return statistics;
+}
+
+const Char *TrackingAllocatorSetCallSite(const Char *callSite) {
+    const Char *previousCallSite = _kTrackingAllocatorCallSite;
+    _kTrackingAllocatorCallSite  = callSite;
+    return previousCallSite;
+}
+
+void TrackingAllocatorPrintReport(AllocatorRef *allocators, Index allocatorCount, FILE *output) {
+    fprintf(output, "===------------------------------------------------------------------------------===\n");
+    fprintf(output, "                            Jelly Memory Report\n");
+    fprintf(output, "===------------------------------------------------------------------------------===\n");
+    fprintf(output, "%12s %14s %14s %12s %12s %12s  %s\n", "Allocations", "Reallocations", "Deallocations", "Live", "Live (KiB)",
+            "Peak (KiB)", "Subsystem");
+
+    for (Index index = 0; index < allocatorCount; index++) {
+        TrackingAllocatorStatistics statistics = TrackingAllocatorGetStatistics(allocators[index]);
+        fprintf(output, "%12zu %14zu %14zu %12zu %12.1f %12.1f  %s\n", statistics.allocationCount, statistics.reallocationCount,
+                statistics.deallocationCount, statistics.liveAllocationCount, statistics.liveBytes / 1024.0, statistics.peakBytes / 1024.0,
+                TrackingAllocatorGetTag(allocators[index]));
+
+        fprintf(output, "%12s", "");
+        for (Index bucket = 0; bucket < JELLY_TRACKING_ALLOCATOR_HISTOGRAM_BUCKET_COUNT; bucket++) {
+            if (statistics.histogram[bucket] < 1) {
+                continue;
+            }
+
+            if (bucket + 1 < JELLY_TRACKING_ALLOCATOR_HISTOGRAM_BUCKET_COUNT) {
+                fprintf(output, " <=%zu:%zu", (Index)16 << bucket, statistics.histogram[bucket]);
+            } else {
+                fprintf(output, " >%zu:%zu", (Index)16 << (bucket - 1), statistics.histogram[bucket]);
+            }
+        }
+        fprintf(output, "\n");
+    }
+}
+
+Index TrackingAllocatorPrintLeakReport(AllocatorRef allocator, FILE *output) {
+    struct _TrackingAllocatorContext *context = _TrackingAllocatorGetContext(allocator);
+    pthread_mutex_lock(&context->mutex);
+
+    Index leakCount = context->statistics.liveAllocationCount;
+    if (leakCount > 0) {
+        // The call sites are aggregated into memory of the underlying allocator to keep the report out of the statistics
+        Index callSiteCount                         = 0;
+        struct _TrackingAllocatorCallSite *callSites = AllocatorAllocate(context->allocator,
+                                                                         sizeof(struct _TrackingAllocatorCallSite) * leakCount);
+        for (struct _TrackingAllocatorHeader *header = context->allocations; header; header = header->next) {
+            const Char *name                        = header->callSite ? header->callSite : "<unknown>";
+            struct _TrackingAllocatorCallSite *site = NULL;
+            for (Index index = 0; index < callSiteCount; index++) {
+                if (strcmp(callSites[index].name, name) == 0) {
+                    site = &callSites[index];
+                    break;
+                }
+            }
+
+            if (!site) {
+                site                  = &callSites[callSiteCount];
+                site->name            = name;
+                site->allocationCount = 0;
+                site->allocatedBytes  = 0;
+                callSiteCount += 1;
+            }
+
+            site->allocationCount += 1;
+            site->allocatedBytes += header->capacity;
+        }
+
+        fprintf(output, "%s: leaked %zu allocation(s) with %zu byte(s)\n", context->tag, leakCount, context->statistics.liveBytes);
+        for (Index index = 0; index < callSiteCount; index++) {
+            fprintf(output, "  %zu allocation(s) with %zu byte(s) allocated in %s\n", callSites[index].allocationCount,
+                    callSites[index].allocatedBytes, callSites[index].name);
+        }
+
+        AllocatorDeallocate(context->allocator, callSites);
+    }
+
+    pthread_mutex_unlock(&context->mutex);
+    return leakCount;
+}
+
+void *_AllocatorTracking(AllocatorMode mode, Index capacity, void *memory, void *context) {
+    struct _TrackingAllocatorContext *trackingContext = context;
+    assert(trackingContext);
+
+    switch (mode) {
+    case AllocatorModeAllocate: {
+        struct _TrackingAllocatorHeader *header = AllocatorAllocate(trackingContext->allocator,
+                                                                    sizeof(struct _TrackingAllocatorHeader) + capacity);
+        if (!header) {
+            return NULL;
+        }
+
+        pthread_mutex_lock(&trackingContext->mutex);
+        trackingContext->statistics.allocationCount += 1;
+        trackingContext->statistics.histogram[_TrackingAllocatorGetHistogramBucket(capacity)] += 1;
+        _TrackingAllocatorInsert(trackingContext, header, capacity);
+        pthread_mutex_unlock(&trackingContext->mutex);
+        return header + 1;
+    }
+
+    case AllocatorModeReallocate: {
+        if (!memory) {
+            return _AllocatorTracking(AllocatorModeAllocate, capacity, NULL, context);
+        }
+
+        // The block is unlinked while reallocating because the underlying allocator is free to move it
+        struct _TrackingAllocatorHeader *header = (struct _TrackingAllocatorHeader *)memory - 1;
+        pthread_mutex_lock(&trackingContext->mutex);
+        _TrackingAllocatorRemove(trackingContext, header);
+        struct _TrackingAllocatorHeader *newHeader = AllocatorReallocate(trackingContext->allocator, header,
+                                                                         sizeof(struct _TrackingAllocatorHeader) + capacity);
+        if (!newHeader) {
+            _TrackingAllocatorInsert(trackingContext, header, header->capacity);
+            pthread_mutex_unlock(&trackingContext->mutex);
+            return NULL;
+        }
+
+        trackingContext->statistics.reallocationCount += 1;
+        trackingContext->statistics.histogram[_TrackingAllocatorGetHistogramBucket(capacity)] += 1;
+        _TrackingAllocatorInsert(trackingContext, newHeader, capacity);
+        pthread_mutex_unlock(&trackingContext->mutex);
+        return newHeader + 1;
+    }
+
+    case AllocatorModeDeallocate: {
+        if (!memory) {
+            return NULL;
+        }
+
+        struct _TrackingAllocatorHeader *header = (struct _TrackingAllocatorHeader *)memory - 1;
+        pthread_mutex_lock(&trackingContext->mutex);
+        trackingContext->statistics.deallocationCount += 1;
+        _TrackingAllocatorRemove(trackingContext, header);
+        pthread_mutex_unlock(&trackingContext->mutex);
+        AllocatorDeallocate(trackingContext->allocator, header);
+        return NULL;
+    }
+
+    case AllocatorModeDestroy: {
+        struct _TrackingAllocatorHeader *header = trackingContext->allocations;
+        while (header) {
+            struct _TrackingAllocatorHeader *next = header->next;
+            AllocatorDeallocate(trackingContext->allocator, header);
+            header = next;
+        }
+
+        pthread_mutex_destroy(&trackingContext->mutex);
+        AllocatorDeallocate(trackingContext->allocator, trackingContext);
+        return NULL;
+    }
+
+    default:
+        JELLY_UNREACHABLE("Invalid value for mode!");
+    }
+}
+
+static inline struct _TrackingAllocatorContext *_TrackingAllocatorGetContext(AllocatorRef allocator) {
+    struct _TrackingAllocatorContext *context = AllocatorGetContext(allocator, &_AllocatorTracking);
+    assert(context && "Allocator has not been created by TrackingAllocatorCreate!");
+    return context;
+}
+
+static inline Index _TrackingAllocatorGetHistogramBucket(Index capacity) {
+    Index bucket = 0;
+    while (bucket + 1 < JELLY_TRACKING_ALLOCATOR_HISTOGRAM_BUCKET_COUNT && capacity > ((Index)16 << bucket)) {
+        bucket += 1;
+    }
+
+    return bucket;
+}
+
+static inline void _TrackingAllocatorInsert(struct _TrackingAllocatorContext *context, struct _TrackingAllocatorHeader *header,
+                                            Index capacity) {
+    header->previous = NULL;
+    header->next     = context->allocations;
+    header->capacity = capacity;
+    header->callSite = _kTrackingAllocatorCallSite;
+    if (header->next) {
+        header->next->previous = header;
+    }
+
+    context->allocations = header;
+    context->statistics.liveAllocationCount += 1;
+    context->statistics.liveBytes += capacity;
+    context->statistics.peakBytes = MAX(context->statistics.peakBytes, context->statistics.liveBytes);
+}
+
+static inline void _TrackingAllocatorRemove(struct _TrackingAllocatorContext *context, struct _TrackingAllocatorHeader *header) {
+    if (header->previous) {
+        header->previous->next = header->next;
+    } else {
+        context->allocations = header->next;
+    }
+
+    if (header->next) {
+        header->next->previous = header->previous;
+    }
+
+    context->statistics.liveAllocationCount -= 1;
+    context->statistics.liveBytes -= header->capacity;
+}
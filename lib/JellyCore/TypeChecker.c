@@ -1,4 +1,5 @@
 #include "JellyCore/ASTFunctions.h"
+#include "JellyCore/BumpAllocator.h"
 #include "JellyCore/Diagnostic.h"
 #include "JellyCore/TypeChecker.h"
 
@@ -15,6 +16,7 @@
 
 struct _TypeChecker {
     AllocatorRef allocator;
+    AllocatorRef scratchAllocator;
 };
 
 static inline void _TypeCheckerValidateSourceUnit(TypeCheckerRef typeChecker, ASTContextRef context, ASTSourceUnitRef sourceUnit);
@@ -45,12 +47,14 @@ static inline Bool _ASTTypeIsEqualOrError(ASTTypeRef lhs, ASTTypeRef rhs);
 static inline Bool _ASTExpressionIsLValue(ASTExpressionRef expression);
 
 TypeCheckerRef TypeCheckerCreate(AllocatorRef allocator) {
-    TypeCheckerRef typeChecker = AllocatorAllocate(allocator, sizeof(struct _TypeChecker));
-    typeChecker->allocator     = allocator;
+    TypeCheckerRef typeChecker    = AllocatorAllocate(allocator, sizeof(struct _TypeChecker));
+    typeChecker->allocator        = allocator;
+    typeChecker->scratchAllocator = BumpAllocatorCreate(allocator);
     return typeChecker;
 }
 
 void TypeCheckerDestroy(TypeCheckerRef typeChecker) {
+    AllocatorDestroy(typeChecker->scratchAllocator);
     AllocatorDeallocate(typeChecker->allocator, typeChecker);
 }
 
@@ -64,7 +68,7 @@ void TypeCheckerValidateModule(TypeCheckerRef typeChecker, ASTContextRef context
         _TypeCheckerValidateSourceUnit(typeChecker, context, sourceUnit);
     }
 
-    if (DiagnosticEngineGetMessageCount(DiagnosticLevelError) > 0 || DiagnosticEngineGetMessageCount(DiagnosticLevelCritical) > 0) {
+    if (DiagnosticEngineHasErrors(DiagnosticEngineGetCurrent())) {
         return;
     }
 
@@ -78,12 +82,12 @@ void TypeCheckerValidateModule(TypeCheckerRef typeChecker, ASTContextRef context
                 continue;
             }
 
-            if (!StringIsEqual(declaration->name, module->entryPointName)) {
+            if (declaration->name != module->entryPointName) {
                 continue;
             }
 
             if (module->entryPoint) {
-                ReportError("Invalid redeclaration of program entry point");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)declaration), "Invalid redeclaration of program entry point");
                 hasError = true;
                 break;
             }
@@ -91,13 +95,13 @@ void TypeCheckerValidateModule(TypeCheckerRef typeChecker, ASTContextRef context
             ASTFunctionDeclarationRef function = (ASTFunctionDeclarationRef)declaration;
 
             if (ASTArrayGetElementCount(function->parameters) != 0) {
-                ReportError("Expected no parameters for program entry point");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)function), "Expected no parameters for program entry point");
                 hasError = true;
                 break;
             }
 
             if (!_ASTTypeIsEqualOrError(function->returnType, (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindVoid))) {
-                ReportError("Return type of program entry point is not 'Void'");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)function), "Return type of program entry point is not 'Void'");
                 hasError = true;
                 break;
             }
@@ -161,8 +165,10 @@ static inline void _TypeCheckerValidateEnumerationDeclaration(TypeCheckerRef typ
                                                               ASTEnumerationDeclarationRef declaration) {
     _GuardValidateOnce(declaration);
 
-    ArrayRef values        = ArrayCreateEmpty(typeChecker->allocator, sizeof(UInt64), ASTArrayGetElementCount(declaration->elements));
-    UInt64 nextMemberValue = 0;
+    BumpAllocatorMarker marker = BumpAllocatorGetMarker(typeChecker->scratchAllocator);
+    ArrayRef values            = ArrayCreateEmpty(typeChecker->scratchAllocator, sizeof(UInt64),
+                                                  ASTArrayGetElementCount(declaration->elements));
+    UInt64 nextMemberValue     = 0;
     for (Index index = 0; index < ASTArrayGetElementCount(declaration->elements); index++) {
         ASTValueDeclarationRef element = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(declaration->elements, index);
         assert(element->kind == ASTValueKindEnumerationElement);
@@ -188,12 +194,14 @@ static inline void _TypeCheckerValidateEnumerationDeclaration(TypeCheckerRef typ
         ASTTypeRef intType = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindInt);
         if (!ASTTypeIsEqual(element->base.type, element->initializer->type) &&
             !(ASTTypeIsEqual(intType, element->initializer->type) || ASTTypeIsImplicitlyConvertible(element->initializer->type, intType))) {
-            ReportErrorFormat("Initializer of element '%s' has mismatching type", StringGetCharacters(element->base.name));
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)element), "Initializer of element '%s' has mismatching type",
+                          StringGetCharacters(element->base.name));
             continue;
         }
 
         if (element->initializer->base.tag != ASTTagConstantExpression) {
-            ReportErrorFormat("Initializer of element '%s' has to be a constant value", StringGetCharacters(element->base.name));
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)element), "Initializer of element '%s' has to be a constant value",
+                          StringGetCharacters(element->base.name));
             continue;
         }
 
@@ -210,14 +218,15 @@ static inline void _TypeCheckerValidateEnumerationDeclaration(TypeCheckerRef typ
         }
 
         if (isOverlappingOtherElementValue) {
-            ReportErrorFormat("Invalid reuse of value %llu for different enum elements", constant->intValue);
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)element),
+                          "Invalid reuse of value %llu for different enum elements", constant->intValue);
         } else {
             ArrayAppendElement(values, &constant->intValue);
             nextMemberValue = constant->intValue + 1;
         }
     }
 
-    ArrayDestroy(values);
+    BumpAllocatorRewind(typeChecker->scratchAllocator, marker);
 }
 
 static inline void _TypeCheckerValidateFunctionDeclaration(TypeCheckerRef typeChecker, ASTContextRef context,
@@ -232,7 +241,7 @@ static inline void _TypeCheckerValidateFunctionDeclaration(TypeCheckerRef typeCh
             ASTBuiltinTypeRef builtinType = (ASTBuiltinTypeRef)parameter->base.type;
             if (builtinType->kind == ASTBuiltinTypeKindVoid) {
                 parameter->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
-                ReportError("Cannot pass 'Void' type as parameter");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)parameter), "Cannot pass 'Void' type as parameter");
             }
         }
     }
@@ -248,7 +257,7 @@ static inline void _TypeCheckerValidateFunctionDeclaration(TypeCheckerRef typeCh
 
     _CheckIsBlockAlwaysReturning(context, declaration->body);
     if (requiresReturnValue && !(declaration->body->base.flags & ASTFlagsStatementIsAlwaysReturning)) {
-        ReportError("Not all code paths return a value");
+        ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)declaration), "Not all code paths return a value");
     }
 
     for (Index index = 0; index < ASTArrayGetElementCount(declaration->body->statements); index++) {
@@ -269,7 +278,7 @@ static inline void _TypeCheckerValidateForeignFunctionDeclaration(TypeCheckerRef
             ASTBuiltinTypeRef builtinType = (ASTBuiltinTypeRef)parameter->base.type;
             if (builtinType->kind == ASTBuiltinTypeKindVoid) {
                 parameter->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
-                ReportError("Cannot pass 'Void' type as parameter");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)parameter), "Cannot pass 'Void' type as parameter");
             }
         }
     }
@@ -296,7 +305,7 @@ static inline void _TypeCheckerValidateIntrinsicFunctionDeclaration(TypeCheckerR
             ASTBuiltinTypeRef builtinType = (ASTBuiltinTypeRef)parameter->base.type;
             if (builtinType->kind == ASTBuiltinTypeKindVoid) {
                 parameter->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
-                ReportError("Cannot pass 'Void' type as parameter");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)parameter), "Cannot pass 'Void' type as parameter");
             }
         }
     }
@@ -315,10 +324,11 @@ static inline void _TypeCheckerValidateStructureDeclaration(TypeCheckerRef typeC
                                                             ASTStructureDeclarationRef declaration) {
     _GuardValidateOnce(declaration);
 
-    ArrayRef parents = ArrayCreateEmpty(typeChecker->allocator, sizeof(ASTDeclarationRef), 8);
+    BumpAllocatorMarker marker = BumpAllocatorGetMarker(typeChecker->scratchAllocator);
+    ArrayRef parents           = ArrayCreateEmpty(typeChecker->scratchAllocator, sizeof(ASTDeclarationRef), 8);
     ArrayAppendElement(parents, &declaration);
     _CheckCyclicStorageInStructureDeclaration(context, declaration, parents);
-    ArrayDestroy(parents);
+    BumpAllocatorRewind(typeChecker->scratchAllocator, marker);
 
     for (Index index = 0; index < ASTArrayGetElementCount(declaration->values); index++) {
         ASTValueDeclarationRef value = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(declaration->values, index);
@@ -328,7 +338,7 @@ static inline void _TypeCheckerValidateStructureDeclaration(TypeCheckerRef typeC
             ASTBuiltinTypeRef builtinType = (ASTBuiltinTypeRef)value->base.type;
             if (builtinType->kind == ASTBuiltinTypeKindVoid) {
                 value->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
-                ReportError("Cannot store 'Void' type as member");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)value), "Cannot store 'Void' type as member");
             }
         }
     }
@@ -344,7 +354,8 @@ static inline void _TypeCheckerValidateVariableDeclaration(TypeCheckerRef typeCh
 
         if (!_ASTTypeIsEqualOrError(declaration->base.type, declaration->initializer->type) &&
             !ASTTypeIsImplicitlyConvertible(declaration->initializer->type, declaration->base.type)) {
-            ReportErrorFormat("Assignment expression of '%s' has mismatching type", StringGetCharacters(declaration->base.name));
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)declaration), "Assignment expression of '%s' has mismatching type",
+                          StringGetCharacters(declaration->base.name));
         }
     }
 }
@@ -359,7 +370,8 @@ static inline void _TypeCheckerValidateStatement(TypeCheckerRef typeChecker, AST
 
         assert(statement->condition->type);
         if (!_ASTTypeIsEqualOrError(statement->condition->type, (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindBool))) {
-            ReportError("Expected type Bool for condition of if statement");
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)statement->condition),
+                          "Expected type Bool for condition of if statement");
         }
 
         _TypeCheckerValidateBlock(typeChecker, context, statement->thenBlock);
@@ -373,7 +385,8 @@ static inline void _TypeCheckerValidateStatement(TypeCheckerRef typeChecker, AST
 
         assert(statement->condition->type);
         if (!_ASTTypeIsEqualOrError(statement->condition->type, (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindBool))) {
-            ReportError("Expected type Bool for condition of loop statement");
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)statement->condition),
+                          "Expected type Bool for condition of loop statement");
         }
 
         _TypeCheckerValidateBlock(typeChecker, context, statement->loopBlock);
@@ -388,11 +401,11 @@ static inline void _TypeCheckerValidateStatement(TypeCheckerRef typeChecker, AST
             assert(node && node->tag == ASTTagSwitchStatement);
             statement->enclosingSwitch = (ASTSwitchStatementRef)node;
         } else {
-            ReportError("'case' is only allowed inside a switch");
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)statement), "'case' is only allowed inside a switch");
         }
 
         if (ASTArrayGetElementCount(statement->body->statements) < 1) {
-            ReportError("Switch case should contain at least one statement");
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)statement), "Switch case should contain at least one statement");
         }
 
         switch (statement->kind) {
@@ -442,7 +455,7 @@ static inline void _TypeCheckerValidateStatement(TypeCheckerRef typeChecker, AST
                 assert(node);
                 control->enclosingNode = node;
             } else {
-                ReportError("'break' is only allowed inside a switch or loop");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)control), "'break' is only allowed inside a switch or loop");
             }
             break;
         }
@@ -454,7 +467,7 @@ static inline void _TypeCheckerValidateStatement(TypeCheckerRef typeChecker, AST
                 assert(node);
                 control->enclosingNode = node;
             } else {
-                ReportError("'continue' is only allowed inside a loop");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)control), "'continue' is only allowed inside a loop");
             }
             break;
         }
@@ -466,7 +479,7 @@ static inline void _TypeCheckerValidateStatement(TypeCheckerRef typeChecker, AST
                 assert(node);
                 control->enclosingNode = node;
             } else {
-                ReportError("'fallthrough' is only allowed inside a case");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)control), "'fallthrough' is only allowed inside a case");
             }
             break;
         }
@@ -493,10 +506,10 @@ static inline void _TypeCheckerValidateStatement(TypeCheckerRef typeChecker, AST
 
                 if (!_ASTTypeIsEqualOrError(resultType, function->returnType) &&
                     !ASTTypeIsImplicitlyConvertible(resultType, function->returnType)) {
-                    ReportError("Type mismatch in return statement");
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)control), "Type mismatch in return statement");
                 }
             } else {
-                ReportError("'return' is only allowed inside a function");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)control), "'return' is only allowed inside a function");
             }
             break;
         }
@@ -541,11 +554,13 @@ static inline void _TypeCheckerValidateSwitchStatement(TypeCheckerRef typeChecke
 
         if (caseStatement->kind == ASTCaseKindElse) {
             if (index + 1 < ASTArrayGetElementCount(statement->cases)) {
-                ReportError("The 'else' case has to be the last case of a switch statement");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)caseStatement),
+                              "The 'else' case has to be the last case of a switch statement");
             }
 
             if (containsElseCase) {
-                ReportError("There can only be a single 'else' case inside a switch statement");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)caseStatement),
+                              "There can only be a single 'else' case inside a switch statement");
             }
 
             containsElseCase = true;
@@ -554,7 +569,7 @@ static inline void _TypeCheckerValidateSwitchStatement(TypeCheckerRef typeChecke
 
     _CheckIsSwitchExhaustive(typeChecker, statement);
     if (!(statement->base.flags & ASTFlagsSwitchIsExhaustive)) {
-        ReportError("Switch statement must be exhaustive");
+        ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)statement), "Switch statement must be exhaustive");
     }
 }
 
@@ -612,7 +627,8 @@ static inline void _TypeCheckerValidateExpression(TypeCheckerRef typeChecker, AS
 
         if (!_ASTExpressionIsLValue(assignment->variable)) {
             assignment->variable->type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
-            ReportError("Left hand side of assignment expression is not assignable");
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)assignment->variable),
+                          "Left hand side of assignment expression is not assignable");
         }
 
         assert(assignment->variable->type);
@@ -624,7 +640,7 @@ static inline void _TypeCheckerValidateExpression(TypeCheckerRef typeChecker, AS
                                    ((ASTConstantExpressionRef)assignment->expression)->kind == ASTConstantKindNil;
 
             if (!isNilAssignment) {
-                ReportError("Assignment expression has mismatching type");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)assignment), "Assignment expression has mismatching type");
             }
         }
 
@@ -664,10 +680,12 @@ static inline void _TypeCheckerValidateExpression(TypeCheckerRef typeChecker, AS
                             !ASTTypeIsImplicitlyConvertible(argument->type, parameterType) && !isMatchingNilArgument) {
                             if (functionType->declaration) {
                                 ASTValueDeclarationRef parameter = ASTArrayGetElementAtIndex(functionType->declaration->parameters, index);
-                                ReportErrorFormat("Mismatching type for parameter '%s' in '%s'", StringGetCharacters(parameter->base.name),
-                                                  StringGetCharacters(functionType->declaration->base.name));
+                                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)argument),
+                                              "Mismatching type for parameter '%s' in '%s'", StringGetCharacters(parameter->base.name),
+                                              StringGetCharacters(functionType->declaration->base.name));
                             } else {
-                                ReportErrorFormat("Mismatching type for parameter at position '%zu'", index);
+                                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)argument),
+                                              "Mismatching type for parameter at position '%zu'", index);
                             }
                         }
 
@@ -676,12 +694,12 @@ static inline void _TypeCheckerValidateExpression(TypeCheckerRef typeChecker, AS
                         parameterIterator = ASTArrayIteratorNext(parameterIterator);
                     }
                 } else {
-                    ReportErrorFormat("Invalid argument count expected '%zu' found '%zu'",
-                                      ASTArrayGetElementCount(functionType->parameterTypes), ASTArrayGetElementCount(call->arguments));
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)call), "Invalid argument count expected '%zu' found '%zu'",
+                                  ASTArrayGetElementCount(functionType->parameterTypes), ASTArrayGetElementCount(call->arguments));
                 }
 
             } else {
-                ReportError("Cannot call a non function type");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)call->callee), "Cannot call a non function type");
             }
         }
         break;
@@ -701,12 +719,13 @@ static inline void _TypeCheckerValidateExpression(TypeCheckerRef typeChecker, AS
         if (ASTArrayGetElementCount(subscript->arguments) == 1) {
             ASTExpressionRef argument = ASTArrayGetElementAtIndex(subscript->arguments, 0);
             if (!ASTTypeIsError(argument->type) && !ASTTypeIsInteger(argument->type)) {
-                ReportError("Type mismatch in argument list of subscript expression");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)argument),
+                              "Type mismatch in argument list of subscript expression");
                 subscript->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
             }
         } else {
-            ReportErrorFormat("Expected single argument for subscript expression found '%zu'",
-                              ASTArrayGetElementCount(subscript->arguments));
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)subscript),
+                          "Expected single argument for subscript expression found '%zu'", ASTArrayGetElementCount(subscript->arguments));
             subscript->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
         }
 
@@ -730,7 +749,8 @@ static inline void _TypeCheckerValidateExpression(TypeCheckerRef typeChecker, AS
         // NOTE: We will limit this operation to only pointer types for now and can eventually add support for other types if it makes
         //       sense...
         if (typeExpression->expression->type->tag != ASTTagPointerType || typeExpression->argumentType->tag != ASTTagPointerType) {
-            ReportError("Bitcast operation only accepts pointer types at the moment");
+            ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)typeExpression),
+                          "Bitcast operation only accepts pointer types at the moment");
             typeExpression->base.type = (ASTTypeRef)ASTContextGetBuiltinType(context, ASTBuiltinTypeKindError);
             return;
         }
@@ -762,9 +782,9 @@ static inline void _TypeCheckerValidateBlock(TypeCheckerRef typeChecker, ASTCont
 }
 
 static inline void _TypeCheckerValidateStaticArrayTypesInContext(TypeCheckerRef typeChecker, ASTContextRef context) {
-    BucketArrayRef arrayTypes = ASTContextGetAllNodes(context, ASTTagArrayType);
-    for (Index index = 0; index < BucketArrayGetElementCount(arrayTypes); index++) {
-        ASTArrayTypeRef arrayType = (ASTArrayTypeRef)BucketArrayGetElementAtIndex(arrayTypes, index);
+    for (ASTContextNodeIterator iterator = ASTContextGetNodeIterator(context, ASTTagArrayType); iterator.node;
+         ASTContextNodeIteratorNext(&iterator)) {
+        ASTArrayTypeRef arrayType = (ASTArrayTypeRef)iterator.node;
         if (arrayType->size) {
             if (arrayType->size->base.tag == ASTTagConstantExpression) {
                 ASTConstantExpressionRef constant = (ASTConstantExpressionRef)arrayType->size;
@@ -772,10 +792,12 @@ static inline void _TypeCheckerValidateStaticArrayTypesInContext(TypeCheckerRef
                     arrayType->base.flags |= ASTFlagsArrayTypeIsStatic;
                     arrayType->sizeValue = constant->intValue;
                 } else {
-                    ReportError("Only integer literals are allowed for the size of an Array");
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)arrayType->size),
+                                  "Only integer literals are allowed for the size of an Array");
                 }
             } else {
-                ReportError("Only literal expressions are allowed for the size of an Array");
+                ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)arrayType->size),
+                              "Only literal expressions are allowed for the size of an Array");
             }
         }
     }
@@ -804,7 +826,8 @@ static inline void _CheckCyclicStorageInStructureDeclaration(ASTContextRef conte
             for (Index parentIndex = 0; parentIndex < ArrayGetElementCount(parents); parentIndex++) {
                 ASTStructureDeclarationRef parent = *((ASTStructureDeclarationRef *)ArrayGetElementAtIndex(parents, parentIndex));
                 if (parent == valueType->declaration) {
-                    ReportError("Struct cannot store a variable of same type recursively");
+                    ReportErrorAt(ASTContextGetNodeLocation(context, (ASTNodeRef)value),
+                                  "Struct cannot store a variable of same type recursively");
                     declaration->base.base.flags |= ASTFlagsStructureHasCyclicStorage;
                     return;
                 }
@@ -911,7 +934,9 @@ static inline void _CheckIsSwitchExhaustive(TypeCheckerRef typeChecker, ASTSwitc
         ASTEnumerationTypeRef enumerationType    = (ASTEnumerationTypeRef)statement->argument->type;
         ASTEnumerationDeclarationRef enumeration = enumerationType->declaration;
 
-        ArrayRef intValues = ArrayCreateEmpty(typeChecker->allocator, sizeof(UInt64), ASTArrayGetElementCount(enumeration->elements));
+        BumpAllocatorMarker marker = BumpAllocatorGetMarker(typeChecker->scratchAllocator);
+        ArrayRef intValues         = ArrayCreateEmpty(typeChecker->scratchAllocator, sizeof(UInt64),
+                                                      ASTArrayGetElementCount(enumeration->elements));
         for (Index index = 0; index < ASTArrayGetElementCount(enumeration->elements); index++) {
             ASTValueDeclarationRef element = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(enumeration->elements, index);
             assert(element->initializer && element->initializer->base.tag == ASTTagConstantExpression);
@@ -948,13 +973,14 @@ static inline void _CheckIsSwitchExhaustive(TypeCheckerRef typeChecker, ASTSwitc
             statement->base.flags |= ASTFlagsSwitchIsExhaustive;
         }
 
-        ArrayDestroy(intValues);
+        BumpAllocatorRewind(typeChecker->scratchAllocator, marker);
     } else if (statement->argument->type->tag == ASTTagBuiltinType) {
         ASTBuiltinTypeRef type = (ASTBuiltinTypeRef)statement->argument->type;
         if (type->kind == ASTBuiltinTypeKindBool) {
-            ArrayRef boolValues = ArrayCreateEmpty(typeChecker->allocator, sizeof(Bool), 2);
-            Bool trueValue      = true;
-            Bool falseValue     = false;
+            BumpAllocatorMarker marker = BumpAllocatorGetMarker(typeChecker->scratchAllocator);
+            ArrayRef boolValues        = ArrayCreateEmpty(typeChecker->scratchAllocator, sizeof(Bool), 2);
+            Bool trueValue             = true;
+            Bool falseValue            = false;
             ArrayAppendElement(boolValues, &trueValue);
             ArrayAppendElement(boolValues, &falseValue);
             for (Index index = 0; index < ASTArrayGetElementCount(statement->cases); index++) {
@@ -977,7 +1003,7 @@ static inline void _CheckIsSwitchExhaustive(TypeCheckerRef typeChecker, ASTSwitc
                 statement->base.flags |= ASTFlagsSwitchIsExhaustive;
             }
 
-            ArrayDestroy(boolValues);
+            BumpAllocatorRewind(typeChecker->scratchAllocator, marker);
         }
     }
 }
@@ -1,20 +1,39 @@
 #include "JellyCore/ASTDumper.h"
 #include "JellyCore/ASTMangling.h"
 #include "JellyCore/ASTSubstitution.h"
+#include "JellyCore/BuildCache.h"
 #include "JellyCore/ClangImporter.h"
 #include "JellyCore/DependencyGraph.h"
 #include "JellyCore/Diagnostic.h"
 #include "JellyCore/Dictionary.h"
 #include "JellyCore/IRBuilder.h"
 #include "JellyCore/LDLinker.h"
+#include "JellyCore/ModuleInterface.h"
 #include "JellyCore/NameResolution.h"
 #include "JellyCore/Parser.h"
+#include "JellyCore/Profiler.h"
 #include "JellyCore/Queue.h"
+#include "JellyCore/SourceBuffer.h"
+#include "JellyCore/TempAllocator.h"
+#include "JellyCore/TrackingAllocator.h"
 #include "JellyCore/TypeChecker.h"
 #include "JellyCore/Workspace.h"
 
 #include <pthread.h>
 
+// The allocations of each subsystem are tracked by a separate allocator if a memory report has been requested
+enum _WorkspaceSubsystem {
+    WorkspaceSubsystemLexer,
+    WorkspaceSubsystemParser,
+    WorkspaceSubsystemASTContext,
+    WorkspaceSubsystemSymbolTable,
+    WorkspaceSubsystemIRBuilder,
+    WorkspaceSubsystemCount,
+};
+typedef enum _WorkspaceSubsystem WorkspaceSubsystem;
+
+static const Char *_kWorkspaceSubsystemTags[WorkspaceSubsystemCount] = {"Lexer", "Parser", "ASTContext", "SymbolTable", "IRBuilder"};
+
 struct _Workspace {
     AllocatorRef allocator;
     StringRef workingDirectory;
@@ -26,53 +45,134 @@ struct _Workspace {
     ASTContextRef context;
     ParserRef parser;
     ClangImporterRef importer;
-    QueueRef parseQueue;
-    QueueRef parseInterfaceQueue;
-    QueueRef parseIncludeQueue;
-    QueueRef importQueue;
+    DiagnosticEngineRef diagnosticEngine;
+    ConcurrentQueueRef parseQueue;
+    ConcurrentQueueRef parseInterfaceQueue;
+    ConcurrentQueueRef parseIncludeQueue;
+    ConcurrentQueueRef importQueue;
     DictionaryRef modules;
 
     WorkspaceOptions options;
     FILE *dumpASTOutput;
+    FILE *traceOutput;
+    StringRef targetTriple;
+    Index jobCount;
+    ProfilerRef profiler;
+    AllocatorRef subsystemAllocators[WorkspaceSubsystemCount];
 
     Bool running;
     Bool waiting;
+    Index activeParserCount;
+    Index idleParserCount;
+    Index parseTicketCount;
+    Index nextParseTicket;
+    Index nextBuildModuleIndex;
     pthread_mutex_t mutex;
     pthread_mutex_t empty;
+    pthread_mutex_t contextMutex;
+    pthread_cond_t parseQueueCondition;
+    pthread_cond_t parseOrderCondition;
     pthread_t thread;
 };
 
+/// A file enqueued into one of the frontend queues, the parse ticket is drawn when the file is enqueued into the parse queue so that the
+/// workers can dequeue without serializing on the mutex of the workspace.
+struct _WorkspaceFileRequest {
+    ASTModuleDeclarationRef module;
+    StringRef filePath;
+    Index parseTicket;
+};
+typedef struct _WorkspaceFileRequest WorkspaceFileRequest;
+
+struct _WorkspaceParseWorker {
+    WorkspaceRef workspace;
+    Index processedFileCount;
+    pthread_t thread;
+};
+typedef struct _WorkspaceParseWorker WorkspaceParseWorker;
+
+struct _WorkspaceBuildWorker {
+    WorkspaceRef workspace;
+    AllocatorRef allocator;
+    ArrayRef modules;
+    pthread_t thread;
+};
+typedef struct _WorkspaceBuildWorker WorkspaceBuildWorker;
+
 Bool _ArrayContainsString(const void *lhs, const void *rhs);
 
+Index _WorkspaceBeginSpan(WorkspaceRef workspace, const Char *phase, StringRef unitName);
+void _WorkspaceEndSpan(WorkspaceRef workspace, Index span);
+void _WorkspaceAddParsedSource(WorkspaceRef workspace, StringRef filePath, SourceBufferRef source);
+void _WorkspaceEnqueueFileRequest(WorkspaceRef workspace, ConcurrentQueueRef queue, ASTModuleDeclarationRef module, StringRef filePath);
+Bool _WorkspaceDequeueFileRequest(WorkspaceRef workspace, ConcurrentQueueRef queue, ASTModuleDeclarationRef *module, StringRef *filePath);
+void _WorkspaceEnqueueParseRequest(WorkspaceRef workspace, StringRef filePath);
+WorkspaceFileRequest *_WorkspaceDequeueParseRequest(WorkspaceRef workspace);
 void _WorkspacePerformLoads(WorkspaceRef workspace, ASTSourceUnitRef sourceUnit);
 void _WorkspacePerformInterfaceLoads(WorkspaceRef workspace, ASTModuleDeclarationRef module, ASTSourceUnitRef sourceUnit);
 void _WorkspacePerformImports(WorkspaceRef workspace, ASTModuleDeclarationRef module, ASTSourceUnitRef sourceUnit);
+void *_WorkspaceParseWorkerProcess(void *context);
+Bool _WorkspaceLoadModuleInterface(WorkspaceRef workspace, ASTModuleDeclarationRef module, StringRef importFilePath);
+UInt64 _WorkspaceGetFingerprintSeed(WorkspaceRef workspace, StringRef moduleName);
+UInt64 _WorkspaceHashSourceFile(WorkspaceRef workspace, UInt64 fingerprint, StringRef filePath);
+UInt64 _WorkspaceGetModuleFingerprint(WorkspaceRef workspace, DictionaryRef fingerprints, ASTModuleDeclarationRef module);
+void _WorkspaceBuildModules(WorkspaceRef workspace, ArrayRef modules);
+void *_WorkspaceBuildWorkerProcess(void *context);
 void *_WorkspaceProcess(void *context);
+void _WorkspaceRunPipeline(WorkspaceRef workspace);
+
+WorkspaceOptions WorkspaceOptionsGetFingerprintOptions(WorkspaceOptions options) {
+    // Dumps, reports and the cache control don't change the object files and must not invalidate the build cache
+    return (WorkspaceOptions)(options & (WorkspaceOptionsTypeCheck | WorkspaceOptionsOptimizeLess | WorkspaceOptionsOptimizeDefault |
+                                         WorkspaceOptionsOptimizeAggressive | WorkspaceOptionsOptimizeSize));
+}
 
 WorkspaceRef WorkspaceCreate(AllocatorRef allocator, StringRef workingDirectory, StringRef buildDirectory, StringRef moduleName,
                              WorkspaceOptions options) {
-    WorkspaceRef workspace         = AllocatorAllocate(allocator, sizeof(struct _Workspace));
-    workspace->allocator           = allocator;
-    workspace->workingDirectory    = StringCreateCopy(allocator, workingDirectory);
-    workspace->buildDirectory      = StringCreateCopy(allocator, buildDirectory);
-    workspace->sourceFilePaths     = ArrayCreateEmpty(allocator, sizeof(StringRef *), 8);
-    workspace->includeFilePaths    = ArrayCreateEmpty(allocator, sizeof(StringRef *), 8);
-    workspace->moduleFilePaths     = ArrayCreateEmpty(allocator, sizeof(StringRef *), 8);
-    workspace->parsedSources       = ArrayCreateEmpty(allocator, sizeof(StringRef *), 8);
-    workspace->context             = ASTContextCreate(allocator, moduleName);
-    workspace->parser              = ParserCreate(allocator, workspace->context);
-    workspace->importer            = ClangImporterCreate(allocator, workspace->context);
-    workspace->parseQueue          = QueueCreate(allocator);
-    workspace->parseInterfaceQueue = QueueCreate(allocator);
-    workspace->parseIncludeQueue   = QueueCreate(allocator);
-    workspace->importQueue         = QueueCreate(allocator);
-    workspace->modules             = CStringDictionaryCreate(allocator, 8);
-    workspace->options             = options;
-    workspace->dumpASTOutput       = stdout;
-    workspace->running             = false;
-    workspace->waiting             = false;
+    WorkspaceRef workspace = AllocatorAllocate(allocator, sizeof(struct _Workspace));
+    for (Index index = 0; index < WorkspaceSubsystemCount; index++) {
+        workspace->subsystemAllocators[index] = allocator;
+        if (options & WorkspaceOptionsMemoryReport) {
+            workspace->subsystemAllocators[index] = TrackingAllocatorCreate(allocator, _kWorkspaceSubsystemTags[index]);
+        }
+    }
+
+    workspace->allocator            = allocator;
+    workspace->workingDirectory     = StringCreateCopy(allocator, workingDirectory);
+    workspace->buildDirectory       = StringCreateCopy(allocator, buildDirectory);
+    workspace->sourceFilePaths      = ArrayCreateEmpty(allocator, sizeof(StringRef *), 8);
+    workspace->includeFilePaths     = ArrayCreateEmpty(allocator, sizeof(StringRef *), 8);
+    workspace->moduleFilePaths      = ArrayCreateEmpty(allocator, sizeof(StringRef *), 8);
+    workspace->parsedSources        = ArrayCreateEmpty(allocator, sizeof(SourceBufferRef), 8);
+    workspace->context              = ASTContextCreate(workspace->subsystemAllocators[WorkspaceSubsystemASTContext],
+                                                       workspace->subsystemAllocators[WorkspaceSubsystemSymbolTable], moduleName);
+    workspace->parser               = ParserCreate(workspace->subsystemAllocators[WorkspaceSubsystemParser],
+                                                   workspace->subsystemAllocators[WorkspaceSubsystemLexer], workspace->context);
+    workspace->importer             = ClangImporterCreate(allocator, workspace->context);
+    workspace->diagnosticEngine     = DiagnosticEngineCreate(allocator);
+    workspace->parseQueue           = ConcurrentQueueCreate(allocator);
+    workspace->parseInterfaceQueue  = ConcurrentQueueCreate(allocator);
+    workspace->parseIncludeQueue    = ConcurrentQueueCreate(allocator);
+    workspace->importQueue          = ConcurrentQueueCreate(allocator);
+    workspace->modules              = CStringDictionaryCreate(allocator, 8);
+    workspace->options              = options;
+    workspace->dumpASTOutput        = stdout;
+    workspace->traceOutput          = NULL;
+    workspace->targetTriple         = NULL;
+    workspace->jobCount             = 1;
+    workspace->profiler             = NULL;
+    workspace->running              = false;
+    workspace->waiting              = false;
+    workspace->activeParserCount    = 0;
+    workspace->idleParserCount      = 0;
+    workspace->parseTicketCount     = 0;
+    workspace->nextParseTicket      = 0;
+    workspace->nextBuildModuleIndex = 0;
     pthread_mutex_init(&workspace->mutex, NULL);
     pthread_mutex_init(&workspace->empty, NULL);
+    pthread_mutex_init(&workspace->contextMutex, NULL);
+    pthread_cond_init(&workspace->parseQueueCondition, NULL);
+    pthread_cond_init(&workspace->parseOrderCondition, NULL);
 
     ASTModuleDeclarationRef module = ASTContextGetModule(workspace->context);
     DictionaryInsert(workspace->modules, StringGetCharacters(module->base.name), &module, sizeof(ASTModuleDeclarationRef));
@@ -84,9 +184,12 @@ void WorkspaceDestroy(WorkspaceRef workspace) {
         WorkspaceWaitForFinish(workspace);
     }
 
+    // The engine is referencing the parsed sources to resolve the locations of diagnostics
+    DiagnosticEngineDestroy(workspace->diagnosticEngine);
+
     for (Index index = 0; index < ArrayGetElementCount(workspace->parsedSources); index++) {
-        StringRef string = *(StringRef *)ArrayGetElementAtIndex(workspace->parsedSources, index);
-        StringDestroy(string);
+        SourceBufferRef source = *(SourceBufferRef *)ArrayGetElementAtIndex(workspace->parsedSources, index);
+        SourceBufferDestroy(source);
     }
 
     for (Index index = 0; index < ArrayGetElementCount(workspace->moduleFilePaths); index++) {
@@ -104,6 +207,14 @@ void WorkspaceDestroy(WorkspaceRef workspace) {
         StringDestroy(string);
     }
 
+    if (workspace->profiler) {
+        ProfilerDestroy(workspace->profiler);
+    }
+
+    if (workspace->targetTriple) {
+        StringDestroy(workspace->targetTriple);
+    }
+
     StringDestroy(workspace->workingDirectory);
     StringDestroy(workspace->buildDirectory);
     ArrayDestroy(workspace->parsedSources);
@@ -113,11 +224,33 @@ void WorkspaceDestroy(WorkspaceRef workspace) {
     ASTContextDestroy(workspace->context);
     ParserDestroy(workspace->parser);
     ClangImporterDestroy(workspace->importer);
-    QueueDestroy(workspace->parseQueue);
-    QueueDestroy(workspace->parseInterfaceQueue);
-    QueueDestroy(workspace->parseIncludeQueue);
-    QueueDestroy(workspace->importQueue);
+    ConcurrentQueueRef queues[] = {workspace->parseQueue, workspace->parseInterfaceQueue, workspace->parseIncludeQueue,
+                                   workspace->importQueue};
+    for (Index index = 0; index < sizeof(queues) / sizeof(ConcurrentQueueRef); index++) {
+        // The queues still contain the files of a workspace which has never been started
+        ASTModuleDeclarationRef module = NULL;
+        StringRef filePath             = NULL;
+        while (_WorkspaceDequeueFileRequest(workspace, queues[index], &module, &filePath)) {
+            StringDestroy(filePath);
+        }
+
+        ConcurrentQueueDestroy(queues[index]);
+    }
+
     DictionaryDestroy(workspace->modules);
+    pthread_cond_destroy(&workspace->parseOrderCondition);
+    pthread_cond_destroy(&workspace->parseQueueCondition);
+    pthread_mutex_destroy(&workspace->contextMutex);
+    pthread_mutex_destroy(&workspace->empty);
+    pthread_mutex_destroy(&workspace->mutex);
+
+    if (workspace->options & WorkspaceOptionsMemoryReport) {
+        for (Index index = 0; index < WorkspaceSubsystemCount; index++) {
+            TrackingAllocatorPrintLeakReport(workspace->subsystemAllocators[index], stdout);
+            AllocatorDestroy(workspace->subsystemAllocators[index]);
+        }
+    }
+
     AllocatorDeallocate(workspace->allocator, workspace);
 }
 
@@ -125,12 +258,19 @@ ASTContextRef WorkspaceGetContext(WorkspaceRef workspace) {
     return workspace->context;
 }
 
+DiagnosticEngineRef WorkspaceGetDiagnosticEngine(WorkspaceRef workspace) {
+    return workspace->diagnosticEngine;
+}
+
 void WorkspaceAddSourceFile(WorkspaceRef workspace, StringRef filePath) {
     StringRef absoluteFilePath = StringCreateCopy(workspace->allocator, workspace->workingDirectory);
     StringAppend(absoluteFilePath, "/");
     StringAppendString(absoluteFilePath, filePath);
     if (ArrayContainsElement(workspace->sourceFilePaths, &_ArrayContainsString, &absoluteFilePath)) {
+        DiagnosticEngineRef previousEngine = DiagnosticEngineGetCurrent();
+        DiagnosticEngineSetCurrent(workspace->diagnosticEngine);
         ReportErrorFormat("Cannot load source file at path '%s' twice", StringGetCharacters(filePath));
+        DiagnosticEngineSetCurrent(previousEngine);
         StringDestroy(absoluteFilePath);
         return;
     }
@@ -138,9 +278,7 @@ void WorkspaceAddSourceFile(WorkspaceRef workspace, StringRef filePath) {
     ArrayAppendElement(workspace->sourceFilePaths, &absoluteFilePath);
 
     StringRef copy = StringCreateCopy(workspace->allocator, filePath);
-    pthread_mutex_lock(&workspace->mutex);
-    QueueEnqueue(workspace->parseQueue, copy);
-    pthread_mutex_unlock(&workspace->mutex);
+    _WorkspaceEnqueueParseRequest(workspace, copy);
 }
 
 void WorkspaceSetDumpASTOutput(WorkspaceRef workspace, FILE *output) {
@@ -148,11 +286,37 @@ void WorkspaceSetDumpASTOutput(WorkspaceRef workspace, FILE *output) {
     workspace->dumpASTOutput = output;
 }
 
+void WorkspaceSetTraceOutput(WorkspaceRef workspace, FILE *output) {
+    assert(output);
+    workspace->traceOutput = output;
+}
+
+void WorkspaceSetJobCount(WorkspaceRef workspace, Index jobCount) {
+    assert(!workspace->running);
+    workspace->jobCount = MAX(jobCount, 1);
+}
+
+void WorkspaceSetTargetTriple(WorkspaceRef workspace, StringRef targetTriple) {
+    assert(!workspace->running);
+    if (workspace->targetTriple) {
+        StringDestroy(workspace->targetTriple);
+        workspace->targetTriple = NULL;
+    }
+
+    if (targetTriple) {
+        workspace->targetTriple = StringCreateCopy(workspace->allocator, targetTriple);
+    }
+}
+
 Bool WorkspaceStartAsync(WorkspaceRef workspace) {
     assert(!workspace->running);
     workspace->running = true;
 
-    DiagnosticEngineResetMessageCounts();
+    if (!workspace->profiler && ((workspace->options & WorkspaceOptionsTimeReport) || workspace->traceOutput)) {
+        workspace->profiler = ProfilerCreate(workspace->allocator);
+    }
+
+    DiagnosticEngineResetMessageCounts(workspace->diagnosticEngine);
     return pthread_create(&workspace->thread, NULL, &_WorkspaceProcess, workspace) == 0;
 }
 
@@ -163,12 +327,128 @@ void WorkspaceWaitForFinish(WorkspaceRef workspace) {
     pthread_join(workspace->thread, NULL);
     workspace->running = false;
     workspace->waiting = false;
+
+    if (workspace->profiler && (workspace->options & WorkspaceOptionsTimeReport)) {
+        ProfilerPrintReport(workspace->profiler, stdout);
+    }
+
+    if (workspace->profiler && workspace->traceOutput) {
+        ProfilerWriteTrace(workspace->profiler, workspace->traceOutput);
+    }
+
+    if (workspace->options & WorkspaceOptionsMemoryReport) {
+        TrackingAllocatorPrintReport(workspace->subsystemAllocators, WorkspaceSubsystemCount, stdout);
+    }
+
+    if (workspace->options & (WorkspaceOptionsTimeReport | WorkspaceOptionsMemoryReport)) {
+        StringInternerPrintReport(ASTContextGetStringInterner(workspace->context), stdout);
+    }
+}
+
+/// The phase of the span is also recorded as call site of the tracked allocations of the calling thread.
+Index _WorkspaceBeginSpan(WorkspaceRef workspace, const Char *phase, StringRef unitName) {
+    if (workspace->options & WorkspaceOptionsMemoryReport) {
+        TrackingAllocatorSetCallSite(phase);
+    }
+
+    if (!workspace->profiler) {
+        return 0;
+    }
+
+    return ProfilerBeginSpan(workspace->profiler, phase, unitName);
+}
+
+void _WorkspaceEndSpan(WorkspaceRef workspace, Index span) {
+    if (workspace->options & WorkspaceOptionsMemoryReport) {
+        TrackingAllocatorSetCallSite(NULL);
+    }
+
+    if (workspace->profiler) {
+        ProfilerEndSpan(workspace->profiler, span);
+    }
 }
 
 Bool _ArrayContainsString(const void *lhs, const void *rhs) {
     return StringIsEqual(*((StringRef *)lhs), *((StringRef *)rhs));
 }
 
+/// The source is retained until the workspace gets destroyed and registered at the diagnostic engine to resolve the locations of
+/// diagnostics pointing into it.
+void _WorkspaceAddParsedSource(WorkspaceRef workspace, StringRef filePath, SourceBufferRef source) {
+    ArrayAppendElement(workspace->parsedSources, &source);
+    DiagnosticEngineAddSource(workspace->diagnosticEngine, filePath, source);
+}
+
+void _WorkspaceEnqueueFileRequest(WorkspaceRef workspace, ConcurrentQueueRef queue, ASTModuleDeclarationRef module, StringRef filePath) {
+    WorkspaceFileRequest *request = AllocatorAllocate(workspace->allocator, sizeof(WorkspaceFileRequest));
+    request->module               = module;
+    request->filePath             = filePath;
+    request->parseTicket          = 0;
+    ConcurrentQueueEnqueue(queue, request);
+}
+
+Bool _WorkspaceDequeueFileRequest(WorkspaceRef workspace, ConcurrentQueueRef queue, ASTModuleDeclarationRef *module, StringRef *filePath) {
+    WorkspaceFileRequest *request = ConcurrentQueueDequeue(queue);
+    if (!request) {
+        return false;
+    }
+
+    *module   = request->module;
+    *filePath = request->filePath;
+    AllocatorDeallocate(workspace->allocator, request);
+    return true;
+}
+
+/// The files of the parse queue are only enqueued by one thread at a time, either before the workspace has been started or while
+/// holding the `contextMutex`, so the tickets are drawn in the order of the queue. The mutex is only acquired to wake up an idle worker.
+void _WorkspaceEnqueueParseRequest(WorkspaceRef workspace, StringRef filePath) {
+    WorkspaceFileRequest *request = AllocatorAllocate(workspace->allocator, sizeof(WorkspaceFileRequest));
+    request->module               = NULL;
+    request->filePath             = filePath;
+    request->parseTicket          = __atomic_fetch_add(&workspace->parseTicketCount, 1, __ATOMIC_RELAXED);
+    ConcurrentQueueEnqueue(workspace->parseQueue, request);
+
+    // Pairs with the fence in _WorkspaceDequeueParseRequest, either the idle worker sees the request or the request sees the idle worker
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&workspace->idleParserCount, __ATOMIC_RELAXED) > 0) {
+        pthread_mutex_lock(&workspace->mutex);
+        pthread_cond_signal(&workspace->parseQueueCondition);
+        pthread_mutex_unlock(&workspace->mutex);
+    }
+}
+
+/// Returns the next request of the parse queue or NULL if the queue is drained and no other worker is still able to enqueue new files.
+/// A worker only acquires the mutex of the workspace to wait for new files, it stops counting as active while waiting and the last
+/// active worker wakes up all waiting workers once it finds the queue drained.
+WorkspaceFileRequest *_WorkspaceDequeueParseRequest(WorkspaceRef workspace) {
+    WorkspaceFileRequest *request = ConcurrentQueueDequeue(workspace->parseQueue);
+    if (request) {
+        return request;
+    }
+
+    pthread_mutex_lock(&workspace->mutex);
+    __atomic_add_fetch(&workspace->idleParserCount, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    while (true) {
+        request = ConcurrentQueueDequeue(workspace->parseQueue);
+        if (request) {
+            break;
+        }
+
+        if (__atomic_sub_fetch(&workspace->activeParserCount, 1, __ATOMIC_SEQ_CST) == 0) {
+            pthread_cond_broadcast(&workspace->parseQueueCondition);
+            break;
+        }
+
+        pthread_cond_wait(&workspace->parseQueueCondition, &workspace->mutex);
+        __atomic_add_fetch(&workspace->activeParserCount, 1, __ATOMIC_SEQ_CST);
+    }
+
+    __atomic_sub_fetch(&workspace->idleParserCount, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&workspace->mutex);
+    return request;
+}
+
 void _WorkspacePerformLoads(WorkspaceRef workspace, ASTSourceUnitRef sourceUnit) {
     for (Index index = 0; index < ASTArrayGetElementCount(sourceUnit->declarations); index++) {
         ASTNodeRef node = (ASTNodeRef)ASTArrayGetElementAtIndex(sourceUnit->declarations, index);
@@ -194,9 +474,7 @@ void _WorkspacePerformLoads(WorkspaceRef workspace, ASTSourceUnitRef sourceUnit)
                 StringDestroy(absoluteFilePath);
             } else {
                 ArrayAppendElement(workspace->sourceFilePaths, &absoluteFilePath);
-                pthread_mutex_lock(&workspace->mutex);
-                QueueEnqueue(workspace->parseQueue, relativeFilePath);
-                pthread_mutex_unlock(&workspace->mutex);
+                _WorkspaceEnqueueParseRequest(workspace, relativeFilePath);
             }
         }
     }
@@ -228,10 +506,7 @@ void _WorkspacePerformInterfaceLoads(WorkspaceRef workspace, ASTModuleDeclaratio
                 StringDestroy(absoluteFilePath);
             } else {
                 ArrayAppendElement(workspace->sourceFilePaths, &absoluteFilePath);
-                pthread_mutex_lock(&workspace->mutex);
-                QueueEnqueue(workspace->parseInterfaceQueue, module);
-                QueueEnqueue(workspace->parseInterfaceQueue, relativeFilePath);
-                pthread_mutex_unlock(&workspace->mutex);
+                _WorkspaceEnqueueFileRequest(workspace, workspace->parseInterfaceQueue, module, relativeFilePath);
             }
         }
 
@@ -265,10 +540,7 @@ void _WorkspacePerformIncludes(WorkspaceRef workspace, ASTModuleDeclarationRef m
                 StringDestroy(absoluteFilePath);
             } else {
                 ArrayAppendElement(workspace->includeFilePaths, &absoluteFilePath);
-                pthread_mutex_lock(&workspace->mutex);
-                QueueEnqueue(workspace->parseIncludeQueue, module);
-                QueueEnqueue(workspace->parseIncludeQueue, relativeFilePath);
-                pthread_mutex_unlock(&workspace->mutex);
+                _WorkspaceEnqueueFileRequest(workspace, workspace->parseIncludeQueue, module, relativeFilePath);
             }
         }
 
@@ -300,10 +572,7 @@ void _WorkspacePerformImports(WorkspaceRef workspace, ASTModuleDeclarationRef mo
                 StringDestroy(absoluteFilePath);
             } else {
                 ArrayAppendElement(workspace->moduleFilePaths, &absoluteFilePath);
-                pthread_mutex_lock(&workspace->mutex);
-                QueueEnqueue(workspace->importQueue, module);
-                QueueEnqueue(workspace->importQueue, relativeFilePath);
-                pthread_mutex_unlock(&workspace->mutex);
+                _WorkspaceEnqueueFileRequest(workspace, workspace->importQueue, module, relativeFilePath);
             }
         }
 
@@ -312,60 +581,135 @@ void _WorkspacePerformImports(WorkspaceRef workspace, ASTModuleDeclarationRef mo
 }
 
 Bool _WorkspaceProcessParseQueue(WorkspaceRef workspace) {
-    Index processedFileCount = 0;
+    Index processedFileCount      = 0;
+    Index workerCount             = 0;
+    WorkspaceParseWorker *workers = NULL;
+
+    if (workspace->jobCount > 1) {
+        workers = AllocatorAllocate(workspace->allocator, sizeof(WorkspaceParseWorker) * workspace->jobCount);
+        for (Index index = 0; index < workspace->jobCount; index++) {
+            WorkspaceParseWorker *worker = &workers[workerCount];
+            worker->workspace            = workspace;
+            worker->processedFileCount   = 0;
+            if (pthread_create(&worker->thread, NULL, &_WorkspaceParseWorkerProcess, worker) != 0) {
+                break;
+            }
 
+            workerCount += 1;
+        }
+    }
+
+    if (workerCount < 1) {
+        WorkspaceParseWorker worker;
+        worker.workspace          = workspace;
+        worker.processedFileCount = 0;
+        _WorkspaceParseWorkerProcess(&worker);
+        processedFileCount += worker.processedFileCount;
+    }
+
+    for (Index index = 0; index < workerCount; index++) {
+        pthread_join(workers[index].thread, NULL);
+        processedFileCount += workers[index].processedFileCount;
+    }
+
+    if (workers) {
+        AllocatorDeallocate(workspace->allocator, workers);
+    }
+
+    DiagnosticEngineFlush(workspace->diagnosticEngine);
+
+    return processedFileCount > 0;
+}
+
+/// Dequeues source files from the parse queue until the queue is drained and no other worker is still able to enqueue new files.
+/// Each file is parsed concurrently into a separate shard of the ASTContext, merging the shard and performing the resulting load, import
+/// and include requests is serialized by the `contextMutex` of the workspace and happens in the order the files have been enqueued.
+void *_WorkspaceParseWorkerProcess(void *context) {
+    WorkspaceParseWorker *worker       = (WorkspaceParseWorker *)context;
+    WorkspaceRef workspace             = worker->workspace;
+    DiagnosticEngineRef previousEngine = DiagnosticEngineGetCurrent();
+    DiagnosticEngineSetCurrent(workspace->diagnosticEngine);
+
+    __atomic_add_fetch(&workspace->activeParserCount, 1, __ATOMIC_SEQ_CST);
     while (true) {
-        pthread_mutex_lock(&workspace->mutex);
-        StringRef parseFilePath = QueueDequeue(workspace->parseQueue);
-        pthread_mutex_unlock(&workspace->mutex);
+        WorkspaceFileRequest *request = _WorkspaceDequeueParseRequest(workspace);
+        if (!request) {
+            break;
+        }
 
-        if (parseFilePath) {
-            StringRef absoluteFilePath = StringCreateCopy(workspace->allocator, workspace->workingDirectory);
-            StringAppend(absoluteFilePath, "/");
-            StringAppendString(absoluteFilePath, parseFilePath);
-            StringRef source = StringCreateFromFile(workspace->allocator, StringGetCharacters(absoluteFilePath));
-            if (source) {
-                // TODO: The source shouldn't be retained in the compilation process but is currently used for
-                //       and should be remove after implementing a better diagnostic system...
-                ArrayAppendElement(workspace->parsedSources, &source);
-
-                ASTSourceUnitRef sourceUnit = ParserParseSourceUnit(workspace->parser, parseFilePath, source);
-                _WorkspacePerformLoads(workspace, sourceUnit);
-                _WorkspacePerformImports(workspace, ASTContextGetModule(workspace->context), sourceUnit);
-                _WorkspacePerformIncludes(workspace, ASTContextGetModule(workspace->context), sourceUnit);
-            } else {
-                ReportErrorFormat("File not found: '%s'", StringGetCharacters(parseFilePath));
-            }
+        // Files are merged in the order they have been enqueued to keep the AST independent of the worker scheduling
+        StringRef parseFilePath = request->filePath;
+        Index parseTicket       = request->parseTicket;
+        AllocatorDeallocate(workspace->allocator, request);
+
+        // The diagnostics are flushed in the order of the tickets after all workers have finished
+        DiagnosticEngineBeginStaging(workspace->diagnosticEngine, parseTicket);
+
+        StringRef absoluteFilePath = StringCreateCopy(workspace->allocator, workspace->workingDirectory);
+        StringAppend(absoluteFilePath, "/");
+        StringAppendString(absoluteFilePath, parseFilePath);
+        SourceBufferRef source      = SourceBufferCreateFromFile(workspace->allocator, StringGetCharacters(absoluteFilePath));
+        ASTContextRef shard         = NULL;
+        ASTSourceUnitRef sourceUnit = NULL;
+        if (source) {
+            shard            = ASTContextCreateShard(workspace->context);
+            ParserRef parser = ParserCreate(workspace->subsystemAllocators[WorkspaceSubsystemParser],
+                                            workspace->subsystemAllocators[WorkspaceSubsystemLexer], shard);
+            Index span       = _WorkspaceBeginSpan(workspace, "Parse", parseFilePath);
+            sourceUnit       = ParserParseSourceUnit(parser, parseFilePath, source);
+            _WorkspaceEndSpan(workspace, span);
+            ParserDestroy(parser);
+        }
 
-            StringDestroy(absoluteFilePath);
-            StringDestroy(parseFilePath);
+        pthread_mutex_lock(&workspace->contextMutex);
+        while (parseTicket != workspace->nextParseTicket) {
+            pthread_cond_wait(&workspace->parseOrderCondition, &workspace->contextMutex);
+        }
 
-            processedFileCount += 1;
+        if (source) {
+            // The source is retained because the SourceRange(s) of the AST and of diagnostics are pointing into it
+            _WorkspaceAddParsedSource(workspace, parseFilePath, source);
+            ASTContextMergeShard(workspace->context, shard);
+            _WorkspacePerformLoads(workspace, sourceUnit);
+            _WorkspacePerformImports(workspace, ASTContextGetModule(workspace->context), sourceUnit);
+            _WorkspacePerformIncludes(workspace, ASTContextGetModule(workspace->context), sourceUnit);
         } else {
-            break;
+            ReportErrorFormat("File not found: '%s'", StringGetCharacters(parseFilePath));
         }
+
+        workspace->nextParseTicket += 1;
+        pthread_cond_broadcast(&workspace->parseOrderCondition);
+        pthread_mutex_unlock(&workspace->contextMutex);
+
+        DiagnosticEngineEndStaging(workspace->diagnosticEngine);
+
+        StringDestroy(absoluteFilePath);
+        StringDestroy(parseFilePath);
+
+        worker->processedFileCount += 1;
     }
 
-    return processedFileCount > 0;
+    DiagnosticEngineSetCurrent(previousEngine);
+    return NULL;
 }
 
 Bool _WorkspaceProcessImportQueue(WorkspaceRef workspace) {
     Index processedFileCount = 0;
 
     while (true) {
-        pthread_mutex_lock(&workspace->mutex);
-        ASTModuleDeclarationRef module = QueueDequeue(workspace->importQueue);
-        StringRef importFilePath       = QueueDequeue(workspace->importQueue);
-        pthread_mutex_unlock(&workspace->mutex);
-
-        if (importFilePath) {
+        ASTModuleDeclarationRef module = NULL;
+        StringRef importFilePath       = NULL;
+        if (_WorkspaceDequeueFileRequest(workspace, workspace->importQueue, &module, &importFilePath)) {
             StringRef absoluteFilePath = StringCreateCopy(workspace->allocator, workspace->workingDirectory);
             StringAppend(absoluteFilePath, "/");
             StringAppendString(absoluteFilePath, importFilePath);
-            StringRef source = StringCreateFromFile(workspace->allocator, StringGetCharacters(absoluteFilePath));
+            SourceBufferRef source = SourceBufferCreateFromFile(workspace->allocator, StringGetCharacters(absoluteFilePath));
             if (source) {
+                _WorkspaceAddParsedSource(workspace, importFilePath, source);
+
+                Index span                             = _WorkspaceBeginSpan(workspace, "Parse", importFilePath);
                 ASTModuleDeclarationRef importedModule = ParserParseModuleDeclaration(workspace->parser, importFilePath, source);
-                StringDestroy(source);
+                _WorkspaceEndSpan(workspace, span);
 
                 if (importedModule) {
                     if (DictionaryLookup(workspace->modules, StringGetCharacters(importedModule->base.name)) != NULL) {
@@ -374,7 +718,9 @@ Bool _WorkspaceProcessImportQueue(WorkspaceRef workspace) {
 
                     assert(ASTArrayGetElementCount(importedModule->sourceUnits) == 1);
                     ASTSourceUnitRef sourceUnit = ASTArrayGetElementAtIndex(importedModule->sourceUnits, 0);
-                    _WorkspacePerformInterfaceLoads(workspace, importedModule, sourceUnit);
+                    if (!_WorkspaceLoadModuleInterface(workspace, importedModule, importFilePath)) {
+                        _WorkspacePerformInterfaceLoads(workspace, importedModule, sourceUnit);
+                    }
                     ASTArrayAppendElement(module->importedModules, importedModule);
                     DictionaryInsert(workspace->modules, StringGetCharacters(importedModule->base.name), &importedModule,
                                      sizeof(ASTModuleDeclarationRef));
@@ -395,24 +741,73 @@ Bool _WorkspaceProcessImportQueue(WorkspaceRef workspace) {
     return processedFileCount > 0;
 }
 
+/// Loads the declarations of the imported `module` from the `.jmod` file emitted by a previous build instead of parsing the files loaded
+/// by the module. The interface is only used if it has been emitted from the same sources with the same options and if the object file
+/// of the module is still valid in the build cache, the module is marked as precompiled and is linked without being built again.
+Bool _WorkspaceLoadModuleInterface(WorkspaceRef workspace, ASTModuleDeclarationRef module, StringRef importFilePath) {
+    if (workspace->options & (WorkspaceOptionsNoCache | WorkspaceOptionsDumpIR)) {
+        return false;
+    }
+
+    StringRef filePath = StringCreateCopy(workspace->allocator, workspace->buildDirectory);
+    StringAppendFormat(filePath, "/%s.jmod", StringGetCharacters(module->base.name));
+    ModuleInterfaceRef interface = ModuleInterfaceCreateFromFile(workspace->allocator, StringGetCharacters(filePath));
+    StringDestroy(filePath);
+    if (!interface) {
+        return false;
+    }
+
+    Bool isValid = StringIsEqualToCString(importFilePath, ModuleInterfaceGetSourceUnitFilePath(interface, 0));
+    if (isValid) {
+        UInt64 fingerprint = _WorkspaceGetFingerprintSeed(workspace, module->base.name);
+        for (Index index = 0; index < ModuleInterfaceGetSourceUnitCount(interface); index++) {
+            StringRef sourceFilePath = StringCreate(workspace->allocator, ModuleInterfaceGetSourceUnitFilePath(interface, index));
+            fingerprint              = _WorkspaceHashSourceFile(workspace, fingerprint, sourceFilePath);
+            StringDestroy(sourceFilePath);
+        }
+
+        BuildCacheRef cache = BuildCacheCreate(workspace->allocator, workspace->buildDirectory);
+        isValid = fingerprint == ModuleInterfaceGetFingerprint(interface) && BuildCacheLookupModule(cache, module->base.name, fingerprint);
+        BuildCacheDestroy(cache);
+    }
+
+    if (isValid) {
+        Index span = _WorkspaceBeginSpan(workspace, "LoadInterface", module->base.name);
+        ModuleInterfaceLoadDeclarations(interface, workspace->context, module);
+        _WorkspaceEndSpan(workspace, span);
+
+        // The loaded files are registered as if they had been parsed to keep the detection of duplicate loads consistent
+        for (Index index = 1; index < ModuleInterfaceGetSourceUnitCount(interface); index++) {
+            StringRef absoluteFilePath = StringCreateCopy(workspace->allocator, workspace->workingDirectory);
+            StringAppendFormat(absoluteFilePath, "/%s", ModuleInterfaceGetSourceUnitFilePath(interface, index));
+            ArrayAppendElement(workspace->sourceFilePaths, &absoluteFilePath);
+        }
+
+        module->base.base.flags |= ASTFlagsModuleIsPrecompiled;
+    }
+
+    ModuleInterfaceDestroy(interface);
+    return isValid;
+}
+
 Bool _WorkspaceProcessParseInterfaceQueue(WorkspaceRef workspace) {
     Index processedFileCount = 0;
 
     while (true) {
-        pthread_mutex_lock(&workspace->mutex);
-        ASTModuleDeclarationRef importedModule = QueueDequeue(workspace->parseInterfaceQueue);
-        StringRef parseInterfaceFilePath       = QueueDequeue(workspace->parseInterfaceQueue);
-        pthread_mutex_unlock(&workspace->mutex);
-
-        if (importedModule && parseInterfaceFilePath) {
+        ASTModuleDeclarationRef importedModule = NULL;
+        StringRef parseInterfaceFilePath       = NULL;
+        if (_WorkspaceDequeueFileRequest(workspace, workspace->parseInterfaceQueue, &importedModule, &parseInterfaceFilePath)) {
             StringRef absoluteFilePath = StringCreateCopy(workspace->allocator, workspace->workingDirectory);
             StringAppend(absoluteFilePath, "/");
             StringAppendString(absoluteFilePath, parseInterfaceFilePath);
-            StringRef source = StringCreateFromFile(workspace->allocator, StringGetCharacters(absoluteFilePath));
+            SourceBufferRef source = SourceBufferCreateFromFile(workspace->allocator, StringGetCharacters(absoluteFilePath));
             if (source) {
+                _WorkspaceAddParsedSource(workspace, parseInterfaceFilePath, source);
+
+                Index span                  = _WorkspaceBeginSpan(workspace, "Parse", parseInterfaceFilePath);
                 ASTSourceUnitRef sourceUnit = ParserParseModuleSourceUnit(workspace->parser, importedModule, parseInterfaceFilePath,
                                                                           source);
-                StringDestroy(source);
+                _WorkspaceEndSpan(workspace, span);
                 _WorkspacePerformInterfaceLoads(workspace, importedModule, sourceUnit);
             } else {
                 ReportErrorFormat("File not found: '%s'", StringGetCharacters(parseInterfaceFilePath));
@@ -434,17 +829,16 @@ Bool _WorkspaceProcessParseIncludeQueue(WorkspaceRef workspace) {
     Index processedFileCount = 0;
 
     while (true) {
-        pthread_mutex_lock(&workspace->mutex);
-        ASTModuleDeclarationRef module = QueueDequeue(workspace->parseIncludeQueue);
-        StringRef parseIncludeFilePath = QueueDequeue(workspace->parseIncludeQueue);
-        pthread_mutex_unlock(&workspace->mutex);
-
-        if (module && parseIncludeFilePath) {
+        ASTModuleDeclarationRef module = NULL;
+        StringRef parseIncludeFilePath = NULL;
+        if (_WorkspaceDequeueFileRequest(workspace, workspace->parseIncludeQueue, &module, &parseIncludeFilePath)) {
             StringRef absoluteFilePath = StringCreateCopy(workspace->allocator, workspace->workingDirectory);
             StringAppend(absoluteFilePath, "/");
             StringAppendString(absoluteFilePath, parseIncludeFilePath);
 
+            Index span                             = _WorkspaceBeginSpan(workspace, "ClangImport", parseIncludeFilePath);
             ASTModuleDeclarationRef importedModule = ClangImporterImport(workspace->importer, absoluteFilePath);
+            _WorkspaceEndSpan(workspace, span);
             if (importedModule) {
                 if (DictionaryLookup(workspace->modules, StringGetCharacters(importedModule->base.name)) != NULL) {
                     ReportErrorFormat("Module '%s' cannot be imported twice", StringGetCharacters(importedModule->base.name));
@@ -468,24 +862,41 @@ Bool _WorkspaceProcessParseIncludeQueue(WorkspaceRef workspace) {
 }
 
 void _WorkspaceVerifyModule(WorkspaceRef workspace, ASTModuleDeclarationRef module) {
+    Index span = _WorkspaceBeginSpan(workspace, "Substitution", module->base.name);
     ASTApplySubstitution(workspace->context, module);
+    _WorkspaceEndSpan(workspace, span);
 
+    span = _WorkspaceBeginSpan(workspace, "NameResolution", module->base.name);
     PerformNameResolution(workspace->context, module);
+    _WorkspaceEndSpan(workspace, span);
 
+    span                       = _WorkspaceBeginSpan(workspace, "TypeCheck", module->base.name);
     TypeCheckerRef typeChecker = TypeCheckerCreate(workspace->allocator);
     TypeCheckerValidateModule(typeChecker, workspace->context, module);
     TypeCheckerDestroy(typeChecker);
+    _WorkspaceEndSpan(workspace, span);
 }
 
-void _WorkspaceBuildModule(WorkspaceRef workspace, ASTModuleDeclarationRef module) {
-    PerformNameMangling(workspace->context, module);
-
-    if (module->kind == ASTModuleKindInterface) {
+void _WorkspaceBuildModule(WorkspaceRef workspace, AllocatorRef allocator, ASTModuleDeclarationRef module) {
+    if (module->kind == ASTModuleKindInterface || (module->base.base.flags & ASTFlagsModuleIsPrecompiled)) {
         return;
     }
 
-    IRBuilderRef builder = IRBuilderCreate(workspace->allocator, workspace->context, workspace->buildDirectory);
+    IRBuilderRef builder = IRBuilderCreate(allocator, workspace->context, workspace->buildDirectory);
+    IRBuilderSetTargetTriple(builder, workspace->targetTriple);
+    if (workspace->options & WorkspaceOptionsOptimizeLess) {
+        IRBuilderSetOptimizationLevel(builder, IROptimizationLevelLess);
+    } else if (workspace->options & WorkspaceOptionsOptimizeDefault) {
+        IRBuilderSetOptimizationLevel(builder, IROptimizationLevelDefault);
+    } else if (workspace->options & WorkspaceOptionsOptimizeAggressive) {
+        IRBuilderSetOptimizationLevel(builder, IROptimizationLevelAggressive);
+    } else if (workspace->options & WorkspaceOptionsOptimizeSize) {
+        IRBuilderSetOptimizationLevel(builder, IROptimizationLevelSize);
+    }
+
+    Index span           = _WorkspaceBeginSpan(workspace, "IRGen", module->base.name);
     IRModuleRef irModule = IRBuilderBuild(builder, module);
+    _WorkspaceEndSpan(workspace, span);
 
     if ((workspace->options & WorkspaceOptionsDumpIR) > 0) {
         IRBuilderDumpModule(builder, irModule, stdout);
@@ -493,17 +904,234 @@ void _WorkspaceBuildModule(WorkspaceRef workspace, ASTModuleDeclarationRef modul
         return;
     }
 
+    span = _WorkspaceBeginSpan(workspace, "Verify", module->base.name);
     IRBuilderVerifyModule(builder, irModule);
+    _WorkspaceEndSpan(workspace, span);
 
-    if (DiagnosticEngineGetMessageCount(DiagnosticLevelError) > 0 || DiagnosticEngineGetMessageCount(DiagnosticLevelCritical) > 0) {
+    if (DiagnosticEngineHasErrors(workspace->diagnosticEngine)) {
         IRBuilderDestroy(builder);
         return;
     }
 
+    // Emitting the object file also runs the optimization pipeline of the IRBuilder
+    span = _WorkspaceBeginSpan(workspace, "Emit", module->base.name);
     IRBuilderEmitObjectFile(builder, irModule, module->base.name);
+    _WorkspaceEndSpan(workspace, span);
     IRBuilderDestroy(builder);
 }
 
+UInt64 _WorkspaceGetFingerprintSeed(WorkspaceRef workspace, StringRef moduleName) {
+    WorkspaceOptions options = WorkspaceOptionsGetFingerprintOptions(workspace->options);
+    UInt64 fingerprint       = BuildCacheHash(kBuildCacheHashSeed, &options, sizeof(options));
+    fingerprint              = BuildCacheHash(fingerprint, StringGetCharacters(moduleName), StringGetLength(moduleName));
+    if (workspace->targetTriple) {
+        fingerprint = BuildCacheHash(fingerprint, StringGetCharacters(workspace->targetTriple), StringGetLength(workspace->targetTriple));
+    }
+
+    return fingerprint;
+}
+
+UInt64 _WorkspaceHashSourceFile(WorkspaceRef workspace, UInt64 fingerprint, StringRef filePath) {
+    fingerprint = BuildCacheHash(fingerprint, StringGetCharacters(filePath), StringGetLength(filePath));
+
+    StringRef absoluteFilePath = NULL;
+    if (StringGetCharacters(filePath)[0] == '/') {
+        absoluteFilePath = StringCreateCopy(workspace->allocator, filePath);
+    } else {
+        absoluteFilePath = StringCreateCopy(workspace->allocator, workspace->workingDirectory);
+        StringAppend(absoluteFilePath, "/");
+        StringAppendString(absoluteFilePath, filePath);
+    }
+
+    SourceBufferRef source = SourceBufferCreateFromFile(workspace->allocator, StringGetCharacters(absoluteFilePath));
+    if (source) {
+        fingerprint = BuildCacheHash(fingerprint, SourceBufferGetCharacters(source), SourceBufferGetLength(source));
+        SourceBufferDestroy(source);
+    }
+
+    StringDestroy(absoluteFilePath);
+    return fingerprint;
+}
+
+/// Hashes the compiler options, the target triple, the contents of all source units of the module and the fingerprints of the imported
+/// modules, so that a change anywhere in the `#load` / `#import` closure of the module results in a different fingerprint.
+UInt64 _WorkspaceGetModuleFingerprint(WorkspaceRef workspace, DictionaryRef fingerprints, ASTModuleDeclarationRef module) {
+    const UInt64 *cachedFingerprint = (const UInt64 *)DictionaryLookup(fingerprints, StringGetCharacters(module->base.name));
+    if (cachedFingerprint) {
+        return *cachedFingerprint;
+    }
+
+    UInt64 fingerprint           = _WorkspaceGetFingerprintSeed(workspace, module->base.name);
+    ASTArrayIteratorRef iterator = ASTArrayGetIterator(module->sourceUnits);
+    while (iterator) {
+        ASTSourceUnitRef sourceUnit = (ASTSourceUnitRef)ASTArrayIteratorGetElement(iterator);
+        fingerprint                 = _WorkspaceHashSourceFile(workspace, fingerprint, sourceUnit->filePath);
+        iterator                    = ASTArrayIteratorNext(iterator);
+    }
+
+    iterator = ASTArrayGetIterator(module->importedModules);
+    while (iterator) {
+        ASTModuleDeclarationRef importedModule = (ASTModuleDeclarationRef)ASTArrayIteratorGetElement(iterator);
+        UInt64 importedFingerprint             = _WorkspaceGetModuleFingerprint(workspace, fingerprints, importedModule);
+        fingerprint                            = BuildCacheHash(fingerprint, &importedFingerprint, sizeof(importedFingerprint));
+        iterator                               = ASTArrayIteratorNext(iterator);
+    }
+
+    DictionaryInsert(fingerprints, StringGetCharacters(module->base.name), &fingerprint, sizeof(fingerprint));
+    return fingerprint;
+}
+
+/// Builds the IR of all modules, verifies it and emits the object files. Each IRBuilder owns its LLVMContextRef and keeps the IR of the
+/// AST nodes in its own tables, so after all names are mangled the modules are independent of each other and are processed by a pool
+/// of `jobCount` workers. Dumping the IR is done on the calling thread to keep the output in the topological order of the modules.
+/// Modules whose fingerprint matches the build cache reuse the object file of the previous build, the interfaces of all library modules are
+/// emitted next to their object files to be loaded by `_WorkspaceLoadModuleInterface` in subsequent builds.
+void _WorkspaceBuildModules(WorkspaceRef workspace, ArrayRef modules) {
+    for (Index index = 0; index < ArrayGetElementCount(modules); index++) {
+        ASTModuleDeclarationRef module = *((ASTModuleDeclarationRef *)ArrayGetElementAtIndex(modules, index));
+        Index span                     = _WorkspaceBeginSpan(workspace, "NameMangling", module->base.name);
+        PerformNameMangling(workspace->context, module);
+        _WorkspaceEndSpan(workspace, span);
+    }
+
+    BuildCacheRef cache        = NULL;
+    DictionaryRef fingerprints = NULL;
+    if (!(workspace->options & (WorkspaceOptionsNoCache | WorkspaceOptionsDumpIR))) {
+        cache        = BuildCacheCreate(workspace->allocator, workspace->buildDirectory);
+        fingerprints = CStringDictionaryCreate(workspace->allocator, 8);
+    }
+
+    ArrayRef buildModules = ArrayCreateEmpty(workspace->allocator, sizeof(ASTModuleDeclarationRef), ArrayGetElementCount(modules));
+    for (Index index = 0; index < ArrayGetElementCount(modules); index++) {
+        ASTModuleDeclarationRef module = *((ASTModuleDeclarationRef *)ArrayGetElementAtIndex(modules, index));
+        if (module->base.base.flags & ASTFlagsModuleIsPrecompiled) {
+            continue;
+        }
+
+        if (cache && module->kind != ASTModuleKindInterface) {
+            UInt64 fingerprint = _WorkspaceGetModuleFingerprint(workspace, fingerprints, module);
+            if (BuildCacheLookupModule(cache, module->base.name, fingerprint)) {
+                continue;
+            }
+
+            BuildCacheRemoveModule(cache, module->base.name);
+        }
+
+        ArrayAppendElement(buildModules, &module);
+    }
+
+    workspace->nextBuildModuleIndex = 0;
+
+    Index workerCount             = 0;
+    WorkspaceBuildWorker *workers = NULL;
+    Index maxWorkerCount          = MIN(workspace->jobCount, ArrayGetElementCount(buildModules));
+    if (maxWorkerCount > 1 && !(workspace->options & WorkspaceOptionsDumpIR)) {
+        workers = AllocatorAllocate(workspace->allocator, sizeof(WorkspaceBuildWorker) * maxWorkerCount);
+        for (Index index = 0; index < maxWorkerCount; index++) {
+            WorkspaceBuildWorker *worker = &workers[workerCount];
+            worker->workspace            = workspace;
+            worker->allocator            = TempAllocatorCreate(workspace->subsystemAllocators[WorkspaceSubsystemIRBuilder]);
+            worker->modules              = buildModules;
+            if (pthread_create(&worker->thread, NULL, &_WorkspaceBuildWorkerProcess, worker) != 0) {
+                AllocatorDestroy(worker->allocator);
+                break;
+            }
+
+            workerCount += 1;
+        }
+    }
+
+    if (workerCount < 1) {
+        WorkspaceBuildWorker worker;
+        worker.workspace = workspace;
+        worker.allocator = TempAllocatorCreate(workspace->subsystemAllocators[WorkspaceSubsystemIRBuilder]);
+        worker.modules   = buildModules;
+        _WorkspaceBuildWorkerProcess(&worker);
+        AllocatorDestroy(worker.allocator);
+    }
+
+    for (Index index = 0; index < workerCount; index++) {
+        pthread_join(workers[index].thread, NULL);
+        AllocatorDestroy(workers[index].allocator);
+    }
+
+    if (workers) {
+        AllocatorDeallocate(workspace->allocator, workers);
+    }
+
+    DiagnosticEngineFlush(workspace->diagnosticEngine);
+
+    if (cache) {
+        if (!DiagnosticEngineHasErrors(workspace->diagnosticEngine)) {
+            for (Index index = 0; index < ArrayGetElementCount(buildModules); index++) {
+                ASTModuleDeclarationRef module = *((ASTModuleDeclarationRef *)ArrayGetElementAtIndex(buildModules, index));
+                if (module->kind != ASTModuleKindInterface) {
+                    UInt64 fingerprint = _WorkspaceGetModuleFingerprint(workspace, fingerprints, module);
+                    BuildCacheInsertModule(cache, module->base.name, fingerprint);
+                }
+            }
+
+            for (Index index = 0; index < ArrayGetElementCount(modules); index++) {
+                ASTModuleDeclarationRef module = *((ASTModuleDeclarationRef *)ArrayGetElementAtIndex(modules, index));
+                if (module->kind == ASTModuleKindLibrary && !(module->base.base.flags & ASTFlagsModuleIsPrecompiled)) {
+                    UInt64 fingerprint = _WorkspaceGetModuleFingerprint(workspace, fingerprints, module);
+                    StringRef filePath = StringCreateCopy(workspace->allocator, workspace->buildDirectory);
+                    StringAppendFormat(filePath, "/%s.jmod", StringGetCharacters(module->base.name));
+                    ModuleInterfaceWrite(workspace->allocator, module, fingerprint, filePath);
+                    StringDestroy(filePath);
+                }
+            }
+        }
+
+        if (!BuildCacheWrite(cache)) {
+            ReportWarningFormat("Couldn't write build cache into build directory at path: '%s'",
+                                StringGetCharacters(workspace->buildDirectory));
+        }
+
+        if (workspace->options & WorkspaceOptionsCacheReport) {
+            BuildCacheStatistics statistics = BuildCacheGetStatistics(cache);
+            ReportInfoFormat("Build cache: %zu hit(s), %zu miss(es)", statistics.hitCount, statistics.missCount);
+        }
+
+        DictionaryDestroy(fingerprints);
+        BuildCacheDestroy(cache);
+    }
+
+    ArrayDestroy(buildModules);
+}
+
+/// The allocator of the worker is owned by the thread spawning the worker and is handed over to the worker until it gets joined, it is
+/// installed as the current default of the worker thread for the duration of the build. The diagnostics of each module are staged and
+/// flushed in the order of the modules after all workers have been joined, so that the output doesn't depend on the worker scheduling.
+void *_WorkspaceBuildWorkerProcess(void *context) {
+    WorkspaceBuildWorker *worker       = (WorkspaceBuildWorker *)context;
+    WorkspaceRef workspace             = worker->workspace;
+    AllocatorRef previousDefault       = AllocatorGetCurrentDefault();
+    DiagnosticEngineRef previousEngine = DiagnosticEngineGetCurrent();
+    AllocatorSetCurrentDefault(worker->allocator);
+    DiagnosticEngineSetCurrent(workspace->diagnosticEngine);
+
+    while (true) {
+        pthread_mutex_lock(&workspace->mutex);
+        Index moduleIndex = workspace->nextBuildModuleIndex;
+        workspace->nextBuildModuleIndex += 1;
+        pthread_mutex_unlock(&workspace->mutex);
+
+        if (moduleIndex >= ArrayGetElementCount(worker->modules)) {
+            break;
+        }
+
+        ASTModuleDeclarationRef module = *((ASTModuleDeclarationRef *)ArrayGetElementAtIndex(worker->modules, moduleIndex));
+        DiagnosticEngineBeginStaging(workspace->diagnosticEngine, moduleIndex);
+        _WorkspaceBuildModule(workspace, worker->allocator, module);
+        DiagnosticEngineEndStaging(workspace->diagnosticEngine);
+    }
+
+    DiagnosticEngineSetCurrent(previousEngine);
+    AllocatorSetCurrentDefault(previousDefault);
+    return NULL;
+}
+
 DependencyGraphNodeRef _DependencyGraphInsertModule(DependencyGraphRef graph, ASTModuleDeclarationRef module) {
     if (StringGetLength(module->base.name) < 1) {
         return NULL;
@@ -533,7 +1161,14 @@ DependencyGraphNodeRef _DependencyGraphInsertModule(DependencyGraphRef graph, AS
 
 void *_WorkspaceProcess(void *context) {
     WorkspaceRef workspace = (WorkspaceRef)context;
+    DiagnosticEngineSetCurrent(workspace->diagnosticEngine);
+    _WorkspaceRunPipeline(workspace);
+    DiagnosticEngineFlush(workspace->diagnosticEngine);
+    DiagnosticEngineSetCurrent(NULL);
+    return NULL;
+}
 
+void _WorkspaceRunPipeline(WorkspaceRef workspace) {
     // Parse / Import phase
     Bool processFrontend = true;
     while (processFrontend) {
@@ -551,11 +1186,11 @@ void *_WorkspaceProcess(void *context) {
         // TODO: Verify if early return is correct behaviour here...
         //       currently we are exiting at this point because we have parsed the full AST here,
         //       but it could be that code can be generated soon
-        return NULL;
+        return;
     }
 
-    if (DiagnosticEngineGetMessageCount(DiagnosticLevelError) > 0 || DiagnosticEngineGetMessageCount(DiagnosticLevelCritical) > 0) {
-        return NULL;
+    if (DiagnosticEngineHasErrors(workspace->diagnosticEngine)) {
+        return;
     }
 
     ASTModuleDeclarationRef astModule = ASTContextGetModule(workspace->context);
@@ -566,7 +1201,7 @@ void *_WorkspaceProcess(void *context) {
     if (hasCyclicDependencies) {
         ReportError("Found cyclic dependencies in imported modules!");
         ArrayDestroy(sortedModuleNames);
-        return NULL;
+        return;
     }
 
     ArrayRef sortedModules = ArrayCreateEmpty(workspace->allocator, sizeof(ASTModuleDeclarationRef),
@@ -585,22 +1220,24 @@ void *_WorkspaceProcess(void *context) {
     ArrayDestroy(sortedModuleNames);
     DependencyGraphDestroy(graph);
 
+    Index span = _WorkspaceBeginSpan(workspace, "Substitution", NULL);
     ASTPerformSubstitution(workspace->context, ASTTagUnaryExpression, &ASTUnaryExpressionUnification);
     ASTPerformSubstitution(workspace->context, ASTTagBinaryExpression, &ASTBinaryExpressionUnification);
+    _WorkspaceEndSpan(workspace, span);
 
     for (Index index = 0; index < ArrayGetElementCount(sortedModules); index++) {
         ASTModuleDeclarationRef module = *((ASTModuleDeclarationRef *)ArrayGetElementAtIndex(sortedModules, index));
         _WorkspaceVerifyModule(workspace, module);
     }
 
-    if (DiagnosticEngineGetMessageCount(DiagnosticLevelError) > 0 || DiagnosticEngineGetMessageCount(DiagnosticLevelCritical) > 0) {
+    if (DiagnosticEngineHasErrors(workspace->diagnosticEngine)) {
         ArrayDestroy(sortedModules);
-        return NULL;
+        return;
     }
 
     if (workspace->options & WorkspaceOptionsTypeCheck) {
         ArrayDestroy(sortedModules);
-        return NULL;
+        return;
     }
 
     DIR *buildDirectory = opendir(StringGetCharacters(workspace->buildDirectory));
@@ -612,19 +1249,16 @@ void *_WorkspaceProcess(void *context) {
         closedir(buildDirectory);
     }
 
-    for (Index index = 0; index < ArrayGetElementCount(sortedModules); index++) {
-        ASTModuleDeclarationRef module = *((ASTModuleDeclarationRef *)ArrayGetElementAtIndex(sortedModules, index));
-        _WorkspaceBuildModule(workspace, module);
-    }
+    _WorkspaceBuildModules(workspace, sortedModules);
 
-    if (DiagnosticEngineGetMessageCount(DiagnosticLevelError) > 0 || DiagnosticEngineGetMessageCount(DiagnosticLevelCritical) > 0) {
+    if (DiagnosticEngineHasErrors(workspace->diagnosticEngine)) {
         ArrayDestroy(sortedModules);
-        return NULL;
+        return;
     }
 
     if ((workspace->options & WorkspaceOptionsDumpIR) > 0) {
         ArrayDestroy(sortedModules);
-        return NULL;
+        return;
     }
 
     ArrayRef objectFiles = ArrayCreateEmpty(workspace->allocator, sizeof(StringRef), 1);
@@ -656,7 +1290,9 @@ void *_WorkspaceProcess(void *context) {
         }
 
         if (module->kind == ASTModuleKindExecutable) {
+            span = _WorkspaceBeginSpan(workspace, "Link", module->base.name);
             LDLinkerLink(workspace->allocator, objectFiles, linkLibraries, linkFrameworks, targetPath, LDLinkerTargetTypeExecutable, NULL);
+            _WorkspaceEndSpan(workspace, span);
         }
 
         ArrayDestroy(linkLibraries);
@@ -671,5 +1307,4 @@ void *_WorkspaceProcess(void *context) {
 
     ArrayDestroy(objectFiles);
     ArrayDestroy(sortedModules);
-    return NULL;
 }
@@ -45,7 +45,7 @@ struct FileTest {
 
 JELLY_EXTERN_C_BEGIN
 
-void FileTestDiagnosticHandler(DiagnosticLevel level, const Char *message, void *context);
+void FileTestDiagnosticHandler(const Diagnostic *diagnostic, void *context);
 
 JELLY_EXTERN_C_END
 
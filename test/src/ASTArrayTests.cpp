@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+class ASTArrayTest : public testing::Test {
+protected:
+    StringRef moduleName;
+    ASTContextRef context;
+    ASTArrayRef array;
+    Index values[1024];
+
+    void SetUp() override {
+        moduleName = StringCreate(AllocatorGetSystemDefault(), "Test");
+        context    = ASTContextCreate(AllocatorGetSystemDefault(), AllocatorGetSystemDefault(), moduleName);
+        array      = ASTContextCreateArray(context, SourceRangeNull(), kScopeNull);
+        for (Index index = 0; index < 1024; index++) {
+            values[index] = index;
+        }
+    }
+
+    void TearDown() override {
+        ASTContextDestroy(context);
+        StringDestroy(moduleName);
+    }
+
+    Index GetValueAtIndex(Index index) {
+        return *(Index *)ASTArrayGetElementAtIndex(array, index);
+    }
+};
+
+TEST_F(ASTArrayTest, AppendsElementsInOrder) {
+    EXPECT_EQ(ASTArrayGetElementCount(array), 0);
+    EXPECT_EQ(ASTArrayGetIterator(array), nullptr);
+
+    for (Index index = 0; index < 3; index++) {
+        ASTArrayAppendElement(array, &values[index]);
+    }
+
+    ASSERT_EQ(ASTArrayGetElementCount(array), 3);
+    for (Index index = 0; index < 3; index++) {
+        EXPECT_EQ(ASTArrayGetElementAtIndex(array, index), &values[index]);
+    }
+}
+
+TEST_F(ASTArrayTest, KeepsElementsWhenGrowing) {
+    for (Index index = 0; index < 1024; index++) {
+        ASTArrayAppendElement(array, &values[index]);
+        ASSERT_EQ(ASTArrayGetElementCount(array), index + 1);
+    }
+
+    for (Index index = 0; index < 1024; index++) {
+        EXPECT_EQ(GetValueAtIndex(index), index);
+    }
+
+    Index expected = 0;
+    for (ASTArrayIteratorRef iterator = ASTArrayGetIterator(array); iterator; iterator = ASTArrayIteratorNext(iterator)) {
+        EXPECT_EQ(*(Index *)ASTArrayIteratorGetElement(iterator), expected);
+        expected += 1;
+    }
+
+    EXPECT_EQ(expected, 1024);
+}
+
+TEST_F(ASTArrayTest, InsertsElementsAtFrontMiddleAndEnd) {
+    ASTArrayInsertElementAtIndex(array, 0, &values[2]);
+    ASTArrayInsertElementAtIndex(array, 0, &values[0]);
+    ASTArrayInsertElementAtIndex(array, 1, &values[1]);
+    ASTArrayInsertElementAtIndex(array, 3, &values[4]);
+    ASTArrayInsertElementAtIndex(array, 3, &values[3]);
+
+    ASSERT_EQ(ASTArrayGetElementCount(array), 5);
+    for (Index index = 0; index < 5; index++) {
+        EXPECT_EQ(GetValueAtIndex(index), index);
+    }
+
+    for (Index index = 5; index < 1024; index++) {
+        ASTArrayInsertElementAtIndex(array, ASTArrayGetElementCount(array), &values[index]);
+    }
+
+    ASSERT_EQ(ASTArrayGetElementCount(array), 1024);
+    for (Index index = 0; index < 1024; index++) {
+        EXPECT_EQ(GetValueAtIndex(index), index);
+    }
+}
+
+TEST_F(ASTArrayTest, RemovesElementsAtFrontMiddleAndEnd) {
+    for (Index index = 0; index < 8; index++) {
+        ASTArrayAppendElement(array, &values[index]);
+    }
+
+    ASTArrayRemoveElementAtIndex(array, 0);
+    ASTArrayRemoveElementAtIndex(array, 3);
+    ASTArrayRemoveElementAtIndex(array, ASTArrayGetElementCount(array) - 1);
+
+    Index expected[] = {1, 2, 3, 5, 6};
+    ASSERT_EQ(ASTArrayGetElementCount(array), 5);
+    for (Index index = 0; index < 5; index++) {
+        EXPECT_EQ(GetValueAtIndex(index), expected[index]);
+    }
+
+    ASTArrayRemoveAllElements(array);
+    EXPECT_EQ(ASTArrayGetElementCount(array), 0);
+    EXPECT_EQ(ASTArrayGetIterator(array), nullptr);
+
+    ASTArrayAppendElement(array, &values[7]);
+    ASSERT_EQ(ASTArrayGetElementCount(array), 1);
+    EXPECT_EQ(GetValueAtIndex(0), 7);
+}
+
+TEST_F(ASTArrayTest, SetsElementsThroughIterator) {
+    for (Index index = 0; index < 16; index++) {
+        ASTArrayAppendElement(array, &values[index]);
+    }
+
+    for (ASTArrayIteratorRef iterator = ASTArrayGetIterator(array); iterator; iterator = ASTArrayIteratorNext(iterator)) {
+        Index value = *(Index *)ASTArrayIteratorGetElement(iterator);
+        ASTArrayIteratorSetElement(iterator, &values[value * 2]);
+    }
+
+    for (Index index = 0; index < 16; index++) {
+        EXPECT_EQ(GetValueAtIndex(index), index * 2);
+    }
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(ASTContext, NodeHeaderIsCompact) {
+    EXPECT_EQ(sizeof(struct _ASTNode), 16);
+}
+
+TEST(ASTContext, ResolvesNodeLocationsInMultipleSources) {
+    AllocatorRef allocator  = AllocatorGetSystemDefault();
+    StringRef moduleName    = StringCreate(allocator, "Test");
+    StringRef firstString   = StringCreate(allocator, "var first: Int = 1\n");
+    StringRef secondString  = StringCreate(allocator, "var second: Int = 2\n");
+    SourceBufferRef first   = SourceBufferCreateFromString(allocator, firstString);
+    SourceBufferRef second  = SourceBufferCreateFromString(allocator, secondString);
+    ASTContextRef context   = ASTContextCreate(allocator, allocator, moduleName);
+    const Char *firstStart  = SourceBufferGetCharacters(first);
+    const Char *secondStart = SourceBufferGetCharacters(second);
+
+    ASTContextAddSource(context, first);
+    ASTNodeRef firstNode = (ASTNodeRef)ASTContextCreateConstantIntExpression(context, SourceRangeMake(firstStart + 17, firstStart + 18),
+                                                                             kScopeNull, 1);
+    ASTContextAddSource(context, second);
+    ASTNodeRef secondNode = (ASTNodeRef)ASTContextCreateConstantIntExpression(context, SourceRangeMake(secondStart + 4, secondStart + 10),
+                                                                              kScopeNull, 2);
+    ASTNodeRef nullNode   = (ASTNodeRef)ASTContextCreateConstantIntExpression(context, SourceRangeNull(), kScopeNull, 3);
+
+    SourceRange location = ASTContextGetNodeLocation(context, firstNode);
+    EXPECT_EQ(location.start, firstStart + 17);
+    EXPECT_EQ(location.end, firstStart + 18);
+
+    location = ASTContextGetNodeLocation(context, secondNode);
+    EXPECT_EQ(location.start, secondStart + 4);
+    EXPECT_EQ(location.end, secondStart + 10);
+
+    location = ASTContextGetNodeLocation(context, nullNode);
+    EXPECT_EQ(location.start, nullptr);
+    EXPECT_EQ(location.end, nullptr);
+
+    ASTContextSetNodeLocation(context, nullNode, SourceRangeMake(firstStart, firstStart + 3));
+    location = ASTContextGetNodeLocation(context, nullNode);
+    EXPECT_EQ(location.start, firstStart);
+    EXPECT_EQ(location.end, firstStart + 3);
+
+    ASTContextDestroy(context);
+    SourceBufferDestroy(second);
+    SourceBufferDestroy(first);
+    StringDestroy(secondString);
+    StringDestroy(firstString);
+    StringDestroy(moduleName);
+}
+
+TEST(ASTContext, StoresSubstitutesOutsideOfNodes) {
+    AllocatorRef allocator = AllocatorGetSystemDefault();
+    StringRef moduleName   = StringCreate(allocator, "Test");
+    ASTContextRef context  = ASTContextCreate(allocator, allocator, moduleName);
+
+    ASTNodeRef nodes[1024];
+    for (Index index = 0; index < 1024; index++) {
+        nodes[index] = (ASTNodeRef)ASTContextCreateConstantIntExpression(context, SourceRangeNull(), kScopeNull, index);
+    }
+
+    for (Index index = 0; index < 1024; index += 2) {
+        ASTContextSetSubstitute(context, nodes[index], nodes[index + 1]);
+    }
+
+    for (Index index = 0; index < 1024; index += 2) {
+        EXPECT_EQ(ASTContextGetSubstitute(context, nodes[index]), nodes[index + 1]);
+        EXPECT_EQ(ASTContextGetSubstitute(context, nodes[index + 1]), nullptr);
+    }
+
+    ASTContextDestroy(context);
+    StringDestroy(moduleName);
+}
+
+TEST(ASTContext, VisitsNodesOfShardsInMergeOrder) {
+    AllocatorRef allocator    = AllocatorGetSystemDefault();
+    StringRef moduleName      = StringCreate(allocator, "Test");
+    StringRef firstPath       = StringCreate(allocator, "first.jelly");
+    StringRef secondPath      = StringCreate(allocator, "second.jelly");
+    StringRef firstString     = StringCreate(allocator, "var first: Int = 1\n");
+    StringRef secondString    = StringCreate(allocator, "var second: Int = 2\n");
+    SourceBufferRef first     = SourceBufferCreateFromString(allocator, firstString);
+    SourceBufferRef second    = SourceBufferCreateFromString(allocator, secondString);
+    ASTContextRef context     = ASTContextCreate(allocator, allocator, moduleName);
+    ASTContextRef firstShard  = ASTContextCreateShard(context);
+    ASTContextRef secondShard = ASTContextCreateShard(context);
+    ParserRef firstParser     = ParserCreate(allocator, allocator, firstShard);
+    ParserRef secondParser    = ParserCreate(allocator, allocator, secondShard);
+
+    ASTSourceUnitRef secondUnit    = ParserParseSourceUnit(secondParser, secondPath, second);
+    ASTSourceUnitRef firstUnit     = ParserParseSourceUnit(firstParser, firstPath, first);
+    ASTModuleDeclarationRef module = ASTContextGetModule(context);
+    EXPECT_EQ(ASTArrayGetElementCount(module->sourceUnits), 0);
+    EXPECT_EQ(ASTContextGetNodeCount(context, ASTTagConstantExpression), 0);
+
+    ASTContextMergeShard(context, firstShard);
+    ASTNodeRef node = (ASTNodeRef)ASTContextCreateConstantIntExpression(context, SourceRangeNull(), kScopeNull, 3);
+    ASTContextMergeShard(context, secondShard);
+    ASSERT_EQ(ASTArrayGetElementCount(module->sourceUnits), 2);
+    EXPECT_EQ(ASTArrayGetElementAtIndex(module->sourceUnits, 0), firstUnit);
+    EXPECT_EQ(ASTArrayGetElementAtIndex(module->sourceUnits, 1), secondUnit);
+    ASSERT_EQ(ASTContextGetNodeCount(context, ASTTagConstantExpression), 3);
+
+    ASTNodeRef constants[3];
+    Index constantCount = 0;
+    for (ASTContextNodeIterator iterator = ASTContextGetNodeIterator(context, ASTTagConstantExpression); iterator.node;
+         ASTContextNodeIteratorNext(&iterator)) {
+        ASSERT_LT(constantCount, 3);
+        constants[constantCount] = iterator.node;
+        constantCount += 1;
+    }
+
+    ASSERT_EQ(constantCount, 3);
+    EXPECT_EQ(((ASTConstantExpressionRef)constants[0])->intValue, 1);
+    EXPECT_EQ(constants[1], node);
+    EXPECT_EQ(((ASTConstantExpressionRef)constants[2])->intValue, 2);
+
+    SourceRange location = ASTContextGetNodeLocation(context, constants[2]);
+    EXPECT_EQ(location.start, SourceBufferGetCharacters(second) + 18);
+
+    ParserDestroy(secondParser);
+    ParserDestroy(firstParser);
+    ASTContextDestroy(context);
+    SourceBufferDestroy(second);
+    SourceBufferDestroy(first);
+    StringDestroy(secondString);
+    StringDestroy(firstString);
+    StringDestroy(secondPath);
+    StringDestroy(firstPath);
+    StringDestroy(moduleName);
+}
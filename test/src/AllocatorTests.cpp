@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+#include <pthread.h>
+
+struct ThreadContext {
+    AllocatorRef inheritedDefault;
+    AllocatorRef workerAllocator;
+};
+
+static void *_AllocatorTestsThreadProcess(void *context) {
+    ThreadContext *threadContext    = (ThreadContext *)context;
+    threadContext->inheritedDefault = AllocatorGetCurrentDefault();
+    AllocatorSetCurrentDefault(threadContext->workerAllocator);
+
+    StringRef string = StringCreate(AllocatorGetDefault(), "worker");
+    StringAppend(string, " thread");
+    EXPECT_STREQ(StringGetCharacters(string), "worker thread");
+    StringDestroy(string);
+    return NULL;
+}
+
+TEST(Allocator, CurrentDefaultIsThreadLocal) {
+    AllocatorRef mainAllocator   = TempAllocatorCreate(AllocatorGetSystemDefault());
+    AllocatorRef workerAllocator = TempAllocatorCreate(AllocatorGetSystemDefault());
+    AllocatorSetCurrentDefault(mainAllocator);
+
+    ThreadContext context = {mainAllocator, workerAllocator};
+    pthread_t thread;
+    ASSERT_EQ(pthread_create(&thread, NULL, &_AllocatorTestsThreadProcess, &context), 0);
+    pthread_join(thread, NULL);
+
+    EXPECT_EQ(context.inheritedDefault, nullptr);
+    EXPECT_EQ(AllocatorGetCurrentDefault(), mainAllocator);
+
+    AllocatorSetCurrentDefault(NULL);
+    AllocatorDestroy(workerAllocator);
+    AllocatorDestroy(mainAllocator);
+}
+
+TEST(Allocator, DefaultResolvesToCurrentDefault) {
+    AllocatorRef allocator = BumpAllocatorCreate(AllocatorGetSystemDefault());
+    AllocatorSetCurrentDefault(allocator);
+    void *first  = AllocatorAllocate(AllocatorGetDefault(), 16);
+    void *second = AllocatorAllocate(AllocatorGetDefault(), 16);
+    EXPECT_EQ((UInt8 *)second - (UInt8 *)first, 16);
+
+    AllocatorSetCurrentDefault(NULL);
+    AllocatorDestroy(allocator);
+}
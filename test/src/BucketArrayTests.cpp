@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(BucketArray, RandomAccessAcrossPages) {
+    BucketArrayRef array = BucketArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(Index), 3);
+    for (Index index = 0; index < 10000; index++) {
+        BucketArrayAppendElement(array, &index);
+    }
+
+    EXPECT_EQ(BucketArrayGetElementCount(array), 10000);
+    for (Index index = 0; index < 10000; index++) {
+        EXPECT_EQ(*(Index *)BucketArrayGetElementAtIndex(array, index), index);
+    }
+
+    BucketArrayDestroy(array);
+}
+
+TEST(BucketArray, ElementAddressesAreStable) {
+    BucketArrayRef array = BucketArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(Index), 8);
+    Index value          = 42;
+    Index *first         = (Index *)BucketArrayAppendUninitializedElement(array);
+    *first               = value;
+
+    for (Index index = 0; index < 100000; index++) {
+        BucketArrayAppendElement(array, &index);
+    }
+
+    EXPECT_EQ(first, BucketArrayGetElementAtIndex(array, 0));
+    EXPECT_EQ(*first, value);
+
+    BucketArrayDestroy(array);
+}
+
+TEST(BucketArray, IteratorVisitsAllElements) {
+    BucketArrayRef array = BucketArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(Index), 8);
+    EXPECT_EQ(BucketArrayGetIterator(array).element, nullptr);
+
+    for (Index index = 0; index < 1000; index++) {
+        BucketArrayAppendElement(array, &index);
+    }
+
+    Index expected = 0;
+    for (BucketArrayIterator iterator = BucketArrayGetIterator(array); iterator.element; BucketArrayIteratorNext(&iterator)) {
+        EXPECT_EQ(*(Index *)iterator.element, expected);
+        expected += 1;
+    }
+
+    EXPECT_EQ(expected, 1000);
+    BucketArrayDestroy(array);
+}
+
+TEST(BucketArray, IteratorVisitsElementsAppendedWhileIterating) {
+    BucketArrayRef array = BucketArrayCreateEmpty(AllocatorGetSystemDefault(), sizeof(Index), 1);
+    Index value          = 0;
+    BucketArrayAppendElement(array, &value);
+
+    Index visitCount = 0;
+    for (BucketArrayIterator iterator = BucketArrayGetIterator(array); iterator.element; BucketArrayIteratorNext(&iterator)) {
+        Index next = *(Index *)iterator.element + 1;
+        if (next < 100) {
+            BucketArrayAppendElement(array, &next);
+        }
+
+        visitCount += 1;
+    }
+
+    EXPECT_EQ(visitCount, 100);
+    BucketArrayDestroy(array);
+}
+
+TEST(BucketArray, CreateCopy) {
+    Index elements[]     = {1, 2, 3, 4, 5, 6, 7};
+    BucketArrayRef array = BucketArrayCreate(AllocatorGetSystemDefault(), 2, sizeof(Index), elements, 7);
+    BucketArrayRef copy  = BucketArrayCreateCopy(AllocatorGetSystemDefault(), 4, array);
+
+    EXPECT_EQ(BucketArrayGetElementCount(copy), 7);
+    for (Index index = 0; index < 7; index++) {
+        EXPECT_EQ(*(Index *)BucketArrayGetElementAtIndex(copy, index), elements[index]);
+    }
+
+    BucketArrayDestroy(copy);
+    BucketArrayDestroy(array);
+}
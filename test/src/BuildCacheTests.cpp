@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+class BuildCacheTest : public testing::Test {
+protected:
+    StringRef buildDirectory;
+
+    void SetUp() override {
+        Char directoryTemplate[] = "/tmp/JellyBuildCacheXXXXXX";
+        ASSERT_NE(mkdtemp(directoryTemplate), nullptr);
+        buildDirectory = StringCreate(AllocatorGetSystemDefault(), directoryTemplate);
+    }
+
+    void TearDown() override {
+        CreateFile("BuildCache", NULL);
+        CreateFile("Module.o", NULL);
+        rmdir(StringGetCharacters(buildDirectory));
+        StringDestroy(buildDirectory);
+    }
+
+    void CreateFile(const Char *fileName, const Char *content) {
+        StringRef filePath = StringCreateCopy(AllocatorGetSystemDefault(), buildDirectory);
+        StringAppendFormat(filePath, "/%s", fileName);
+        if (content) {
+            FILE *file = fopen(StringGetCharacters(filePath), "w");
+            fputs(content, file);
+            fclose(file);
+        } else {
+            remove(StringGetCharacters(filePath));
+        }
+
+        StringDestroy(filePath);
+    }
+};
+
+TEST_F(BuildCacheTest, HashDependsOnContent) {
+    UInt64 lhs = BuildCacheHash(kBuildCacheHashSeed, "func main() {}", 14);
+    UInt64 rhs = BuildCacheHash(kBuildCacheHashSeed, "func main() {}", 14);
+    EXPECT_EQ(lhs, rhs);
+    EXPECT_NE(lhs, BuildCacheHash(kBuildCacheHashSeed, "func main() { }", 15));
+    EXPECT_NE(lhs, BuildCacheHash(lhs, "", 1));
+}
+
+TEST_F(BuildCacheTest, LookupRequiresFingerprintAndObjectFile) {
+    StringRef moduleName = StringCreate(AllocatorGetSystemDefault(), "Module");
+    BuildCacheRef cache  = BuildCacheCreate(AllocatorGetSystemDefault(), buildDirectory);
+    EXPECT_FALSE(BuildCacheLookupModule(cache, moduleName, 42));
+
+    BuildCacheInsertModule(cache, moduleName, 42);
+    EXPECT_FALSE(BuildCacheLookupModule(cache, moduleName, 42));
+
+    CreateFile("Module.o", "");
+    EXPECT_TRUE(BuildCacheLookupModule(cache, moduleName, 42));
+    EXPECT_FALSE(BuildCacheLookupModule(cache, moduleName, 43));
+
+    BuildCacheRemoveModule(cache, moduleName);
+    EXPECT_FALSE(BuildCacheLookupModule(cache, moduleName, 42));
+
+    BuildCacheStatistics statistics = BuildCacheGetStatistics(cache);
+    EXPECT_EQ(statistics.hitCount, 1);
+    EXPECT_EQ(statistics.missCount, 4);
+
+    BuildCacheDestroy(cache);
+    StringDestroy(moduleName);
+}
+
+TEST_F(BuildCacheTest, WriteAndReload) {
+    StringRef moduleName = StringCreate(AllocatorGetSystemDefault(), "Module");
+    CreateFile("Module.o", "");
+
+    BuildCacheRef cache = BuildCacheCreate(AllocatorGetSystemDefault(), buildDirectory);
+    BuildCacheInsertModule(cache, moduleName, 0xfedcba9876543210ULL);
+    EXPECT_TRUE(BuildCacheWrite(cache));
+    BuildCacheDestroy(cache);
+
+    cache = BuildCacheCreate(AllocatorGetSystemDefault(), buildDirectory);
+    EXPECT_TRUE(BuildCacheLookupModule(cache, moduleName, 0xfedcba9876543210ULL));
+    BuildCacheDestroy(cache);
+
+    CreateFile("BuildCache", "jelly-build-cache 0\nfedcba9876543210 Module\n");
+    cache = BuildCacheCreate(AllocatorGetSystemDefault(), buildDirectory);
+    EXPECT_FALSE(BuildCacheLookupModule(cache, moduleName, 0xfedcba9876543210ULL));
+    BuildCacheDestroy(cache);
+
+    StringDestroy(moduleName);
+}
+
+TEST(BuildCacheFingerprint, IgnoresReportAndDumpOptions) {
+    WorkspaceOptions options = (WorkspaceOptions)(WorkspaceOptionsTypeCheck | WorkspaceOptionsOptimizeDefault);
+    WorkspaceOptions reports = (WorkspaceOptions)(WorkspaceOptionsDumpAST | WorkspaceOptionsNoCache | WorkspaceOptionsCacheReport |
+                                                  WorkspaceOptionsTimeReport | WorkspaceOptionsMemoryReport);
+    EXPECT_EQ(WorkspaceOptionsGetFingerprintOptions(options), options);
+    EXPECT_EQ(WorkspaceOptionsGetFingerprintOptions((WorkspaceOptions)(options | reports)), options);
+    EXPECT_EQ(WorkspaceOptionsGetFingerprintOptions(reports), WorkspaceOptionsNone);
+    EXPECT_NE(WorkspaceOptionsGetFingerprintOptions(WorkspaceOptionsOptimizeSize),
+              WorkspaceOptionsGetFingerprintOptions(WorkspaceOptionsOptimizeAggressive));
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(BumpAllocator, AllocateAligned) {
+    AllocatorRef allocator = BumpAllocatorCreate(AllocatorGetSystemDefault());
+    for (Index alignment = 1; alignment <= 4096; alignment <<= 1) {
+        AllocatorAllocate(allocator, 3);
+        void *memory = BumpAllocatorAllocateAligned(allocator, 5, alignment);
+        EXPECT_EQ((uintptr_t)memory % alignment, 0);
+    }
+
+    void *memory = AllocatorAllocate(allocator, 1);
+    EXPECT_EQ((uintptr_t)memory % (2 * sizeof(void *)), 0);
+    AllocatorDestroy(allocator);
+}
+
+TEST(BumpAllocator, RewindToMarker) {
+    AllocatorRef allocator = BumpAllocatorCreate(AllocatorGetSystemDefault());
+    AllocatorAllocate(allocator, 16);
+
+    BumpAllocatorMarker marker = BumpAllocatorGetMarker(allocator);
+    void *first                = AllocatorAllocate(allocator, 32);
+    for (Index index = 0; index < 1024; index++) {
+        AllocatorAllocate(allocator, 256);
+    }
+
+    void *oversized = AllocatorAllocate(allocator, 1 << 20);
+    memset(oversized, 0xFF, 1 << 20);
+
+    BumpAllocatorRewind(allocator, marker);
+    EXPECT_EQ(AllocatorAllocate(allocator, 32), first);
+    AllocatorDestroy(allocator);
+}
+
+TEST(BumpAllocator, ResetReusesPages) {
+    AllocatorRef allocator = BumpAllocatorCreate(AllocatorGetSystemDefault());
+    void *first            = AllocatorAllocate(allocator, 64);
+    for (Index index = 0; index < 4096; index++) {
+        AllocatorAllocate(allocator, 128);
+    }
+
+    BumpAllocatorReset(allocator);
+    EXPECT_EQ(AllocatorAllocate(allocator, 64), first);
+
+    AllocatorStatistics statistics = AllocatorGetThreadStatistics();
+    for (Index index = 0; index < 4096; index++) {
+        AllocatorAllocate(allocator, 128);
+    }
+
+    EXPECT_EQ(AllocatorGetThreadStatistics().allocationCount, statistics.allocationCount);
+    AllocatorDestroy(allocator);
+}
+
+TEST(BumpAllocator, ReallocatePreservesContent) {
+    AllocatorRef allocator = BumpAllocatorCreate(AllocatorGetSystemDefault());
+    UInt8 *memory          = (UInt8 *)AllocatorAllocate(allocator, 16);
+    for (Index index = 0; index < 16; index++) {
+        memory[index] = (UInt8)index;
+    }
+
+    UInt8 *grown = (UInt8 *)AllocatorReallocate(allocator, memory, 64);
+    EXPECT_EQ(grown, memory);
+
+    AllocatorAllocate(allocator, 8);
+    UInt8 *moved = (UInt8 *)AllocatorReallocate(allocator, grown, 1 << 16);
+    EXPECT_NE(moved, grown);
+    for (Index index = 0; index < 16; index++) {
+        EXPECT_EQ(moved[index], index);
+    }
+
+    AllocatorDestroy(allocator);
+}
+
+TEST(BumpAllocator, ArrayGrowth) {
+    AllocatorRef allocator = BumpAllocatorCreate(AllocatorGetSystemDefault());
+    ArrayRef array         = ArrayCreateEmpty(allocator, sizeof(Index), 2);
+    for (Index index = 0; index < 100000; index++) {
+        ArrayAppendElement(array, &index);
+    }
+
+    for (Index index = 0; index < 100000; index++) {
+        EXPECT_EQ(*(Index *)ArrayGetElementAtIndex(array, index), index);
+    }
+
+    ArrayDestroy(array);
+    AllocatorDestroy(allocator);
+}
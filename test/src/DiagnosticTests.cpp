@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void RecordDiagnostic(const Diagnostic *diagnostic, void *context) {
+    ((std::vector<std::string> *)context)->push_back(diagnostic->message);
+}
+
+TEST(DiagnosticEngine, ReportsToCurrentEngine) {
+    std::vector<std::string> messages;
+    DiagnosticEngineRef engine = DiagnosticEngineCreate(AllocatorGetSystemDefault());
+    DiagnosticEngineSetHandler(engine, &RecordDiagnostic, &messages);
+
+    Index defaultErrorCount = DiagnosticEngineGetMessageCount(DiagnosticEngineGetDefault(), DiagnosticLevelError);
+    DiagnosticEngineSetCurrent(engine);
+    EXPECT_EQ(DiagnosticEngineGetCurrent(), engine);
+    ReportErrorFormat("Unknown identifier '%s'", "x");
+    ReportWarning("Unused variable");
+    DiagnosticEngineSetCurrent(NULL);
+    EXPECT_EQ(DiagnosticEngineGetCurrent(), DiagnosticEngineGetDefault());
+
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0], "Unknown identifier 'x'");
+    EXPECT_EQ(messages[1], "Unused variable");
+    EXPECT_TRUE(DiagnosticEngineHasErrors(engine));
+    EXPECT_EQ(DiagnosticEngineGetMessageCount(engine, DiagnosticLevelWarning), 1);
+    EXPECT_EQ(DiagnosticEngineGetMessageCount(DiagnosticEngineGetDefault(), DiagnosticLevelError), defaultErrorCount);
+
+    DiagnosticEngineResetMessageCounts(engine);
+    EXPECT_FALSE(DiagnosticEngineHasErrors(engine));
+    DiagnosticEngineDestroy(engine);
+}
+
+TEST(DiagnosticEngine, FormatsLongMessages) {
+    std::vector<std::string> messages;
+    DiagnosticEngineRef engine = DiagnosticEngineCreate(AllocatorGetSystemDefault());
+    DiagnosticEngineSetHandler(engine, &RecordDiagnostic, &messages);
+    DiagnosticEngineSetCurrent(engine);
+
+    std::string name(100000, 'a');
+    ReportInfoFormat("%s!", name.c_str());
+    DiagnosticEngineSetCurrent(NULL);
+
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0], name + "!");
+    DiagnosticEngineDestroy(engine);
+}
+
+TEST(DiagnosticEngine, FlushesStagedReportsInOrder) {
+    std::vector<std::string> messages;
+    DiagnosticEngineRef engine = DiagnosticEngineCreate(AllocatorGetSystemDefault());
+    DiagnosticEngineSetHandler(engine, &RecordDiagnostic, &messages);
+
+    const Index threadCount = 8;
+    std::vector<std::thread> threads;
+    for (Index threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+        threads.emplace_back([engine, threadIndex]() {
+            DiagnosticEngineSetCurrent(engine);
+            for (Index order = threadIndex; order < 64; order += threadCount) {
+                DiagnosticEngineBeginStaging(engine, 63 - order);
+                ReportErrorFormat("%zu.0", 63 - order);
+                ReportErrorFormat("%zu.1", 63 - order);
+                DiagnosticEngineEndStaging(engine);
+            }
+            DiagnosticEngineSetCurrent(NULL);
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_TRUE(messages.empty());
+    EXPECT_EQ(DiagnosticEngineGetMessageCount(engine, DiagnosticLevelError), 128);
+
+    DiagnosticEngineFlush(engine);
+    ASSERT_EQ(messages.size(), 128);
+    for (Index index = 0; index < 128; index++) {
+        EXPECT_EQ(messages[index], std::to_string(index / 2) + "." + std::to_string(index % 2));
+    }
+
+    DiagnosticEngineDestroy(engine);
+}
+
+static void RecordLocation(const Diagnostic *diagnostic, void *context) {
+    std::string location = diagnostic->filePath ? diagnostic->filePath : "";
+    location += ":" + std::to_string(diagnostic->line) + ":" + std::to_string(diagnostic->column);
+    ((std::vector<std::string> *)context)->push_back(location);
+}
+
+TEST(DiagnosticEngine, ResolvesLocationsOfAddedSources) {
+    std::vector<std::string> locations;
+    DiagnosticEngineRef engine = DiagnosticEngineCreate(AllocatorGetSystemDefault());
+    DiagnosticEngineSetHandler(engine, &RecordLocation, &locations);
+
+    StringRef content      = StringCreate(AllocatorGetSystemDefault(), "func main() {\n    var x: Int\n}\n");
+    StringRef filePath     = StringCreate(AllocatorGetSystemDefault(), "main.jelly");
+    SourceBufferRef source = SourceBufferCreateFromString(AllocatorGetSystemDefault(), content);
+    DiagnosticEngineAddSource(engine, filePath, source);
+
+    const Char *characters = SourceBufferGetCharacters(source);
+    DiagnosticEngineSetCurrent(engine);
+    ReportErrorAt(SourceRangeMake(characters + 22, characters + 23), "Unused variable '%s'", "x");
+    ReportError("No location");
+    DiagnosticEngineSetCurrent(NULL);
+
+    ASSERT_EQ(locations.size(), 2);
+    EXPECT_EQ(locations[0], "main.jelly:2:9");
+    EXPECT_EQ(locations[1], ":0:0");
+
+    DiagnosticEngineDestroy(engine);
+    SourceBufferDestroy(source);
+    StringDestroy(filePath);
+    StringDestroy(content);
+}
+
+TEST(DiagnosticEngine, WritesJSONLines) {
+    FILE *output = tmpfile();
+    ASSERT_NE(output, nullptr);
+
+    Diagnostic diagnostic;
+    diagnostic.level    = DiagnosticLevelError;
+    diagnostic.message  = "Use of unresolved identifier \"x\"";
+    diagnostic.location = SourceRangeNull();
+    diagnostic.filePath = "main.jelly";
+    diagnostic.line     = 2;
+    diagnostic.column   = 9;
+    DiagnosticHandlerJSON(&diagnostic, output);
+
+    diagnostic.level    = DiagnosticLevelWarning;
+    diagnostic.message  = "Line\nBreak";
+    diagnostic.filePath = NULL;
+    DiagnosticHandlerJSON(&diagnostic, output);
+
+    rewind(output);
+    Char line[256];
+    ASSERT_NE(fgets(line, sizeof(line), output), nullptr);
+    EXPECT_STREQ(line, "{\"level\":\"error\",\"message\":\"Use of unresolved identifier \\\"x\\\"\",\"file\":\"main.jelly\",\"line\":2,"
+                       "\"column\":9}\n");
+    ASSERT_NE(fgets(line, sizeof(line), output), nullptr);
+    EXPECT_STREQ(line, "{\"level\":\"warning\",\"message\":\"Line\\nBreak\"}\n");
+    fclose(output);
+}
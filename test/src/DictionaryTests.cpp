@@ -105,3 +105,91 @@ TEST(Dictionary, CStringDictionaryRemove) {
     EXPECT_EQ(789, *value);
     DictionaryDestroy(dictionary);
 }
+
+TEST(Dictionary, CStringDictionaryGrowth) {
+    DictionaryRef dictionary = CStringDictionaryCreate(AllocatorGetSystemDefault(), 2);
+    Char key[32];
+
+    for (Int64 index = 0; index < 10000; index++) {
+        snprintf(key, sizeof(key), "key%lld", (long long)index);
+        DictionaryInsert(dictionary, key, &index, sizeof(Int64));
+    }
+
+    for (Int64 index = 0; index < 10000; index++) {
+        snprintf(key, sizeof(key), "key%lld", (long long)index);
+        const Int64 *value = (const Int64 *)DictionaryLookup(dictionary, key);
+        EXPECT_NE(value, nullptr);
+        EXPECT_EQ(index, *value);
+    }
+
+    EXPECT_EQ(DictionaryLookup(dictionary, "key10000"), nullptr);
+    DictionaryDestroy(dictionary);
+}
+
+TEST(Dictionary, CStringDictionaryReplace) {
+    Int64 element    = 123;
+    Int64 elements[] = {456, 789};
+    const Int64 *value;
+
+    DictionaryRef dictionary = CStringDictionaryCreate(AllocatorGetSystemDefault(), 2);
+    DictionaryInsert(dictionary, "A", &element, sizeof(Int64));
+    DictionaryInsert(dictionary, "A", &elements, sizeof(elements));
+    value = (const Int64 *)DictionaryLookup(dictionary, "A");
+    EXPECT_NE(value, nullptr);
+    EXPECT_EQ(456, value[0]);
+    EXPECT_EQ(789, value[1]);
+    DictionaryInsert(dictionary, "A", &element, sizeof(Int64));
+    value = (const Int64 *)DictionaryLookup(dictionary, "A");
+    EXPECT_NE(value, nullptr);
+    EXPECT_EQ(123, *value);
+
+    for (Int64 index = 0; index < 1000; index++) {
+        DictionaryInsert(dictionary, "B", &index, sizeof(Int64));
+    }
+
+    void *memory;
+    Index length;
+    DictionaryGetValueBuffer(dictionary, &memory, &length);
+    EXPECT_EQ(length, 2 * sizeof(Int64));
+    value = (const Int64 *)DictionaryLookup(dictionary, "B");
+    EXPECT_NE(value, nullptr);
+    EXPECT_EQ(999, *value);
+    DictionaryDestroy(dictionary);
+}
+
+TEST(Dictionary, CStringDictionaryRemoveAndReinsert) {
+    DictionaryRef dictionary = CStringDictionaryCreate(AllocatorGetSystemDefault(), 8);
+    Char key[32];
+
+    for (Int64 round = 0; round < 10; round++) {
+        for (Int64 index = 0; index < 500; index++) {
+            Int64 element = round * 1000 + index;
+            snprintf(key, sizeof(key), "key%lld", (long long)index);
+            DictionaryInsert(dictionary, key, &element, sizeof(Int64));
+        }
+
+        for (Int64 index = 0; index < 500; index += 2) {
+            snprintf(key, sizeof(key), "key%lld", (long long)index);
+            DictionaryRemove(dictionary, key);
+        }
+
+        for (Int64 index = 0; index < 500; index++) {
+            snprintf(key, sizeof(key), "key%lld", (long long)index);
+            const Int64 *value = (const Int64 *)DictionaryLookup(dictionary, key);
+            if (index % 2 == 0) {
+                EXPECT_EQ(value, nullptr);
+            } else {
+                EXPECT_NE(value, nullptr);
+                EXPECT_EQ(round * 1000 + index, *value);
+            }
+        }
+    }
+
+    void *memory;
+    Index length;
+    DictionaryGetKeyBuffer(dictionary, &memory, &length);
+    EXPECT_LT(length, 250 * sizeof(key));
+    DictionaryGetValueBuffer(dictionary, &memory, &length);
+    EXPECT_EQ(length, 250 * sizeof(Int64));
+    DictionaryDestroy(dictionary);
+}
@@ -128,8 +128,8 @@ std::string FileTest::GetFileName(std::string filepath) {
     return result;
 }
 
-void FileTestDiagnosticHandler(DiagnosticLevel level, const Char *message, void *context) {
-    printf("[  MESSAGE ] %s\n", message);
+void FileTestDiagnosticHandler(const Diagnostic *diagnostic, void *context) {
+    printf("[  MESSAGE ] %s\n", diagnostic->message);
 
     FileTestDiagnosticContext *fileTestContext = (FileTestDiagnosticContext *)context;
     if (fileTestContext->records.size() <= fileTestContext->index) {
@@ -137,7 +137,7 @@ void FileTestDiagnosticHandler(DiagnosticLevel level, const Char *message, void
     }
 
     FileTestDiagnosticRecord record = fileTestContext->records[fileTestContext->index];
-    EXPECT_EQ(record.level, level);
-    EXPECT_STREQ(record.message.c_str(), message);
+    EXPECT_EQ(record.level, diagnostic->level);
+    EXPECT_STREQ(record.message.c_str(), diagnostic->message);
     fileTestContext->index += 1;
 }
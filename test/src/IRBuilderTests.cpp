@@ -69,3 +69,13 @@ TEST_P(IRBuilderTests, run) {
 }
 
 INSTANTIATE_TEST_CASE_P(run, IRBuilderTests, testing::ValuesIn(FileTest::ReadFromDirectory("irbuilder")));
+
+TEST(IRBuilder, TargetTripleSupport) {
+    StringRef targetTriple = StringCreate(AllocatorGetSystemDefault(), "x86_64-unknown-linux-gnu");
+    EXPECT_TRUE(IRBuilderIsTargetTripleSupported(targetTriple));
+    StringDestroy(targetTriple);
+
+    targetTriple = StringCreate(AllocatorGetSystemDefault(), "jelly-unknown-nowhere");
+    EXPECT_FALSE(IRBuilderIsTargetTripleSupported(targetTriple));
+    StringDestroy(targetTriple);
+}
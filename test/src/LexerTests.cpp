@@ -36,11 +36,13 @@ static inline void _PrintTokenKindDescription(TokenKind kind);
 }
 
 TEST(Lexer, Directives) {
-    EXPECT_TOKEN_KINDS_EQ("#load #link #import #include",
+    EXPECT_TOKEN_KINDS_EQ("#load #link #import #include #foreign #intrinsic",
                           TokenKindDirectiveLoad,
                           TokenKindDirectiveLink,
                           TokenKindDirectiveImport,
-                          TokenKindDirectiveInclude);
+                          TokenKindDirectiveInclude,
+                          TokenKindDirectiveForeign,
+                          TokenKindDirectiveIntrinsic);
 }
 
 TEST(Lexer, InvalidDirectiveName) {
@@ -76,6 +78,68 @@ TEST(Lexer, Keywords) {
                           TokenKindKeywordTrue);
 }
 
+TEST(Lexer, TypeKeywords) {
+    EXPECT_TOKEN_KINDS_EQ("Void Bool Int8 Int16 Int32 Int64 Int UInt8 UInt16 UInt32 UInt64 UInt Float32 Float64 Float",
+                          TokenKindKeywordVoid,
+                          TokenKindKeywordBool,
+                          TokenKindKeywordInt8,
+                          TokenKindKeywordInt16,
+                          TokenKindKeywordInt32,
+                          TokenKindKeywordInt64,
+                          TokenKindKeywordInt,
+                          TokenKindKeywordUInt8,
+                          TokenKindKeywordUInt16,
+                          TokenKindKeywordUInt32,
+                          TokenKindKeywordUInt64,
+                          TokenKindKeywordUInt,
+                          TokenKindKeywordFloat32,
+                          TokenKindKeywordFloat64,
+                          TokenKindKeywordFloat);
+}
+
+TEST(Lexer, KeywordPrefixesAndSuffixesAreIdentifiers) {
+    EXPECT_TOKEN_KINDS_EQ("i iff Int9 Int128 UInt_8 Float16 modules typealia Func _func fallthrough_ sizeof1",
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier,
+                          TokenKindIdentifier);
+}
+
+TEST(Lexer, LongIdentifiersAndWhitespaceRuns) {
+    EXPECT_TOKEN_KINDS_EQ("                                  very_long_identifier_name_0123456789_abcdefghijklmnopqrstuvwxyz\n"
+                          "\t\t\t\t\r\n\n\n    init /* comment spanning more than sixteen characters\n */ sizeof",
+                          TokenKindIdentifier,
+                          TokenKindKeywordInit,
+                          TokenKindKeywordSizeOf);
+}
+
+TEST(Lexer, LineAndColumnAfterWhitespaceRuns) {
+    StringRef buffer = StringCreate(AllocatorGetSystemDefault(),
+                                    "a\n\n                    b\n  /* c\n\n c */     \t d // e\n\n          f");
+    LexerRef lexer   = LexerCreate(AllocatorGetSystemDefault(), buffer);
+    const Index expectedLines[]   = {1, 3, 6, 8};
+    const Index expectedColumns[] = {0, 20, 12, 10};
+
+    Token token;
+    for (Index index = 0; index < sizeof(expectedLines) / sizeof(Index); index++) {
+        LexerNextToken(lexer, &token);
+        EXPECT_EQ(token.kind, TokenKindIdentifier);
+        EXPECT_EQ(token.line, expectedLines[index]);
+        EXPECT_EQ(token.column, expectedColumns[index]);
+    }
+
+    LexerDestroy(lexer);
+    StringDestroy(buffer);
+}
+
 TEST(Lexer, EmptyFuncDecl) {
     EXPECT_TOKEN_KINDS_EQ("func _myFunc1() -> Void {}",
                           TokenKindKeywordFunc,
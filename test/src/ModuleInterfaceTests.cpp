@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include <JellyCore/ASTMangling.h>
+#include <JellyCore/ASTSubstitution.h>
+#include <JellyCore/JellyCore.h>
+#include <JellyCore/TypeChecker.h>
+#include <string>
+
+class ModuleInterfaceTest : public testing::Test {
+protected:
+    AllocatorRef allocator;
+    StringRef buildDirectory;
+    StringRef interfacePath;
+    DiagnosticEngineRef engine;
+
+    void SetUp() override {
+        Char directoryTemplate[] = "/tmp/JellyModuleInterfaceXXXXXX";
+        ASSERT_NE(mkdtemp(directoryTemplate), nullptr);
+        allocator      = AllocatorGetSystemDefault();
+        buildDirectory = StringCreate(allocator, directoryTemplate);
+        interfacePath  = StringCreateCopy(allocator, buildDirectory);
+        StringAppend(interfacePath, "/Geo.jmod");
+        engine = DiagnosticEngineCreate(allocator);
+        DiagnosticEngineSetCurrent(engine);
+    }
+
+    void TearDown() override {
+        DiagnosticEngineSetCurrent(NULL);
+        DiagnosticEngineDestroy(engine);
+        remove(StringGetCharacters(interfacePath));
+        rmdir(StringGetCharacters(buildDirectory));
+        StringDestroy(interfacePath);
+        StringDestroy(buildDirectory);
+    }
+
+    void Verify(ASTContextRef context) {
+        ASTModuleDeclarationRef module = ASTContextGetModule(context);
+        module->kind                   = ASTModuleKindLibrary;
+        ASTPerformSubstitution(context, ASTTagUnaryExpression, &ASTUnaryExpressionUnification);
+        ASTPerformSubstitution(context, ASTTagBinaryExpression, &ASTBinaryExpressionUnification);
+        ASTApplySubstitution(context, module);
+        PerformNameResolution(context, module);
+
+        TypeCheckerRef typeChecker = TypeCheckerCreate(allocator);
+        TypeCheckerValidateModule(typeChecker, context, module);
+        TypeCheckerDestroy(typeChecker);
+
+        PerformNameMangling(context, module);
+    }
+
+    Bool Write(const Char *source) {
+        StringRef moduleName     = StringCreate(allocator, "Geo");
+        StringRef moduleFilePath = StringCreate(allocator, "Geo/Geo.jelly");
+        StringRef moduleString   = StringCreate(allocator, "");
+        StringRef filePath       = StringCreate(allocator, "Geo/src/Shapes.jelly");
+        StringRef string         = StringCreate(allocator, source);
+        SourceBufferRef module   = SourceBufferCreateFromString(allocator, moduleString);
+        SourceBufferRef buffer   = SourceBufferCreateFromString(allocator, string);
+        ASTContextRef context    = ASTContextCreate(allocator, allocator, moduleName);
+        ParserRef parser         = ParserCreate(allocator, allocator, context);
+
+        ParserParseSourceUnit(parser, moduleFilePath, module);
+        ParserParseSourceUnit(parser, filePath, buffer);
+        Verify(context);
+        EXPECT_FALSE(DiagnosticEngineHasErrors(engine));
+
+        Bool success = ModuleInterfaceWrite(allocator, ASTContextGetModule(context), 42, interfacePath);
+
+        ParserDestroy(parser);
+        ASTContextDestroy(context);
+        SourceBufferDestroy(buffer);
+        SourceBufferDestroy(module);
+        StringDestroy(string);
+        StringDestroy(filePath);
+        StringDestroy(moduleString);
+        StringDestroy(moduleFilePath);
+        StringDestroy(moduleName);
+        return success;
+    }
+
+    std::string ReadInterface() {
+        std::string content;
+        FILE *file = fopen(StringGetCharacters(interfacePath), "rb");
+        if (file) {
+            Char buffer[256];
+            size_t length = 0;
+            while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+                content.append(buffer, length);
+            }
+
+            fclose(file);
+        }
+
+        return content;
+    }
+
+    void WriteInterface(const std::string &content) {
+        FILE *file = fopen(StringGetCharacters(interfacePath), "wb");
+        fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+    }
+};
+
+static const Char *kInterfaceSource = "struct Point {\n"
+                                      "    var x: Int\n"
+                                      "    var y: Int\n"
+                                      "\n"
+                                      "    init() {\n"
+                                      "        self.x = 0\n"
+                                      "        self.y = 0\n"
+                                      "    }\n"
+                                      "}\n"
+                                      "\n"
+                                      "enum Shape {\n"
+                                      "    case circle\n"
+                                      "    case square = 4\n"
+                                      "}\n"
+                                      "\n"
+                                      "struct Polygon {\n"
+                                      "    var points: Point[4]\n"
+                                      "    var next: Polygon*\n"
+                                      "    var shape: Shape\n"
+                                      "}\n"
+                                      "\n"
+                                      "typealias Coordinate = Int\n"
+                                      "\n"
+                                      "var origin: Point\n"
+                                      "\n"
+                                      "#foreign func labs(value: Int) -> Int \"labs\"\n";
+
+TEST_F(ModuleInterfaceTest, WritesAndLoadsDeclarations) {
+    ASSERT_TRUE(Write(kInterfaceSource));
+
+    ModuleInterfaceRef interface = ModuleInterfaceCreateFromFile(allocator, StringGetCharacters(interfacePath));
+    ASSERT_NE(interface, nullptr);
+    EXPECT_EQ(ModuleInterfaceGetFingerprint(interface), 42);
+    ASSERT_EQ(ModuleInterfaceGetSourceUnitCount(interface), 2);
+    EXPECT_STREQ(ModuleInterfaceGetSourceUnitFilePath(interface, 0), "Geo/Geo.jelly");
+    EXPECT_STREQ(ModuleInterfaceGetSourceUnitFilePath(interface, 1), "Geo/src/Shapes.jelly");
+
+    StringRef moduleName  = StringCreate(allocator, "Geo");
+    ASTContextRef context = ASTContextCreate(allocator, allocator, moduleName);
+    ModuleInterfaceLoadDeclarations(interface, context, ASTContextGetModule(context));
+    ModuleInterfaceDestroy(interface);
+    Verify(context);
+    EXPECT_FALSE(DiagnosticEngineHasErrors(engine));
+
+    ASTModuleDeclarationRef module = ASTContextGetModule(context);
+    ASSERT_EQ(ASTArrayGetElementCount(module->sourceUnits), 1);
+    ASTSourceUnitRef sourceUnit = (ASTSourceUnitRef)ASTArrayGetElementAtIndex(module->sourceUnits, 0);
+    EXPECT_STREQ(StringGetCharacters(sourceUnit->filePath), "Geo/src/Shapes.jelly");
+    ASSERT_EQ(ASTArrayGetElementCount(sourceUnit->declarations), 6);
+
+    ASTStructureDeclarationRef point = (ASTStructureDeclarationRef)ASTArrayGetElementAtIndex(sourceUnit->declarations, 0);
+    ASSERT_EQ(point->base.base.tag, ASTTagStructureDeclaration);
+    EXPECT_STREQ(StringGetCharacters(point->base.name), "Point");
+    EXPECT_EQ(ASTArrayGetElementCount(point->values), 2);
+    EXPECT_EQ(ASTArrayGetElementCount(point->initializers), 1);
+
+    ASTEnumerationDeclarationRef shape = (ASTEnumerationDeclarationRef)ASTArrayGetElementAtIndex(sourceUnit->declarations, 1);
+    ASSERT_EQ(shape->base.base.tag, ASTTagEnumerationDeclaration);
+    ASSERT_EQ(ASTArrayGetElementCount(shape->elements), 2);
+    ASTValueDeclarationRef square = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(shape->elements, 1);
+    ASSERT_EQ(square->initializer->base.tag, ASTTagConstantExpression);
+    EXPECT_EQ(((ASTConstantExpressionRef)square->initializer)->intValue, 4);
+
+    ASTStructureDeclarationRef polygon = (ASTStructureDeclarationRef)ASTArrayGetElementAtIndex(sourceUnit->declarations, 2);
+    ASSERT_EQ(ASTArrayGetElementCount(polygon->values), 3);
+    ASTValueDeclarationRef points = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(polygon->values, 0);
+    ASSERT_EQ(points->base.type->tag, ASTTagArrayType);
+    EXPECT_EQ(((ASTArrayTypeRef)points->base.type)->sizeValue, 4);
+    ASTValueDeclarationRef next = (ASTValueDeclarationRef)ASTArrayGetElementAtIndex(polygon->values, 1);
+    ASSERT_EQ(next->base.type->tag, ASTTagPointerType);
+    EXPECT_EQ(((ASTPointerTypeRef)next->base.type)->pointeeType->tag, ASTTagStructureType);
+
+    ASTFunctionDeclarationRef labs = (ASTFunctionDeclarationRef)ASTArrayGetElementAtIndex(sourceUnit->declarations, 5);
+    ASSERT_EQ(labs->base.base.tag, ASTTagForeignFunctionDeclaration);
+    EXPECT_STREQ(StringGetCharacters(labs->foreignName), "labs");
+    EXPECT_STREQ(StringGetCharacters(labs->base.mangledName), "$F4labs1$b3Int$b3Int");
+    EXPECT_EQ(ASTArrayGetElementCount(labs->parameters), 1);
+
+    ASTContextDestroy(context);
+    StringDestroy(moduleName);
+}
+
+TEST_F(ModuleInterfaceTest, RejectsModulesWithImplementations) {
+    EXPECT_FALSE(Write("func area(x: Int, y: Int) -> Int {\n    return x * y\n}\n"));
+    EXPECT_EQ(ModuleInterfaceCreateFromFile(allocator, StringGetCharacters(interfacePath)), nullptr);
+}
+
+TEST_F(ModuleInterfaceTest, RejectsMalformedFiles) {
+    ASSERT_TRUE(Write(kInterfaceSource));
+    std::string content = ReadInterface();
+    ASSERT_GT(content.size(), 64);
+
+    WriteInterface(content.substr(0, content.size() - 1));
+    EXPECT_EQ(ModuleInterfaceCreateFromFile(allocator, StringGetCharacters(interfacePath)), nullptr);
+
+    WriteInterface(content.substr(0, 32));
+    EXPECT_EQ(ModuleInterfaceCreateFromFile(allocator, StringGetCharacters(interfacePath)), nullptr);
+
+    std::string corrupted = content;
+    corrupted[0]          = 'X';
+    WriteInterface(corrupted);
+    EXPECT_EQ(ModuleInterfaceCreateFromFile(allocator, StringGetCharacters(interfacePath)), nullptr);
+
+    WriteInterface(content);
+    ModuleInterfaceRef interface = ModuleInterfaceCreateFromFile(allocator, StringGetCharacters(interfacePath));
+    EXPECT_NE(interface, nullptr);
+    if (interface) {
+        ModuleInterfaceDestroy(interface);
+    }
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+#include <vector>
+
+struct PointerMapTestValue {
+    Index index;
+    void *pointer;
+};
+
+TEST(PointerMap, InsertAndLookupAcrossGrowth) {
+    PointerMapRef map = PointerMapCreate(AllocatorGetSystemDefault(), sizeof(PointerMapTestValue));
+    std::vector<Index> keys(10000);
+
+    for (Index index = 0; index < keys.size(); index++) {
+        EXPECT_EQ(PointerMapLookup(map, &keys[index]), nullptr);
+
+        PointerMapTestValue *value = (PointerMapTestValue *)PointerMapInsert(map, &keys[index]);
+        EXPECT_EQ(value->index, 0);
+        EXPECT_EQ(value->pointer, nullptr);
+        value->index   = index;
+        value->pointer = &keys[index];
+    }
+
+    EXPECT_EQ(PointerMapGetCount(map), keys.size());
+
+    for (Index index = 0; index < keys.size(); index++) {
+        PointerMapTestValue *value = (PointerMapTestValue *)PointerMapLookup(map, &keys[index]);
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(value->index, index);
+        EXPECT_EQ(value->pointer, &keys[index]);
+    }
+
+    PointerMapDestroy(map);
+}
+
+TEST(PointerMap, InsertReturnsExistingValue) {
+    PointerMapRef map = PointerMapCreate(AllocatorGetSystemDefault(), sizeof(void *));
+    Index key         = 0;
+
+    *(void **)PointerMapInsert(map, &key) = &key;
+    EXPECT_EQ(*(void **)PointerMapInsert(map, &key), &key);
+    EXPECT_EQ(PointerMapGetCount(map), 1);
+
+    PointerMapDestroy(map);
+}
+
+TEST(PointerMap, ReserveKeepsValues) {
+    PointerMapRef map = PointerMapCreate(AllocatorGetSystemDefault(), sizeof(Index));
+    std::vector<Index> keys(100);
+
+    for (Index index = 0; index < keys.size(); index++) {
+        *(Index *)PointerMapInsert(map, &keys[index]) = index;
+    }
+
+    PointerMapReserve(map, 100000);
+
+    for (Index index = 0; index < keys.size(); index++) {
+        Index *value = (Index *)PointerMapLookup(map, &keys[index]);
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, index);
+    }
+
+    PointerMapDestroy(map);
+}
+
+TEST(PointerMap, RemoveAll) {
+    PointerMapRef map = PointerMapCreate(AllocatorGetSystemDefault(), sizeof(Index));
+    Index key         = 0;
+
+    *(Index *)PointerMapInsert(map, &key) = 42;
+    PointerMapRemoveAll(map);
+    EXPECT_EQ(PointerMapGetCount(map), 0);
+    EXPECT_EQ(PointerMapLookup(map, &key), nullptr);
+    EXPECT_EQ(*(Index *)PointerMapInsert(map, &key), 0);
+
+    PointerMapDestroy(map);
+}
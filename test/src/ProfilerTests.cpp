@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(Profiler, SpansMeasureAllocationsOfThread) {
+    ProfilerRef profiler = ProfilerCreate(AllocatorGetSystemDefault());
+    StringRef unitName   = StringCreate(AllocatorGetSystemDefault(), "main.jelly");
+
+    Index span   = ProfilerBeginSpan(profiler, "Parse", unitName);
+    void *memory = AllocatorAllocate(AllocatorGetSystemDefault(), 4096);
+    AllocatorDeallocate(AllocatorGetSystemDefault(), memory);
+    ProfilerEndSpan(profiler, span);
+
+    FILE *output = tmpfile();
+    ASSERT_NE(output, nullptr);
+    ProfilerWriteTrace(profiler, output);
+
+    Char buffer[1024] = {};
+    rewind(output);
+    fread(buffer, sizeof(Char), sizeof(buffer) - 1, output);
+    fclose(output);
+
+    EXPECT_NE(strstr(buffer, "\"name\":\"Parse\""), nullptr);
+    EXPECT_NE(strstr(buffer, "\"detail\":\"main.jelly\""), nullptr);
+    EXPECT_NE(strstr(buffer, "\"allocations\":1,\"allocated_bytes\":4096"), nullptr);
+
+    StringDestroy(unitName);
+    ProfilerDestroy(profiler);
+}
+
+TEST(Profiler, TraceEscapesUnitNames) {
+    ProfilerRef profiler = ProfilerCreate(AllocatorGetSystemDefault());
+    StringRef unitName   = StringCreate(AllocatorGetSystemDefault(), "dir\\\"file\".jelly");
+    ProfilerEndSpan(profiler, ProfilerBeginSpan(profiler, "Parse", unitName));
+
+    FILE *output = tmpfile();
+    ASSERT_NE(output, nullptr);
+    ProfilerWriteTrace(profiler, output);
+
+    Char buffer[1024] = {};
+    rewind(output);
+    fread(buffer, sizeof(Char), sizeof(buffer) - 1, output);
+    fclose(output);
+
+    EXPECT_NE(strstr(buffer, "\"detail\":\"dir\\\\\\\"file\\\".jelly\""), nullptr);
+
+    StringDestroy(unitName);
+    ProfilerDestroy(profiler);
+}
+
+TEST(Profiler, SpansMeasurePeakOfOwnPhase) {
+    ProfilerRef profiler = ProfilerCreate(AllocatorGetSystemDefault());
+    StringRef unitName   = StringCreate(AllocatorGetSystemDefault(), "main.jelly");
+
+    Index outerSpan = ProfilerBeginSpan(profiler, "Compile", unitName);
+    Index parseSpan = ProfilerBeginSpan(profiler, "Parse", unitName);
+    void *memory    = AllocatorAllocate(AllocatorGetSystemDefault(), 1 << 20);
+    AllocatorDeallocate(AllocatorGetSystemDefault(), memory);
+    ProfilerEndSpan(profiler, parseSpan);
+
+    Index typeCheckSpan = ProfilerBeginSpan(profiler, "TypeCheck", unitName);
+    memory              = AllocatorAllocate(AllocatorGetSystemDefault(), 1024);
+    AllocatorDeallocate(AllocatorGetSystemDefault(), memory);
+    ProfilerEndSpan(profiler, typeCheckSpan);
+    ProfilerEndSpan(profiler, outerSpan);
+
+    FILE *output = tmpfile();
+    ASSERT_NE(output, nullptr);
+    ProfilerWriteTrace(profiler, output);
+
+    Char buffer[2048] = {};
+    rewind(output);
+    fread(buffer, sizeof(Char), sizeof(buffer) - 1, output);
+    fclose(output);
+
+    Index peakBytes[3] = {};
+    const Char *cursor = buffer;
+    for (Index index = 0; index < 3; index++) {
+        cursor = strstr(cursor, "\"peak_bytes\":");
+        ASSERT_NE(cursor, nullptr);
+        cursor += strlen("\"peak_bytes\":");
+        peakBytes[index] = (Index)strtoull(cursor, NULL, 10);
+    }
+
+    // The spans are written in the order they have been started: Compile, Parse, TypeCheck
+    EXPECT_GE(peakBytes[0], 1 << 20);
+    EXPECT_GE(peakBytes[1], 1 << 20);
+    EXPECT_GE(peakBytes[2], 1024);
+    EXPECT_LT(peakBytes[2], 1 << 20);
+
+    StringDestroy(unitName);
+    ProfilerDestroy(profiler);
+}
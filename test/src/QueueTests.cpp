@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+#include <pthread.h>
+
+TEST(Queue, FIFOAcrossWrapAroundAndGrowth) {
+    QueueRef queue = QueueCreate(AllocatorGetSystemDefault());
+    EXPECT_EQ(QueueDequeue(queue), nullptr);
+
+    uintptr_t nextValue    = 1;
+    uintptr_t nextExpected = 1;
+    for (Index round = 0; round < 100; round++) {
+        for (Index index = 0; index < round % 13 + 3; index++) {
+            QueueEnqueue(queue, (void *)nextValue);
+            nextValue += 1;
+        }
+
+        for (Index index = 0; index < round % 7 + 1; index++) {
+            EXPECT_EQ((uintptr_t)QueueDequeue(queue), nextExpected);
+            nextExpected += 1;
+        }
+    }
+
+    EXPECT_EQ(QueueGetElementCount(queue), nextValue - nextExpected);
+    while (void *element = QueueDequeue(queue)) {
+        EXPECT_EQ((uintptr_t)element, nextExpected);
+        nextExpected += 1;
+    }
+
+    EXPECT_EQ(nextExpected, nextValue);
+    QueueDestroy(queue);
+}
+
+TEST(ConcurrentQueue, SingleThreadedFIFO) {
+    ConcurrentQueueRef queue = ConcurrentQueueCreate(AllocatorGetSystemDefault());
+    EXPECT_EQ(ConcurrentQueueDequeue(queue), nullptr);
+
+    for (uintptr_t value = 1; value <= 1000; value++) {
+        ConcurrentQueueEnqueue(queue, (void *)value);
+    }
+
+    for (uintptr_t value = 1; value <= 1000; value++) {
+        EXPECT_EQ((uintptr_t)ConcurrentQueueDequeue(queue), value);
+    }
+
+    EXPECT_EQ(ConcurrentQueueDequeue(queue), nullptr);
+    ConcurrentQueueDestroy(queue);
+}
+
+struct ConcurrentQueueTestContext {
+    ConcurrentQueueRef queue;
+    uintptr_t producerIndex;
+    Index dequeueCount;
+    UInt64 dequeueSum;
+    Bool isOrdered;
+};
+
+static const Index kProducerCount = 4;
+static const Index kConsumerCount = 4;
+static const Index kElementCount  = 20000;
+
+static void *_ConcurrentQueueTestProduce(void *context) {
+    ConcurrentQueueTestContext *testContext = (ConcurrentQueueTestContext *)context;
+    for (uintptr_t index = 0; index < kElementCount; index++) {
+        ConcurrentQueueEnqueue(testContext->queue, (void *)(testContext->producerIndex * kElementCount + index + 1));
+    }
+
+    return NULL;
+}
+
+static void *_ConcurrentQueueTestConsume(void *context) {
+    ConcurrentQueueTestContext *testContext = (ConcurrentQueueTestContext *)context;
+    uintptr_t lastValues[kProducerCount]    = {};
+    while (__atomic_load_n(&testContext->dequeueCount, __ATOMIC_ACQUIRE) < kProducerCount * kElementCount) {
+        uintptr_t value = (uintptr_t)ConcurrentQueueDequeue(testContext->queue);
+        if (!value) {
+            continue;
+        }
+
+        // Elements of the same producer have to be dequeued in the order they have been enqueued
+        uintptr_t producer = (value - 1) / kElementCount;
+        if (value <= lastValues[producer]) {
+            __atomic_store_n(&testContext->isOrdered, false, __ATOMIC_RELAXED);
+        }
+
+        lastValues[producer] = value;
+        __atomic_fetch_add(&testContext->dequeueSum, value, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&testContext->dequeueCount, 1, __ATOMIC_ACQ_REL);
+    }
+
+    return NULL;
+}
+
+TEST(ConcurrentQueue, MultipleProducersAndConsumers) {
+    ConcurrentQueueRef queue = ConcurrentQueueCreate(AllocatorGetSystemDefault());
+    ConcurrentQueueTestContext contexts[kProducerCount];
+    ConcurrentQueueTestContext consumerContext = {queue, 0, 0, 0, true};
+    pthread_t producers[kProducerCount];
+    pthread_t consumers[kConsumerCount];
+
+    for (Index index = 0; index < kConsumerCount; index++) {
+        ASSERT_EQ(pthread_create(&consumers[index], NULL, &_ConcurrentQueueTestConsume, &consumerContext), 0);
+    }
+
+    for (Index index = 0; index < kProducerCount; index++) {
+        contexts[index] = {queue, index, 0, 0, true};
+        ASSERT_EQ(pthread_create(&producers[index], NULL, &_ConcurrentQueueTestProduce, &contexts[index]), 0);
+    }
+
+    for (Index index = 0; index < kProducerCount; index++) {
+        pthread_join(producers[index], NULL);
+    }
+
+    for (Index index = 0; index < kConsumerCount; index++) {
+        pthread_join(consumers[index], NULL);
+    }
+
+    UInt64 elementCount = kProducerCount * kElementCount;
+    EXPECT_EQ(consumerContext.dequeueCount, elementCount);
+    EXPECT_EQ(consumerContext.dequeueSum, elementCount * (elementCount + 1) / 2);
+    EXPECT_TRUE(consumerContext.isOrdered);
+    EXPECT_EQ(ConcurrentQueueDequeue(queue), nullptr);
+    ConcurrentQueueDestroy(queue);
+}
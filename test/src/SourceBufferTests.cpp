@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+#include <string>
+
+static void WriteFile(const Char *filePath, const Char *content, Index length) {
+    FILE *file = fopen(filePath, "w");
+    ASSERT_NE(file, nullptr);
+    fwrite(content, sizeof(Char), length, file);
+    fclose(file);
+}
+
+TEST(SourceBuffer, MapsFileWithNullTerminator) {
+    const Char *filePath = "/tmp/JellySourceBufferMapped.jelly";
+    const Char *content  = "func main() -> Void {}";
+    WriteFile(filePath, content, strlen(content));
+
+    SourceBufferRef buffer = SourceBufferCreateFromFile(AllocatorGetSystemDefault(), filePath);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_TRUE(SourceBufferIsMapped(buffer));
+    EXPECT_EQ(SourceBufferGetLength(buffer), strlen(content));
+    EXPECT_STREQ(SourceBufferGetCharacters(buffer), content);
+
+    SourceBufferDestroy(buffer);
+    remove(filePath);
+}
+
+TEST(SourceBuffer, ReadsPageSizedFileWithNullTerminator) {
+    const Char *filePath = "/tmp/JellySourceBufferPageSized.jelly";
+    Index length         = (Index)sysconf(_SC_PAGESIZE);
+    Char *content        = (Char *)malloc(length);
+    memset(content, ' ', length);
+    WriteFile(filePath, content, length);
+
+    SourceBufferRef buffer = SourceBufferCreateFromFile(AllocatorGetSystemDefault(), filePath);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_FALSE(SourceBufferIsMapped(buffer));
+    EXPECT_EQ(SourceBufferGetLength(buffer), length);
+    EXPECT_EQ(SourceBufferGetCharacters(buffer)[length], 0);
+
+    SourceBufferDestroy(buffer);
+    free(content);
+    remove(filePath);
+}
+
+TEST(SourceBuffer, ReadsEmptyFile) {
+    const Char *filePath = "/tmp/JellySourceBufferEmpty.jelly";
+    WriteFile(filePath, "", 0);
+
+    SourceBufferRef buffer = SourceBufferCreateFromFile(AllocatorGetSystemDefault(), filePath);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(SourceBufferGetLength(buffer), 0);
+    EXPECT_STREQ(SourceBufferGetCharacters(buffer), "");
+
+    SourceBufferDestroy(buffer);
+    remove(filePath);
+}
+
+TEST(SourceBuffer, MissingFile) {
+    EXPECT_EQ(SourceBufferCreateFromFile(AllocatorGetSystemDefault(), "/tmp/JellySourceBufferMissing.jelly"), nullptr);
+}
+
+TEST(SourceBuffer, ResolvesLineAndColumn) {
+    std::string content;
+    for (Index line = 0; line < 100; line++) {
+        content.append(line % 7, ' ');
+        content.append("var x: Int\n");
+    }
+    content.append("func main() {}");
+
+    StringRef string       = StringCreate(AllocatorGetSystemDefault(), content.c_str());
+    SourceBufferRef buffer = SourceBufferCreateFromString(AllocatorGetSystemDefault(), string);
+    const Char *characters = SourceBufferGetCharacters(buffer);
+    EXPECT_EQ(SourceBufferGetLineCount(buffer), 101);
+
+    Index line   = 0;
+    Index column = 0;
+    EXPECT_TRUE(SourceBufferGetLineAndColumn(buffer, characters, &line, &column));
+    EXPECT_EQ(line, 1);
+    EXPECT_EQ(column, 1);
+
+    Index offset = 0;
+    for (Index index = 0; index < 42; index++) {
+        offset += index % 7 + strlen("var x: Int\n");
+    }
+    EXPECT_TRUE(SourceBufferGetLineAndColumn(buffer, characters + offset + 42 % 7 + 4, &line, &column));
+    EXPECT_EQ(line, 43);
+    EXPECT_EQ(column, 42 % 7 + 5);
+
+    EXPECT_TRUE(SourceBufferGetLineAndColumn(buffer, characters + content.find("main"), &line, &column));
+    EXPECT_EQ(line, 101);
+    EXPECT_EQ(column, 6);
+
+    EXPECT_TRUE(SourceBufferGetLineAndColumn(buffer, characters + content.length(), &line, &column));
+    EXPECT_EQ(line, 101);
+    EXPECT_FALSE(SourceBufferGetLineAndColumn(buffer, characters + content.length() + 1, &line, &column));
+
+    SourceBufferDestroy(buffer);
+    StringDestroy(string);
+}
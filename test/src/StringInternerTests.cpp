@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(StringInterner, InternReturnsUniqueString) {
+    StringInternerRef interner = StringInternerCreate(AllocatorGetSystemDefault());
+    StringRef lhs              = StringCreate(AllocatorGetSystemDefault(), "identifier");
+    StringRef rhs              = StringCreate(AllocatorGetSystemDefault(), "identifier");
+
+    StringRef internedLhs = StringInternerIntern(interner, lhs);
+    StringRef internedRhs = StringInternerIntern(interner, rhs);
+    EXPECT_NE(internedLhs, lhs);
+    EXPECT_EQ(internedLhs, internedRhs);
+    EXPECT_EQ(internedLhs, StringInternerInternCString(interner, "identifier"));
+    EXPECT_TRUE(StringIsEqualToCString(internedLhs, "identifier"));
+    EXPECT_NE(internedLhs, StringInternerInternCString(interner, "identifier2"));
+
+    StringInternerStatistics statistics = StringInternerGetStatistics(interner);
+    EXPECT_EQ(statistics.internCount, 4);
+    EXPECT_EQ(statistics.stringCount, 2);
+    EXPECT_EQ(statistics.savedMemorySize, 2 * sizeof("identifier"));
+
+    StringDestroy(rhs);
+    StringDestroy(lhs);
+    StringInternerDestroy(interner);
+}
+
+TEST(StringInterner, LookupDoesNotIntern) {
+    StringInternerRef interner = StringInternerCreate(AllocatorGetSystemDefault());
+    StringRef name             = StringCreate(AllocatorGetSystemDefault(), "name");
+
+    EXPECT_EQ(StringInternerLookup(interner, name), nullptr);
+    StringRef interned = StringInternerIntern(interner, name);
+    EXPECT_EQ(StringInternerLookup(interner, name), interned);
+
+    StringDestroy(name);
+    StringInternerDestroy(interner);
+}
+
+TEST(StringInterner, InternManyStrings) {
+    StringInternerRef interner = StringInternerCreate(AllocatorGetSystemDefault());
+    Index stringCount          = 10000;
+    StringRef *strings         = (StringRef *)malloc(sizeof(StringRef) * stringCount);
+    Char buffer[32];
+
+    for (Index index = 0; index < stringCount; index++) {
+        snprintf(buffer, sizeof(buffer), "name%zu", (size_t)index);
+        strings[index] = StringInternerInternCString(interner, buffer);
+    }
+
+    for (Index index = 0; index < stringCount; index++) {
+        snprintf(buffer, sizeof(buffer), "name%zu", (size_t)index);
+        EXPECT_EQ(StringInternerInternCString(interner, buffer), strings[index]);
+    }
+
+    EXPECT_EQ(StringInternerGetStatistics(interner).stringCount, stringCount);
+
+    free(strings);
+    StringInternerDestroy(interner);
+}
+
+TEST(StringInterner, CacheReturnsStringsOfInterner) {
+    StringInternerRef interner = StringInternerCreate(AllocatorGetSystemDefault());
+    StringInternerRef cache    = StringInternerCreateCache(AllocatorGetSystemDefault(), interner);
+    StringRef name             = StringCreate(AllocatorGetSystemDefault(), "name");
+
+    StringRef interned = StringInternerIntern(interner, name);
+    EXPECT_EQ(StringInternerIntern(cache, name), interned);
+    EXPECT_EQ(StringInternerIntern(cache, name), interned);
+    EXPECT_EQ(StringInternerLookup(cache, name), interned);
+
+    StringRef cached = StringInternerInternCString(cache, "other");
+    EXPECT_EQ(StringInternerLookup(interner, cached), cached);
+    EXPECT_EQ(StringInternerGetStatistics(interner).stringCount, 2);
+
+    StringDestroy(name);
+    StringInternerDestroy(cache);
+    StringInternerDestroy(interner);
+}
+
+TEST(StringInterner, MergeCacheStatistics) {
+    StringInternerRef interner = StringInternerCreate(AllocatorGetSystemDefault());
+    StringInternerRef cache    = StringInternerCreateCache(AllocatorGetSystemDefault(), interner);
+
+    StringRef interned = StringInternerInternCString(interner, "name");
+    EXPECT_EQ(StringInternerInternCString(cache, "name"), interned);
+    EXPECT_EQ(StringInternerInternCString(cache, "name"), interned);
+    EXPECT_EQ(StringInternerLookup(cache, interned), interned);
+    StringInternerInternCString(cache, "other");
+
+    StringInternerMergeCacheStatistics(cache);
+
+    StringInternerStatistics statistics = StringInternerGetStatistics(interner);
+    EXPECT_EQ(statistics.internCount, 4);
+    EXPECT_EQ(statistics.lookupCount, 1);
+    EXPECT_EQ(statistics.stringCount, 2);
+    EXPECT_EQ(statistics.savedMemorySize, 10);
+    EXPECT_EQ(StringInternerGetStatistics(cache).internCount, 0);
+
+    StringInternerDestroy(cache);
+    StringInternerDestroy(interner);
+}
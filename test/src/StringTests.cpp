@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(String, ShortStringsNeedSingleAllocation) {
+    AllocatorStatistics statistics = AllocatorGetThreadStatistics();
+    StringRef string               = StringCreate(AllocatorGetSystemDefault(), "identifier");
+    EXPECT_EQ(AllocatorGetThreadStatistics().allocationCount, statistics.allocationCount + 1);
+    EXPECT_STREQ(StringGetCharacters(string), "identifier");
+    StringDestroy(string);
+}
+
+TEST(String, AppendGrowsGeometrically) {
+    StringRef string               = StringCreateEmpty(AllocatorGetSystemDefault());
+    AllocatorStatistics statistics = AllocatorGetThreadStatistics();
+    for (Index index = 0; index < 10000; index++) {
+        StringAppend(string, "x");
+    }
+
+    EXPECT_EQ(StringGetLength(string), 10000);
+    EXPECT_EQ(strlen(StringGetCharacters(string)), 10000);
+    EXPECT_LT(AllocatorGetThreadStatistics().allocationCount - statistics.allocationCount, 16);
+
+    StringRef copy = StringCreateCopy(AllocatorGetSystemDefault(), string);
+    EXPECT_TRUE(StringIsEqual(copy, string));
+    StringDestroy(copy);
+    StringDestroy(string);
+}
+
+TEST(String, AppendAcrossInlineCapacity) {
+    StringRef string = StringCreate(AllocatorGetSystemDefault(), "/usr/local");
+    StringAppendFormat(string, "/%s/%zu", "a-rather-long-directory-name", (Index)42);
+    StringAppendString(string, string);
+    EXPECT_STREQ(StringGetCharacters(string), "/usr/local/a-rather-long-directory-name/42/usr/local/a-rather-long-directory-name/42");
+    StringDestroy(string);
+}
+
+TEST(String, AppendFormatBeyondFormatBufferSize) {
+    StringRef path   = StringCreateEmpty(AllocatorGetSystemDefault());
+    StringRef string = StringCreate(AllocatorGetSystemDefault(), "ld");
+    for (Index index = 0; index < 8192; index++) {
+        StringAppend(path, "/path/to");
+    }
+
+    StringAppendFormat(string, " %s %s", StringGetCharacters(path), "-o");
+    EXPECT_EQ(StringGetLength(string), 2 + 1 + 8192 * 8 + 3);
+    EXPECT_EQ(strlen(StringGetCharacters(string)), StringGetLength(string));
+    EXPECT_STREQ(StringGetCharacters(string) + StringGetLength(string) - 11, "/path/to -o");
+
+    StringAppendFormat(string, "%s", "");
+    EXPECT_EQ(StringGetLength(string), 2 + 1 + 8192 * 8 + 3);
+    StringDestroy(string);
+    StringDestroy(path);
+}
+
+TEST(StringView, CompareWithoutCopying) {
+    const Char *source = "func main() {}";
+    StringView keyword = StringViewMake(source, source + 4);
+    StringView name    = StringViewMake(source + 5, source + 9);
+    EXPECT_TRUE(StringViewIsEqualToCString(keyword, "func"));
+    EXPECT_FALSE(StringViewIsEqualToCString(keyword, "fun"));
+    EXPECT_FALSE(StringViewIsEqualToCString(keyword, "function"));
+    EXPECT_FALSE(StringViewIsEqual(keyword, name));
+
+    StringRef string = StringCreateFromView(AllocatorGetSystemDefault(), name);
+    EXPECT_STREQ(StringGetCharacters(string), "main");
+    EXPECT_TRUE(StringViewIsEqual(StringGetView(string), name));
+
+    StringAppendView(string, keyword);
+    EXPECT_STREQ(StringGetCharacters(string), "mainfunc");
+    StringDestroy(string);
+}
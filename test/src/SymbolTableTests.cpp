@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(SymbolTable, InsertAndLookupSymbol) {
+    StringInternerRef interner = StringInternerCreate(AllocatorGetSystemDefault());
+    SymbolTableRef table       = SymbolTableCreate(AllocatorGetSystemDefault(), interner);
+    StringRef name             = StringCreate(AllocatorGetSystemDefault(), "value");
+    StringRef other            = StringCreate(AllocatorGetSystemDefault(), "other");
+
+    EXPECT_EQ(SymbolTableLookupSymbol(table, kScopeGlobal, name), kSymbolNull);
+    SymbolID symbol = SymbolTableInsertSymbol(table, kScopeGlobal, name);
+    EXPECT_NE(symbol, kSymbolNull);
+    EXPECT_EQ(SymbolTableLookupSymbol(table, kScopeGlobal, name), symbol);
+    EXPECT_EQ(SymbolTableLookupSymbol(table, kScopeGlobal, other), kSymbolNull);
+
+    StringDestroy(other);
+    StringDestroy(name);
+    SymbolTableDestroy(table);
+    StringInternerDestroy(interner);
+}
+
+TEST(SymbolTable, LookupSymbolInHierarchy) {
+    StringInternerRef interner = StringInternerCreate(AllocatorGetSystemDefault());
+    SymbolTableRef table       = SymbolTableCreate(AllocatorGetSystemDefault(), interner);
+    StringRef name             = StringCreate(AllocatorGetSystemDefault(), "value");
+    ScopeID scope              = SymbolTableInsertScope(table, ScopeKindBranch, kScopeGlobal, NULL);
+
+    SymbolID symbol = SymbolTableInsertSymbol(table, kScopeGlobal, name);
+    EXPECT_EQ(SymbolTableLookupSymbol(table, scope, name), kSymbolNull);
+    EXPECT_EQ(SymbolTableLookupSymbolInHierarchy(table, scope, name), symbol);
+
+    SymbolID shadow = SymbolTableInsertSymbol(table, scope, name);
+    EXPECT_NE(shadow, symbol);
+    EXPECT_EQ(SymbolTableLookupSymbolInHierarchy(table, scope, name), shadow);
+    EXPECT_EQ(SymbolTableLookupSymbol(table, kScopeGlobal, name), symbol);
+
+    StringDestroy(name);
+    SymbolTableDestroy(table);
+    StringInternerDestroy(interner);
+}
+
+TEST(SymbolTable, InsertManySymbols) {
+    StringInternerRef interner = StringInternerCreate(AllocatorGetSystemDefault());
+    SymbolTableRef table       = SymbolTableCreate(AllocatorGetSystemDefault(), interner);
+    ScopeID scope              = SymbolTableInsertScope(table, ScopeKindFunction, kScopeGlobal, NULL);
+    Index symbolCount          = 1000;
+
+    for (Index index = 0; index < symbolCount; index++) {
+        StringRef name = StringCreate(AllocatorGetSystemDefault(), "symbol_");
+        StringAppendFormat(name, "%zu", (size_t)index);
+        EXPECT_EQ(SymbolTableInsertSymbol(table, scope, name), (SymbolID)index);
+        StringDestroy(name);
+    }
+
+    for (Index index = 0; index < symbolCount; index++) {
+        StringRef name = StringCreate(AllocatorGetSystemDefault(), "symbol_");
+        StringAppendFormat(name, "%zu", (size_t)index);
+        EXPECT_EQ(SymbolTableLookupSymbol(table, scope, name), (SymbolID)index);
+        EXPECT_EQ(SymbolTableLookupSymbol(table, kScopeGlobal, name), kSymbolNull);
+        StringDestroy(name);
+    }
+
+    SymbolID *symbols;
+    Index count;
+    SymbolTableGetScopeSymbols(table, scope, &symbols, &count);
+    EXPECT_EQ(count, symbolCount);
+    for (Index index = 0; index < count; index++) {
+        EXPECT_EQ(symbols[index], (SymbolID)index);
+    }
+
+    SymbolTableDestroy(table);
+    StringInternerDestroy(interner);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(TempAllocator, ReuseDeallocatedBlocks) {
+    AllocatorRef allocator = TempAllocatorCreate(AllocatorGetSystemDefault());
+    void *first            = AllocatorAllocate(allocator, 24);
+    void *second           = AllocatorAllocate(allocator, 24);
+    EXPECT_NE(first, second);
+    EXPECT_EQ((uintptr_t)first % 16, 0);
+
+    AllocatorDeallocate(allocator, first);
+    EXPECT_EQ(AllocatorAllocate(allocator, 32), first);
+    EXPECT_NE(AllocatorAllocate(allocator, 32), first);
+    AllocatorDestroy(allocator);
+}
+
+TEST(TempAllocator, ReallocatePreservesContent) {
+    AllocatorRef allocator = TempAllocatorCreate(AllocatorGetSystemDefault());
+    Index capacity         = 1;
+    UInt8 *memory          = (UInt8 *)AllocatorAllocate(allocator, capacity);
+    memory[0]              = 0;
+    while (capacity < 1 << 16) {
+        Index newCapacity = capacity * 2 + 1;
+        memory            = (UInt8 *)AllocatorReallocate(allocator, memory, newCapacity);
+        for (Index index = capacity; index < newCapacity; index++) {
+            memory[index] = (UInt8)index;
+        }
+
+        capacity = newCapacity;
+    }
+
+    for (Index index = 0; index < capacity; index++) {
+        EXPECT_EQ(memory[index], (UInt8)index);
+    }
+
+    AllocatorDestroy(allocator);
+}
+
+TEST(TempAllocator, DestroyReleasesLiveAllocations) {
+    AllocatorRef allocator = TempAllocatorCreate(AllocatorGetSystemDefault());
+    for (Index index = 0; index < 10000; index++) {
+        StringRef string = StringCreate(allocator, "identifier");
+        StringAppendFormat(string, "%zu", index);
+        EXPECT_TRUE(StringGetLength(string) > 10);
+        if (index % 3 == 0) {
+            StringDestroy(string);
+        }
+    }
+
+    void *large = AllocatorAllocate(allocator, 1 << 20);
+    memset(large, 0, 1 << 20);
+    AllocatorDeallocate(allocator, AllocatorAllocate(allocator, 1 << 16));
+    AllocatorDestroy(allocator);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(TokenBuffer, MatchesLexerTokens) {
+    StringRef source = StringCreate(AllocatorGetSystemDefault(), "#load \"Library.jelly\"\n\n"
+                                                                 "func main() -> Int {\n"
+                                                                 "    /* comment */ var x: Float64 = 1.5e3 // trailing\n"
+                                                                 "    var y: Int = 0xFF + 42\n"
+                                                                 "    return (x as! Int) + y\n"
+                                                                 "}\n  ");
+    LexerRef lexer        = LexerCreate(AllocatorGetSystemDefault(), source);
+    TokenBufferRef buffer = TokenBufferCreate(AllocatorGetSystemDefault(), source);
+
+    Index index = 0;
+    Token expected;
+    Token token;
+    do {
+        LexerNextToken(lexer, &expected);
+        ASSERT_LT(index, TokenBufferGetCount(buffer));
+        TokenBufferGetToken(buffer, index, &token);
+        EXPECT_EQ(TokenBufferGetKind(buffer, index), expected.kind);
+        EXPECT_EQ(token.kind, expected.kind);
+        EXPECT_EQ(token.location.start, expected.location.start);
+        EXPECT_EQ(token.location.end, expected.location.end);
+        EXPECT_EQ(token.leadingTrivia.start, expected.leadingTrivia.start);
+        EXPECT_EQ(token.leadingTrivia.end, expected.leadingTrivia.end);
+        EXPECT_EQ(token.trailingTrivia.start, expected.trailingTrivia.start);
+        EXPECT_EQ(token.trailingTrivia.end, expected.trailingTrivia.end);
+        EXPECT_EQ(token.valueKind, expected.valueKind);
+        if (expected.valueKind == TokenValueKindInt) {
+            EXPECT_EQ(token.intValue, expected.intValue);
+        } else if (expected.valueKind == TokenValueKindFloat) {
+            EXPECT_EQ(token.floatValue, expected.floatValue);
+        }
+
+        index += 1;
+    } while (expected.kind != TokenKindEndOfFile);
+
+    EXPECT_EQ(index, TokenBufferGetCount(buffer));
+
+    TokenBufferDestroy(buffer);
+    LexerDestroy(lexer);
+    StringDestroy(source);
+}
+
+TEST(TokenBuffer, EmptySource) {
+    StringRef source      = StringCreate(AllocatorGetSystemDefault(), "");
+    TokenBufferRef buffer = TokenBufferCreate(AllocatorGetSystemDefault(), source);
+    EXPECT_EQ(TokenBufferGetCount(buffer), 1);
+    EXPECT_EQ(TokenBufferGetKind(buffer, 0), TokenKindEndOfFile);
+    TokenBufferDestroy(buffer);
+    StringDestroy(source);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <JellyCore/JellyCore.h>
+
+TEST(TrackingAllocator, RecordsLiveAndPeakBytes) {
+    AllocatorRef allocator = TrackingAllocatorCreate(AllocatorGetSystemDefault(), "Test");
+    EXPECT_STREQ(TrackingAllocatorGetTag(allocator), "Test");
+
+    void *first  = AllocatorAllocate(allocator, 16);
+    void *second = AllocatorAllocate(allocator, 100);
+    second       = AllocatorReallocate(allocator, second, 1000);
+    AllocatorDeallocate(allocator, first);
+
+    TrackingAllocatorStatistics statistics = TrackingAllocatorGetStatistics(allocator);
+    EXPECT_EQ(statistics.allocationCount, 2);
+    EXPECT_EQ(statistics.reallocationCount, 1);
+    EXPECT_EQ(statistics.deallocationCount, 1);
+    EXPECT_EQ(statistics.liveAllocationCount, 1);
+    EXPECT_EQ(statistics.liveBytes, 1000);
+    EXPECT_EQ(statistics.peakBytes, 1016);
+    EXPECT_EQ(statistics.histogram[0], 1);
+    EXPECT_EQ(statistics.histogram[3], 1);
+    EXPECT_EQ(statistics.histogram[6], 1);
+
+    AllocatorDeallocate(allocator, second);
+    AllocatorDestroy(allocator);
+}
+
+TEST(TrackingAllocator, LeakReportGroupsByCallSite) {
+    AllocatorRef allocator = TrackingAllocatorCreate(AllocatorGetSystemDefault(), "Test");
+    EXPECT_EQ(TrackingAllocatorSetCallSite("Parse"), nullptr);
+    AllocatorAllocate(allocator, 8);
+    AllocatorAllocate(allocator, 8);
+    EXPECT_STREQ(TrackingAllocatorSetCallSite("TypeCheck"), "Parse");
+    AllocatorDeallocate(allocator, AllocatorAllocate(allocator, 32));
+    AllocatorAllocate(allocator, 4);
+    TrackingAllocatorSetCallSite(NULL);
+
+    Char *buffer = NULL;
+    size_t size  = 0;
+    FILE *output = open_memstream(&buffer, &size);
+    EXPECT_EQ(TrackingAllocatorPrintLeakReport(allocator, output), 3);
+    fclose(output);
+
+    EXPECT_NE(strstr(buffer, "Test: leaked 3 allocation(s) with 20 byte(s)"), nullptr);
+    EXPECT_NE(strstr(buffer, "2 allocation(s) with 16 byte(s) allocated in Parse"), nullptr);
+    EXPECT_NE(strstr(buffer, "1 allocation(s) with 4 byte(s) allocated in TypeCheck"), nullptr);
+    free(buffer);
+
+    AllocatorDestroy(allocator);
+}
+
+TEST(TrackingAllocator, PrintReport) {
+    AllocatorRef allocators[2] = {
+        TrackingAllocatorCreate(AllocatorGetSystemDefault(), "Lexer"),
+        TrackingAllocatorCreate(AllocatorGetSystemDefault(), "Parser"),
+    };
+    AllocatorDeallocate(allocators[1], AllocatorAllocate(allocators[1], 1 << 20));
+
+    Char *buffer = NULL;
+    size_t size  = 0;
+    FILE *output = open_memstream(&buffer, &size);
+    TrackingAllocatorPrintReport(allocators, 2, output);
+    fclose(output);
+
+    EXPECT_NE(strstr(buffer, "Jelly Memory Report"), nullptr);
+    EXPECT_NE(strstr(buffer, "  Lexer\n"), nullptr);
+    EXPECT_NE(strstr(buffer, "1024.0  Parser\n"), nullptr);
+    EXPECT_NE(strstr(buffer, ">65536:1"), nullptr);
+    free(buffer);
+
+    AllocatorDestroy(allocators[0]);
+    AllocatorDestroy(allocators[1]);
+}